@@ -11,9 +11,9 @@
 
 #include "sw_all.h"
 #include <strsafe.h>
+#include <functional>
+#include <cstdio>
 #include <climits>
-#include <atomic>
-#include <deque>
 #include <cstdarg>
 
 // Animation.cpp
@@ -107,6 +107,16 @@ namespace
      */
     thread_local sw::Action<MSG &> _nullHwndMsgHandler;
 
+    /**
+     * @brief 当前线程消息循环每次执行空闲任务的时间预算，单位为毫秒
+     */
+    thread_local int _idleBudget = 8;
+
+    /**
+     * @brief 当前线程消息循环的空闲任务
+     */
+    thread_local sw::IdleScheduler _idleScheduler;
+
     /**
      * @brief 获取当前exe文件路径
      */
@@ -204,21 +214,95 @@ const sw::Property<sw::AppQuitMode> sw::App::QuitMode(
         }) //
 );
 
+const sw::Property<int> sw::App::IdleBudget(
+    Property<int>::Init()
+        .Getter([]() -> int {
+            return _idleBudget;
+        })
+        .Setter([](int value) {
+            _idleBudget = (std::max)(value, 0);
+        }) //
+);
+
 int sw::App::MsgLoop()
 {
+    // 创建当前线程的调度器，此后其他线程的InvokeAsync通过调度器批量执行
+    std::shared_ptr<Dispatcher> dispatcher = Dispatcher::GetCurrent();
+
+    // 有绑定等待延迟更新时通过调度器唤醒，空闲任务以及DefWindowProc等模态消息循环中产生的更新也能及时应用
+    Binding::SetDeferredUpdateRequestHandler([dispatcher]() {
+        dispatcher->BeginInvoke([]() { Binding::FlushDeferredUpdates(); });
+    });
+
     MSG msg;
-    while (GetMessageW(&msg, NULL, 0, 0) > 0) {
-        if (msg.hwnd == NULL) {
-            if (_nullHwndMsgHandler)
-                _nullHwndMsgHandler(msg);
+    bool hasIdleWork  = true;
+    bool resetPending = false;
+
+    while (true) {
+        if (PeekMessageW(&msg, NULL, 0, 0, PM_REMOVE)) {
+            if (msg.message == WM_QUIT) {
+                break;
+            }
+            if (msg.hwnd == NULL) {
+                if (_nullHwndMsgHandler)
+                    _nullHwndMsgHandler(msg);
+            } else {
+                TranslateMessage(&msg);
+                DispatchMessageW(&msg);
+            }
+            // 每处理一条消息更新一次延迟绑定，期间源属性的多次更改只应用最新值
+            Binding::FlushDeferredUpdates();
+
+            // 处理消息可能产生新的工作，下次空闲时重新调用所有任务
+            hasIdleWork  = true;
+            resetPending = true;
+            continue;
+        }
+
+        if (hasIdleWork && !_idleScheduler.IsEmpty()) {
+            if (resetPending) {
+                _idleScheduler.Reset();
+                resetPending = false;
+            }
+            // 消息队列为空，在预算内执行空闲任务，有输入时立即让出
+            hasIdleWork = _idleScheduler.Run(
+                std::chrono::milliseconds(_idleBudget),
+                []() { return HIWORD(GetQueueStatus(QS_INPUT)) != 0; });
         } else {
-            TranslateMessage(&msg);
-            DispatchMessageW(&msg);
+            hasIdleWork = false;
+        }
+
+        // 等待新消息前应用空闲任务产生的延迟更新，剩余的更新（在外层刷新中嵌套运行时）由外层刷新应用，不会空转
+        Binding::FlushDeferredUpdates();
+
+        if (!hasIdleWork) {
+            // 没有空闲工作时等待新消息，MWMO_INPUTAVAILABLE使已经在队列中但被查看过的输入也能唤醒
+            MsgWaitForMultipleObjectsEx(0, NULL, INFINITE, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
         }
     }
     return (int)msg.wParam;
 }
 
+int sw::App::AddIdleTask(const std::wstring &name, const Func<bool> &task)
+{
+    return _idleScheduler.Add(name, task);
+}
+
+bool sw::App::RemoveIdleTask(int id)
+{
+    return _idleScheduler.Remove(id);
+}
+
+std::vector<sw::IdleTaskStatistics> sw::App::GetIdleTaskStatistics()
+{
+    return _idleScheduler.GetStatistics();
+}
+
+void sw::App::ResetIdleTaskStatistics()
+{
+    _idleScheduler.ResetStatistics();
+}
+
 void sw::App::QuitMsgLoop(int exitCode)
 {
     PostQuitMessage(exitCode);
@@ -314,7 +398,7 @@ bool sw::BmpBox::OnPaint()
     HBITMAP hBitmap    = CreateCompatibleBitmap(hdc, width, height);
     HBITMAP hBitmapOld = (HBITMAP)SelectObject(hdcMem, hBitmap);
 
-    HBRUSH hBackColorBrush = CreateSolidBrush(static_cast<COLORREF>(this->GetRealBackColor()));
+    HBRUSH hBackColorBrush = BrushCache::GetBrush(static_cast<COLORREF>(this->GetRealBackColor()));
     FillRect(hdcMem, &clientRect, hBackColorBrush);
 
     if (this->_hBitmap != NULL &&
@@ -371,7 +455,6 @@ bool sw::BmpBox::OnPaint()
 
     SelectObject(hdcMem, hBitmapOld);
     DeleteObject(hBitmap);
-    DeleteObject(hBackColorBrush);
     DeleteDC(hdcMem);
 
     EndPaint(hwnd, &ps);
@@ -437,6 +520,142 @@ HBITMAP sw::BmpBox::_SetBmpIfNotNull(HBITMAP hBitmap)
     return hBitmap;
 }
 
+// BrushCache.cpp
+
+constexpr int sw::BrushCache::DefaultCapacity;
+
+sw::BrushCache::~BrushCache()
+{
+    for (auto &item : this->_brushes) {
+        DeleteObject(item.hBrush);
+    }
+    _IsDestroyed() = true;
+}
+
+HBRUSH sw::BrushCache::GetBrush(COLORREF color)
+{
+    BrushCache &cache = _GetInstance();
+
+    auto it = cache._Get(color);
+    return it == cache._brushes.end() ? NULL : it->hBrush;
+}
+
+HBRUSH sw::BrushCache::Acquire(COLORREF color)
+{
+    BrushCache &cache = _GetInstance();
+
+    auto it = cache._Get(color);
+    if (it == cache._brushes.end()) {
+        return NULL;
+    }
+
+    if (it->refCount++ == 0) {
+        ++cache._statistics.acquiredCount;
+    }
+    return it->hBrush;
+}
+
+void sw::BrushCache::Release(HBRUSH hBrush)
+{
+    if (hBrush == NULL || _IsDestroyed()) {
+        return;
+    }
+
+    BrushCache &cache = _GetInstance();
+
+    auto it = cache._handles.find(hBrush);
+    if (it == cache._handles.end() || it->second->refCount <= 0) {
+        return;
+    }
+
+    if (--it->second->refCount == 0) {
+        --cache._statistics.acquiredCount;
+        cache._Trim(cache._capacity);
+    }
+}
+
+int sw::BrushCache::GetCapacity()
+{
+    return _GetInstance()._capacity;
+}
+
+void sw::BrushCache::SetCapacity(int capacity)
+{
+    BrushCache &cache = _GetInstance();
+
+    cache._capacity = capacity < 1 ? 1 : capacity;
+    cache._Trim(cache._capacity);
+}
+
+void sw::BrushCache::Clear()
+{
+    _GetInstance()._Trim(0);
+}
+
+sw::BrushCacheStatistics sw::BrushCache::GetStatistics()
+{
+    return _GetInstance()._statistics;
+}
+
+sw::BrushCache &sw::BrushCache::_GetInstance()
+{
+    static thread_local BrushCache cache;
+    return cache;
+}
+
+bool &sw::BrushCache::_IsDestroyed()
+{
+    static thread_local bool destroyed = false;
+    return destroyed;
+}
+
+std::list<sw::BrushCache::_BrushInfo>::iterator sw::BrushCache::_Get(COLORREF color)
+{
+    auto it = this->_index.find(color);
+
+    if (it != this->_index.end()) {
+        // 移至表头，标记为最近使用
+        this->_brushes.splice(this->_brushes.begin(), this->_brushes, it->second);
+        ++this->_statistics.reusedCount;
+        return it->second;
+    }
+
+    HBRUSH hBrush = CreateSolidBrush(color);
+    if (hBrush == NULL) {
+        return this->_brushes.end();
+    }
+
+    // 先腾出位置再插入，保证新画刷不会被立即销毁
+    this->_Trim(this->_capacity - 1);
+    this->_brushes.push_front(_BrushInfo{color, hBrush, 0});
+    this->_index.emplace(color, this->_brushes.begin());
+    this->_handles.emplace(hBrush, this->_brushes.begin());
+
+    ++this->_statistics.createdCount;
+    this->_statistics.brushCount = static_cast<int>(this->_brushes.size());
+    return this->_brushes.begin();
+}
+
+void sw::BrushCache::_Trim(int maxCount)
+{
+    // 被引用的画刷不计入数量，也不会被销毁
+    int count = static_cast<int>(this->_brushes.size()) - this->_statistics.acquiredCount;
+
+    for (auto it = this->_brushes.end(); count > maxCount && it != this->_brushes.begin();) {
+        --it;
+        if (it->refCount > 0) {
+            continue;
+        }
+        DeleteObject(it->hBrush);
+        this->_index.erase(it->color);
+        this->_handles.erase(it->hBrush);
+        it = this->_brushes.erase(it);
+        ++this->_statistics.evictedCount;
+        --count;
+    }
+    this->_statistics.brushCount = static_cast<int>(this->_brushes.size());
+}
+
 // Button.cpp
 
 sw::Button::Button()
@@ -935,6 +1154,34 @@ sw::ComboBox::ComboBox()
                       self->OnSelectionChanged();
                       self->RaisePropertyChanged(&ComboBox::IsEditable);
                   }
+              })),
+
+      VirtualMode(
+          Property<bool>::Init(this)
+              .Getter([](ComboBox *self) -> bool {
+                  return (self->GetStyle() & (CBS_OWNERDRAWFIXED | CBS_HASSTRINGS)) == CBS_OWNERDRAWFIXED;
+              })
+              .Setter([](ComboBox *self, bool value) {
+                  if (self->VirtualMode != value) {
+                      auto baseStyle = self->GetStyle() & ~(CBS_OWNERDRAWFIXED | CBS_HASSTRINGS);
+                      self->SetStyle(baseStyle | (value ? CBS_OWNERDRAWFIXED : CBS_HASSTRINGS));
+                      self->ResetHandle();
+                      self->Refresh();
+                      self->OnSelectionChanged();
+                      self->RaisePropertyChanged(&ComboBox::VirtualMode);
+                  }
+              })),
+
+      SearchIndex(
+          Property<IItemSearchIndex *>::Init(this)
+              .Getter([](ComboBox *self) -> IItemSearchIndex * {
+                  return self->_searchIndex;
+              })
+              .Setter([](ComboBox *self, IItemSearchIndex *value) {
+                  if (self->_searchIndex != value) {
+                      self->_searchIndex = value;
+                      self->RaisePropertyChanged(&ComboBox::SearchIndex);
+                  }
               }))
 {
     InitControl(
@@ -968,6 +1215,27 @@ void sw::ComboBox::CloseDropDown()
     SendMessageW(CB_SHOWDROPDOWN, FALSE, 0);
 }
 
+int sw::ComboBox::FindString(const std::wstring &prefix, int startIndex)
+{
+    if (!VirtualMode) {
+        return (int)SendMessageW(CB_FINDSTRING, startIndex, reinterpret_cast<LPARAM>(prefix.c_str()));
+    }
+
+    if (_searchIndex != nullptr) {
+        return _searchIndex->FindPrefix(prefix, startIndex);
+    }
+
+    IList *items = GetCurrentItemsSource();
+    int count    = items ? items->Count() : 0;
+    int length   = static_cast<int>(prefix.size());
+
+    return IncrementalItemSearch::FindNext(count, startIndex, [&](int index) -> bool {
+        std::wstring text = GetDisplayText(index, items->GetVariantAt(index));
+        return static_cast<int>(text.size()) >= length &&
+               CompareStringOrdinal(text.c_str(), length, prefix.c_str(), length, TRUE) == CSTR_EQUAL;
+    });
+}
+
 sw::IList *sw::ComboBox::GetDefaultItemsSource()
 {
     return &_items;
@@ -988,19 +1256,31 @@ void sw::ComboBox::OnCurrentItemsSourceCollectionChanged(const NotifyCollectionC
     switch (args.action) {
         case NotifyCollectionChangedAction::Add:
             if (index >= args.index) {
-                index++;
+                index += args.count;
+            }
+            if (VirtualMode) {
+                _SetCount(args.list->Count());
+            } else {
+                for (int i = args.index; i < args.index + args.count; ++i) {
+                    _InsertString(i, GetDisplayText(i, args.list->GetVariantAt(i)));
+                }
             }
-            _InsertString(args.index, GetDisplayText(args.index, args.list->GetVariantAt(args.index)));
             itemsCountChanged = true;
             break;
 
         case NotifyCollectionChangedAction::Remove:
-            if (index == args.index) {
+            if (index >= args.index && index < args.index + args.count) {
                 index = -1;
-            } else if (index > args.index) {
-                index--;
+            } else if (index >= args.index + args.count) {
+                index -= args.count;
+            }
+            if (VirtualMode) {
+                _SetCount(args.list->Count());
+            } else {
+                for (int i = 0; i < args.count; ++i) {
+                    _DeleteString(args.index);
+                }
             }
-            _DeleteString(args.index);
             itemsCountChanged = true;
             break;
 
@@ -1010,8 +1290,16 @@ void sw::ComboBox::OnCurrentItemsSourceCollectionChanged(const NotifyCollectionC
             break;
 
         case NotifyCollectionChangedAction::Replace:
-            _DeleteString(args.index);
-            _InsertString(args.index, GetDisplayText(args.index, args.list->GetVariantAt(args.index)));
+            if (VirtualMode) {
+                if (index >= args.index && index < args.index + args.count) {
+                    _UpdateSelectedText();
+                }
+            } else {
+                for (int i = args.index; i < args.index + args.count; ++i) {
+                    _DeleteString(i);
+                    _InsertString(i, GetDisplayText(i, args.list->GetVariantAt(i)));
+                }
+            }
             break;
 
         case NotifyCollectionChangedAction::Move:
@@ -1022,8 +1310,10 @@ void sw::ComboBox::OnCurrentItemsSourceCollectionChanged(const NotifyCollectionC
             } else if (index < args.oldIndex && index >= args.index) {
                 index++;
             }
-            _DeleteString(args.oldIndex);
-            _InsertString(args.index, GetDisplayText(args.index, args.list->GetVariantAt(args.index)));
+            if (!VirtualMode) {
+                _DeleteString(args.oldIndex);
+                _InsertString(args.index, GetDisplayText(args.index, args.list->GetVariantAt(args.index)));
+            }
             break;
     }
 
@@ -1078,6 +1368,75 @@ void sw::ComboBox::OnSelectionChanged()
     TBase::OnSelectionChanged();
 }
 
+void sw::ComboBox::FontChanged(HFONT hfont)
+{
+    if (VirtualMode) {
+        _UpdateItemHeight();
+    }
+    TBase::FontChanged(hfont);
+}
+
+void sw::ComboBox::OnHandleChanged(HWND hwnd)
+{
+    if (VirtualMode) {
+        _UpdateItemHeight();
+    }
+    TBase::OnHandleChanged(hwnd);
+}
+
+bool sw::ComboBox::OnChar(wchar_t ch, const KeyFlags &flags)
+{
+    if (TBase::OnChar(ch, flags)) {
+        return true;
+    }
+
+    // 虚拟模式下控件中的项没有文本，由控件自身查找会匹配不到任何项
+    if (VirtualMode && ch >= L' ') {
+        _IncrementalSearch(ch);
+        return true;
+    }
+    return false;
+}
+
+bool sw::ComboBox::OnDrawItemSelf(DRAWITEMSTRUCT *pDrawItem)
+{
+    if (!VirtualMode) {
+        return TBase::OnDrawItemSelf(pDrawItem);
+    }
+
+    IList *items = GetCurrentItemsSource();
+
+    int index = static_cast<int>(pDrawItem->itemID);
+    int count = items ? items->Count() : 0;
+
+    HDC hdc   = pDrawItem->hDC;
+    RECT rect = pDrawItem->rcItem;
+
+    std::wstring text;
+    if (index >= 0 && index < count) {
+        text = GetDisplayText(index, items->GetVariantAt(index));
+    }
+
+    if (pDrawItem->itemState & ODS_SELECTED) {
+        ::SetBkColor(hdc, GetSysColor(COLOR_HIGHLIGHT));
+        ::SetTextColor(hdc, GetSysColor(COLOR_HIGHLIGHTTEXT));
+    } else {
+        ::SetBkColor(hdc, static_cast<COLORREF>(GetRealBackColor()));
+        ::SetTextColor(hdc, pDrawItem->itemState & ODS_DISABLED ? GetSysColor(COLOR_GRAYTEXT) : static_cast<COLORREF>(GetRealTextColor()));
+    }
+
+    ::ExtTextOutW(hdc, rect.left, rect.top, ETO_OPAQUE, &rect, nullptr, 0, nullptr);
+
+    RECT textRect = rect;
+    textRect.left += GetSystemMetrics(SM_CXBORDER) * 2;
+    ::DrawTextW(hdc, text.c_str(), -1, &textRect, DT_LEFT | DT_VCENTER | DT_SINGLELINE | DT_NOPREFIX);
+
+    if (pDrawItem->itemState & ODS_FOCUS) {
+        ::DrawFocusRect(hdc, &rect);
+    }
+    return true;
+}
+
 std::wstring sw::ComboBox::GetDisplayText(int index, const Variant &item)
 {
     std::wstring text;
@@ -1102,6 +1461,12 @@ void sw::ComboBox::_UpdateSelectedText()
 
 void sw::ComboBox::_UpdateItems()
 {
+    if (VirtualMode) {
+        IList *items = GetCurrentItemsSource();
+        _SetCount(items ? items->Count() : 0);
+        return;
+    }
+
     SendMessageW(CB_RESETCONTENT, 0, 0);
 
     if (IList *items = GetCurrentItemsSource()) {
@@ -1127,6 +1492,71 @@ void sw::ComboBox::_DeleteString(int index)
     SendMessageW(CB_DELETESTRING, index, 0);
 }
 
+void sw::ComboBox::_SetCount(int count)
+{
+    int current = (int)SendMessageW(CB_GETCOUNT, 0, 0);
+
+    if (count == current) {
+        return;
+    }
+
+    // 删除的项多于保留的项时清空后重新添加
+    if (count < current - count) {
+        SendMessageW(CB_RESETCONTENT, 0, 0);
+        current = 0;
+    }
+
+    if (count > current) {
+        // 虚拟模式下控件不保存文本，添加的项只是占位，绘制时从数据源读取
+        SendMessageW(CB_INITSTORAGE, count - current, 0);
+        for (; current < count; ++current) {
+            SendMessageW(CB_ADDSTRING, 0, 0);
+        }
+    } else {
+        for (; current > count; --current) {
+            SendMessageW(CB_DELETESTRING, current - 1, 0);
+        }
+    }
+}
+
+void sw::ComboBox::_UpdateItemHeight()
+{
+    HWND hwnd   = Handle;
+    HDC hdc     = GetDC(hwnd);
+    HFONT hFont = (HFONT)SendMessageW(WM_GETFONT, 0, 0);
+
+    if (hFont == NULL) {
+        hFont = (HFONT)GetStockObject(DEFAULT_GUI_FONT);
+    }
+
+    HFONT hFontOld = (HFONT)SelectObject(hdc, hFont);
+
+    TEXTMETRIC tm{};
+    GetTextMetrics(hdc, &tm);
+
+    int cyItem = tm.tmHeight + tm.tmExternalLeading;
+    cyItem += GetSystemMetrics(SM_CYBORDER) * 2;
+
+    SelectObject(hdc, hFontOld);
+    ReleaseDC(hwnd, hdc);
+
+    SendMessageW(CB_SETITEMHEIGHT, (WPARAM)-1, cyItem);
+    SendMessageW(CB_SETITEMHEIGHT, 0, cyItem);
+}
+
+void sw::ComboBox::_IncrementalSearch(wchar_t ch)
+{
+    int found = _incrementalSearch.Input(
+        ch, GetTickCount(), GetSelectedIndex(),
+        [this](const std::wstring &prefix, int startIndex) -> int {
+            return FindString(prefix, startIndex);
+        });
+
+    if (found >= 0) {
+        SetSelectedIndex(found);
+    }
+}
+
 // CommandLink.cpp
 
 sw::CommandLink::CommandLink()
@@ -1608,38 +2038,436 @@ int sw::Dip::DipToPxY(double dip) noexcept
     return (int)std::lround(dip / _scaleInfo.scaleY);
 }
 
-// DockLayout.cpp
+// Dispatcher.cpp
 
-static int _GetDockLayoutTag(sw::ILayout &item)
+namespace
 {
-    auto tag = item.GetLayoutTag();
-    return (tag > sw::DockLayoutTag::Bottom) ? sw::DockLayoutTag::Left : int(tag);
-}
+    /**
+     * @brief 消息窗口的窗口类名
+     */
+    constexpr wchar_t _DispatcherClassName[] = L"sw::Dispatcher";
 
-sw::DockLayoutTag::DockLayoutTag(uint64_t value)
-    : _value(value)
-{
-}
+    /**
+     * @brief 各线程的调度器
+     */
+    struct _DispatcherRegistry {
+        std::mutex mutex;
+        std::unordered_map<DWORD, std::weak_ptr<sw::Dispatcher>> dispatchers;
+    };
 
-sw::DockLayoutTag::operator uint64_t() const
-{
-    return this->_value;
-}
+    /**
+     * @brief 获取调度器表
+     */
+    _DispatcherRegistry &_GetRegistry()
+    {
+        static _DispatcherRegistry registry;
+        return registry;
+    }
 
-bool sw::DockLayoutTag::Equals(const DockLayoutTag &other) const
-{
-    return this->_value == other._value;
+    /**
+     * @brief 当前线程上次通过FromThread获取的调度器，避免每次添加任务都访问调度器表
+     */
+    thread_local DWORD _cachedThreadId = 0;
+    thread_local std::weak_ptr<sw::Dispatcher> _cachedDispatcher;
 }
 
-bool sw::DockLayoutTag::operator==(uint64_t value) const
-{
-    return this->_value == value;
-}
+constexpr UINT_PTR sw::Dispatcher::_ContinueTimerId;
+constexpr int sw::Dispatcher::_DrainBudgetMs;
 
-bool sw::DockLayoutTag::operator!=(uint64_t value) const
+sw::Dispatcher::Dispatcher()
+    : _threadId(GetCurrentThreadId()), _hwnd(NULL)
 {
-    return this->_value != value;
-}
+    static ATOM wndClsAtom = []() -> ATOM {
+        WNDCLASSEXW wc{};
+        wc.cbSize        = sizeof(wc);
+        wc.hInstance     = App::Instance;
+        wc.lpfnWndProc   = Dispatcher::_WndProc;
+        wc.lpszClassName = _DispatcherClassName;
+        return RegisterClassExW(&wc);
+    }();
+
+    (void)wndClsAtom; // 消除未使用变量警告
+
+    this->_hwnd = CreateWindowExW(
+        0, _DispatcherClassName, L"", 0, 0, 0, 0, 0, HWND_MESSAGE, NULL, App::Instance, NULL);
+
+    if (this->_hwnd == NULL) {
+        // 没有消息窗口时无法唤醒，BeginInvoke总是失败，调用者回退到其他方式
+        this->_isShutdown.store(true);
+    } else {
+        SetWindowLongPtrW(this->_hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(this));
+    }
+}
+
+sw::Dispatcher::~Dispatcher()
+{
+}
+
+std::shared_ptr<sw::Dispatcher> sw::Dispatcher::GetCurrent()
+{
+    static thread_local class _ThreadHolder
+    {
+    public:
+        // 当前线程的调度器
+        std::shared_ptr<Dispatcher> dispatcher;
+
+        // 线程退出时会调用析构函数
+        ~_ThreadHolder()
+        {
+            if (this->dispatcher != nullptr) {
+                _DispatcherRegistry &registry = _GetRegistry();
+                {
+                    std::lock_guard<std::mutex> lock(registry.mutex);
+                    registry.dispatchers.erase(this->dispatcher->_threadId);
+                }
+                this->dispatcher->_Shutdown();
+            }
+        }
+    } holder;
+
+    if (holder.dispatcher == nullptr) {
+        holder.dispatcher.reset(new Dispatcher);
+
+        _DispatcherRegistry &registry = _GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.dispatchers[holder.dispatcher->_threadId] = holder.dispatcher;
+    }
+    return holder.dispatcher;
+}
+
+std::shared_ptr<sw::Dispatcher> sw::Dispatcher::FromThread(DWORD threadId)
+{
+    if (threadId == _cachedThreadId) {
+        std::shared_ptr<Dispatcher> result = _cachedDispatcher.lock();
+        if (result != nullptr) {
+            return result;
+        }
+    }
+
+    std::shared_ptr<Dispatcher> result;
+    {
+        _DispatcherRegistry &registry = _GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        auto it = registry.dispatchers.find(threadId);
+        if (it != registry.dispatchers.end()) {
+            result = it->second.lock();
+        }
+    }
+
+    if (result != nullptr) {
+        _cachedThreadId   = threadId;
+        _cachedDispatcher = result;
+    }
+    return result;
+}
+
+DWORD sw::Dispatcher::GetThreadId() const noexcept
+{
+    return this->_threadId;
+}
+
+bool sw::Dispatcher::CheckAccess() const noexcept
+{
+    return this->_threadId == GetCurrentThreadId();
+}
+
+bool sw::Dispatcher::BeginInvoke(const Action<> &action, DispatcherPriority priority, uint64_t key)
+{
+    if (action == nullptr || this->_isShutdown.load()) {
+        return false;
+    }
+
+    if (!this->_queue.Enqueue(action, priority, key) ||
+        PostMessageW(this->_hwnd, WM_DispatcherWake, 0, 0)) {
+        return true;
+    }
+
+    // 在所属线程中添加时改用计时器唤醒，计时器消息不占用消息队列
+    if (this->CheckAccess() && !this->_isShutdown.load()) {
+        if (this->_isTimerSet || SetTimer(this->_hwnd, _ContinueTimerId, USER_TIMER_MINIMUM, NULL) != 0) {
+            this->_isTimerSet = true;
+            return true;
+        }
+    }
+
+    // 消息队列已满时投递失败，撤销唤醒请求以便下次添加任务时重试，已添加的任务随下次成功的唤醒执行
+    this->_queue.CancelWakeRequest();
+    return false;
+}
+
+sw::DispatcherQueueMetrics sw::Dispatcher::GetMetrics() const
+{
+    return this->_queue.GetMetrics();
+}
+
+void sw::Dispatcher::ResetMetrics()
+{
+    this->_queue.ResetMetrics();
+}
+
+void sw::Dispatcher::_OnWake()
+{
+    if (this->_isTimerSet) {
+        KillTimer(this->_hwnd, _ContinueTimerId);
+        this->_isTimerSet = false;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_DrainBudgetMs);
+
+    bool hasRemaining = this->_queue.Drain([deadline]() -> bool {
+        return HIWORD(GetQueueStatus(QS_INPUT)) != 0 ||
+               std::chrono::steady_clock::now() >= deadline;
+    });
+
+    if (hasRemaining && !this->_isShutdown.load()) {
+        // 计时器消息在输入消息之后才会被取出，剩余任务不会阻塞输入的处理
+        this->_isTimerSet = SetTimer(this->_hwnd, _ContinueTimerId, USER_TIMER_MINIMUM, NULL) != 0;
+
+        if (!this->_isTimerSet) {
+            PostMessageW(this->_hwnd, WM_DispatcherWake, 0, 0);
+        }
+    }
+}
+
+void sw::Dispatcher::_Shutdown()
+{
+    this->_isShutdown.store(true);
+
+    if (this->_hwnd != NULL) {
+        SetWindowLongPtrW(this->_hwnd, GWLP_USERDATA, 0);
+        DestroyWindow(this->_hwnd);
+    }
+}
+
+LRESULT CALLBACK sw::Dispatcher::_WndProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+{
+    if (uMsg == WM_DispatcherWake || (uMsg == WM_TIMER && wParam == _ContinueTimerId)) {
+        auto pDispatcher = reinterpret_cast<Dispatcher *>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
+        if (pDispatcher) pDispatcher->_OnWake();
+        return 0;
+    }
+    return DefWindowProcW(hwnd, uMsg, wParam, lParam);
+}
+
+// DispatcherQueue.cpp
+
+constexpr int sw::DispatcherQueue::_PriorityCount;
+
+sw::DispatcherQueue::~DispatcherQueue()
+{
+    for (_Level &level : this->_levels) {
+        this->_Take(level);
+        for (_Node *node : level.taken) {
+            delete node;
+        }
+        level.taken.clear();
+        level.pendingKeys.clear();
+    }
+}
+
+bool sw::DispatcherQueue::Enqueue(const Action<> &action, DispatcherPriority priority, uint64_t key)
+{
+    _Node *node       = new _Node;
+    node->action      = action;
+    node->key         = key;
+    node->enqueueTime = this->_Now();
+
+    size_t depth = this->_depth.fetch_add(1, std::memory_order_relaxed) + 1;
+    size_t max   = this->_maxDepth.load(std::memory_order_relaxed);
+    while (depth > max && !this->_maxDepth.compare_exchange_weak(max, depth, std::memory_order_relaxed)) {
+    }
+    this->_enqueuedCount.fetch_add(1, std::memory_order_relaxed);
+
+    _Push(this->_levels[static_cast<int>(priority)], node);
+
+    // 添加完成后再检查唤醒请求，消费者在Drain开始时清除请求，因此Drain取不到的任务总会有新的唤醒请求
+    return !this->_wakeRequested.exchange(true, std::memory_order_acq_rel);
+}
+
+void sw::DispatcherQueue::CancelWakeRequest() noexcept
+{
+    this->_wakeRequested.store(false, std::memory_order_seq_cst);
+}
+
+bool sw::DispatcherQueue::Drain(const Func<bool> &shouldYield)
+{
+    this->_wakeRequested.store(false, std::memory_order_seq_cst);
+    ++this->_batchCount;
+
+    const Func<bool> *yield = shouldYield ? &shouldYield : nullptr;
+
+    for (int i = 0; i < _PriorityCount; ++i) {
+        _Level &level = this->_levels[i];
+        this->_Take(level);
+
+        // Input优先级的任务总是全部执行
+        if (this->_Run(level, i == static_cast<int>(DispatcherPriority::Input) ? nullptr : yield)) {
+            break;
+        }
+    }
+
+    for (_Level &level : this->_levels) {
+        if (!level.taken.empty() || level.tail != &level.stub || level.head.load(std::memory_order_acquire) != &level.stub) {
+            return true;
+        }
+    }
+    return false;
+}
+
+sw::DispatcherQueueMetrics sw::DispatcherQueue::GetMetrics() const
+{
+    DispatcherQueueMetrics metrics;
+    metrics.depth          = this->_depth.load(std::memory_order_relaxed);
+    metrics.maxDepth       = this->_maxDepth.load(std::memory_order_relaxed);
+    metrics.enqueuedCount  = this->_enqueuedCount.load(std::memory_order_relaxed);
+    metrics.executedCount  = this->_executedCount;
+    metrics.coalescedCount = this->_coalescedCount;
+    metrics.batchCount     = this->_batchCount;
+    metrics.totalLatency   = this->_totalLatency;
+    metrics.maxLatency     = this->_maxLatency;
+    return metrics;
+}
+
+void sw::DispatcherQueue::ResetMetrics()
+{
+    this->_maxDepth.store(this->_depth.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    this->_enqueuedCount.store(0, std::memory_order_relaxed);
+    this->_executedCount  = 0;
+    this->_coalescedCount = 0;
+    this->_batchCount     = 0;
+    this->_totalLatency   = 0;
+    this->_maxLatency     = 0;
+}
+
+uint64_t sw::DispatcherQueue::_Now() const noexcept
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->_epoch).count());
+}
+
+void sw::DispatcherQueue::_Push(_Level &level, _Node *node) noexcept
+{
+    node->next.store(nullptr, std::memory_order_relaxed);
+    _Node *prev = level.head.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+}
+
+sw::DispatcherQueue::_Node *sw::DispatcherQueue::_Pop(_Level &level) noexcept
+{
+    _Node *tail = level.tail;
+    _Node *next = tail->next.load(std::memory_order_acquire);
+
+    if (tail == &level.stub) {
+        if (next == nullptr) {
+            return nullptr;
+        }
+        level.tail = next;
+        tail       = next;
+        next       = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next != nullptr) {
+        level.tail = next;
+        return tail;
+    }
+
+    // tail不是最后入队的节点时，有生产者已交换head但尚未链接next，留到下次取出
+    if (tail != level.head.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+
+    // tail是最后一个节点，重新放入哨兵节点后才能将其取出
+    _Push(level, &level.stub);
+    next = tail->next.load(std::memory_order_acquire);
+
+    if (next != nullptr) {
+        level.tail = next;
+        return tail;
+    }
+    return nullptr;
+}
+
+void sw::DispatcherQueue::_Take(_Level &level)
+{
+    while (_Node *node = _Pop(level)) {
+        if (node->key != 0) {
+            auto result = level.pendingKeys.emplace(node->key, node);
+            if (!result.second) {
+                result.first->second->superseded = true;
+                result.first->second             = node;
+                ++this->_coalescedCount;
+            }
+        }
+        level.taken.push_back(node);
+    }
+}
+
+bool sw::DispatcherQueue::_Run(_Level &level, const Func<bool> *shouldYield)
+{
+    while (!level.taken.empty()) {
+        _Node *front = level.taken.front();
+
+        if (!front->superseded && shouldYield != nullptr && (*shouldYield)()) {
+            return true;
+        }
+
+        std::unique_ptr<_Node> node(front);
+        level.taken.pop_front();
+        this->_depth.fetch_sub(1, std::memory_order_relaxed);
+
+        if (node->superseded) {
+            continue;
+        }
+
+        if (node->key != 0) {
+            level.pendingKeys.erase(node->key);
+        }
+
+        uint64_t latency = this->_Now() - node->enqueueTime;
+        this->_totalLatency += latency;
+        this->_maxLatency = (std::max)(this->_maxLatency, latency);
+        ++this->_executedCount;
+
+        if (node->action) {
+            node->action();
+        }
+    }
+    return false;
+}
+
+// DockLayout.cpp
+
+static int _GetDockLayoutTag(sw::ILayout &item)
+{
+    auto tag = item.GetLayoutTag();
+    return (tag > sw::DockLayoutTag::Bottom) ? sw::DockLayoutTag::Left : int(tag);
+}
+
+sw::DockLayoutTag::DockLayoutTag(uint64_t value)
+    : _value(value)
+{
+}
+
+sw::DockLayoutTag::operator uint64_t() const
+{
+    return this->_value;
+}
+
+bool sw::DockLayoutTag::Equals(const DockLayoutTag &other) const
+{
+    return this->_value == other._value;
+}
+
+bool sw::DockLayoutTag::operator==(uint64_t value) const
+{
+    return this->_value == value;
+}
+
+bool sw::DockLayoutTag::operator!=(uint64_t value) const
+{
+    return this->_value != value;
+}
 
 sw::Size sw::DockLayout::MeasureOverride(const Size &availableSize)
 {
@@ -2196,8 +3024,10 @@ void sw::FileDialog::_FiltersCollectionChangedHandler(
     INotifyCollectionChanged &sender, NotifyCollectionChangedEventArgs &args)
 {
     if (args.action == NotifyCollectionChangedAction::Add &&
-        args.index == _filters.Count() - 1) {
-        _AppendFilterToBuffer(_filters.GetAt(args.index));
+        args.index + args.count == _filters.Count()) {
+        for (int i = args.index; i < _filters.Count(); ++i) {
+            _AppendFilterToBuffer(_filters.GetAt(i));
+        }
     } else {
         _ResetFilterBuffer();
     }
@@ -2555,6 +3385,126 @@ sw::Font &sw::Font::GetDefaultFont(bool update)
     return font;
 }
 
+// FontCache.cpp
+
+size_t sw::FontCache::_LogFontHash::operator()(const LOGFONTW &logFont) const noexcept
+{
+    size_t result = 0;
+
+    auto combine = [&result](size_t value) {
+        result ^= value + 0x9e3779b9 + (result << 6) + (result >> 2);
+    };
+
+    combine(std::hash<LONG>{}(logFont.lfHeight));
+    combine(std::hash<LONG>{}(logFont.lfWidth));
+    combine(std::hash<LONG>{}(logFont.lfEscapement));
+    combine(std::hash<LONG>{}(logFont.lfOrientation));
+    combine(std::hash<LONG>{}(logFont.lfWeight));
+
+    combine((size_t)logFont.lfItalic |
+            (size_t)logFont.lfUnderline << 8 |
+            (size_t)logFont.lfStrikeOut << 16 |
+            (size_t)logFont.lfCharSet << 24);
+    combine((size_t)logFont.lfOutPrecision |
+            (size_t)logFont.lfClipPrecision << 8 |
+            (size_t)logFont.lfQuality << 16 |
+            (size_t)logFont.lfPitchAndFamily << 24);
+
+    for (int i = 0; i < LF_FACESIZE && logFont.lfFaceName[i] != L'\0'; ++i) {
+        combine(std::hash<wchar_t>{}(logFont.lfFaceName[i]));
+    }
+    return result;
+}
+
+bool sw::FontCache::_LogFontEqual::operator()(const LOGFONTW &a, const LOGFONTW &b) const noexcept
+{
+    // 字体名称之后的内容不参与比较
+    return a.lfHeight == b.lfHeight &&
+           a.lfWidth == b.lfWidth &&
+           a.lfEscapement == b.lfEscapement &&
+           a.lfOrientation == b.lfOrientation &&
+           a.lfWeight == b.lfWeight &&
+           a.lfItalic == b.lfItalic &&
+           a.lfUnderline == b.lfUnderline &&
+           a.lfStrikeOut == b.lfStrikeOut &&
+           a.lfCharSet == b.lfCharSet &&
+           a.lfOutPrecision == b.lfOutPrecision &&
+           a.lfClipPrecision == b.lfClipPrecision &&
+           a.lfQuality == b.lfQuality &&
+           a.lfPitchAndFamily == b.lfPitchAndFamily &&
+           std::wcsncmp(a.lfFaceName, b.lfFaceName, LF_FACESIZE) == 0;
+}
+
+HFONT sw::FontCache::Acquire(const LOGFONTW &logFont)
+{
+    FontCache &cache = _GetInstance();
+    std::lock_guard<std::mutex> lock(cache._mutex);
+
+    auto it = cache._handles.find(logFont);
+
+    if (it != cache._handles.end()) {
+        ++cache._handleInfos.find(it->second)->second.refCount;
+        ++cache._statistics.hitCount;
+        ++cache._statistics.referenceCount;
+        return it->second;
+    }
+
+    HFONT hfont = CreateFontIndirectW(&logFont);
+    ++cache._statistics.missCount;
+
+    if (hfont != NULL) {
+        cache._handles.emplace(logFont, hfont);
+        cache._handleInfos.emplace(hfont, _HandleInfo{logFont, 1});
+        ++cache._statistics.handleCount;
+        ++cache._statistics.referenceCount;
+    }
+    return hfont;
+}
+
+HFONT sw::FontCache::Acquire(const Font &font)
+{
+    LOGFONTW logFont = font;
+    return Acquire(logFont);
+}
+
+void sw::FontCache::Release(HFONT hfont)
+{
+    if (hfont == NULL) {
+        return;
+    }
+
+    FontCache &cache = _GetInstance();
+    std::lock_guard<std::mutex> lock(cache._mutex);
+
+    auto it = cache._handleInfos.find(hfont);
+    if (it == cache._handleInfos.end()) {
+        return;
+    }
+
+    --cache._statistics.referenceCount;
+
+    if (--it->second.refCount == 0) {
+        cache._handles.erase(it->second.logFont);
+        cache._handleInfos.erase(it);
+        --cache._statistics.handleCount;
+        DeleteObject(hfont);
+    }
+}
+
+sw::FontCacheStatistics sw::FontCache::GetStatistics()
+{
+    FontCache &cache = _GetInstance();
+    std::lock_guard<std::mutex> lock(cache._mutex);
+    return cache._statistics;
+}
+
+sw::FontCache &sw::FontCache::_GetInstance()
+{
+    // 不析构缓存对象，避免静态对象析构时释放字体句柄访问已销毁的缓存
+    static FontCache *instance = new FontCache;
+    return *instance;
+}
+
 // FontDialog.cpp
 
 sw::FontDialog::FontDialog()
@@ -2693,25 +3643,27 @@ sw::FrameworkElement::FrameworkElement()
                   if (!self->_dataContext.ReferenceEquals(value)) {
                       auto oldDataContext = self->CurrentDataContext.Get();
                       self->_dataContext  = value;
+                      self->_InvalidateCurrentDataContextTree();
                       self->RaisePropertyChanged(&FrameworkElement::DataContext);
-                      if (oldDataContext != self->_dataContext.Object()) {
-                          self->OnCurrentDataContextChanged(oldDataContext);
-                      }
+                      // 小对象存放在Variant内部的缓冲区中，新旧对象的地址可能相同，不能通过指针判断是否改变
+                      self->OnCurrentDataContextChanged(oldDataContext);
                   }
               })),
 
       CurrentDataContext(
           Property<DynamicObject *>::Init(this)
               .Getter([](FrameworkElement *self) -> DynamicObject * {
-                  DynamicObject *result     = nullptr;
-                  FrameworkElement *element = self;
-                  do {
-                      result  = element->_dataContext.Object();
-                      element = element->GetParent();
-                  } while (result == nullptr && element != nullptr);
-                  return result;
-              }))
-{
+                  if (DynamicObject *result = self->_dataContext.Object()) {
+                      return result;
+                  }
+                  if (!self->_isCurrentDataContextValid) {
+                      FrameworkElement *parent         = self->GetParent();
+                      self->_currentDataContext        = parent ? parent->CurrentDataContext.Get() : nullptr;
+                      self->_isCurrentDataContextValid = true;
+                  }
+                  return self->_currentDataContext;
+              }))
+{
 }
 
 bool sw::FrameworkElement::AddBinding(BindingBase *binding)
@@ -2788,13 +3740,13 @@ void sw::FrameworkElement::OnTagChanged()
 
 void sw::FrameworkElement::OnCurrentDataContextChanged(DynamicObject *oldDataContext)
 {
-    std::vector<FrameworkElement *> stack;
-    stack.push_back(this);
+    ScratchBuffer<FrameworkElement *> stack;
+    stack->push_back(this);
 
-    while (!stack.empty()) //
+    while (!stack->empty()) //
     {
-        auto current = stack.back();
-        stack.pop_back();
+        auto current = stack->back();
+        stack->pop_back();
 
         current->RaisePropertyChanged(
             &FrameworkElement::CurrentDataContext);
@@ -2812,7 +3764,42 @@ void sw::FrameworkElement::OnCurrentDataContextChanged(DynamicObject *oldDataCon
             auto &child = current->GetChildAt(i);
 
             if (child._dataContext.IsNull()) {
-                stack.push_back(&child);
+                stack->push_back(&child);
+            }
+        }
+    }
+}
+
+void sw::FrameworkElement::InvalidateCurrentDataContext()
+{
+    // 自身设置了DataContext时，父元素的变化不会影响当前元素及其子元素
+    if (this->_dataContext.IsNull()) {
+        this->_InvalidateCurrentDataContextTree();
+    }
+}
+
+void sw::FrameworkElement::_InvalidateCurrentDataContextTree()
+{
+    ScratchBuffer<FrameworkElement *> stack;
+    stack->push_back(this);
+
+    this->_isCurrentDataContextValid = false;
+
+    while (!stack->empty()) //
+    {
+        auto current = stack->back();
+        stack->pop_back();
+
+        int childCount = current->GetChildCount();
+
+        for (int i = 0; i < childCount; ++i) //
+        {
+            auto &child = current->GetChildAt(i);
+
+            // 缓存已失效的子元素，其后代的缓存也必然已失效
+            if (child._dataContext.IsNull() && child._isCurrentDataContextValid) {
+                child._isCurrentDataContextValid = false;
+                stack->push_back(&child);
             }
         }
     }
@@ -2880,6 +3867,41 @@ void sw::Grid::_RowsColumnsCollectionChangedHandler(
 
 // GridLayout.cpp
 
+namespace
+{
+    /**
+     * @brief 判断两组行定义是否相同
+     */
+    bool IsSameDefinitions(const std::vector<sw::GridRow> &a, const std::vector<sw::GridRow> &b)
+    {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i].type != b[i].type || a[i].height != b[i].height) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 判断两组列定义是否相同
+     */
+    bool IsSameDefinitions(const std::vector<sw::GridColumn> &a, const std::vector<sw::GridColumn> &b)
+    {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i].type != b[i].type || a[i].width != b[i].width) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
 sw::GridLayoutTag::GridLayoutTag(
     uint16_t row, uint16_t column, uint16_t rowSpan, uint16_t columnSpan)
     : row(row), column(column), rowSpan(rowSpan), columnSpan(columnSpan)
@@ -2989,23 +4011,11 @@ sw::Size sw::GridLayout::MeasureOverride(const Size &availableSize)
 
     // Measure列
 
-    // 对childrenInfo进行排序
+    // 按照_UpdateInternalData中确定的顺序measure
     // 优先级 FixSize > AutoSize > FillRemain
     // 对于优先级相同的则按照columnSpan从小到大排序
-    std::sort(
-        this->_internalData.childrenInfo.begin(),
-        this->_internalData.childrenInfo.end(),
-        [](const _ChildInfo &a, const _ChildInfo &b) -> bool {
-            if (a.colMeasureType != b.colMeasureType) {
-                // 先FixSize，后AutoSize，最后FillRemain
-                return a.colMeasureType < b.colMeasureType;
-            } else {
-                // 若类型相同，则按照跨列数从小到大measure
-                return a.layoutTag.columnSpan < b.layoutTag.columnSpan;
-            }
-        });
-
-    for (_ChildInfo &childInfo : this->_internalData.childrenInfo) {
+    for (int childIndex : this->_internalData.colMeasureOrder) {
+        _ChildInfo &childInfo = this->_internalData.childrenInfo[childIndex];
         bool breakFlag = false; // 标记是否退出循环
 
         switch (childInfo.colMeasureType) {
@@ -3136,28 +4146,17 @@ sw::Size sw::GridLayout::MeasureOverride(const Size &availableSize)
 
     // Measure行
 
-    // 对childrenInfo进行排序
+    // 按照_UpdateInternalData中确定的顺序measure
     // 优先级 FixSize > AutoSize > FillRemain
     // 对于优先级相同的则按照rowSpan从小到大排序
-    std::sort(
-        this->_internalData.childrenInfo.begin(),
-        this->_internalData.childrenInfo.end(),
-        [](const _ChildInfo &a, const _ChildInfo &b) -> bool {
-            if (a.rowMeasureType != b.rowMeasureType) {
-                // 先FixSize，后AutoSize，最后FillRemain
-                return a.rowMeasureType < b.rowMeasureType;
-            } else {
-                // 若类型相同，则按照跨列数从小到大measure
-                return a.layoutTag.rowSpan < b.layoutTag.rowSpan;
-            }
-        });
+    const std::vector<int> &rowMeasureOrder = this->_internalData.rowMeasureOrder;
 
     int measureIndex = 0;
 
     // Measure行类型为FixSize的元素
     while (measureIndex < childCount &&
-           this->_internalData.childrenInfo[measureIndex].rowMeasureType == GridRCType::FixSize) {
-        _ChildInfo &childInfo = this->_internalData.childrenInfo[measureIndex++];
+           this->_internalData.childrenInfo[rowMeasureOrder[measureIndex]].rowMeasureType == GridRCType::FixSize) {
+        _ChildInfo &childInfo = this->_internalData.childrenInfo[rowMeasureOrder[measureIndex++]];
 
         Size measureSize{};
         for (int i = 0; i < childInfo.layoutTag.columnSpan; ++i)
@@ -3169,8 +4168,8 @@ sw::Size sw::GridLayout::MeasureOverride(const Size &availableSize)
 
     // Measure行类型为AutoSize的元素
     while (measureIndex < childCount &&
-           this->_internalData.childrenInfo[measureIndex].rowMeasureType == GridRCType::AutoSize) {
-        _ChildInfo &childInfo = this->_internalData.childrenInfo[measureIndex++];
+           this->_internalData.childrenInfo[rowMeasureOrder[measureIndex]].rowMeasureType == GridRCType::AutoSize) {
+        _ChildInfo &childInfo = this->_internalData.childrenInfo[rowMeasureOrder[measureIndex++]];
 
         Size measureSize{0, INFINITY};
         for (int i = 0; i < childInfo.layoutTag.columnSpan; ++i) {
@@ -3214,7 +4213,7 @@ sw::Size sw::GridLayout::MeasureOverride(const Size &availableSize)
     if (heightSizeToContent) {
         // 高度由内容决定，依据所占宽度最大元素为基准计算列宽度
         while (measureIndex < childCount) {
-            _ChildInfo &childInfo = this->_internalData.childrenInfo[measureIndex++];
+            _ChildInfo &childInfo = this->_internalData.childrenInfo[rowMeasureOrder[measureIndex++]];
 
             Size measureSize{0, INFINITY};
             for (int i = 0; i < childInfo.layoutTag.columnSpan; ++i)
@@ -3289,7 +4288,7 @@ sw::Size sw::GridLayout::MeasureOverride(const Size &availableSize)
         }
         // Measure
         while (measureIndex < childCount) {
-            _ChildInfo &childInfo = this->_internalData.childrenInfo[measureIndex++];
+            _ChildInfo &childInfo = this->_internalData.childrenInfo[rowMeasureOrder[measureIndex++]];
 
             Size measureSize{};
             for (int i = 0; i < childInfo.layoutTag.columnSpan; ++i)
@@ -3350,6 +4349,60 @@ void sw::GridLayout::ArrangeOverride(const Size &finalSize)
 
 void sw::GridLayout::_UpdateInternalData()
 {
+    if (this->_IsInternalDataValid()) {
+        // 行列定义、子元素及其布局标记均未改变，沿用已排好序的子元素信息，
+        // 只需重置非FixSize行/列的尺寸，由本次measure重新计算。
+        // ILayout无法得知子元素的测量结果是否已失效，因此AutoSize行/列总是重新测量并累加子元素的尺寸；
+        // 固定尺寸单元格中的子元素每次收到相同的可用尺寸，未失效时由UIElement::Measure直接返回
+        this->_ResetTrackSizes();
+    } else {
+        this->_RebuildInternalData();
+    }
+}
+
+bool sw::GridLayout::_IsInternalDataValid()
+{
+    if (this->_internalData.rowsInfo.empty() ||
+        !IsSameDefinitions(this->rows.GetInternalVector(), this->_internalData.rowsDefinition) ||
+        !IsSameDefinitions(this->columns.GetInternalVector(), this->_internalData.colsDefinition)) {
+        return false;
+    }
+
+    int childCount = this->GetChildLayoutCount();
+
+    if (childCount != (int)this->_internalData.childrenInfo.size()) {
+        return false;
+    }
+
+    for (int i = 0; i < childCount; ++i) {
+        ILayout &item         = this->GetChildLayoutAt(i);
+        _ChildInfo &childInfo = this->_internalData.childrenInfo[i];
+        if (childInfo.instance != &item || childInfo.sourceTag != item.GetLayoutTag()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void sw::GridLayout::_ResetTrackSizes()
+{
+    for (_RowInfo &rowInfo : this->_internalData.rowsInfo) {
+        if (rowInfo.row.type != GridRCType::FixSize) {
+            rowInfo.size = 0;
+        }
+    }
+    for (_ColInfo &colInfo : this->_internalData.colsInfo) {
+        if (colInfo.col.type != GridRCType::FixSize) {
+            colInfo.size = 0;
+        }
+    }
+}
+
+void sw::GridLayout::_RebuildInternalData()
+{
+    this->_internalData.rowsDefinition = this->rows.GetInternalVector();
+    this->_internalData.colsDefinition = this->columns.GetInternalVector();
+
     this->_internalData.rowsInfo.clear();
     this->_internalData.colsInfo.clear();
     this->_internalData.childrenInfo.clear();
@@ -3508,6 +4561,7 @@ void sw::GridLayout::_UpdateInternalData()
             }
 
             info.instance       = &item;
+            info.sourceTag      = item.GetLayoutTag();
             info.layoutTag      = tag;
             info.rowMeasureType = rowMeasureType;
             info.colMeasureType = colMeasureType;
@@ -3516,6 +4570,51 @@ void sw::GridLayout::_UpdateInternalData()
         }
     }
 
+    // measure顺序
+    {
+        int childCount = (int)this->_internalData.childrenInfo.size();
+
+        std::vector<int> &colOrder = this->_internalData.colMeasureOrder;
+        std::vector<int> &rowOrder = this->_internalData.rowMeasureOrder;
+
+        colOrder.resize(childCount);
+        rowOrder.resize(childCount);
+
+        for (int i = 0; i < childCount; ++i) {
+            colOrder[i] = rowOrder[i] = i;
+        }
+
+        const std::vector<_ChildInfo> &childrenInfo = this->_internalData.childrenInfo;
+
+        // 先FixSize，后AutoSize，最后FillRemain
+        // 若类型相同，则按照跨列数从小到大measure
+        std::sort(colOrder.begin(), colOrder.end(), [&childrenInfo](int a, int b) -> bool {
+            const _ChildInfo &infoA = childrenInfo[a];
+            const _ChildInfo &infoB = childrenInfo[b];
+            if (infoA.colMeasureType != infoB.colMeasureType) {
+                return infoA.colMeasureType < infoB.colMeasureType;
+            } else if (infoA.layoutTag.columnSpan != infoB.layoutTag.columnSpan) {
+                return infoA.layoutTag.columnSpan < infoB.layoutTag.columnSpan;
+            } else {
+                return a < b;
+            }
+        });
+
+        // 先FixSize，后AutoSize，最后FillRemain
+        // 若类型相同，则按照跨行数从小到大measure
+        std::sort(rowOrder.begin(), rowOrder.end(), [&childrenInfo](int a, int b) -> bool {
+            const _ChildInfo &infoA = childrenInfo[a];
+            const _ChildInfo &infoB = childrenInfo[b];
+            if (infoA.rowMeasureType != infoB.rowMeasureType) {
+                return infoA.rowMeasureType < infoB.rowMeasureType;
+            } else if (infoA.layoutTag.rowSpan != infoB.layoutTag.rowSpan) {
+                return infoA.layoutTag.rowSpan < infoB.layoutTag.rowSpan;
+            } else {
+                return a < b;
+            }
+        });
+    }
+
     // cells
     {
         this->_internalData.cells.resize(this->_internalData.rowsInfo.size() * this->_internalData.colsInfo.size());
@@ -3577,7 +4676,7 @@ void sw::GroupBox::OnDrawBorder(HDC hdc, RECT &rect)
         COLORREF oldTextColor = ::SetTextColor(hdc, textColor);
         HGDIOBJ hOldFont      = ::SelectObject(hdc, GetFontHandle());
 
-        HBRUSH hBrush = CreateSolidBrush(backColor);
+        HBRUSH hBrush = BrushCache::GetBrush(backColor);
 
         RECT rtHeaderRow = {
             rect.left,
@@ -3621,10 +4720,6 @@ void sw::GroupBox::OnDrawBorder(HDC hdc, RECT &rect)
 
         ::SetTextColor(hdc, oldTextColor);
         ::SetBkColor(hdc, oldBackColor);
-
-        if (hBrush != NULL) {
-            DeleteObject(hBrush);
-        }
     }
 
     rect.left += borderThicknessX;
@@ -4148,6 +5243,151 @@ HICON sw::IconBox::_SetIconIfNotNull(HICON hIcon)
     return hIcon;
 }
 
+// IdleScheduler.cpp
+
+int sw::IdleScheduler::Add(const std::wstring &name, const Func<bool> &task)
+{
+    std::unique_ptr<_Task> item(new _Task);
+    item->task            = task;
+    item->statistics.id   = this->_nextId++;
+    item->statistics.name = name;
+
+    int id = item->statistics.id;
+    this->_tasks.push_back(std::move(item));
+    return id;
+}
+
+bool sw::IdleScheduler::Remove(int id)
+{
+    for (size_t i = 0; i < this->_tasks.size(); ++i) {
+        _Task &item = *this->_tasks[i];
+
+        if (item.removed || item.statistics.id != id) {
+            continue;
+        }
+
+        if (this->_isRunning) {
+            // 任务可能正在执行，延迟到Run结束时删除
+            item.removed      = true;
+            item.hasWork      = false;
+            this->_hasRemoved = true;
+        } else {
+            this->_tasks.erase(this->_tasks.begin() + i);
+            if (this->_cursor > i) --this->_cursor;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool sw::IdleScheduler::IsEmpty() const noexcept
+{
+    for (const auto &item : this->_tasks) {
+        if (!item->removed) return false;
+    }
+    return true;
+}
+
+void sw::IdleScheduler::Reset() noexcept
+{
+    for (auto &item : this->_tasks) {
+        item->hasWork = !item->removed;
+    }
+}
+
+bool sw::IdleScheduler::Run(std::chrono::nanoseconds budget, const Func<bool> &shouldYield)
+{
+    using clock = std::chrono::steady_clock;
+
+    if (this->_isRunning) {
+        return false; // 任务中嵌套的消息循环不执行空闲任务，由外层的Run继续
+    }
+
+    this->_isRunning = true;
+    clock::time_point start = clock::now();
+
+    // 连续检查一轮都没有找到有工作的任务时停止
+    size_t index = this->_cursor;
+    size_t idle  = 0;
+
+    while (idle < this->_tasks.size()) {
+        if (index >= this->_tasks.size()) {
+            index = 0;
+        }
+        _Task &item = *this->_tasks[index++];
+
+        if (!item.hasWork) {
+            ++idle;
+            continue;
+        }
+        this->_cursor = index;
+
+        clock::time_point begin = clock::now();
+        item.hasWork            = item.task() && !item.removed;
+        clock::time_point end   = clock::now();
+
+        uint64_t cost = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+        item.statistics.callCount += 1;
+        item.statistics.totalTime += cost;
+        item.statistics.maxTime = (std::max)(item.statistics.maxTime, cost);
+
+        idle = 0;
+
+        if (end - start >= budget || (shouldYield && shouldYield())) {
+            break;
+        }
+    }
+
+    this->_isRunning = false;
+    this->_RemovePending();
+
+    for (const auto &item : this->_tasks) {
+        if (item->hasWork) return true;
+    }
+    return false;
+}
+
+std::vector<sw::IdleTaskStatistics> sw::IdleScheduler::GetStatistics() const
+{
+    std::vector<IdleTaskStatistics> result;
+    result.reserve(this->_tasks.size());
+
+    for (const auto &item : this->_tasks) {
+        if (!item->removed) result.push_back(item->statistics);
+    }
+    return result;
+}
+
+void sw::IdleScheduler::ResetStatistics() noexcept
+{
+    for (auto &item : this->_tasks) {
+        item->statistics.callCount = 0;
+        item->statistics.totalTime = 0;
+        item->statistics.maxTime   = 0;
+    }
+}
+
+void sw::IdleScheduler::_RemovePending()
+{
+    if (!this->_hasRemoved) {
+        return;
+    }
+    this->_hasRemoved = false;
+
+    size_t cursor = this->_cursor;
+    size_t kept   = 0;
+
+    for (size_t i = 0; i < this->_tasks.size(); ++i) {
+        if (this->_tasks[i]->removed) {
+            if (i < this->_cursor) --cursor;
+        } else {
+            this->_tasks[kept++] = std::move(this->_tasks[i]);
+        }
+    }
+    this->_tasks.resize(kept);
+    this->_cursor = cursor;
+}
+
 // ImageList.cpp
 
 sw::ImageList::ImageList(HIMAGELIST hImageList, bool isWrap) noexcept
@@ -4416,6 +5656,53 @@ void sw::ImageList::_DestroyIfNotWrap() noexcept
     }
 }
 
+// IncrementalItemSearch.cpp
+
+sw::IncrementalItemSearch::IncrementalItemSearch(uint32_t timeout)
+    : _timeout(timeout)
+{
+}
+
+int sw::IncrementalItemSearch::Input(wchar_t ch, uint32_t time, int currentIndex, const Func<const std::wstring &, int, int> &findPrefix)
+{
+    if (time - this->_lastTime > this->_timeout) {
+        this->_text.clear();
+    }
+    this->_lastTime = time;
+    this->_text += ch;
+
+    if (this->_text.find_first_not_of(ch) == std::wstring::npos) {
+        // 重复输入同一字符时依次选中以该字符开头的下一项
+        return findPrefix(this->_text.substr(0, 1), currentIndex);
+    } else {
+        // 当前项仍然匹配时保持不变
+        return findPrefix(this->_text, currentIndex < 0 ? -1 : currentIndex - 1);
+    }
+}
+
+void sw::IncrementalItemSearch::Reset() noexcept
+{
+    this->_text.clear();
+}
+
+const std::wstring &sw::IncrementalItemSearch::GetText() const noexcept
+{
+    return this->_text;
+}
+
+int sw::IncrementalItemSearch::FindNext(int count, int startIndex, const Func<int, bool> &match)
+{
+    int first = (startIndex < 0 || startIndex >= count) ? 0 : startIndex + 1;
+
+    for (int i = 0; i < count; ++i) {
+        int index = (first + i) % count;
+        if (match(index)) {
+            return index;
+        }
+    }
+    return -1;
+}
+
 // ItemsControl.cpp
 
 sw::ItemsControl::ItemsControl()
@@ -4765,47 +6052,356 @@ sw::ILayout &sw::LayoutHost::GetChildLayoutAt(int index) const
     return this->_associatedObj->GetChildLayoutAt(index);
 }
 
-// ListBox.cpp
+void sw::LayoutHost::UpdateViewport(const Rect &viewport)
+{
+}
 
-sw::ListBox::ListBox()
-    : Items(
-          Property<ObservableCollection<std::wstring> *>::Init(this)
-              .Getter([](ListBox *self) -> ObservableCollection<std::wstring> * {
-                  return &self->_items;
-              })),
+sw::Size sw::LayoutHost::GetContentExtent()
+{
+    return Size{};
+}
 
-      ItemHeight(
-          Property<double>::Init(this)
-              .Getter([](ListBox *self) -> double {
-                  return self->_itemHeight;
-              })
-              .Setter([](ListBox *self, double value) {
-                  if (self->_itemHeight != value) {
-                      self->_itemHeight = value;
-                      self->_UpdateItemHeight();
-                      self->RaisePropertyChanged(&ListBox::ItemHeight);
-                  }
-              })),
+// LayoutProfiler.cpp
 
-      TopIndex(
-          Property<int>::Init(this)
-              .Getter([](ListBox *self) -> int {
-                  return (int)self->SendMessageW(LB_GETTOPINDEX, 0, 0);
-              })
-              .Setter([](ListBox *self, int value) {
-                  self->SendMessageW(LB_SETTOPINDEX, value, 0);
-              })),
+namespace
+{
+    /**
+     * @brief 将字符串转义后以JSON字符串的形式追加到out
+     */
+    void _AppendJsonString(std::string &out, const char *str)
+    {
+        out += '"';
+        for (; *str; ++str) {
+            char ch = *str;
+            switch (ch) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default: {
+                    if (static_cast<unsigned char>(ch) < 0x20) {
+                        char buf[8];
+                        snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(ch));
+                        out += buf;
+                    } else {
+                        out += ch;
+                    }
+                    break;
+                }
+            }
+        }
+        out += '"';
+    }
 
-      SelectedItemBackColor(
-          Property<Color>::Init(this)
-              .Getter([](ListBox *self) -> Color {
-                  return self->_selectedItemBackColor;
-              })
-              .Setter([](ListBox *self, const Color &value) {
-                  if (self->_selectedItemBackColor != value) {
-                      self->_selectedItemBackColor = value;
-                      self->Redraw();
-                      self->RaisePropertyChanged(&ListBox::SelectedItemBackColor);
+    /**
+     * @brief 将对象地址以JSON字符串的形式追加到out
+     */
+    void _AppendJsonAddress(std::string &out, const void *obj)
+    {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "\"0x%llx\"", static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(obj)));
+        out += buf;
+    }
+
+    /**
+     * @brief 将整数追加到out
+     */
+    void _AppendNumber(std::string &out, uint64_t value)
+    {
+        out += std::to_string(value);
+    }
+
+    /**
+     * @brief 将纳秒数以微秒为单位追加到out，用于Chrome Trace的时间戳
+     */
+    void _AppendMicroseconds(std::string &out, uint64_t ns)
+    {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%llu.%03u", static_cast<unsigned long long>(ns / 1000), static_cast<unsigned>(ns % 1000));
+        out += buf;
+    }
+}
+
+constexpr size_t sw::LayoutProfiler::MaxTraceEventCount;
+
+bool sw::LayoutProfiler::IsEnabled() noexcept
+{
+    return _GetInstance()._enabled;
+}
+
+void sw::LayoutProfiler::SetEnabled(bool enabled, bool trace)
+{
+    LayoutProfiler &profiler = _GetInstance();
+
+    profiler._enabled      = enabled;
+    profiler._traceEnabled = enabled && trace;
+}
+
+void sw::LayoutProfiler::Reset()
+{
+    LayoutProfiler &profiler = _GetInstance();
+
+    profiler._records.clear();
+    profiler._index.clear();
+    profiler._stack.clear();
+    profiler._events.clear();
+    profiler._droppedEventCount = 0;
+    profiler._epoch             = std::chrono::steady_clock::now();
+}
+
+void sw::LayoutProfiler::RecordMeasureSkipped(const void *obj)
+{
+    LayoutProfiler &profiler = _GetInstance();
+
+    if (profiler._enabled) {
+        ++profiler._GetRecord(obj).measureSkipCount;
+    }
+}
+
+void sw::LayoutProfiler::RecordSetWindowPos(const void *obj)
+{
+    LayoutProfiler &profiler = _GetInstance();
+
+    if (profiler._enabled) {
+        ++profiler._GetRecord(obj).setWindowPosCount;
+    }
+}
+
+void sw::LayoutProfiler::RecordDeferWindowPos(const void *obj)
+{
+    LayoutProfiler &profiler = _GetInstance();
+
+    if (profiler._enabled) {
+        ++profiler._GetRecord(obj).deferWindowPosCount;
+    }
+}
+
+std::vector<sw::LayoutProfileRecord> sw::LayoutProfiler::GetRecords()
+{
+    return _GetInstance()._records;
+}
+
+std::string sw::LayoutProfiler::ToJson()
+{
+    LayoutProfiler &profiler = _GetInstance();
+
+    // 按记录的parent字段建立树，外层对象没有记录的视为根节点
+    std::vector<size_t> roots;
+    std::vector<std::vector<size_t>> children(profiler._records.size());
+
+    for (size_t i = 0; i < profiler._records.size(); ++i) {
+        auto it = profiler._index.find(profiler._records[i].parent);
+        if (profiler._records[i].parent == nullptr || it == profiler._index.end()) {
+            roots.push_back(i);
+        } else {
+            children[it->second].push_back(i);
+        }
+    }
+
+    std::string out = "{\"elements\":[";
+    for (size_t i = 0; i < roots.size(); ++i) {
+        if (i != 0) out += ',';
+        profiler._WriteJsonNode(out, roots[i], children);
+    }
+    out += "]}";
+    return out;
+}
+
+std::string sw::LayoutProfiler::ToChromeTrace()
+{
+    LayoutProfiler &profiler = _GetInstance();
+
+    std::string out = "{\"traceEvents\":[";
+    for (size_t i = 0; i < profiler._events.size(); ++i) {
+        const _TraceEvent &event          = profiler._events[i];
+        const LayoutProfileRecord &record = profiler._records[event.record];
+
+        if (i != 0) out += ',';
+        out += "{\"name\":";
+        _AppendJsonString(out, record.typeName);
+        out += event.pass == LayoutPass::Measure ? ",\"cat\":\"Measure\"" : ",\"cat\":\"Arrange\"";
+        out += ",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":";
+        _AppendMicroseconds(out, event.startTime);
+        out += ",\"dur\":";
+        _AppendMicroseconds(out, event.duration);
+        out += ",\"args\":{\"object\":";
+        _AppendJsonAddress(out, record.object);
+        out += "}}";
+    }
+    out += "],\"displayTimeUnit\":\"ns\",\"otherData\":{\"droppedEvents\":";
+    _AppendNumber(out, profiler._droppedEventCount);
+    out += "}}";
+    return out;
+}
+
+sw::LayoutProfiler &sw::LayoutProfiler::_GetInstance() noexcept
+{
+    static thread_local LayoutProfiler instance;
+    return instance;
+}
+
+uint64_t sw::LayoutProfiler::_Now() const noexcept
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _epoch).count());
+}
+
+sw::LayoutProfileRecord &sw::LayoutProfiler::_GetRecord(const void *obj)
+{
+    auto it = _index.find(obj);
+    if (it != _index.end()) {
+        return _records[it->second];
+    }
+
+    _index.emplace(obj, _records.size());
+    _records.emplace_back();
+    _records.back().object = obj;
+    return _records.back();
+}
+
+bool sw::LayoutProfiler::_Begin(const void *obj, const std::type_info &type, LayoutPass pass)
+{
+    LayoutProfiler &profiler = _GetInstance();
+
+    LayoutProfileRecord &record = profiler._GetRecord(obj);
+    record.typeName             = type.name();
+
+    // 外层调用属于同一对象时（如Layer::Arrange调用UIElement::Arrange）保留原有的外层对象
+    if (!profiler._stack.empty()) {
+        const void *outer = profiler._records[profiler._stack.back().record].object;
+        if (outer != obj) record.parent = outer;
+    } else {
+        record.parent = nullptr;
+    }
+
+    if (pass == LayoutPass::Measure) {
+        ++record.measureCount;
+    } else {
+        ++record.arrangeCount;
+    }
+
+    size_t index = static_cast<size_t>(&record - profiler._records.data());
+    profiler._stack.push_back(_Frame{index, pass, profiler._Now(), 0});
+    return true;
+}
+
+void sw::LayoutProfiler::_End() noexcept
+{
+    LayoutProfiler &profiler = _GetInstance();
+
+    // 布局过程中调用了Reset
+    if (profiler._stack.empty()) {
+        return;
+    }
+
+    _Frame frame = profiler._stack.back();
+    profiler._stack.pop_back();
+
+    uint64_t duration  = profiler._Now() - frame.startTime;
+    uint64_t exclusive = duration > frame.childTime ? duration - frame.childTime : 0;
+
+    LayoutProfileRecord &record = profiler._records[frame.record];
+    if (frame.pass == LayoutPass::Measure) {
+        record.measureInclusiveTime += duration;
+        record.measureExclusiveTime += exclusive;
+    } else {
+        record.arrangeInclusiveTime += duration;
+        record.arrangeExclusiveTime += exclusive;
+    }
+
+    if (!profiler._stack.empty()) {
+        profiler._stack.back().childTime += duration;
+    }
+
+    if (profiler._traceEnabled) {
+        if (profiler._events.size() < MaxTraceEventCount) {
+            try {
+                profiler._events.push_back(_TraceEvent{frame.record, frame.pass, frame.startTime, duration});
+            } catch (...) {
+                ++profiler._droppedEventCount;
+            }
+        } else {
+            ++profiler._droppedEventCount;
+        }
+    }
+}
+
+void sw::LayoutProfiler::_WriteJsonNode(std::string &out, size_t index, const std::vector<std::vector<size_t>> &children) const
+{
+    const LayoutProfileRecord &record = _records[index];
+
+    out += "{\"type\":";
+    _AppendJsonString(out, record.typeName);
+    out += ",\"object\":";
+    _AppendJsonAddress(out, record.object);
+    out += ",\"measure\":{\"count\":";
+    _AppendNumber(out, record.measureCount);
+    out += ",\"skipped\":";
+    _AppendNumber(out, record.measureSkipCount);
+    out += ",\"inclusiveNs\":";
+    _AppendNumber(out, record.measureInclusiveTime);
+    out += ",\"exclusiveNs\":";
+    _AppendNumber(out, record.measureExclusiveTime);
+    out += "},\"arrange\":{\"count\":";
+    _AppendNumber(out, record.arrangeCount);
+    out += ",\"inclusiveNs\":";
+    _AppendNumber(out, record.arrangeInclusiveTime);
+    out += ",\"exclusiveNs\":";
+    _AppendNumber(out, record.arrangeExclusiveTime);
+    out += "},\"setWindowPos\":";
+    _AppendNumber(out, record.setWindowPosCount);
+    out += ",\"deferWindowPos\":";
+    _AppendNumber(out, record.deferWindowPosCount);
+    out += ",\"children\":[";
+    for (size_t i = 0; i < children[index].size(); ++i) {
+        if (i != 0) out += ',';
+        _WriteJsonNode(out, children[index][i], children);
+    }
+    out += "]}";
+}
+
+// ListBox.cpp
+
+sw::ListBox::ListBox()
+    : Items(
+          Property<ObservableCollection<std::wstring> *>::Init(this)
+              .Getter([](ListBox *self) -> ObservableCollection<std::wstring> * {
+                  return &self->_items;
+              })),
+
+      ItemHeight(
+          Property<double>::Init(this)
+              .Getter([](ListBox *self) -> double {
+                  return self->_itemHeight;
+              })
+              .Setter([](ListBox *self, double value) {
+                  if (self->_itemHeight != value) {
+                      self->_itemHeight = value;
+                      self->_UpdateItemHeight();
+                      self->RaisePropertyChanged(&ListBox::ItemHeight);
+                  }
+              })),
+
+      TopIndex(
+          Property<int>::Init(this)
+              .Getter([](ListBox *self) -> int {
+                  return (int)self->SendMessageW(LB_GETTOPINDEX, 0, 0);
+              })
+              .Setter([](ListBox *self, int value) {
+                  self->SendMessageW(LB_SETTOPINDEX, value, 0);
+              })),
+
+      SelectedItemBackColor(
+          Property<Color>::Init(this)
+              .Getter([](ListBox *self) -> Color {
+                  return self->_selectedItemBackColor;
+              })
+              .Setter([](ListBox *self, const Color &value) {
+                  if (self->_selectedItemBackColor != value) {
+                      self->_selectedItemBackColor = value;
+                      self->Redraw();
+                      self->RaisePropertyChanged(&ListBox::SelectedItemBackColor);
                   }
               })),
 
@@ -5689,15 +7285,21 @@ void sw::ListView::_ColumnsCollectionChangedHandler(
 {
     switch (args.action) {
         case NotifyCollectionChangedAction::Add:
-            _InsertColumn(args.index, _columns.GetAt(args.index));
+            for (int i = args.index; i < args.index + args.count; ++i) {
+                _InsertColumn(i, _columns.GetAt(i));
+            }
             break;
 
         case NotifyCollectionChangedAction::Remove:
-            _DeleteColumn(args.index);
+            for (int i = 0; i < args.count; ++i) {
+                _DeleteColumn(args.index);
+            }
             break;
 
         case NotifyCollectionChangedAction::Replace:
-            _SetColumn(args.index, _columns.GetAt(args.index));
+            for (int i = args.index; i < args.index + args.count; ++i) {
+                _SetColumn(i, _columns.GetAt(i));
+            }
             break;
 
         case NotifyCollectionChangedAction::Move:
@@ -6038,6 +7640,7 @@ sw::MenuItem *sw::MenuItem::CreateRoot(bool isPopup)
 {
     MenuItem *root = new MenuItem({});
     root->_isRoot  = true;
+    root->_index.reset(new _MenuItemIndex);
 
     if (!isPopup) {
         root->_hMenu = CreateMenu();
@@ -6058,7 +7661,14 @@ void sw::MenuItem::OnTagChanged()
         newTagValue = tagVariant.UnsafeCast<uint64_t>();
     }
     if (_desc.tag != newTagValue) {
+        _MenuItemIndex *index = _isRoot ? nullptr : _GetRootIndex();
+        if (index != nullptr) {
+            _RemoveTagFromIndex(index, this);
+        }
         _desc.tag = newTagValue;
+        if (index != nullptr && newTagValue != 0) {
+            index->tags.emplace(newTagValue, this);
+        }
         RaisePropertyChanged(&MenuItem::Tag);
     }
 }
@@ -6123,6 +7733,11 @@ bool sw::MenuItem::RemoveChildAt(int index)
         return false;
     }
 
+    _MenuItemIndex *rootIndex = _GetRootIndex();
+    if (rootIndex != nullptr) {
+        _RemoveFromIndex(rootIndex, _subItems[index].get());
+    }
+
     DeleteMenu(_hMenu, index, MF_BYPOSITION);
     _subItems.erase(_subItems.begin() + index);
 
@@ -6148,6 +7763,12 @@ void sw::MenuItem::ClearChildren()
             DeleteMenu(_hMenu, i, MF_BYPOSITION);
         }
     }
+    _MenuItemIndex *rootIndex = _GetRootIndex();
+    if (rootIndex != nullptr) {
+        for (auto &child : _subItems) {
+            _RemoveFromIndex(rootIndex, child.get());
+        }
+    }
     _subItems.clear();
     _ResetMenuItem();
 }
@@ -6169,6 +7790,12 @@ void sw::MenuItem::ResetChildren(std::initializer_list<MenuItemDesc> descs)
         return;
     }
 
+    _MenuItemIndex *rootIndex = _GetRootIndex();
+    if (rootIndex != nullptr) {
+        for (auto &child : _subItems) {
+            _RemoveFromIndex(rootIndex, child.get());
+        }
+    }
     _subItems.clear();
 
     for (auto &desc : descs) {
@@ -6200,6 +7827,17 @@ void sw::MenuItem::ResetChildren(std::initializer_list<MenuItemDesc> descs)
 
 sw::MenuItem *sw::MenuItem::FindChildById(int id)
 {
+    if (_id == id) {
+        return this;
+    }
+
+    _MenuItemIndex *index = _GetRootIndex();
+    if (index != nullptr) {
+        auto it = index->ids.find(id);
+        return it != index->ids.end() && _IsSelfOrAncestorOf(it->second) ? it->second : nullptr;
+    }
+
+    // 不在根菜单项下的菜单项没有索引，遍历查找
     std::vector<MenuItem *> stack;
     stack.push_back(this);
 
@@ -6219,6 +7857,29 @@ sw::MenuItem *sw::MenuItem::FindChildById(int id)
 
 sw::MenuItem *sw::MenuItem::FindChildByTag(uint64_t tag)
 {
+    if (_desc.tag == tag) {
+        return this;
+    }
+
+    _MenuItemIndex *index = _GetRootIndex();
+    if (index != nullptr && tag != 0) {
+        MenuItem *found = nullptr;
+        int count       = 0;
+
+        auto range = index->tags.equal_range(tag);
+        for (auto it = range.first; it != range.second && count < 2; ++it) {
+            if (_IsSelfOrAncestorOf(it->second)) {
+                found = it->second;
+                ++count;
+            }
+        }
+        if (count < 2) {
+            return found;
+        }
+    }
+
+    // 不在根菜单项下的菜单项没有索引，tag为0的菜单项也不加入索引，遍历查找；
+    // 子树中有多个菜单项的tag相同时索引中的顺序不确定，同样遍历查找，返回先序遍历中的第一个
     std::vector<MenuItem *> stack;
     stack.push_back(this);
 
@@ -6229,8 +7890,8 @@ sw::MenuItem *sw::MenuItem::FindChildByTag(uint64_t tag)
         if (current->_desc.tag == tag) {
             return current;
         }
-        for (auto &child : current->_subItems) {
-            stack.push_back(child.get());
+        for (auto it = current->_subItems.rbegin(); it != current->_subItems.rend(); ++it) {
+            stack.push_back(it->get());
         }
     }
     return nullptr;
@@ -6359,12 +8020,87 @@ void sw::MenuItem::_UpdateState()
 void sw::MenuItem::_SetParent(MenuItem *parent, MenuItem *child, int index)
 {
     child->_parent = parent;
+    child->InvalidateCurrentDataContext();
 
     if (index == -1) {
         parent->_subItems.emplace_back(child);
     } else {
         parent->_subItems.insert(parent->_subItems.begin() + index, std::unique_ptr<MenuItem>(child));
     }
+
+    _MenuItemIndex *rootIndex = parent->_GetRootIndex();
+    if (rootIndex != nullptr) {
+        _AddToIndex(rootIndex, child);
+    }
+}
+
+sw::MenuItem::_MenuItemIndex *sw::MenuItem::_GetRootIndex()
+{
+    MenuItem *item = this;
+    while (item->_parent != nullptr) {
+        item = item->_parent;
+    }
+    return item->_index.get();
+}
+
+bool sw::MenuItem::_IsSelfOrAncestorOf(MenuItem *item) const
+{
+    for (; item != nullptr; item = item->_parent) {
+        if (item == this) return true;
+    }
+    return false;
+}
+
+void sw::MenuItem::_AddToIndex(_MenuItemIndex *index, MenuItem *item)
+{
+    std::vector<MenuItem *> stack;
+    stack.push_back(item);
+
+    while (!stack.empty()) {
+        MenuItem *current = stack.back();
+        stack.pop_back();
+
+        index->ids[current->_id] = current;
+        if (current->_desc.tag != 0) {
+            index->tags.emplace(current->_desc.tag, current);
+        }
+        for (auto &child : current->_subItems) {
+            stack.push_back(child.get());
+        }
+    }
+}
+
+void sw::MenuItem::_RemoveFromIndex(_MenuItemIndex *index, MenuItem *item)
+{
+    std::vector<MenuItem *> stack;
+    stack.push_back(item);
+
+    while (!stack.empty()) {
+        MenuItem *current = stack.back();
+        stack.pop_back();
+
+        index->ids.erase(current->_id);
+        _RemoveTagFromIndex(index, current);
+
+        for (auto &child : current->_subItems) {
+            stack.push_back(child.get());
+        }
+    }
+}
+
+void sw::MenuItem::_RemoveTagFromIndex(_MenuItemIndex *index, MenuItem *item)
+{
+    if (item->_desc.tag == 0) {
+        return;
+    }
+
+    auto range = index->tags.equal_range(item->_desc.tag);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == item) {
+            index->tags.erase(it);
+            return;
+        }
+    }
 }
 
 int sw::MenuItem::_GenerateMenuItemID()
@@ -6984,7 +8720,7 @@ LRESULT sw::Panel::WndProc(ProcMsg &refMsg)
         }
 
         case WM_UpdateLayout: {
-            if (IsInHierarchy)
+            if (AcceptLayoutUpdate(refMsg.wParam != FALSE) && IsInHierarchy)
                 UpdateLayout();
             return 0;
         }
@@ -7012,11 +8748,10 @@ bool sw::Panel::OnPaint()
         ps.rcPaint.top < ps.rcPaint.bottom) //
     {
         auto color    = static_cast<COLORREF>(GetRealBackColor());
-        HBRUSH hBrush = CreateSolidBrush(color);
+        HBRUSH hBrush = BrushCache::GetBrush(color);
 
         if (hBrush != NULL) {
             FillRect(hdc, &ps.rcPaint, hBrush);
-            DeleteObject(hBrush);
         }
     }
 
@@ -7085,11 +8820,10 @@ bool sw::Panel::OnNcPaint(HRGN hRgn)
                 if (hdcMem != NULL && hBmpWnd != NULL) {
                     HBITMAP hBmpOld = (HBITMAP)SelectObject(hdcMem, hBmpWnd);
                     if (hBmpOld != NULL) {
-                        HBRUSH hBrush = CreateSolidBrush(static_cast<COLORREF>(GetRealBackColor()));
+                        HBRUSH hBrush = BrushCache::GetBrush(static_cast<COLORREF>(GetRealBackColor()));
                         if (hBrush != NULL) {
                             // 先在内存DC中完成整块非客户区绘制，再一次性提交，减少绘制步骤外露。
                             FillRect(hdcMem, &rtWindow, hBrush);
-                            DeleteObject(hBrush);
 
                             RECT rect = rtWindow;
                             OnDrawBorder(hdcMem, rect);
@@ -7179,7 +8913,7 @@ void sw::Panel::OnDrawPadding(HDC hdc, RECT &rect)
     rect = rtPaddingInner;
     if (hdc == NULL) return;
 
-    HBRUSH hBrush = CreateSolidBrush(static_cast<COLORREF>(GetRealBackColor()));
+    HBRUSH hBrush = BrushCache::GetBrush(static_cast<COLORREF>(GetRealBackColor()));
     if (hBrush == NULL) return;
 
     auto clamp = [](LONG value, LONG minValue, LONG maxValue) -> LONG {
@@ -7206,8 +8940,6 @@ void sw::Panel::OnDrawPadding(HDC hdc, RECT &rect)
     fillRect(rtPaddingOuter.left, rtPaintInner.bottom, rtPaddingOuter.right, rtPaddingOuter.bottom);
     fillRect(rtPaddingOuter.left, rtPaintInner.top, rtPaintInner.left, rtPaintInner.bottom);
     fillRect(rtPaintInner.right, rtPaintInner.top, rtPaddingOuter.right, rtPaintInner.bottom);
-
-    DeleteObject(hBrush);
 }
 
 // PasswordBox.cpp
@@ -8090,7 +9822,7 @@ bool sw::Splitter::OnPaint()
     RECT rect;
     GetClientRect(hwnd, &rect);
 
-    HBRUSH hBrush = CreateSolidBrush(static_cast<COLORREF>(GetRealBackColor()));
+    HBRUSH hBrush = BrushCache::GetBrush(static_cast<COLORREF>(GetRealBackColor()));
     FillRect(hdc, &rect, hBrush);
 
     if (_drawSplitterLine) {
@@ -8105,7 +9837,6 @@ bool sw::Splitter::OnPaint()
         }
     }
 
-    DeleteObject(hBrush);
     EndPaint(hwnd, &ps);
     return true;
 }
@@ -8937,6 +10668,32 @@ sw::TextBoxBase::TextBoxBase()
                       self->_acceptTab = value;
                       self->RaisePropertyChanged(&TextBoxBase::AcceptTab);
                   }
+              })),
+
+      MaxLineCount(
+          Property<int>::Init(this)
+              .Getter([](TextBoxBase *self) -> int {
+                  return self->_maxLineCount;
+              })
+              .Setter([](TextBoxBase *self, int value) {
+                  value = (std::max)(value, 0);
+                  if (self->_maxLineCount != value) {
+                      self->_maxLineCount = value;
+                      self->RaisePropertyChanged(&TextBoxBase::MaxLineCount);
+                  }
+              })),
+
+      MaxTextLength(
+          Property<int>::Init(this)
+              .Getter([](TextBoxBase *self) -> int {
+                  return self->_maxTextLength;
+              })
+              .Setter([](TextBoxBase *self, int value) {
+                  value = (std::max)(value, 0);
+                  if (self->_maxTextLength != value) {
+                      self->_maxTextLength = value;
+                      self->RaisePropertyChanged(&TextBoxBase::MaxTextLength);
+                  }
               }))
 {
     this->TabStop = true;
@@ -8953,6 +10710,8 @@ void sw::TextBoxBase::InitTextBoxBase(DWORD dwStyle, DWORD dwExStyle)
 
 std::wstring &sw::TextBoxBase::GetInternalText()
 {
+    this->FlushAppendText();
+
     if (this->_isTextChanged) {
         this->UpdateInternalText();
         this->_isTextChanged = false;
@@ -8960,10 +10719,20 @@ std::wstring &sw::TextBoxBase::GetInternalText()
     return this->WndBase::GetInternalText();
 }
 
+void sw::TextBoxBase::SetInternalText(const std::wstring &value)
+{
+    this->_pendingAppendText.clear();
+    this->Control::SetInternalText(value);
+}
+
 void sw::TextBoxBase::OnCommand(int code)
 {
     switch (code) {
         case EN_CHANGE: {
+            // 追加文本时储存的文本由FlushAppendText更新，写入完成后统一调用OnTextChanged
+            if (this->_isAppending) {
+                break;
+            }
             this->_isTextChanged = true;
             this->OnTextChanged();
             break;
@@ -9001,6 +10770,13 @@ bool sw::TextBoxBase::OnKeyDown(VirtualKey key, const KeyFlags &flags)
     return e.handledMsg;
 }
 
+void sw::TextBoxBase::OnHandleChanged(HWND hwnd)
+{
+    // 重新创建句柄前读取文本时已写入追加的文本，投递到旧句柄的消息不会再被处理
+    this->_isAppendPosted = false;
+    this->Control::OnHandleChanged(hwnd);
+}
+
 void sw::TextBoxBase::Select(int start, int length)
 {
     this->SendMessageW(EM_SETSEL, start, start + length);
@@ -9026,20 +10802,113 @@ void sw::TextBoxBase::Clear()
     this->Text = std::wstring{};
 }
 
-sw::HorizontalAlignment sw::TextBoxBase::_GetHorzContentAlignment()
+void sw::TextBoxBase::AppendText(const std::wstring &text)
 {
-    LONG_PTR style = this->GetStyle();
+    if (text.empty()) {
+        return;
+    }
 
-    if (style & ES_CENTER) {
-        return sw::HorizontalAlignment::Center;
-    } else if (style & ES_RIGHT) {
-        return sw::HorizontalAlignment::Right;
-    } else {
-        return sw::HorizontalAlignment::Left;
+    this->_pendingAppendText += text;
+
+    if (!this->_isAppendPosted) {
+        this->_isAppendPosted = this->InvokeAsync([this]() {
+            this->_isAppendPosted = false;
+            this->FlushAppendText();
+        });
+        if (!this->_isAppendPosted) {
+            this->FlushAppendText();
+        }
     }
 }
 
-void sw::TextBoxBase::_SetHorzContentAlignment(sw::HorizontalAlignment value)
+void sw::TextBoxBase::AppendLines(const std::vector<std::wstring> &lines)
+{
+    size_t length = 0;
+    for (const std::wstring &line : lines) {
+        length += line.size() + 2;
+    }
+
+    std::wstring text;
+    text.reserve(length);
+    for (const std::wstring &line : lines) {
+        text += line;
+        text += L"\r\n";
+    }
+    this->AppendText(text);
+}
+
+void sw::TextBoxBase::FlushAppendText()
+{
+    if (this->_pendingAppendText.empty()) {
+        return;
+    }
+
+    std::wstring text;
+    text.swap(this->_pendingAppendText);
+
+    HWND hwnd  = this->Handle;
+    int length = GetWindowTextLengthW(hwnd);
+
+    DWORD selStart = 0, selEnd = 0;
+    this->SendMessageW(EM_GETSEL, reinterpret_cast<WPARAM>(&selStart), reinterpret_cast<LPARAM>(&selEnd));
+    bool caretAtEnd  = selStart == selEnd && selEnd == static_cast<DWORD>(length);
+    int firstVisible = static_cast<int>(this->SendMessageW(EM_GETFIRSTVISIBLELINE, 0, 0));
+
+    // EM_REPLACESEL受EM_SETLIMITTEXT的限制，与设置Text属性一样不应截断追加的文本
+    size_t newLength = static_cast<size_t>(length) + text.size();
+    if (newLength > static_cast<size_t>(this->SendMessageW(EM_GETLIMITTEXT, 0, 0))) {
+        this->SendMessageW(EM_SETLIMITTEXT, static_cast<WPARAM>(newLength), 0);
+    }
+
+    this->_isAppending = true;
+    this->SendMessageW(EM_SETSEL, length, length);
+    this->SendMessageW(EM_REPLACESEL, FALSE, reinterpret_cast<LPARAM>(text.c_str()));
+
+    int trimmedLines = 0;
+    int trimLength   = this->_GetAppendTrimLength(text.back() == L'\n');
+    if (trimLength > 0) {
+        trimmedLines = static_cast<int>(this->SendMessageW(EM_LINEFROMCHAR, trimLength, 0));
+        this->SendMessageW(EM_SETSEL, 0, trimLength);
+        this->SendMessageW(EM_REPLACESEL, FALSE, reinterpret_cast<LPARAM>(L""));
+    }
+    this->_isAppending = false;
+
+    // 插入符号原本在末尾时跟随新文本滚动，否则恢复原来的选区和滚动位置
+    if (caretAtEnd) {
+        int end = GetWindowTextLengthW(hwnd);
+        this->SendMessageW(EM_SETSEL, end, end);
+        this->SendMessageW(EM_SCROLLCARET, 0, 0);
+    } else {
+        int start = (std::max)(static_cast<int>(selStart) - trimLength, 0);
+        int end   = (std::max)(static_cast<int>(selEnd) - trimLength, 0);
+        this->SendMessageW(EM_SETSEL, start, end);
+        int target = (std::max)(firstVisible - trimmedLines, 0);
+        this->SendMessageW(EM_LINESCROLL, 0, target - static_cast<int>(this->SendMessageW(EM_GETFIRSTVISIBLELINE, 0, 0)));
+    }
+
+    // 储存的文本未失效时直接在其末尾追加，之后读取Text属性不需要重新获取整个文本
+    if (!this->_isTextChanged) {
+        std::wstring &cache = this->WndBase::GetInternalText();
+        cache += text;
+        cache.erase(0, static_cast<size_t>(trimLength));
+    }
+    this->OnTextChanged();
+}
+
+sw::HorizontalAlignment sw::TextBoxBase::_GetHorzContentAlignment()
+{
+    LONG_PTR style = this->GetStyle();
+
+    if (style & ES_CENTER) {
+        return sw::HorizontalAlignment::Center;
+    } else if (style & ES_RIGHT) {
+        return sw::HorizontalAlignment::Right;
+    } else {
+        return sw::HorizontalAlignment::Left;
+    }
+}
+
+void sw::TextBoxBase::_SetHorzContentAlignment(sw::HorizontalAlignment value)
 {
     if (this->_GetHorzContentAlignment() == value) {
         return;
@@ -9072,6 +10941,36 @@ void sw::TextBoxBase::_SetHorzContentAlignment(sw::HorizontalAlignment value)
     this->RaisePropertyChanged(&TextBoxBase::HorizontalContentAlignment);
 }
 
+int sw::TextBoxBase::_GetAppendTrimLength(bool endsWithNewLine)
+{
+    int result = 0;
+
+    if (this->_maxTextLength > 0) {
+        int length = GetWindowTextLengthW(this->Handle);
+        if (length > this->_maxTextLength) {
+            // 删除到超出部分所在行的下一行开头，避免在开头留下不完整的行
+            int excess    = length - this->_maxTextLength;
+            int line      = static_cast<int>(this->SendMessageW(EM_LINEFROMCHAR, excess, 0));
+            int lineStart = static_cast<int>(this->SendMessageW(EM_LINEINDEX, line, 0));
+            int nextStart = lineStart < excess ? static_cast<int>(this->SendMessageW(EM_LINEINDEX, line + 1, 0)) : -1;
+            result        = nextStart > 0 ? nextStart : excess;
+        }
+    }
+
+    if (this->_maxLineCount > 0) {
+        int lineCount = static_cast<int>(this->SendMessageW(EM_GETLINECOUNT, 0, 0));
+        if (endsWithNewLine) {
+            --lineCount;
+        }
+        if (lineCount > this->_maxLineCount) {
+            int start = static_cast<int>(this->SendMessageW(EM_LINEINDEX, lineCount - this->_maxLineCount, 0));
+            result    = (std::max)(result, start);
+        }
+    }
+
+    return result;
+}
+
 // Thickness.cpp
 
 sw::Thickness::Thickness(double thickness) noexcept
@@ -9782,6 +11681,11 @@ namespace
     const sw::FieldId _PropId_LogicalRect         = sw::Reflection::GetFieldId(&sw::UIElement::LogicalRect);
     const sw::FieldId _PropId_IsHitTestVisible    = sw::Reflection::GetFieldId(&sw::UIElement::IsHitTestVisible);
     const sw::FieldId _PropId_IsFocusedViaTab     = sw::Reflection::GetFieldId(&sw::UIElement::IsFocusedViaTab);
+
+    /**
+     * @brief 当前线程的布局更新统计数据
+     */
+    thread_local sw::LayoutUpdateStatistics _layoutUpdateStatistics;
 }
 
 sw::UIElement::UIElement()
@@ -10049,35 +11953,42 @@ sw::UIElement::~UIElement()
     // 将自己从父窗口的children中移除
     this->SetParent(nullptr);
 
-    // 释放资源
-    if (this->_hCtlColorBrush != NULL) {
-        DeleteObject(this->_hCtlColorBrush);
-    }
+    // 释放WM_CTLCOLORxxx使用的画刷
+    BrushCache::Release(this->_hCtlColorBrush);
 }
 
 void sw::UIElement::RegisterRoutedEvent(RoutedEventType eventType, const RoutedEventHandler &handler)
 {
-    this->_eventMap[eventType] = handler;
+    if (handler) {
+        this->_eventTable.GetOrAdd(eventType) = handler;
+    } else {
+        this->UnregisterRoutedEvent(eventType);
+    }
 }
 
 void sw::UIElement::AddHandler(RoutedEventType eventType, const RoutedEventHandler &handler)
 {
-    if (handler) this->_eventMap[eventType] += handler;
+    if (handler) this->_eventTable.GetOrAdd(eventType) += handler;
 }
 
 bool sw::UIElement::RemoveHandler(RoutedEventType eventType, const RoutedEventHandler &handler)
 {
-    return handler == nullptr ? false : this->_eventMap[eventType].Remove(handler);
+    if (handler == nullptr) return false;
+    auto eventHandler = this->_eventTable.Find(eventType);
+    return eventHandler != nullptr && eventHandler->Remove(handler);
 }
 
 void sw::UIElement::UnregisterRoutedEvent(RoutedEventType eventType)
 {
-    this->_eventMap[eventType] = nullptr;
+    if (auto eventHandler = this->_eventTable.Find(eventType)) {
+        *eventHandler = nullptr;
+    }
 }
 
 bool sw::UIElement::IsRoutedEventRegistered(RoutedEventType eventType)
 {
-    return this->_eventMap[eventType] != nullptr;
+    auto eventHandler = this->_eventTable.Find(eventType);
+    return eventHandler != nullptr && *eventHandler != nullptr;
 }
 
 bool sw::UIElement::AddChild(UIElement *element)
@@ -10424,7 +12335,45 @@ void sw::UIElement::InvalidateMeasure()
         element = element->_parent;
     } while (element != nullptr);
 
-    root->SendMessageW(WM_UpdateLayout, 0, 0);
+    ++_layoutUpdateStatistics.invalidationCount;
+
+    if (root->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::LayoutPending)) {
+        // 已有挂起的布局更新，合并到该次更新中
+        ++root->_pendingInvalidationCount;
+        ++_layoutUpdateStatistics.mergedInvalidationCount;
+        return;
+    }
+
+    root->_layoutUpdateCondition |= sw::LayoutUpdateCondition::LayoutPending;
+    root->_pendingInvalidationCount = 1;
+
+    // 投递的消息会在WM_PAINT之前被处理，wParam为TRUE表示延迟的布局更新
+    if (!root->PostMessageW(WM_UpdateLayout, TRUE, 0)) {
+        root->SendMessageW(WM_UpdateLayout, FALSE, 0);
+    }
+}
+
+void sw::UIElement::UpdateLayoutNow()
+{
+    UIElement *root = this;
+    while (root->_parent != nullptr) {
+        root = root->_parent;
+    }
+
+    if (root->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::LayoutPending) ||
+        root->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::MeasureInvalidated)) {
+        root->SendMessageW(WM_UpdateLayout, FALSE, 0);
+    }
+}
+
+sw::LayoutUpdateStatistics sw::UIElement::GetLayoutUpdateStatistics()
+{
+    return _layoutUpdateStatistics;
+}
+
+void sw::UIElement::ResetLayoutUpdateStatistics()
+{
+    _layoutUpdateStatistics = sw::LayoutUpdateStatistics{};
 }
 
 bool sw::UIElement::BringIntoView()
@@ -10493,9 +12442,14 @@ void sw::UIElement::Measure(const Size &availableSize)
 {
     if (!this->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::MeasureInvalidated) &&
         this->_lastMeasureAvailableSize == availableSize) {
+#if !defined(SW_DISABLE_LAYOUT_PROFILER)
+        LayoutProfiler::RecordMeasureSkipped(this);
+#endif
         return; // 若布局未失效且可用尺寸没有变化，则无需重新测量
     }
 
+    LayoutProfiler::Scope profilerScope(this, LayoutPass::Measure);
+
     Size measureSize = availableSize;
 
     Thickness &margin   = this->_margin;
@@ -10540,10 +12494,13 @@ void sw::UIElement::Measure(const Size &availableSize)
 
 void sw::UIElement::Arrange(const sw::Rect &finalPosition)
 {
+    LayoutProfiler::Scope profilerScope(this, LayoutPass::Arrange);
+
     // 为什么在Arrange阶段清除MeasureInvalidated标记：
     // 一些复杂的布局可能会在测量阶段多次调用Measure函数，
     // 比如Grid会调用两次Measure，若在测量阶段清除该标记，
     // 则在第二次调用时会认为布局没有失效，导致测量被跳过。
+    bool measureInvalidated = this->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::MeasureInvalidated);
     this->_layoutUpdateCondition &= ~sw::LayoutUpdateCondition::MeasureInvalidated;
     this->_layoutUpdateCondition |= sw::LayoutUpdateCondition::Supressed;
 
@@ -10607,19 +12564,40 @@ void sw::UIElement::Arrange(const sw::Rect &finalPosition)
     bool hasChildren = !this->_children.empty();
     HDWP hdwpCurrent = this->_parent ? this->_parent->_hdwpChildren : NULL;
 
-    if (!hasChildren && hdwpCurrent != NULL) {
+    RECT pxRect{
+        Dip::DipToPxX(rect.left), Dip::DipToPxY(rect.top),
+        Dip::DipToPxX(rect.width), Dip::DipToPxY(rect.height)};
+
+    // 与上次Arrange的结果相同且窗口没有被移动或调整大小时，无需再次调整窗口位置，
+    // 避免产生WM_WINDOWPOSCHANGING/WM_WINDOWPOSCHANGED以及OnMove、OnSize等一系列回调
+    bool rectChanged = !this->_IsArrangedAt(pxRect);
+
+    if (!rectChanged) {
+        ++_layoutUpdateStatistics.skippedWindowPosCount;
+    } else if (!hasChildren && hdwpCurrent != NULL) {
         DeferWindowPos(hdwpCurrent, this->Handle, NULL,
-                       Dip::DipToPxX(rect.left), Dip::DipToPxY(rect.top),
-                       Dip::DipToPxX(rect.width), Dip::DipToPxY(rect.height),
+                       pxRect.left, pxRect.top, pxRect.right, pxRect.bottom,
                        SWP_NOACTIVATE | SWP_NOZORDER);
+#if !defined(SW_DISABLE_LAYOUT_PROFILER)
+        LayoutProfiler::RecordDeferWindowPos(this);
+#endif
     } else {
         SetWindowPos(this->Handle, NULL,
-                     Dip::DipToPxX(rect.left), Dip::DipToPxY(rect.top),
-                     Dip::DipToPxX(rect.width), Dip::DipToPxY(rect.height),
+                     pxRect.left, pxRect.top, pxRect.right, pxRect.bottom,
                      SWP_NOACTIVATE | SWP_NOZORDER);
+#if !defined(SW_DISABLE_LAYOUT_PROFILER)
+        LayoutProfiler::RecordSetWindowPos(this);
+#endif
     }
 
-    if (hasChildren) {
+    this->_lastArrangedRect = pxRect;
+    this->_hasArrangedRect  = true;
+
+    // 位置和尺寸未变且测量未失效时，子元素的排列结果也不会改变：
+    // 子元素及其布局相关属性的变化都会通过InvalidateMeasure使当前元素的测量失效
+    if (hasChildren && !rectChanged && !measureInvalidated) {
+        ++_layoutUpdateStatistics.skippedArrangeOverrideCount;
+    } else if (hasChildren) {
         if (this->_children.size() >= 3) {
             this->_hdwpChildren = BeginDeferWindowPos((int)this->_children.size());
         }
@@ -10649,10 +12627,12 @@ void sw::UIElement::RaiseRoutedEvent(RoutedEventArgs &eventArgs)
         eventArgs.source = this;
     }
 
+    static const RoutedEventHandler emptyHandler{};
+
     UIElement *element = this;
     do {
-        auto &handler = element->_eventMap[eventArgs.eventType];
-        element->OnRoutedEvent(eventArgs, handler);
+        auto handler = element->_eventTable.Find(eventArgs.eventType);
+        element->OnRoutedEvent(eventArgs, handler ? *handler : emptyHandler);
 
         if (eventArgs.handled) {
             break;
@@ -10762,19 +12742,19 @@ bool sw::UIElement::QueryAllChildren(const Predicate<UIElement *> &queryFunc)
         return true;
     }
 
-    std::vector<UIElement *> stack;
-    stack.push_back(this);
+    ScratchBuffer<UIElement *> stack;
+    stack->push_back(this);
 
-    while (!stack.empty()) {
-        auto current = stack.back();
-        stack.pop_back();
+    while (!stack->empty()) {
+        auto current = stack->back();
+        stack->pop_back();
 
         if (current != this && !queryFunc(current)) {
             return false;
         }
 
         for (UIElement *child : current->_children) {
-            stack.push_back(child);
+            stack->push_back(child);
         }
     }
     return true;
@@ -10803,6 +12783,25 @@ void sw::UIElement::ArrangeOverride(const Size &finalSize)
 {
 }
 
+bool sw::UIElement::AcceptLayoutUpdate(bool deferred)
+{
+    bool pending = this->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::LayoutPending);
+
+    if (deferred && !pending) {
+        return false; // 已被UpdateLayoutNow提前处理
+    }
+
+    uint32_t count = this->_pendingInvalidationCount;
+
+    this->_layoutUpdateCondition &= ~sw::LayoutUpdateCondition::LayoutPending;
+    this->_pendingInvalidationCount = 0;
+
+    ++_layoutUpdateStatistics.layoutPassCount;
+    _layoutUpdateStatistics.lastPassInvalidationCount = count;
+    _layoutUpdateStatistics.maxPassInvalidationCount  = (std::max)(_layoutUpdateStatistics.maxPassInvalidationCount, count);
+    return true;
+}
+
 void sw::UIElement::OnSetBackColor(Color color, bool redraw)
 {
     this->_backColor = color;
@@ -10946,8 +12945,16 @@ void sw::UIElement::ParentChanged(WndBase *newParent)
 {
     auto oldDataContext = this->CurrentDataContext.Get();
 
-    this->_parent = newParent ? newParent->ToUIElement() : nullptr;
+    this->_parent          = newParent ? newParent->ToUIElement() : nullptr;
+    this->_hasArrangedRect = false;
     this->_SetMeasureInvalidated();
+    this->InvalidateCurrentDataContext();
+
+    // 不再是根元素时，挂起的布局更新由新的根元素负责
+    if (this->_parent != nullptr) {
+        this->_layoutUpdateCondition &= ~sw::LayoutUpdateCondition::LayoutPending;
+        this->_pendingInvalidationCount = 0;
+    }
     this->WndBase::ParentChanged(newParent);
 
     if (this->CurrentDataContext != oldDataContext) {
@@ -11175,18 +13182,14 @@ bool sw::UIElement::OnColor(HDC hdc, HBRUSH &hRetBrush)
     ::SetTextColor(hdc, textColor);
     ::SetBkColor(hdc, backColor);
 
-    if (this->_lastTextColor != textColor ||
-        this->_lastBackColor != backColor) {
-        if (this->_hCtlColorBrush != NULL)
-            DeleteObject(this->_hCtlColorBrush);
-        this->_hCtlColorBrush = NULL;
-        this->_lastTextColor  = textColor;
-        this->_lastBackColor  = backColor;
+    // 返回的画刷在控件绘制期间仍会被使用，持有其引用使其不会被缓存销毁
+    if (this->_hCtlColorBrush == NULL || this->_ctlColorBrushColor != backColor) {
+        HBRUSH hBrush = BrushCache::Acquire(backColor);
+        BrushCache::Release(this->_hCtlColorBrush);
+        this->_hCtlColorBrush     = hBrush;
+        this->_ctlColorBrushColor = backColor;
     }
 
-    if (this->_hCtlColorBrush == NULL)
-        this->_hCtlColorBrush = CreateSolidBrush(backColor);
-
     hRetBrush = this->_hCtlColorBrush;
     return true;
 }
@@ -11246,6 +13249,20 @@ void sw::UIElement::_SetMeasureInvalidated()
     this->_layoutUpdateCondition |= sw::LayoutUpdateCondition::MeasureInvalidated;
 }
 
+bool sw::UIElement::_IsArrangedAt(const RECT &pxRect)
+{
+    if (!this->_hasArrangedRect ||
+        this->_lastArrangedRect.left != pxRect.left || this->_lastArrangedRect.top != pxRect.top ||
+        this->_lastArrangedRect.right != pxRect.right || this->_lastArrangedRect.bottom != pxRect.bottom) {
+        return false;
+    }
+
+    // 窗口可能在两次Arrange之间被其他方式移动或调整大小，此时仍需重新设置位置
+    sw::Rect windowRect = this->Rect;
+    return Dip::DipToPxX(windowRect.left) == pxRect.left && Dip::DipToPxY(windowRect.top) == pxRect.top &&
+           Dip::DipToPxX(windowRect.width) == pxRect.right && Dip::DipToPxY(windowRect.height) == pxRect.bottom;
+}
+
 void sw::UIElement::_UpdateLayoutVisibleChildren()
 {
     this->_layoutVisibleChildren.clear();
@@ -11404,168 +13421,616 @@ sw::Size sw::UniformGridLayout::MeasureOverride(const Size &availableSize)
         itemMaxDesireHeight = Utils::Max(itemDesireSize.height, itemMaxDesireHeight);
     }
 
-    return Size{
-        std::isinf(availableSize.width) ? (itemMaxDesireWidth * colCount) : (availableSize.width),
-        std::isinf(availableSize.height) ? (itemMaxDesireHeight * rowCount) : (availableSize.height)};
+    return Size{
+        std::isinf(availableSize.width) ? (itemMaxDesireWidth * colCount) : (availableSize.width),
+        std::isinf(availableSize.height) ? (itemMaxDesireHeight * rowCount) : (availableSize.height)};
+}
+
+void sw::UniformGridLayout::ArrangeOverride(const Size &finalSize)
+{
+    int rowCount = Utils::Max(1, this->rows);
+    int colCount = Utils::Max(1, this->columns);
+    int beginCol = Utils::Max(0, Utils::Min(colCount - 1, this->firstColumn));
+
+    double arrangeWidth  = finalSize.width / colCount;
+    double arrangeHeight = finalSize.height / rowCount;
+
+    int childCount = this->GetChildLayoutCount();
+
+    for (int i = 0; i < childCount; ++i) {
+        int arrangeRow = (i + beginCol) / colCount;
+        int arrangeCol = (i + beginCol) % colCount;
+
+        if (arrangeRow >= rowCount) {
+            arrangeRow = rowCount - 1;
+            arrangeCol = colCount - 1;
+        }
+
+        ILayout &item = this->GetChildLayoutAt(i);
+        item.Arrange(Rect{arrangeCol * arrangeWidth, arrangeRow * arrangeHeight, arrangeWidth, arrangeHeight});
+    }
+}
+
+// Utils.cpp
+
+namespace
+{
+    /**
+     * @brief 指示是否使用UTF-8编码进行字符串转换
+     */
+    bool _usesUtf8 = true;
+
+    /**
+     * @brief 用于裁剪字符串的空白字符集合
+     */
+    constexpr wchar_t _WhitespaceChars[] = L" \t\n\r\f\v";
+}
+
+void sw::Utils::UseUtf8Encoding(bool useUtf8)
+{
+    _usesUtf8 = useUtf8;
+}
+
+std::wstring sw::Utils::ToWideStr(const std::string &str)
+{
+    return ToWideStr(str, _usesUtf8);
+}
+
+std::string sw::Utils::ToMultiByteStr(const std::wstring &wstr)
+{
+    return ToMultiByteStr(wstr, _usesUtf8);
+}
+
+std::wstring sw::Utils::ToWideStr(const std::string &str, bool utf8)
+{
+    int code = utf8 ? CP_UTF8 : CP_ACP;
+    int size = MultiByteToWideChar(code, 0, str.c_str(), -1, nullptr, 0);
+    std::wstring wstr(size, L'\0');
+    MultiByteToWideChar(code, 0, str.c_str(), -1, &wstr[0], size);
+    wstr.resize(wcslen(wstr.data()));
+    return wstr;
+}
+
+std::string sw::Utils::ToMultiByteStr(const std::wstring &wstr, bool utf8)
+{
+    int code = utf8 ? CP_UTF8 : CP_ACP;
+    int size = WideCharToMultiByte(code, 0, wstr.c_str(), -1, nullptr, 0, nullptr, nullptr);
+    std::string str(size, '\0');
+    WideCharToMultiByte(code, 0, wstr.c_str(), -1, &str[0], size, nullptr, nullptr);
+    str.resize(strlen(str.data()));
+    return str;
+}
+
+std::wstring sw::Utils::Trim(const std::wstring &str)
+{
+    size_t firstNonSpace = str.find_first_not_of(_WhitespaceChars);
+
+    if (firstNonSpace == std::wstring::npos) {
+        return std::wstring{};
+    } else {
+        size_t lastNonSpace = str.find_last_not_of(_WhitespaceChars);
+        return str.substr(firstNonSpace, lastNonSpace - firstNonSpace + 1);
+    }
+}
+
+std::wstring sw::Utils::TrimStart(const std::wstring &str)
+{
+    size_t firstNonSpace = str.find_first_not_of(_WhitespaceChars);
+
+    if (firstNonSpace == std::wstring::npos) {
+        return std::wstring{};
+    } else {
+        return str.substr(firstNonSpace);
+    }
+}
+
+std::wstring sw::Utils::TrimEnd(const std::wstring &str)
+{
+    size_t lastNonSpace = str.find_last_not_of(_WhitespaceChars);
+
+    if (lastNonSpace == std::wstring::npos) {
+        return std::wstring{};
+    } else {
+        return str.substr(0, lastNonSpace + 1);
+    }
+}
+
+std::vector<std::wstring> sw::Utils::Split(const std::wstring &str, const std::wstring &delimiter)
+{
+    std::vector<std::wstring> result;
+
+    if (delimiter.empty()) {
+        result.push_back(str);
+        return result;
+    }
+
+    size_t start = 0;
+    size_t end   = str.find(delimiter);
+
+    const size_t delimiterLength = delimiter.length();
+
+    while (end != std::wstring::npos) {
+        result.emplace_back(str, start, end - start);
+        start = end + delimiterLength;
+        end   = str.find(delimiter, start);
+    }
+
+    result.emplace_back(str, start);
+    return result;
+}
+
+std::wstring sw::Utils::FormatStr(const wchar_t *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+
+    int len = vswprintf(nullptr, 0, fmt, argsCopy);
+    va_end(argsCopy);
+
+    if (len <= 0) {
+        va_end(args);
+        return std::wstring{};
+    }
+
+    std::wstring result;
+    result.resize(len + 1);
+
+    vswprintf(&result[0], result.size(), fmt, args);
+    va_end(args);
+
+    result.resize(len);
+    return result;
+}
+
+// VirtualizingStackLayout.cpp
+
+namespace
+{
+    /**
+     * @brief 获取尺寸在堆叠方向上的分量
+     */
+    double _GetAlong(const sw::Size &size, bool vertical)
+    {
+        return vertical ? size.height : size.width;
+    }
+
+    /**
+     * @brief 获取尺寸在另一方向上的分量
+     */
+    double _GetCross(const sw::Size &size, bool vertical)
+    {
+        return vertical ? size.width : size.height;
+    }
+
+    /**
+     * @brief 由堆叠方向与另一方向上的分量构造尺寸
+     */
+    sw::Size _MakeSize(double along, double cross, bool vertical)
+    {
+        return vertical ? sw::Size{cross, along} : sw::Size{along, cross};
+    }
+}
+
+sw::Size sw::VirtualizingStackLayout::MeasureOverride(const Size &availableSize)
+{
+    bool vertical = this->orientation == Orientation::Vertical;
+
+    this->_SyncItemCount();
+
+    double start  = Utils::Max(0.0, vertical ? this->_viewport.top : this->_viewport.left);
+    double length = vertical ? this->_viewport.height : this->_viewport.width;
+
+    if (length <= 0) {
+        // 尚未获得可视区域时按可用尺寸实现化，可用尺寸为无穷大时实现化全部子项
+        length = _GetAlong(availableSize, vertical);
+    }
+
+    double crossAvailable = _GetCross(availableSize, vertical);
+    this->_UpdateRealizedItems(start, length, std::isinf(crossAvailable) ? INFINITY : crossAvailable, true);
+
+    return this->GetContentExtent();
+}
+
+void sw::VirtualizingStackLayout::ArrangeOverride(const Size &finalSize)
+{
+    bool vertical = this->orientation == Orientation::Vertical;
+
+    this->_SyncItemCount();
+
+    // 最终尺寸可能大于测量时的可视区域，此时需要补充实现化新露出的子项
+    double start = Utils::Max(0.0, vertical ? this->_viewport.top : this->_viewport.left);
+    this->_UpdateRealizedItems(start, _GetAlong(finalSize, vertical), _GetCross(finalSize, vertical), false);
+
+    double crossSize = _GetCross(finalSize, vertical);
+    double position  = this->_firstRealizedOffset;
+    int realizedCount = static_cast<int>(this->_realizedItems.size());
+
+    for (int i = 0; i < realizedCount; ++i) {
+        double extent = this->_GetItemExtent(this->_firstRealized + i);
+        this->_realizedItems[i]->Arrange(vertical ? Rect{0, position, crossSize, extent} : Rect{position, 0, extent, crossSize});
+        position += extent;
+    }
+}
+
+void sw::VirtualizingStackLayout::UpdateViewport(const Rect &viewport)
+{
+    this->_viewport = viewport;
+}
+
+sw::Size sw::VirtualizingStackLayout::GetContentExtent()
+{
+    int unmeasuredCount = static_cast<int>(this->_itemExtents.size()) - this->_measuredCount;
+    double along        = this->_measuredExtentSum + unmeasuredCount * this->estimatedItemExtent;
+    return _MakeSize(along, this->_maxCrossExtent, this->orientation == Orientation::Vertical);
+}
+
+void sw::VirtualizingStackLayout::ResetItems()
+{
+    this->_RecycleAll();
+    this->_itemExtents.assign(this->_itemExtents.size(), -1);
+    this->_measuredExtentSum   = 0;
+    this->_measuredCount       = 0;
+    this->_maxCrossExtent      = 0;
+    this->_firstRealized       = 0;
+    this->_firstRealizedOffset = 0;
+}
+
+int sw::VirtualizingStackLayout::GetFirstRealizedIndex() const
+{
+    return this->_firstRealized;
+}
+
+int sw::VirtualizingStackLayout::GetRealizedCount() const
+{
+    return static_cast<int>(this->_realizedItems.size());
+}
+
+void sw::VirtualizingStackLayout::_SyncItemCount()
+{
+    int count    = this->generator == nullptr ? 0 : this->generator->GetItemCount();
+    int oldCount = static_cast<int>(this->_itemExtents.size());
+
+    if (count >= oldCount) {
+        this->_itemExtents.resize(count, -1);
+        return;
+    }
+
+    // 回收索引超出范围的子项
+    int realizedCount = static_cast<int>(this->_realizedItems.size());
+    int keepCount     = Utils::Max(0, Utils::Min(realizedCount, count - this->_firstRealized));
+
+    for (int i = keepCount; i < realizedCount && this->generator != nullptr; ++i) {
+        this->generator->RecycleItem(this->_firstRealized + i, *this->_realizedItems[i]);
+    }
+    this->_realizedItems.resize(keepCount);
+
+    for (int i = count; i < oldCount; ++i) {
+        if (this->_itemExtents[i] >= 0) {
+            this->_measuredExtentSum -= this->_itemExtents[i];
+            --this->_measuredCount;
+        }
+    }
+    this->_itemExtents.resize(count);
+
+    if (this->_realizedItems.empty()) {
+        this->_firstRealized       = 0;
+        this->_firstRealizedOffset = 0;
+    }
+}
+
+double sw::VirtualizingStackLayout::_GetItemExtent(int index) const
+{
+    double extent = this->_itemExtents[index];
+    return extent < 0 ? this->estimatedItemExtent : extent;
+}
+
+void sw::VirtualizingStackLayout::_SetItemMeasured(int index, const Size &desireSize)
+{
+    bool vertical  = this->orientation == Orientation::Vertical;
+    double &extent = this->_itemExtents[index];
+
+    if (extent < 0) {
+        ++this->_measuredCount;
+    } else {
+        this->_measuredExtentSum -= extent;
+    }
+
+    extent = _GetAlong(desireSize, vertical);
+    this->_measuredExtentSum += extent;
+    this->_maxCrossExtent = Utils::Max(this->_maxCrossExtent, _GetCross(desireSize, vertical));
+}
+
+int sw::VirtualizingStackLayout::_LocateItem(double position, double &offset)
+{
+    int count = static_cast<int>(this->_itemExtents.size());
+
+    int index = 0;
+    double pos = 0;
+
+    // 第一个已实现化子项的位置只取决于其之前的子项，这些子项在其未实现化期间不会被重新测量，
+    // 只要估计尺寸未改变即可作为查找的起点
+    if (this->_offsetEstimate == this->estimatedItemExtent && this->_firstRealized < count) {
+        index = this->_firstRealized;
+        pos   = this->_firstRealizedOffset;
+    }
+
+    while (index > 0 && pos > position) {
+        pos -= this->_GetItemExtent(--index);
+    }
+    while (index + 1 < count && pos + this->_GetItemExtent(index) <= position) {
+        pos += this->_GetItemExtent(index++);
+    }
+
+    offset = index == 0 ? 0 : pos;
+    return index;
 }
 
-void sw::UniformGridLayout::ArrangeOverride(const Size &finalSize)
+void sw::VirtualizingStackLayout::_UpdateRealizedItems(double start, double length, double crossAvailable, bool measureRealized)
 {
-    int rowCount = Utils::Max(1, this->rows);
-    int colCount = Utils::Max(1, this->columns);
-    int beginCol = Utils::Max(0, Utils::Min(colCount - 1, this->firstColumn));
+    int count = static_cast<int>(this->_itemExtents.size());
 
-    double arrangeWidth  = finalSize.width / colCount;
-    double arrangeHeight = finalSize.height / rowCount;
+    if (count == 0) {
+        this->_RecycleAll();
+        return;
+    }
 
-    int childCount = this->GetChildLayoutCount();
+    bool vertical = this->orientation == Orientation::Vertical;
+    double end    = start + length;
 
-    for (int i = 0; i < childCount; ++i) {
-        int arrangeRow = (i + beginCol) / colCount;
-        int arrangeCol = (i + beginCol) % colCount;
+    double offset;
+    int first = this->_LocateItem(start, offset);
 
-        if (arrangeRow >= rowCount) {
-            arrangeRow = rowCount - 1;
-            arrangeCol = colCount - 1;
+    std::vector<ILayout *> &oldItems = this->_previousItems;
+    oldItems.swap(this->_realizedItems);
+    this->_realizedItems.clear();
+    int oldFirst = this->_firstRealized;
+    int oldCount = static_cast<int>(oldItems.size());
+
+    // 先回收按当前尺寸确定位于新范围之外的子项，使随后实现化的子项可以复用这些容器
+    double position = offset;
+    for (int i = 0, index = first; i < oldCount; ++i) {
+        int oldIndex = oldFirst + i;
+        if (oldIndex > first) {
+            while (index < oldIndex) {
+                position += this->_GetItemExtent(index++);
+            }
         }
+        if (oldIndex < first || (oldIndex > first && position >= end)) {
+            this->generator->RecycleItem(oldIndex, *oldItems[i]);
+            oldItems[i] = nullptr;
+        }
+    }
 
-        ILayout &item = this->GetChildLayoutAt(i);
-        item.Arrange(Rect{arrangeCol * arrangeWidth, arrangeRow * arrangeHeight, arrangeWidth, arrangeHeight});
+    position = offset;
+
+    for (int index = first; index < count && (index == first || position < end); ++index) {
+        ILayout *item = nullptr;
+        if (index >= oldFirst && index < oldFirst + oldCount) {
+            std::swap(item, oldItems[index - oldFirst]);
+        }
+
+        bool realized = item == nullptr;
+        if (realized) {
+            item = &this->generator->RealizeItem(index);
+        }
+        if (realized || measureRealized) {
+            item->Measure(_MakeSize(INFINITY, crossAvailable, vertical));
+            this->_SetItemMeasured(index, item->GetDesireSize());
+        }
+
+        this->_realizedItems.push_back(item);
+        position += this->_GetItemExtent(index);
+    }
+
+    // 测量后尺寸变小的子项可能使原先的子项移出范围
+    for (int i = 0; i < oldCount; ++i) {
+        if (oldItems[i] != nullptr) {
+            this->generator->RecycleItem(oldFirst + i, *oldItems[i]);
+        }
     }
+    oldItems.clear();
+
+    this->_firstRealized       = first;
+    this->_firstRealizedOffset = offset;
+    this->_offsetEstimate      = this->estimatedItemExtent;
 }
 
-// Utils.cpp
+void sw::VirtualizingStackLayout::_RecycleAll()
+{
+    int realizedCount = static_cast<int>(this->_realizedItems.size());
+
+    for (int i = 0; i < realizedCount && this->generator != nullptr; ++i) {
+        this->generator->RecycleItem(this->_firstRealized + i, *this->_realizedItems[i]);
+    }
+    this->_realizedItems.clear();
+}
+
+// VirtualizingStackPanel.cpp
 
 namespace
 {
     /**
-     * @brief 指示是否使用UTF-8编码进行字符串转换
+     * @brief 在作用域内抑制元素的InvalidateMeasure，析构时恢复
+     * @note 子元素在面板测量过程中被实现化和回收，面板正在测量，实现化的子元素随后也会被测量，
+     *       此时由子元素的属性变化触发的布局更新请求是多余的，会导致再进行一轮布局
      */
-    bool _usesUtf8 = true;
+    class _InvalidationSuppressor
+    {
+    private:
+        sw::UIElement &_element;
+        bool _wasSupressed;
 
-    /**
-     * @brief 用于裁剪字符串的空白字符集合
-     */
-    constexpr wchar_t _WhitespaceChars[] = L" \t\n\r\f\v";
-}
+    public:
+        explicit _InvalidationSuppressor(sw::UIElement &element)
+            : _element(element),
+              _wasSupressed(element.IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::Supressed))
+        {
+            element.LayoutUpdateCondition = element.LayoutUpdateCondition.Get() | sw::LayoutUpdateCondition::Supressed;
+        }
 
-void sw::Utils::UseUtf8Encoding(bool useUtf8)
-{
-    _usesUtf8 = useUtf8;
-}
+        ~_InvalidationSuppressor()
+        {
+            if (!this->_wasSupressed) {
+                this->_element.LayoutUpdateCondition = this->_element.LayoutUpdateCondition.Get() & ~sw::LayoutUpdateCondition::Supressed;
+            }
+        }
 
-std::wstring sw::Utils::ToWideStr(const std::string &str)
-{
-    return ToWideStr(str, _usesUtf8);
+        _InvalidationSuppressor(const _InvalidationSuppressor &)            = delete;
+        _InvalidationSuppressor &operator=(const _InvalidationSuppressor &) = delete;
+    };
 }
 
-std::string sw::Utils::ToMultiByteStr(const std::wstring &wstr)
-{
-    return ToMultiByteStr(wstr, _usesUtf8);
-}
+sw::VirtualizingStackPanel::VirtualizingStackPanel()
+    : Orientation(
+          Property<sw::Orientation>::Init(this)
+              .Getter([](VirtualizingStackPanel *self) -> sw::Orientation {
+                  return self->_virtualizingLayout.orientation;
+              })
+              .Setter([](VirtualizingStackPanel *self, sw::Orientation value) {
+                  if (self->_virtualizingLayout.orientation != value) {
+                      self->_virtualizingLayout.orientation = value;
+                      self->RaisePropertyChanged(&VirtualizingStackPanel::Orientation);
+                      self->_ResetItems();
+                  }
+              })),
 
-std::wstring sw::Utils::ToWideStr(const std::string &str, bool utf8)
-{
-    int code = utf8 ? CP_UTF8 : CP_ACP;
-    int size = MultiByteToWideChar(code, 0, str.c_str(), -1, nullptr, 0);
-    std::wstring wstr(size, L'\0');
-    MultiByteToWideChar(code, 0, str.c_str(), -1, &wstr[0], size);
-    wstr.resize(wcslen(wstr.data()));
-    return wstr;
-}
+      EstimatedItemExtent(
+          Property<double>::Init(this)
+              .Getter([](VirtualizingStackPanel *self) -> double {
+                  return self->_virtualizingLayout.estimatedItemExtent;
+              })
+              .Setter([](VirtualizingStackPanel *self, double value) {
+                  if (self->_virtualizingLayout.estimatedItemExtent != value) {
+                      self->_virtualizingLayout.estimatedItemExtent = value;
+                      self->RaisePropertyChanged(&VirtualizingStackPanel::EstimatedItemExtent);
+                      self->InvalidateMeasure();
+                  }
+              })),
 
-std::string sw::Utils::ToMultiByteStr(const std::wstring &wstr, bool utf8)
+      ItemsSource(
+          Property<IList *>::Init(this)
+              .Getter([](VirtualizingStackPanel *self) -> IList * {
+                  return self->_itemsSource;
+              })
+              .Setter([](VirtualizingStackPanel *self, IList *value) {
+                  if (self->_itemsSource == value) {
+                      return;
+                  }
+                  if (self->_notifyCollectionChanged != nullptr) {
+                      self->_notifyCollectionChanged->CollectionChanged -=
+                          NotifyCollectionChangedEventHandler(*self, &VirtualizingStackPanel::_CollectionChangedEventHandler);
+                  }
+                  self->_itemsSource             = value;
+                  self->_notifyCollectionChanged = dynamic_cast<INotifyCollectionChanged *>(value);
+                  if (self->_notifyCollectionChanged != nullptr) {
+                      self->_notifyCollectionChanged->CollectionChanged +=
+                          NotifyCollectionChangedEventHandler(*self, &VirtualizingStackPanel::_CollectionChangedEventHandler);
+                  }
+                  self->RaisePropertyChanged(&VirtualizingStackPanel::ItemsSource);
+                  self->_ResetItems();
+              })),
+
+      ItemContainerCount(
+          Property<int>::Init(this)
+              .Getter([](VirtualizingStackPanel *self) -> int {
+                  return static_cast<int>(self->_itemContainers.size());
+              }))
 {
-    int code = utf8 ? CP_UTF8 : CP_ACP;
-    int size = WideCharToMultiByte(code, 0, wstr.c_str(), -1, nullptr, 0, nullptr, nullptr);
-    std::string str(size, '\0');
-    WideCharToMultiByte(code, 0, wstr.c_str(), -1, &str[0], size, nullptr, nullptr);
-    str.resize(strlen(str.data()));
-    return str;
+    this->_virtualizingLayout.generator = this;
+    this->_virtualizingLayout.Associate(this);
+    this->HorizontalAlignment = HorizontalAlignment::Stretch;
+    this->VerticalAlignment   = VerticalAlignment::Stretch;
 }
 
-std::wstring sw::Utils::Trim(const std::wstring &str)
+sw::VirtualizingStackPanel::~VirtualizingStackPanel()
 {
-    size_t firstNonSpace = str.find_first_not_of(_WhitespaceChars);
-
-    if (firstNonSpace == std::wstring::npos) {
-        return std::wstring{};
-    } else {
-        size_t lastNonSpace = str.find_last_not_of(_WhitespaceChars);
-        return str.substr(firstNonSpace, lastNonSpace - firstNonSpace + 1);
+    if (this->_notifyCollectionChanged != nullptr) {
+        this->_notifyCollectionChanged->CollectionChanged -=
+            NotifyCollectionChangedEventHandler(*this, &VirtualizingStackPanel::_CollectionChangedEventHandler);
     }
+
+    // 销毁子元素时可能触发布局，此时不应再创建新的子元素
+    this->_virtualizingLayout.generator = nullptr;
+    this->_recycledContainers.clear();
+    this->_itemContainers.clear();
 }
 
-std::wstring sw::Utils::TrimStart(const std::wstring &str)
+int sw::VirtualizingStackPanel::GetItemCount()
 {
-    size_t firstNonSpace = str.find_first_not_of(_WhitespaceChars);
-
-    if (firstNonSpace == std::wstring::npos) {
-        return std::wstring{};
-    } else {
-        return str.substr(firstNonSpace);
-    }
+    return this->_itemsSource == nullptr ? 0 : this->_itemsSource->Count();
 }
 
-std::wstring sw::Utils::TrimEnd(const std::wstring &str)
+sw::ILayout &sw::VirtualizingStackPanel::RealizeItem(int index)
 {
-    size_t lastNonSpace = str.find_last_not_of(_WhitespaceChars);
+    UIElement *container;
+    bool created = this->_recycledContainers.empty();
 
-    if (lastNonSpace == std::wstring::npos) {
-        return std::wstring{};
+    if (created) {
+        container = this->CreateItemContainer();
+        this->_itemContainers.emplace_back(container);
     } else {
-        return str.substr(0, lastNonSpace + 1);
+        container = this->_recycledContainers.back();
+        this->_recycledContainers.pop_back();
     }
-}
 
-std::vector<std::wstring> sw::Utils::Split(const std::wstring &str, const std::wstring &delimiter)
-{
-    std::vector<std::wstring> result;
+    {
+        _InvalidationSuppressor suppressPanel(*this);
+        _InvalidationSuppressor suppressContainer(*container);
 
-    if (delimiter.empty()) {
-        result.push_back(str);
-        return result;
+        if (created) {
+            this->AddChild(container);
+        }
+        this->PrepareItemContainer(*container, index, this->_itemsSource->GetVariantAt(index));
+        container->Visible = true;
     }
 
-    size_t start = 0;
-    size_t end   = str.find(delimiter);
-
-    const size_t delimiterLength = delimiter.length();
+    // 子元素的内容可能已改变，使布局对象接下来对其重新测量
+    container->LayoutUpdateCondition = container->LayoutUpdateCondition.Get() | sw::LayoutUpdateCondition::MeasureInvalidated;
+    return *container;
+}
 
-    while (end != std::wstring::npos) {
-        result.emplace_back(str, start, end - start);
-        start = end + delimiterLength;
-        end   = str.find(delimiter, start);
+void sw::VirtualizingStackPanel::RecycleItem(int index, ILayout &container)
+{
+    UIElement &element = static_cast<UIElement &>(container);
+    {
+        _InvalidationSuppressor suppressPanel(*this);
+        _InvalidationSuppressor suppressElement(element);
+        element.Visible = false;
     }
-
-    result.emplace_back(str, start);
-    return result;
+    this->_recycledContainers.push_back(&element);
 }
 
-std::wstring sw::Utils::FormatStr(const wchar_t *fmt, ...)
+sw::LayoutHost *sw::VirtualizingStackPanel::GetDefaultLayout()
 {
-    va_list args;
-    va_start(args, fmt);
-
-    va_list argsCopy;
-    va_copy(argsCopy, args);
+    return &this->_virtualizingLayout;
+}
 
-    int len = vswprintf(nullptr, 0, fmt, argsCopy);
-    va_end(argsCopy);
+sw::UIElement *sw::VirtualizingStackPanel::CreateItemContainer()
+{
+    return new Label;
+}
 
-    if (len <= 0) {
-        va_end(args);
-        return std::wstring{};
+void sw::VirtualizingStackPanel::PrepareItemContainer(UIElement &container, int index, const Variant &item)
+{
+    if (item.IsType<std::wstring>()) {
+        container.Text = item.UnsafeCast<std::wstring>();
     }
+}
 
-    std::wstring result;
-    result.resize(len + 1);
-
-    vswprintf(&result[0], result.size(), fmt, args);
-    va_end(args);
+void sw::VirtualizingStackPanel::_ResetItems()
+{
+    this->_virtualizingLayout.ResetItems();
+    this->InvalidateMeasure();
+}
 
-    result.resize(len);
-    return result;
+void sw::VirtualizingStackPanel::_CollectionChangedEventHandler(
+    INotifyCollectionChanged &sender, NotifyCollectionChangedEventArgs &args)
+{
+    // 项的增删会改变其后所有项的索引，这里统一回收后重新实现化可视区域内的项
+    this->_ResetItems();
 }
 
 // Window.cpp
@@ -11880,7 +14345,8 @@ LRESULT sw::Window::WndProc(ProcMsg &refMsg)
         }
 
         case WM_UpdateLayout: {
-            if (!_isDestroying && !_IsLayoutDisabled()) {
+            if (AcceptLayoutUpdate(refMsg.wParam != FALSE) &&
+                !_isDestroying && !_IsLayoutDisabled()) {
                 UpdateLayout();
             }
             return 0;
@@ -11951,11 +14417,10 @@ bool sw::Window::OnPaint()
         ps.rcPaint.top < ps.rcPaint.bottom) //
     {
         auto color    = static_cast<COLORREF>(GetRealBackColor());
-        HBRUSH hBrush = CreateSolidBrush(color);
+        HBRUSH hBrush = BrushCache::GetBrush(color);
 
         if (hBrush != NULL) {
             FillRect(hdc, &ps.rcPaint, hBrush);
-            DeleteObject(hBrush);
         }
     }
 
@@ -12172,6 +14637,8 @@ bool sw::Window::EnableLayout(bool reset)
         RaisePropertyChanged(&Window::IsLayoutDisabled);
     }
     if (!newValue) {
+        // 立即更新布局，清除挂起的布局更新使已投递的WM_UpdateLayout消息被忽略
+        AcceptLayoutUpdate(false);
         UpdateLayout();
     }
     return true;
@@ -12574,9 +15041,7 @@ sw::WndBase::~WndBase()
     if (this->_hwnd != NULL && !this->_isDestroyed) {
         DestroyWindow(this->_hwnd);
     }
-    if (this->_hfont != NULL) {
-        DeleteObject(this->_hfont);
-    }
+    FontCache::Release(this->_hfont);
 
     // 将_check字段置零，标记当前对象无效
     const_cast<uint32_t &>(this->_check) = 0;
@@ -13459,10 +15924,11 @@ void sw::WndBase::Update()
 
 void sw::WndBase::UpdateFont()
 {
-    if (this->_hfont != NULL) {
-        DeleteObject(this->_hfont);
-    }
-    this->_hfont = this->_font.CreateHandle();
+    // 先获取新句柄再释放旧句柄，字体未改变时可直接复用缓存中的同一个句柄
+    HFONT hfont = FontCache::Acquire(this->_font);
+    FontCache::Release(this->_hfont);
+
+    this->_hfont = hfont;
     this->SendMessageW(WM_SETFONT, (WPARAM)this->_hfont, TRUE);
     this->FontChanged(this->_hfont);
 }
@@ -13583,11 +16049,24 @@ void sw::WndBase::Invoke(const Action<> &action)
 }
 
 bool sw::WndBase::InvokeAsync(const Action<> &action)
+{
+    return this->InvokeAsync(action, DispatcherPriority::Render);
+}
+
+bool sw::WndBase::InvokeAsync(const Action<> &action, DispatcherPriority priority, uint64_t key)
 {
     bool result;
 
     if (action == nullptr) {
         result = false;
+    } else if (auto dispatcher = Dispatcher::FromThread(this->GetThreadId())) {
+        // 调度器中的任务不随窗口销毁，执行前检查窗口是否仍然有效
+        HWND hwnd = this->_hwnd;
+        result    = dispatcher->BeginInvoke(
+            [this, hwnd, action]() {
+                if (WndBase::GetWndBase(hwnd) == this) action();
+            },
+            priority, key);
     } else {
         auto *p = new Action<>(action);
 
@@ -13627,7 +16106,13 @@ sw::WndBase *sw::WndBase::GetWndBase(HWND hwnd) noexcept
     } _atom;
     // clang-format on
 
-    auto p = reinterpret_cast<WndBase *>(GetProp(hwnd, MAKEINTATOM(_atom.value)));
+    // 当前线程创建的窗口先查线程内的表，避免每条消息都遍历窗口属性列表
+    WndBase *p = WndBaseTable::_GetCurrent().Find(hwnd);
+    if (p != nullptr && p->_check == _WndBaseMagicNumber && p->_hwnd == hwnd) {
+        return p;
+    }
+
+    p = reinterpret_cast<WndBase *>(GetProp(hwnd, MAKEINTATOM(_atom.value)));
     return (p == nullptr || p->_check != _WndBaseMagicNumber) ? nullptr : p;
 }
 
@@ -13642,7 +16127,12 @@ LRESULT sw::WndBase::_WndProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam
 
     if (pThis != nullptr) {
         ProcMsg msg{hwnd, uMsg, wParam, lParam};
-        return pThis->WndProc(msg);
+        LRESULT result = pThis->WndProc(msg);
+        if (uMsg == WM_NCDESTROY) {
+            // 窗口句柄已失效，之后可能被复用，需要从表中移除
+            WndBaseTable::_GetCurrent().Remove(hwnd);
+        }
+        return result;
     } else {
         return DefWindowProcW(hwnd, uMsg, wParam, lParam);
     }
@@ -13752,6 +16242,114 @@ int sw::WndBase::_NextControlId()
 void sw::WndBase::_SetWndBase(HWND hwnd, WndBase &wnd)
 {
     SetPropW(hwnd, _WndBasePtrProp, reinterpret_cast<HANDLE>(&wnd));
+
+    // 线程内的表只记录当前线程的窗口，其他线程的窗口在销毁时无法从当前线程的表中移除
+    if (GetWindowThreadProcessId(hwnd, NULL) == GetCurrentThreadId()) {
+        WndBaseTable::_GetCurrent().Set(hwnd, &wnd);
+    }
+}
+
+// WndBaseTable.cpp
+
+constexpr size_t sw::WndBaseTable::InitialCapacity;
+
+sw::WndBase *sw::WndBaseTable::Find(HWND hwnd) const noexcept
+{
+    if (hwnd == NULL || this->_count == 0) {
+        return nullptr;
+    }
+    return this->_slots[this->_Probe(hwnd)].wnd;
+}
+
+void sw::WndBaseTable::Set(HWND hwnd, WndBase *wnd)
+{
+    if (hwnd == NULL) {
+        return;
+    }
+
+    // 负载因子不超过1/2，保证探测总能遇到空位且探测序列较短
+    if ((this->_count + 1) * 2 > this->_slots.size()) {
+        this->_Rehash(this->_slots.empty() ? InitialCapacity : this->_slots.size() * 2);
+    }
+
+    _Slot &slot = this->_slots[this->_Probe(hwnd)];
+    if (slot.hwnd == NULL) {
+        slot.hwnd = hwnd;
+        ++this->_count;
+    }
+    slot.wnd = wnd;
+}
+
+void sw::WndBaseTable::Remove(HWND hwnd) noexcept
+{
+    if (hwnd == NULL || this->_count == 0) {
+        return;
+    }
+
+    std::vector<_Slot> &slots = this->_slots;
+
+    size_t mask = slots.size() - 1;
+    size_t hole = this->_Probe(hwnd);
+
+    if (slots[hole].hwnd == NULL) {
+        return;
+    }
+
+    // 向后移动同一探测序列上的后续项填补空位，避免使用删除标记
+    for (size_t i = (hole + 1) & mask; slots[i].hwnd != NULL; i = (i + 1) & mask) {
+        size_t home = _Hash(slots[i].hwnd) & mask;
+
+        // 理想位置位于(hole, i]之间的项无需移动
+        bool stay = hole <= i ? (hole < home && home <= i) : (hole < home || home <= i);
+        if (!stay) {
+            slots[hole] = slots[i];
+            hole        = i;
+        }
+    }
+
+    slots[hole] = _Slot{};
+    --this->_count;
+}
+
+size_t sw::WndBaseTable::GetCount() const noexcept
+{
+    return this->_count;
+}
+
+sw::WndBaseTable &sw::WndBaseTable::_GetCurrent() noexcept
+{
+    static thread_local WndBaseTable table;
+    return table;
+}
+
+size_t sw::WndBaseTable::_Hash(HWND hwnd) noexcept
+{
+    // 句柄值的低位变化较少，乘以黄金分割常数后取高位
+    uint64_t value = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(hwnd));
+    return static_cast<size_t>((value * 0x9e3779b97f4a7c15ull) >> 32);
+}
+
+size_t sw::WndBaseTable::_Probe(HWND hwnd) const noexcept
+{
+    size_t mask = _slots.size() - 1;
+    size_t i    = _Hash(hwnd) & mask;
+
+    while (_slots[i].hwnd != NULL && _slots[i].hwnd != hwnd) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+void sw::WndBaseTable::_Rehash(size_t capacity)
+{
+    std::vector<_Slot> oldSlots(capacity);
+    std::swap(_slots, oldSlots);
+
+    for (const _Slot &slot : oldSlots) {
+        if (slot.hwnd != NULL) {
+            _slots[_Probe(slot.hwnd)] = slot;
+        }
+    }
 }
 
 // WrapLayout.cpp
@@ -13760,32 +16358,36 @@ namespace
 {
     /**
      * @brief 按行高统一安排一行中的所有子元素，使行内元素占用相同的垂直布局空间
+     * @param begin 该行第一个子元素的索引
+     * @param end 该行最后一个子元素之后的索引
      */
     void _WrapLayoutArrangeRow(
-        double top, double height, const std::vector<std::tuple<sw::ILayout *, sw::Size>> &row)
+        sw::LayoutHost *self, int begin, int end, double top, double height)
     {
         double left = 0;
 
-        for (auto &tuple : row) {
-            sw::ILayout *item = std::get<0>(tuple);
-            sw::Size itemSize = std::get<1>(tuple);
-            item->Arrange(sw::Rect{left, top, itemSize.width, height});
+        for (int i = begin; i < end; ++i) {
+            sw::ILayout &item = self->GetChildLayoutAt(i);
+            sw::Size itemSize = item.GetDesireSize();
+            item.Arrange(sw::Rect{left, top, itemSize.width, height});
             left += itemSize.width;
         }
     }
 
     /**
      * @brief 按列宽统一安排一列中的所有子元素，使列内元素占用相同的水平布局空间
+     * @param begin 该列第一个子元素的索引
+     * @param end 该列最后一个子元素之后的索引
      */
     void _WrapLayoutArrangeCol(
-        double left, double width, const std::vector<std::tuple<sw::ILayout *, sw::Size>> &col)
+        sw::LayoutHost *self, int begin, int end, double left, double width)
     {
         double top = 0;
 
-        for (auto &tuple : col) {
-            sw::ILayout *item = std::get<0>(tuple);
-            sw::Size itemSize = std::get<1>(tuple);
-            item->Arrange(sw::Rect{left, top, width, itemSize.height});
+        for (int i = begin; i < end; ++i) {
+            sw::ILayout &item = self->GetChildLayoutAt(i);
+            sw::Size itemSize = item.GetDesireSize();
+            item.Arrange(sw::Rect{left, top, width, itemSize.height});
             top += itemSize.height;
         }
     }
@@ -13842,33 +16444,29 @@ namespace
         double rowWidth  = 0;
         double rowHeight = 0;
 
-        int count = self->GetChildLayoutCount();
-
-        std::vector<std::tuple<sw::ILayout *, sw::Size>> row;
-        row.reserve(count);
+        int count    = self->GetChildLayoutCount();
+        int rowBegin = 0; // 当前行第一个子元素的索引
 
+        // 行内的子元素是连续的，只记录行的起始索引，排列时再次获取子元素及其尺寸，无需额外分配内存
         for (int i = 0; i < count; ++i) {
-            sw::ILayout &item       = self->GetChildLayoutAt(i);
-            sw::Size itemDesireSize = item.GetDesireSize();
+            sw::Size itemDesireSize = self->GetChildLayoutAt(i).GetDesireSize();
 
             if (rowWidth + itemDesireSize.width <= finalSize.width) {
-                row.emplace_back(&item, itemDesireSize);
                 rowWidth += itemDesireSize.width;
                 rowHeight = sw::Utils::Max(rowHeight, itemDesireSize.height);
             } else {
-                if (!row.empty()) {
-                    _WrapLayoutArrangeRow(top, rowHeight, row);
+                if (rowBegin < i) {
+                    _WrapLayoutArrangeRow(self, rowBegin, i, top, rowHeight);
                 }
-                row.clear();
-                row.emplace_back(&item, itemDesireSize);
+                rowBegin = i;
                 top += rowHeight;
                 rowWidth  = itemDesireSize.width;
                 rowHeight = itemDesireSize.height;
             }
         }
 
-        if (!row.empty()) {
-            _WrapLayoutArrangeRow(top, rowHeight, row);
+        if (rowBegin < count) {
+            _WrapLayoutArrangeRow(self, rowBegin, count, top, rowHeight);
         }
     }
 
@@ -13924,33 +16522,29 @@ namespace
         double colHeight = 0;
         double colWidth  = 0;
 
-        int count = self->GetChildLayoutCount();
-
-        std::vector<std::tuple<sw::ILayout *, sw::Size>> col;
-        col.reserve(count);
+        int count    = self->GetChildLayoutCount();
+        int colBegin = 0; // 当前列第一个子元素的索引
 
+        // 列内的子元素是连续的，只记录列的起始索引，排列时再次获取子元素及其尺寸，无需额外分配内存
         for (int i = 0; i < count; ++i) {
-            sw::ILayout &item       = self->GetChildLayoutAt(i);
-            sw::Size itemDesireSize = item.GetDesireSize();
+            sw::Size itemDesireSize = self->GetChildLayoutAt(i).GetDesireSize();
 
             if (colHeight + itemDesireSize.height <= finalSize.height) {
-                col.emplace_back(&item, itemDesireSize);
                 colHeight += itemDesireSize.height;
                 colWidth = sw::Utils::Max(colWidth, itemDesireSize.width);
             } else {
-                if (!col.empty()) {
-                    _WrapLayoutArrangeCol(left, colWidth, col);
+                if (colBegin < i) {
+                    _WrapLayoutArrangeCol(self, colBegin, i, left, colWidth);
                 }
-                col.clear();
-                col.emplace_back(&item, itemDesireSize);
+                colBegin = i;
                 left += colWidth;
                 colHeight = itemDesireSize.height;
                 colWidth  = itemDesireSize.width;
             }
         }
 
-        if (!col.empty()) {
-            _WrapLayoutArrangeCol(left, colWidth, col);
+        if (colBegin < count) {
+            _WrapLayoutArrangeCol(self, colBegin, count, left, colWidth);
         }
     }
 }
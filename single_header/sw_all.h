@@ -12,7 +12,9 @@
 #pragma once
 #include <windows.h>
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cmath>
 #include <commctrl.h>
 #include <cstddef>
@@ -20,10 +22,15 @@
 #include <cstdlib>
 #include <cstring>
 #include <cwchar>
+#include <deque>
 #include <initializer_list>
+#include <iterator>
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <shellapi.h>
 #include <shlobj.h>
 #include <sstream>
@@ -32,6 +39,7 @@
 #include <tuple>
 #include <type_traits>
 #include <typeindex>
+#include <typeinfo>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -70,6 +78,149 @@ namespace sw
     };
 }
 
+// BrushCache.h
+
+
+namespace sw
+{
+    /**
+     * @brief 画刷缓存的统计信息
+     */
+    struct BrushCacheStatistics {
+        uint64_t createdCount = 0; ///< 新建画刷的次数
+        uint64_t reusedCount  = 0; ///< 复用已缓存画刷的次数
+        uint64_t evictedCount = 0; ///< 销毁已缓存画刷的次数，包括超出容量与调用Clear时
+        int brushCount        = 0; ///< 当前缓存的画刷数量
+        int acquiredCount     = 0; ///< 当前通过Acquire持有引用、不会被销毁的画刷数量
+    };
+
+    /**
+     * @brief 线程内的纯色画刷缓存，按颜色缓存最近使用的画刷，超出容量时销毁最久未使用的画刷
+     * @note 画刷由缓存持有，调用方不能销毁获取到的画刷。通过GetBrush获取的画刷不应长期保存：
+     *       之后获取其他颜色的画刷可能使其被销毁，应在每次绘制时重新获取；
+     *       需要在返回后继续使用的画刷（例如响应WM_CTLCOLORxxx时返回给系统的画刷）应通过Acquire获取，
+     *       在引用计数归零前不会被销毁
+     * @note 每个线程拥有独立的缓存，线程结束时销毁该线程缓存的所有画刷
+     */
+    class BrushCache
+    {
+    public:
+        /**
+         * @brief 默认容量
+         */
+        static constexpr int DefaultCapacity = 32;
+
+    private:
+        /**
+         * @brief 缓存的画刷信息
+         */
+        struct _BrushInfo {
+            COLORREF color;
+            HBRUSH hBrush;
+            int refCount;
+        };
+
+        /**
+         * @brief 缓存的画刷，按最近使用的顺序排列，表头为最近使用的画刷
+         */
+        std::list<_BrushInfo> _brushes;
+
+        /**
+         * @brief 颜色到_brushes中对应项的映射
+         */
+        std::unordered_map<COLORREF, std::list<_BrushInfo>::iterator> _index;
+
+        /**
+         * @brief 画刷句柄到_brushes中对应项的映射，用于Release
+         */
+        std::unordered_map<HBRUSH, std::list<_BrushInfo>::iterator> _handles;
+
+        /**
+         * @brief 最多缓存的画刷数量
+         */
+        int _capacity = DefaultCapacity;
+
+        /**
+         * @brief 统计信息
+         */
+        BrushCacheStatistics _statistics;
+
+    public:
+        /**
+         * @brief 析构函数，销毁缓存的所有画刷
+         */
+        ~BrushCache();
+
+        /**
+         * @brief 获取指定颜色的纯色画刷
+         * @return 画刷句柄，创建失败时返回NULL
+         */
+        static HBRUSH GetBrush(COLORREF color);
+
+        /**
+         * @brief 获取指定颜色的纯色画刷，并增加其引用计数
+         * @return 画刷句柄，创建失败时返回NULL
+         * @note 引用计数不为零的画刷不会因超出容量或调用Clear而被销毁，使用完后需在同一线程调用Release
+         */
+        static HBRUSH Acquire(COLORREF color);
+
+        /**
+         * @brief 减少通过Acquire获取的画刷的引用计数，归零后按最近使用的顺序参与淘汰
+         * @note 传入NULL、不是由当前线程的缓存创建的句柄或在线程的缓存销毁后调用时不做任何操作
+         */
+        static void Release(HBRUSH hBrush);
+
+        /**
+         * @brief 获取当前线程缓存的容量
+         */
+        static int GetCapacity();
+
+        /**
+         * @brief 设置当前线程缓存的容量，缓存的画刷多于该值时立即销毁最久未使用的画刷
+         * @param capacity 容量，小于1时按1处理
+         * @note 通过Acquire持有引用的画刷不计入容量
+         */
+        static void SetCapacity(int capacity);
+
+        /**
+         * @brief 销毁当前线程缓存的所有未被引用的画刷
+         * @note 通过Acquire持有引用的画刷（例如控件正在使用的背景画刷）不会被销毁，因此可以在窗口存在时调用
+         */
+        static void Clear();
+
+        /**
+         * @brief 获取当前线程缓存的统计信息
+         */
+        static BrushCacheStatistics GetStatistics();
+
+    private:
+        /**
+         * @brief 默认构造函数
+         */
+        BrushCache() = default;
+
+        /**
+         * @brief 获取当前线程的缓存对象
+         */
+        static BrushCache &_GetInstance();
+
+        /**
+         * @brief 当前线程的缓存对象是否已销毁，线程结束时静态对象的析构函数可能在其后调用Release
+         */
+        static bool &_IsDestroyed();
+
+        /**
+         * @brief 获取指定颜色的画刷并将其标记为最近使用，不存在时创建
+         */
+        std::list<_BrushInfo>::iterator _Get(COLORREF color);
+
+        /**
+         * @brief 销毁最久未使用且未被引用的画刷，直到未被引用的画刷数量不超过maxCount
+         */
+        void _Trim(int maxCount);
+    };
+}
+
 // Cursor.h
 
 
@@ -189,6 +340,10 @@ namespace sw
 
     /**
      * @brief 用于存储和管理多个可调用对象的列表，针对单个可调用对象的情况进行优化
+     * @note 第一个可调用对象若足够小（不超过对象指针加成员函数指针的大小）且可无异常移动，
+     *       可通过Emplace直接构造在内部缓冲区中，不会分配堆内存
+     * @note 存储多个可调用对象时列表采用写时复制：GetSnapshot返回的快照与列表共享存储，
+     *       仅当快照仍被持有时修改列表才会复制存储，因此调用委托时无需复制列表
      */
     template <typename T>
     class CallableList
@@ -209,20 +364,73 @@ namespace sw
          */
         using TSharedList = std::vector<std::shared_ptr<TCallable>>;
 
+        /**
+         * @brief 指向共享列表存储的智能指针类型别名
+         */
+        using TListPtr = std::shared_ptr<TSharedList>;
+
+        /**
+         * @brief 只读列表快照类型别名
+         */
+        using TSnapshot = std::shared_ptr<const TSharedList>;
+
     private:
+        /**
+         * @brief 仅用于计算成员函数指针的最大尺寸的不完整类型
+         */
+        struct _IncompleteClass;
+
+        /**
+         * @brief 内联缓冲区大小，可容纳虚表指针、对象指针与任意成员函数指针
+         */
+        static constexpr size_t _InlineSize =
+            sizeof(void *) * 2 + sizeof(void (_IncompleteClass::*)());
+
+        /**
+         * @brief 内联存储的可调用对象的类型相关操作
+         */
+        struct _InlineOps {
+            void (*copy)(void *dst, const TCallable &src);     ///< 在dst处拷贝构造src
+            void (*relocate)(void *dst, TCallable &src);       ///< 将src移动到dst并析构src
+            TCallable *(*moveToHeap)(TCallable &src);          ///< 将src移动到新分配的堆对象中
+        };
+
+        /**
+         * @brief 判断TImpl能否内联存储
+         */
+        template <typename TImpl>
+        struct _IsInlineStorable : std::integral_constant<
+                                       bool,
+                                       sizeof(TImpl) <= _InlineSize &&
+                                           alignof(TImpl) <= alignof(void *) &&
+                                           std::is_nothrow_move_constructible<TImpl>::value &&
+                                           std::is_copy_constructible<TImpl>::value> {
+        };
+
         /**
          * @brief 内部存储可调用对象的联合体
          */
         mutable union {
             alignas(TSinglePtr) uint8_t _single[sizeof(TSinglePtr)];
-            alignas(TSharedList) uint8_t _list[sizeof(TSharedList)];
+            alignas(TListPtr) uint8_t _list[sizeof(TListPtr)];
         } _data = {};
 
+        /**
+         * @brief 内联存储可调用对象的缓冲区
+         */
+        alignas(void *) mutable uint8_t _inline[_InlineSize];
+
+        /**
+         * @brief 当状态为STATE_INLINE时内联对象的类型相关操作
+         */
+        const _InlineOps *_ops = nullptr;
+
         /**
          * @brief 当前状态枚举
          */
         enum : uint8_t {
             STATE_NONE,   ///< 未存储任何可调用对象
+            STATE_INLINE, ///< 在内部缓冲区中储存了一个可调用对象
             STATE_SINGLE, ///< 储存了一个可调用对象
             STATE_LIST,   ///< 储存了多个可调用对象
         } _state = STATE_NONE;
@@ -253,9 +461,9 @@ namespace sw
 
         /**
          * @brief 拷贝赋值运算
-         * @note 强异常安全：先在本地完成可能抛异常的 Clone / vector 拷贝，
-         *       全部成功后再原子地切换 *this 的状态。提交阶段（_Reset(state) 与
-         *       unique_ptr/vector 的移动赋值）均为 noexcept，不会导致中间不一致。
+         * @note 强异常安全：先在本地完成可能抛异常的 Clone / 内联对象拷贝，全部成功后再原子地切换 *this 的状态。
+         *       提交阶段（_Reset(state)、智能指针的赋值与内联对象的移动）均为 noexcept，不会导致中间不一致。
+         * @note 多个可调用对象时与other共享列表存储，之后任一方被修改时才会复制
          */
         CallableList &operator=(const CallableList &other)
         {
@@ -268,6 +476,12 @@ namespace sw
                     _Reset();
                     break;
                 }
+                case STATE_INLINE: {
+                    CallableList copied;
+                    copied._EmplaceCopy(other);
+                    *this = std::move(copied);
+                    break;
+                }
                 case STATE_SINGLE: {
                     std::unique_ptr<TCallable> cloned(other._GetSingle()->Clone());
                     _Reset(STATE_SINGLE);
@@ -275,9 +489,9 @@ namespace sw
                     break;
                 }
                 case STATE_LIST: {
-                    TSharedList copied = other._GetList();
+                    TListPtr shared = other._GetListPtr();
                     _Reset(STATE_LIST);
-                    _GetList() = std::move(copied);
+                    _GetListPtr() = std::move(shared);
                     break;
                 }
             }
@@ -299,13 +513,20 @@ namespace sw
                 case STATE_NONE: {
                     break;
                 }
+                case STATE_INLINE: {
+                    other._ops->relocate(_inline, other._GetInline());
+                    _ops         = other._ops;
+                    _state       = STATE_INLINE;
+                    other._state = STATE_NONE;
+                    break;
+                }
                 case STATE_SINGLE: {
                     _GetSingle() = std::move(other._GetSingle());
                     other._Reset();
                     break;
                 }
                 case STATE_LIST: {
-                    _GetList() = std::move(other._GetList());
+                    _GetListPtr() = std::move(other._GetListPtr());
                     other._Reset();
                     break;
                 }
@@ -328,6 +549,7 @@ namespace sw
         size_t Count() const noexcept
         {
             switch (_state) {
+                case STATE_INLINE:
                 case STATE_SINGLE: {
                     return 1;
                 }
@@ -361,11 +583,10 @@ namespace sw
          * @brief 添加一个可调用对象到列表中
          * @note 传入对象的生命周期将由CallableList管理
          * @note 异常安全：
-         *       - SINGLE→LIST 升级时使用 reserve(2) 避免后续 emplace_back 触发扩容，
-         *         并使用 shared_ptr(unique_ptr&&) 接管所有权，构造失败时原 unique_ptr
-         *         不会释放其管理的对象。
+         *       - SINGLE/INLINE→LIST 升级时使用 reserve(2) 避免后续 emplace_back 触发扩容，
+         *         并使用 shared_ptr 接管所有权，构造失败时原对象保持不变，传入对象会被正确释放。
          *       - STATE_LIST 分支先把裸指针转交给本地 shared_ptr，再 emplace_back，
-         *         即使 vector 扩容失败，本地 shared_ptr 析构时也会正确释放对象。
+         *         即使复制列表存储或 vector 扩容失败，本地 shared_ptr 析构时也会正确释放对象。
          */
         void Add(TCallable *callable)
         {
@@ -381,32 +602,68 @@ namespace sw
                     _GetSingle() = std::move(owned);
                     break;
                 }
+                case STATE_INLINE: {
+                    TListPtr list = std::make_shared<TSharedList>();
+                    list->reserve(2);
+                    std::shared_ptr<TCallable> incoming(std::move(owned));
+                    std::shared_ptr<TCallable> current(_ops->moveToHeap(_GetInline()));
+                    list->emplace_back(std::move(current));
+                    list->emplace_back(std::move(incoming));
+                    _Reset(STATE_LIST);
+                    _GetListPtr() = std::move(list);
+                    break;
+                }
                 case STATE_SINGLE: {
-                    TSharedList list;
-                    list.reserve(2);
+                    TListPtr list = std::make_shared<TSharedList>();
+                    list->reserve(2);
                     std::shared_ptr<TCallable> incoming(std::move(owned));
                     std::shared_ptr<TCallable> current(std::move(_GetSingle()));
-                    list.emplace_back(std::move(current));
-                    list.emplace_back(std::move(incoming));
+                    list->emplace_back(std::move(current));
+                    list->emplace_back(std::move(incoming));
                     _Reset(STATE_LIST);
-                    _GetList() = std::move(list);
+                    _GetListPtr() = std::move(list);
                     break;
                 }
                 case STATE_LIST: {
                     std::shared_ptr<TCallable> sp(std::move(owned));
-                    _GetList().emplace_back(std::move(sp));
+                    _GetMutableList().emplace_back(std::move(sp));
                     break;
                 }
             }
         }
 
+        /**
+         * @brief 构造一个TImpl类型的可调用对象并添加到列表中
+         * @note 列表为空且TImpl可以内联存储时直接在内部缓冲区中构造，否则在堆上构造后调用Add
+         */
+        template <typename TImpl, typename... TArgs>
+        void Emplace(TArgs &&...args)
+        {
+            _Emplace<TImpl>(_IsInlineStorable<TImpl>{}, std::forward<TArgs>(args)...);
+        }
+
+        /**
+         * @brief 添加other中指定索引处可调用对象的副本
+         * @note 若该对象在other中内联存储且当前列表为空，副本同样内联存储，不会分配内存
+         */
+        void AddCopy(const CallableList &other, size_t index)
+        {
+            if (index == 0 && other._state == STATE_INLINE && _state == STATE_NONE) {
+                _EmplaceCopy(other);
+            } else if (TCallable *callable = other.GetAt(index)) {
+                Add(callable->Clone());
+            }
+        }
+
         /**
          * @brief 移除指定索引处的可调用对象
          * @return 如果成功移除则返回true，否则返回false
+         * @throw std::bad_alloc 列表存储被快照共享且复制存储失败时
          */
-        bool RemoveAt(size_t index) noexcept
+        bool RemoveAt(size_t index)
         {
             switch (_state) {
+                case STATE_INLINE:
                 case STATE_SINGLE: {
                     if (index != 0) {
                         return false;
@@ -416,10 +673,10 @@ namespace sw
                     }
                 }
                 case STATE_LIST: {
-                    auto &list = _GetList();
-                    if (index >= list.size()) {
+                    if (index >= _GetList().size()) {
                         return false;
                     }
+                    auto &list = _GetMutableList();
                     list.erase(list.begin() + index);
                     if (list.empty()) {
                         _Reset();
@@ -442,6 +699,9 @@ namespace sw
         TCallable *GetAt(size_t index) const noexcept
         {
             switch (_state) {
+                case STATE_INLINE: {
+                    return index == 0 ? &_GetInline() : nullptr;
+                }
                 case STATE_SINGLE: {
                     return index == 0 ? _GetSingle().get() : nullptr;
                 }
@@ -464,7 +724,131 @@ namespace sw
             return GetAt(index);
         }
 
+        /**
+         * @brief 获取存储多个可调用对象时的只读快照
+         * @return 与列表共享存储的快照，若当前未处于多个可调用对象的状态则返回nullptr
+         * @note 获取快照不会分配内存。持有快照期间对列表的修改会先复制存储，快照内容保持不变，
+         *       因此可以在遍历快照时安全地添加或移除可调用对象
+         */
+        TSnapshot GetSnapshot() const noexcept
+        {
+            return _state == STATE_LIST ? TSnapshot(_GetListPtr()) : TSnapshot();
+        }
+
+        /**
+         * @brief 判断唯一的可调用对象是否内联存储
+         */
+        bool IsInline() const noexcept
+        {
+            return _state == STATE_INLINE;
+        }
+
+        /**
+         * @brief 内联存储的可调用对象的局部副本
+         * @note 内联对象执行时若向所在列表添加其他可调用对象，会被移至堆上并析构，
+         *       调用其局部副本可保证对象在调用返回前始终有效
+         */
+        class InlineCopy
+        {
+        public:
+            /**
+             * @brief 拷贝list中内联存储的可调用对象，list的状态须为STATE_INLINE
+             */
+            explicit InlineCopy(const CallableList &list)
+            {
+                list._ops->copy(_buf, list._GetInline());
+            }
+
+            InlineCopy(const InlineCopy &)            = delete;
+            InlineCopy &operator=(const InlineCopy &) = delete;
+
+            /**
+             * @brief 析构副本
+             */
+            ~InlineCopy()
+            {
+                (*this)->~TCallable();
+            }
+
+            /**
+             * @brief 访问副本
+             */
+            TCallable *operator->() noexcept
+            {
+                return reinterpret_cast<TCallable *>(_buf);
+            }
+
+        private:
+            /**
+             * @brief 存放副本的缓冲区
+             */
+            alignas(void *) uint8_t _buf[_InlineSize];
+        };
+
     private:
+        /**
+         * @brief 内部函数，获取TImpl类型的内联操作表
+         */
+        template <typename TImpl>
+        static const _InlineOps *_GetInlineOps() noexcept
+        {
+            static const _InlineOps ops = {
+                [](void *dst, const TCallable &src) {
+                    new (dst) TImpl(static_cast<const TImpl &>(src));
+                },
+                [](void *dst, TCallable &src) {
+                    new (dst) TImpl(std::move(static_cast<TImpl &>(src)));
+                    static_cast<TImpl &>(src).~TImpl();
+                },
+                [](TCallable &src) -> TCallable * {
+                    return new TImpl(std::move(static_cast<TImpl &>(src)));
+                },
+            };
+            return &ops;
+        }
+
+        /**
+         * @brief 内部函数，Emplace的内联存储实现
+         */
+        template <typename TImpl, typename... TArgs>
+        void _Emplace(std::true_type, TArgs &&...args)
+        {
+            if (_state != STATE_NONE) {
+                Add(new TImpl(std::forward<TArgs>(args)...));
+            } else {
+                new (_inline) TImpl(std::forward<TArgs>(args)...);
+                _ops   = _GetInlineOps<TImpl>();
+                _state = STATE_INLINE;
+            }
+        }
+
+        /**
+         * @brief 内部函数，Emplace的堆存储实现
+         */
+        template <typename TImpl, typename... TArgs>
+        void _Emplace(std::false_type, TArgs &&...args)
+        {
+            Add(new TImpl(std::forward<TArgs>(args)...));
+        }
+
+        /**
+         * @brief 内部函数，当前状态为STATE_NONE且other状态为STATE_INLINE时，拷贝other的内联对象
+         */
+        void _EmplaceCopy(const CallableList &other)
+        {
+            other._ops->copy(_inline, other._GetInline());
+            _ops   = other._ops;
+            _state = STATE_INLINE;
+        }
+
+        /**
+         * @brief 内部函数，当状态为STATE_INLINE时返回内联存储的可调用对象的引用
+         */
+        TCallable &_GetInline() const noexcept
+        {
+            return *reinterpret_cast<TCallable *>(_inline);
+        }
+
         /**
          * @brief 内部函数，当状态为STATE_SINGLE时返回单个可调用对象的引用，
          */
@@ -474,11 +858,31 @@ namespace sw
         }
 
         /**
-         * @brief 内部函数，当状态为STATE_LIST时返回可调用对象列表的引用
+         * @brief 内部函数，当状态为STATE_LIST时返回列表存储智能指针的引用
+         */
+        constexpr TListPtr &_GetListPtr() const noexcept
+        {
+            return *reinterpret_cast<TListPtr *>(_data._list);
+        }
+
+        /**
+         * @brief 内部函数，当状态为STATE_LIST时返回可调用对象列表的只读引用
+         */
+        const TSharedList &_GetList() const noexcept
+        {
+            return *_GetListPtr();
+        }
+
+        /**
+         * @brief 内部函数，当状态为STATE_LIST时返回可修改的可调用对象列表，若存储被快照共享则先复制
          */
-        constexpr TSharedList &_GetList() const noexcept
+        TSharedList &_GetMutableList()
         {
-            return *reinterpret_cast<TSharedList *>(_data._list);
+            auto &ptr = _GetListPtr();
+            if (ptr.use_count() > 1) {
+                ptr = std::make_shared<TSharedList>(*ptr);
+            }
+            return *ptr;
         }
 
         /**
@@ -490,13 +894,18 @@ namespace sw
                 case STATE_NONE: {
                     break;
                 }
+                case STATE_INLINE: {
+                    _GetInline().~TCallable();
+                    _state = STATE_NONE;
+                    break;
+                }
                 case STATE_SINGLE: {
                     _GetSingle().~TSinglePtr();
                     _state = STATE_NONE;
                     break;
                 }
                 case STATE_LIST: {
-                    _GetList().~TSharedList();
+                    _GetListPtr().~TListPtr();
                     _state = STATE_NONE;
                     break;
                 }
@@ -517,7 +926,7 @@ namespace sw
                     break;
                 }
                 case STATE_LIST: {
-                    new (_data._list) TSharedList();
+                    new (_data._list) TListPtr();
                     _state = STATE_LIST;
                     break;
                 }
@@ -630,10 +1039,16 @@ namespace sw
             }
 
         public:
-            // 禁用拷贝/移动：默认实现会按字节拷贝 _storage，不会调用 T 的构造函数，
-            // 对非平凡可拷贝类型会破坏不变式。需要克隆请走 Clone()。
-            _CallableWrapperImpl(const _CallableWrapperImpl &)            = delete;
-            _CallableWrapperImpl(_CallableWrapperImpl &&)                 = delete;
+            // 拷贝/移动构造经由 T 的构造函数完成（默认实现会按字节拷贝 _storage），
+            // 供 CallableList 内联存储时拷贝与搬移使用。赋值没有用途，保持禁用。
+            _CallableWrapperImpl(const _CallableWrapperImpl &other)
+                : _CallableWrapperImpl(other.GetValue())
+            {
+            }
+            _CallableWrapperImpl(_CallableWrapperImpl &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+                : _CallableWrapperImpl(std::move(other.GetValue()))
+            {
+            }
             _CallableWrapperImpl &operator=(const _CallableWrapperImpl &) = delete;
             _CallableWrapperImpl &operator=(_CallableWrapperImpl &&)      = delete;
         };
@@ -677,9 +1092,9 @@ namespace sw
             }
 
         public:
-            // 禁用拷贝/移动：与 _CallableWrapperImpl 保持一致，需要克隆请走 Clone()。
-            _MemberFuncWrapper(const _MemberFuncWrapper &)            = delete;
-            _MemberFuncWrapper(_MemberFuncWrapper &&)                 = delete;
+            // 仅包含指针，拷贝/移动构造可直接使用默认实现；与 _CallableWrapperImpl 保持一致禁用赋值。
+            _MemberFuncWrapper(const _MemberFuncWrapper &)            = default;
+            _MemberFuncWrapper(_MemberFuncWrapper &&)                 = default;
             _MemberFuncWrapper &operator=(const _MemberFuncWrapper &) = delete;
             _MemberFuncWrapper &operator=(_MemberFuncWrapper &&)      = delete;
         };
@@ -720,9 +1135,9 @@ namespace sw
             }
 
         public:
-            // 禁用拷贝/移动：与 _CallableWrapperImpl 保持一致，需要克隆请走 Clone()。
-            _ConstMemberFuncWrapper(const _ConstMemberFuncWrapper &)            = delete;
-            _ConstMemberFuncWrapper(_ConstMemberFuncWrapper &&)                 = delete;
+            // 仅包含指针，拷贝/移动构造可直接使用默认实现；与 _CallableWrapperImpl 保持一致禁用赋值。
+            _ConstMemberFuncWrapper(const _ConstMemberFuncWrapper &)            = default;
+            _ConstMemberFuncWrapper(_ConstMemberFuncWrapper &&)                 = default;
             _ConstMemberFuncWrapper &operator=(const _ConstMemberFuncWrapper &) = delete;
             _ConstMemberFuncWrapper &operator=(_ConstMemberFuncWrapper &&)      = delete;
         };
@@ -790,7 +1205,7 @@ namespace sw
         Delegate(const Delegate &other)
         {
             for (size_t i = 0; i < other._data.Count(); ++i) {
-                _data.Add(other._data[i]->Clone());
+                _data.AddCopy(other._data, i);
             }
         }
 
@@ -814,7 +1229,7 @@ namespace sw
             CallableList<TRet(Args...)> copied;
 
             for (size_t i = 0; i < other._data.Count(); ++i) {
-                copied.Add(other._data[i]->Clone());
+                copied.AddCopy(other._data, i);
             }
             _data = std::move(copied);
             return *this;
@@ -849,7 +1264,7 @@ namespace sw
                 if (delegate._data.IsEmpty()) {
                     return;
                 } else if (delegate._data.Count() == 1) {
-                    _data.Add(delegate._data[0]->Clone());
+                    _data.AddCopy(delegate._data, 0);
                     return;
                 }
             }
@@ -862,7 +1277,7 @@ namespace sw
         void Add(TRet (*func)(Args...))
         {
             if (func != nullptr) {
-                _data.Add(new _CallableWrapper<decltype(func)>(func));
+                _Emplace<_CallableWrapper<decltype(func)>>(func);
             }
         }
 
@@ -873,7 +1288,7 @@ namespace sw
         auto Add(const T &callable)
             -> typename std::enable_if<!std::is_base_of<_ICallable, T>::value, void>::type
         {
-            _data.Add(new _CallableWrapper<T>(callable));
+            _Emplace<_CallableWrapper<T>>(callable);
         }
 
         /**
@@ -882,7 +1297,7 @@ namespace sw
         template <typename T>
         void Add(T &obj, TRet (T::*func)(Args...))
         {
-            _data.Add(new _MemberFuncWrapper<T>(obj, func));
+            _Emplace<_MemberFuncWrapper<T>>(obj, func);
         }
 
         /**
@@ -891,7 +1306,7 @@ namespace sw
         template <typename T>
         void Add(const T &obj, TRet (T::*func)(Args...) const)
         {
-            _data.Add(new _ConstMemberFuncWrapper<T>(obj, func));
+            _Emplace<_ConstMemberFuncWrapper<T>>(obj, func);
         }
 
         /**
@@ -1154,6 +1569,8 @@ namespace sw
          * @return 返回一个包含所有可调用对象返回值的vector
          * @note 多播调用时，前 N-1 次按左值传参，仅最后一次执行 std::forward，
          *       避免对 move-only 类型或右值引用形参反复 move 同一对象。
+         * @note 多播调用遍历调用开始时的快照：调用期间新增的可调用对象不会被调用，
+         *       被移除的可调用对象仍会在本次调用中执行
          */
         template <typename U = TRet>
         auto InvokeAll(Args... args) const
@@ -1164,9 +1581,15 @@ namespace sw
             if (count == 0) {
                 _ThrowEmptyDelegateError();
             } else if (count == 1) {
-                results.emplace_back(_data[0]->Invoke(std::forward<Args>(args)...));
+                if (_data.IsInline()) {
+                    typename CallableList<TRet(Args...)>::InlineCopy callable(_data);
+                    results.emplace_back(callable->Invoke(std::forward<Args>(args)...));
+                } else {
+                    results.emplace_back(_data[0]->Invoke(std::forward<Args>(args)...));
+                }
             } else {
-                auto list = _data;
+                auto snapshot = _data.GetSnapshot();
+                auto &list    = *snapshot;
                 results.reserve(count);
                 for (size_t i = 0; i + 1 < count; ++i) {
                     results.emplace_back(list[i]->Invoke(args...));
@@ -1177,6 +1600,53 @@ namespace sw
         }
 
     private:
+        /**
+         * @brief 判断T能否通过const引用调用
+         */
+        template <typename T, typename = void>
+        struct _IsConstInvocable : std::false_type {
+        };
+
+        template <typename T>
+        struct _IsConstInvocable<
+            T, decltype(void(std::declval<const T &>()(std::declval<Args>()...)))> : std::true_type {
+        };
+
+        /**
+         * @brief 判断包装类型是否可以内联存储在CallableList中
+         * @note 仅内联存储平凡可拷贝且调用时不修改自身的可调用对象（函数指针、非mutable的lambda、成员函数指针），
+         *       调用时直接调用其局部副本，结果与调用原对象相同
+         */
+        template <typename TImpl>
+        struct _IsInlinePayload : std::true_type {
+        };
+
+        template <typename T>
+        struct _IsInlinePayload<_CallableWrapperImpl<T>>
+            : std::integral_constant<bool, std::is_trivially_copyable<T>::value && _IsConstInvocable<T>::value> {
+        };
+
+        /**
+         * @brief 内部函数，构造一个TImpl类型的可调用对象并添加到委托中
+         */
+        template <typename TImpl, typename... TArgs>
+        void _Emplace(TArgs &&...args)
+        {
+            _EmplaceImpl<TImpl>(_IsInlinePayload<TImpl>{}, std::forward<TArgs>(args)...);
+        }
+
+        template <typename TImpl, typename... TArgs>
+        void _EmplaceImpl(std::true_type, TArgs &&...args)
+        {
+            _data.template Emplace<TImpl>(std::forward<TArgs>(args)...);
+        }
+
+        template <typename TImpl, typename... TArgs>
+        void _EmplaceImpl(std::false_type, TArgs &&...args)
+        {
+            _data.Add(new TImpl(std::forward<TArgs>(args)...));
+        }
+
         /**
          * @brief 内部函数，用于从后向前查找并移除一个可调用对象
          */
@@ -1202,6 +1672,7 @@ namespace sw
          * @brief 内部函数，Invoke和operator()的实现
          * @note 多播调用时，前 N-1 次按左值传参，仅最后一次执行 std::forward，
          *       避免对 move-only 类型或右值引用形参反复 move 同一对象。
+         * @note 多播调用遍历写时复制的快照，调用路径上不会分配内存
          */
         inline TRet _InvokeImpl(Args... args) const
         {
@@ -1209,9 +1680,15 @@ namespace sw
             if (count == 0) {
                 _ThrowEmptyDelegateError();
             } else if (count == 1) {
+                if (_data.IsInline()) {
+                    // 调用内联对象的局部副本，处理函数修改当前委托时不会影响正在执行的对象
+                    typename CallableList<TRet(Args...)>::InlineCopy callable(_data);
+                    return callable->Invoke(std::forward<Args>(args)...);
+                }
                 return _data[0]->Invoke(std::forward<Args>(args)...);
             } else {
-                auto list = _data;
+                auto snapshot = _data.GetSnapshot();
+                auto &list    = *snapshot;
                 for (size_t i = 0; i + 1 < count; ++i)
                     list[i]->Invoke(args...);
                 return list[count - 1]->Invoke(std::forward<Args>(args)...);
@@ -1870,6 +2347,34 @@ namespace sw
     };
 }
 
+// IItemSearchIndex.h
+
+
+namespace sw
+{
+    /**
+     * @brief 按显示文本前缀查找子项的索引接口，用于虚拟模式下的组合框等控件
+     */
+    class IItemSearchIndex
+    {
+    public:
+        /**
+         * @brief 默认虚析构函数
+         */
+        virtual ~IItemSearchIndex() = default;
+
+    public:
+        /**
+         * @brief 查找显示文本以指定前缀开头的子项，不区分大小写
+         * @param prefix 要查找的前缀
+         * @param startIndex 从该索引的下一项开始查找，到末尾后从头继续查找至该项，为-1时从头查找整个列表
+         * @return 找到的子项索引，未找到时返回-1
+         * @note 索引应自行跟踪数据源的变化，保证返回的索引与数据源一致
+         */
+        virtual int FindPrefix(const std::wstring &prefix, int startIndex) = 0;
+    };
+}
+
 // IToString.h
 
 
@@ -2624,16 +3129,251 @@ namespace sw
     };
 }
 
-// Path.h
+// LayoutProfiler.h
+
+// 定义SW_DISABLE_LAYOUT_PROFILER可以移除Measure和Arrange中的统计代码
+// #define SW_DISABLE_LAYOUT_PROFILER
 
 
 namespace sw
 {
     /**
-     * @brief 用于处理文件路径的工具类
+     * @brief 布局过程的阶段
      */
-    class Path
-    {
+    enum class LayoutPass {
+        Measure, ///< 测量
+        Arrange, ///< 排列
+    };
+
+    /**
+     * @brief 某个元素或布局对象在布局过程中的统计信息，时间单位为纳秒
+     * @note 包含时间为整个调用的耗时，独占时间为包含时间减去其中嵌套的其他对象的包含时间
+     */
+    struct LayoutProfileRecord {
+        const void *object            = nullptr; ///< 元素或布局对象的地址
+        const void *parent            = nullptr; ///< 最近一次调用时外层对象的地址，最外层对象为nullptr
+        const char *typeName          = "";      ///< 对象的类型名称
+        uint64_t measureCount         = 0;       ///< 实际执行测量的次数
+        uint64_t measureSkipCount     = 0;       ///< 因布局未失效且可用尺寸未变而跳过测量的次数
+        uint64_t arrangeCount         = 0;       ///< 执行排列的次数
+        uint64_t setWindowPosCount    = 0;       ///< 调用SetWindowPos的次数
+        uint64_t deferWindowPosCount  = 0;       ///< 调用DeferWindowPos的次数
+        uint64_t measureInclusiveTime = 0;       ///< 测量的包含时间
+        uint64_t measureExclusiveTime = 0;       ///< 测量的独占时间
+        uint64_t arrangeInclusiveTime = 0;       ///< 排列的包含时间
+        uint64_t arrangeExclusiveTime = 0;       ///< 排列的独占时间
+    };
+
+    /**
+     * @brief 布局过程的统计工具，记录每个元素及布局对象的测量、排列次数与耗时，可导出为JSON树或Chrome Trace格式
+     * @note 每个线程拥有独立的统计数据，默认不启用，启用后只统计当前线程的布局过程
+     * @note 统计数据以对象地址区分，对象销毁后其地址可能被新对象复用，建议在每次统计前调用Reset
+     * @note 定义SW_DISABLE_LAYOUT_PROFILER后布局过程中不再调用任何统计函数，SetEnabled无效
+     */
+    class LayoutProfiler
+    {
+    public:
+        /**
+         * @brief 最多记录的Chrome Trace事件数量，超出后丢弃新事件
+         */
+        static constexpr size_t MaxTraceEventCount = 1000000;
+
+        /**
+         * @brief 记录一次测量或排列调用的范围对象，构造时开始计时，析构时结束计时
+         * @note 统计未启用时构造和析构不做任何操作
+         */
+        class Scope
+        {
+        private:
+            /**
+             * @brief 是否正在计时
+             */
+            bool _active = false;
+
+        public:
+            /**
+             * @brief 开始记录对象的一次测量或排列调用
+             * @param obj 元素或布局对象，以其地址区分不同对象
+             * @param pass 布局阶段
+             */
+            template <typename T>
+            Scope(const T *obj, LayoutPass pass)
+            {
+#if !defined(SW_DISABLE_LAYOUT_PROFILER)
+                if (LayoutProfiler::IsEnabled()) {
+                    _active = LayoutProfiler::_Begin(obj, typeid(*obj), pass);
+                }
+#endif
+            }
+
+            /**
+             * @brief 结束计时
+             */
+            ~Scope()
+            {
+                if (_active) LayoutProfiler::_End();
+            }
+
+            Scope(const Scope &)            = delete;
+            Scope &operator=(const Scope &) = delete;
+        };
+
+    private:
+        /**
+         * @brief 正在进行的调用
+         */
+        struct _Frame {
+            size_t record;      // 在_records中的索引
+            LayoutPass pass;    // 布局阶段
+            uint64_t startTime; // 开始时间
+            uint64_t childTime; // 嵌套调用的包含时间之和
+        };
+
+        /**
+         * @brief Chrome Trace中的一个完整事件
+         */
+        struct _TraceEvent {
+            size_t record;      // 在_records中的索引
+            LayoutPass pass;    // 布局阶段
+            uint64_t startTime; // 开始时间
+            uint64_t duration;  // 持续时间
+        };
+
+        /**
+         * @brief 是否启用统计
+         */
+        bool _enabled = false;
+
+        /**
+         * @brief 是否记录Chrome Trace事件
+         */
+        bool _traceEnabled = false;
+
+        /**
+         * @brief 按首次出现顺序排列的统计记录
+         */
+        std::vector<LayoutProfileRecord> _records;
+
+        /**
+         * @brief 对象地址到_records中索引的映射
+         */
+        std::unordered_map<const void *, size_t> _index;
+
+        /**
+         * @brief 调用栈
+         */
+        std::vector<_Frame> _stack;
+
+        /**
+         * @brief Chrome Trace事件
+         */
+        std::vector<_TraceEvent> _events;
+
+        /**
+         * @brief 因超出MaxTraceEventCount而丢弃的事件数量
+         */
+        size_t _droppedEventCount = 0;
+
+        /**
+         * @brief 计时起点，Chrome Trace中的时间戳相对于该时间
+         */
+        std::chrono::steady_clock::time_point _epoch = std::chrono::steady_clock::now();
+
+    public:
+        /**
+         * @brief 判断当前线程是否启用了统计
+         */
+        static bool IsEnabled() noexcept;
+
+        /**
+         * @brief 启用或禁用当前线程的统计，禁用时保留已有的统计数据
+         * @param enabled 是否启用
+         * @param trace 是否同时记录每次调用的Chrome Trace事件，事件较多时会占用较多内存
+         */
+        static void SetEnabled(bool enabled, bool trace = false);
+
+        /**
+         * @brief 清除当前线程的统计数据
+         * @note 不能在布局过程中调用
+         */
+        static void Reset();
+
+        /**
+         * @brief 记录一次因布局未失效且可用尺寸未变而跳过的测量
+         */
+        static void RecordMeasureSkipped(const void *obj);
+
+        /**
+         * @brief 记录一次SetWindowPos调用
+         */
+        static void RecordSetWindowPos(const void *obj);
+
+        /**
+         * @brief 记录一次DeferWindowPos调用
+         */
+        static void RecordDeferWindowPos(const void *obj);
+
+        /**
+         * @brief 获取当前线程的统计记录，按对象首次出现的顺序排列
+         */
+        static std::vector<LayoutProfileRecord> GetRecords();
+
+        /**
+         * @brief 将当前线程的统计记录按调用关系导出为JSON树
+         * @return UTF-8编码的JSON字符串
+         */
+        static std::string ToJson();
+
+        /**
+         * @brief 将当前线程记录的事件导出为Chrome Trace格式，可在chrome://tracing或Perfetto中打开
+         * @return UTF-8编码的JSON字符串，SetEnabled时未启用trace则事件列表为空
+         */
+        static std::string ToChromeTrace();
+
+    private:
+        /**
+         * @brief 获取当前线程的实例
+         */
+        static LayoutProfiler &_GetInstance() noexcept;
+
+        /**
+         * @brief 获取当前时间
+         */
+        uint64_t _Now() const noexcept;
+
+        /**
+         * @brief 获取对象对应的记录，若不存在则创建
+         */
+        LayoutProfileRecord &_GetRecord(const void *obj);
+
+        /**
+         * @brief 开始记录一次调用，由Scope调用
+         * @return 是否已入栈，入栈后需调用_End
+         */
+        static bool _Begin(const void *obj, const std::type_info &type, LayoutPass pass);
+
+        /**
+         * @brief 结束最近一次开始的调用，由Scope调用
+         */
+        static void _End() noexcept;
+
+        /**
+         * @brief 将索引为index的记录及其子记录写入JSON
+         */
+        void _WriteJsonNode(std::string &out, size_t index, const std::vector<std::vector<size_t>> &children) const;
+    };
+}
+
+// Path.h
+
+
+namespace sw
+{
+    /**
+     * @brief 用于处理文件路径的工具类
+     */
+    class Path
+    {
     private:
         /**
          * @brief 静态类，禁止实例化
@@ -2740,6 +3480,90 @@ namespace sw
     };
 }
 
+// ScratchBuffer.h
+
+
+namespace sw
+{
+    /**
+     * @brief 线程内可复用的临时数组，用于遍历元素树等需要临时栈的场景
+     * @note 构造时从当前线程的缓冲池取出一个数组，析构时清空并放回，数组已分配的容量会保留到下次使用，
+     *       因此反复执行的遍历在稳定后不会再进行堆分配
+     * @note 遍历过程中的回调再次进入时会从池中取出另一个数组，不会与外层共用同一数组
+     */
+    template <typename T>
+    class ScratchBuffer
+    {
+    private:
+        /**
+         * @brief 当前线程中空闲的数组
+         */
+        using _Pool = std::vector<std::unique_ptr<std::vector<T>>>;
+
+        /**
+         * @brief 当前使用的数组
+         */
+        std::unique_ptr<std::vector<T>> _buffer;
+
+    public:
+        /**
+         * @brief 从当前线程的缓冲池取出一个空数组
+         */
+        ScratchBuffer()
+        {
+            _Pool &pool = _GetPool();
+            if (pool.empty()) {
+                _buffer.reset(new std::vector<T>);
+            } else {
+                _buffer = std::move(pool.back());
+                pool.pop_back();
+            }
+        }
+
+        /**
+         * @brief 清空数组并放回当前线程的缓冲池
+         */
+        ~ScratchBuffer()
+        {
+            _buffer->clear();
+            try {
+                _GetPool().push_back(std::move(_buffer));
+            } catch (...) {
+                // 放回失败时直接释放数组
+            }
+        }
+
+        ScratchBuffer(const ScratchBuffer &)            = delete;
+        ScratchBuffer &operator=(const ScratchBuffer &) = delete;
+
+        /**
+         * @brief 获取数组
+         */
+        std::vector<T> &operator*() noexcept
+        {
+            return *_buffer;
+        }
+
+        /**
+         * @brief 访问数组的成员
+         */
+        std::vector<T> *operator->() noexcept
+        {
+            return _buffer.get();
+        }
+
+    private:
+        /**
+         * @brief 获取当前线程的缓冲池
+         */
+        static _Pool &_GetPool()
+        {
+            static thread_local _Pool pool;
+            return pool;
+        }
+    };
+}
+
 // ScrollEnums.h
 
 
@@ -2775,6 +3599,95 @@ namespace sw
     };
 }
 
+// WndBaseTable.h
+
+
+namespace sw
+{
+    class WndBase; // WndBase.h
+
+    /**
+     * @brief 窗口句柄到WndBase对象的映射表，使用开放寻址（线性探测）实现，框架内部使用
+     * @note WndBase为每个线程维护一个表，只记录当前线程创建的窗口，表中没有的句柄回退到窗口属性查找；
+     *       该表只能由WndBase访问，不通过SimpleWindow.h导出
+     * @note 表只保存指针，不检查指针的有效性，窗口销毁时应及时移除对应项
+     */
+    class WndBaseTable
+    {
+        friend class WndBase;
+
+    public:
+        /**
+         * @brief 初始容量
+         */
+        static constexpr size_t InitialCapacity = 16;
+
+    private:
+        /**
+         * @brief 表项，句柄为NULL表示空位
+         */
+        struct _Slot {
+            HWND hwnd    = NULL;
+            WndBase *wnd = nullptr;
+        };
+
+        /**
+         * @brief 表项数组，长度为0或2的幂
+         */
+        std::vector<_Slot> _slots;
+
+        /**
+         * @brief 已使用的表项数量
+         */
+        size_t _count = 0;
+
+    public:
+        /**
+         * @brief 查找窗口句柄对应的对象
+         * @return 对象指针，若表中没有该句柄则返回nullptr
+         */
+        WndBase *Find(HWND hwnd) const noexcept;
+
+        /**
+         * @brief 记录窗口句柄对应的对象，若已存在则替换
+         * @note hwnd为NULL时不做任何操作
+         */
+        void Set(HWND hwnd, WndBase *wnd);
+
+        /**
+         * @brief 移除窗口句柄对应的项
+         */
+        void Remove(HWND hwnd) noexcept;
+
+        /**
+         * @brief 获取表中记录的窗口数量
+         */
+        size_t GetCount() const noexcept;
+
+    private:
+        /**
+         * @brief 获取WndBase使用的当前线程的表
+         */
+        static WndBaseTable &_GetCurrent() noexcept;
+
+        /**
+         * @brief 计算句柄的哈希值
+         */
+        static size_t _Hash(HWND hwnd) noexcept;
+
+        /**
+         * @brief 查找句柄所在的位置，若不存在则返回探测到的第一个空位
+         * @note 调用前需保证_slots不为空
+         */
+        size_t _Probe(HWND hwnd) const noexcept;
+
+        /**
+         * @brief 以指定容量重建表
+         */
+        void _Rehash(size_t capacity);
+    };
+}
+
 // WndMsg.h
 
 
@@ -2787,7 +3700,7 @@ namespace sw
         /// SimpleWindow所用消息的起始位置
         WM_SimpleWindowBegin = WM_APP + 0x3000,
 
-        /// 控件布局发生变化时控件所在顶级窗口将收到该消息，wParam和lParam均未使用
+        /// 控件布局发生变化时控件所在顶级窗口将收到该消息，wParam表示是否为InvalidateMeasure延迟投递的消息，lParam未使用
         WM_UpdateLayout,
 
         /// 在窗口线程上执行指定委托，lParam为指向sw::Action<>的指针，wParam表示是否对委托指针执行delete
@@ -2796,6 +3709,9 @@ namespace sw
         /// 在WndBase::SetParent函数中设置父窗口之前发送该消息，wParam为新的父窗口句柄，lParam未使用
         WM_PreSetParent,
 
+        /// 调度器有待执行的任务时其消息窗口将收到该消息，wParam和lParam未使用
+        WM_DispatcherWake,
+
         /// SimpleWindow所用消息的结束位置
         WM_SimpleWindowEnd,
     };
@@ -2875,6 +3791,178 @@ namespace sw
         "Color should be a POD type.");
 }
 
+// DispatcherQueue.h
+
+
+namespace sw
+{
+    /**
+     * @brief 调度器中任务的优先级，数值越小优先级越高
+     */
+    enum class DispatcherPriority {
+        Input,      ///< 响应输入的任务
+        Render,     ///< 更新界面的任务
+        Background, ///< 后台任务
+    };
+
+    /**
+     * @brief 调度队列的统计信息，时间单位为纳秒
+     */
+    struct DispatcherQueueMetrics {
+        size_t depth            = 0; ///< 当前等待执行的任务数量，包括将被合并的任务
+        size_t maxDepth         = 0; ///< 等待执行的任务数量的最大值
+        uint64_t enqueuedCount  = 0; ///< 入队的任务数量
+        uint64_t executedCount  = 0; ///< 已执行的任务数量
+        uint64_t coalescedCount = 0; ///< 因同一键值有更新的任务而被丢弃的任务数量
+        uint64_t batchCount     = 0; ///< 调用Drain的次数
+        uint64_t totalLatency   = 0; ///< 已执行任务从入队到开始执行的时间之和
+        uint64_t maxLatency     = 0; ///< 已执行任务从入队到开始执行的最长时间
+    };
+
+    /**
+     * @brief 多生产者单消费者的任务队列，任意线程可以无锁地添加任务，由单个线程批量执行
+     * @note 每个优先级使用一个无锁链表，Drain按优先级从高到低执行，同一优先级内按入队顺序执行
+     * @note 键值不为0的任务在执行前若有相同优先级、相同键值的任务入队，则只执行最后入队的任务。
+     *       键值按优先级分别合并，不同优先级的任务执行顺序与入队顺序无关，因此同一键值应始终使用同一优先级，
+     *       否则先入队的高优先级任务可能先于后入队的低优先级任务执行，反之亦然
+     */
+    class DispatcherQueue
+    {
+    private:
+        /**
+         * @brief 优先级的数量
+         */
+        static constexpr int _PriorityCount = 3;
+
+        /**
+         * @brief 链表节点
+         */
+        struct _Node {
+            std::atomic<_Node *> next{nullptr}; // 下一节点
+            Action<> action;                    // 任务
+            uint64_t key         = 0;           // 合并任务的键值，0表示不合并
+            uint64_t enqueueTime = 0;           // 入队时间
+            bool superseded      = false;       // 是否已被相同键值的任务取代
+        };
+
+        /**
+         * @brief 一个优先级的任务链表，生产者在head处添加，消费者从tail处取出
+         */
+        struct _Level {
+            std::atomic<_Node *> head; // 最后入队的节点
+            _Node *tail;               // 下一个要取出的节点，仅由消费者访问
+            _Node stub;                // 哨兵节点
+            std::deque<_Node *> taken; // 已取出尚未执行的节点，仅由消费者访问
+
+            std::unordered_map<uint64_t, _Node *> pendingKeys; // taken中每个键值最后入队的节点，仅由消费者访问
+
+            _Level() : head(&stub), tail(&stub) {}
+        };
+
+        /**
+         * @brief 各优先级的任务链表
+         */
+        _Level _levels[_PriorityCount];
+
+        /**
+         * @brief 是否已请求消费者执行任务
+         */
+        std::atomic<bool> _wakeRequested{false};
+
+        /**
+         * @brief 计时起点
+         */
+        const std::chrono::steady_clock::time_point _epoch = std::chrono::steady_clock::now();
+
+        /**
+         * @brief 统计信息，生产者更新的计数使用原子操作
+         */
+        std::atomic<size_t> _depth{0};
+        std::atomic<size_t> _maxDepth{0};
+        std::atomic<uint64_t> _enqueuedCount{0};
+        uint64_t _executedCount  = 0;
+        uint64_t _coalescedCount = 0;
+        uint64_t _batchCount     = 0;
+        uint64_t _totalLatency   = 0;
+        uint64_t _maxLatency     = 0;
+
+    public:
+        /**
+         * @brief 创建空队列
+         */
+        DispatcherQueue() = default;
+
+        /**
+         * @brief 释放未执行的任务
+         */
+        ~DispatcherQueue();
+
+        DispatcherQueue(const DispatcherQueue &)            = delete;
+        DispatcherQueue &operator=(const DispatcherQueue &) = delete;
+
+        /**
+         * @brief 添加任务，可在任意线程调用
+         * @param action 要执行的任务
+         * @param priority 优先级
+         * @param key 合并任务的键值，不为0时同一优先级中相同键值的任务在执行前只保留最后一个
+         * @return 若调用者需要唤醒消费者执行Drain则返回true，否则表示已有唤醒请求尚未处理
+         */
+        bool Enqueue(const Action<> &action, DispatcherPriority priority, uint64_t key = 0);
+
+        /**
+         * @brief 撤销唤醒请求，使下次Enqueue重新返回true，用于唤醒消费者失败时
+         */
+        void CancelWakeRequest() noexcept;
+
+        /**
+         * @brief 执行任务，只能由消费者线程调用
+         * @note 每个优先级在开始执行时取出已入队的全部任务作为一批，此后入队的同一优先级的任务留到下次调用
+         * @param shouldYield 开始执行Render和Background优先级的每个任务前调用，返回true时停止执行，
+         *                    剩余任务保留到下次调用，为空时执行全部任务
+         * @return 是否仍有未执行的任务，返回true时调用者应安排再次调用Drain
+         */
+        bool Drain(const Func<bool> &shouldYield = nullptr);
+
+        /**
+         * @brief 获取统计信息，只能由消费者线程调用
+         */
+        DispatcherQueueMetrics GetMetrics() const;
+
+        /**
+         * @brief 清除除depth以外的统计信息，只能由消费者线程调用
+         */
+        void ResetMetrics();
+
+    private:
+        /**
+         * @brief 获取当前时间
+         */
+        uint64_t _Now() const noexcept;
+
+        /**
+         * @brief 将节点添加到链表
+         */
+        static void _Push(_Level &level, _Node *node) noexcept;
+
+        /**
+         * @brief 从链表取出一个节点
+         * @return 取出的节点，链表为空或有生产者尚未完成添加时返回nullptr
+         */
+        static _Node *_Pop(_Level &level) noexcept;
+
+        /**
+         * @brief 将链表中的节点全部移动到taken中，并标记被相同键值的任务取代的节点
+         */
+        void _Take(_Level &level);
+
+        /**
+         * @brief 执行taken中的节点
+         * @return 是否因shouldYield返回true而停止
+         */
+        bool _Run(_Level &level, const Func<bool> *shouldYield);
+    };
+}
+
 // Event.h
 
 
@@ -3172,6 +4260,108 @@ namespace sw
     using EventHandler = Delegate<void(TSender &, TEventArgs &)>;
 }
 
+// FontCache.h
+
+
+namespace sw
+{
+    /**
+     * @brief 字体缓存的统计信息
+     */
+    struct FontCacheStatistics {
+        uint64_t hitCount  = 0; ///< 获取字体句柄时命中缓存的次数
+        uint64_t missCount = 0; ///< 获取字体句柄时新建句柄的次数
+        int handleCount    = 0; ///< 当前缓存的字体句柄数量
+        int referenceCount = 0; ///< 当前所有字体句柄的引用计数之和
+    };
+
+    /**
+     * @brief 进程内共享的字体句柄缓存，相同LOGFONTW的字体共用同一个HFONT
+     * @note 句柄带有引用计数，通过Acquire获取的句柄在不再使用时须调用Release，引用计数归零时句柄被销毁
+     * @note 可在多个线程中使用
+     */
+    class FontCache
+    {
+    private:
+        /**
+         * @brief 计算LOGFONTW哈希值的函数对象
+         */
+        struct _LogFontHash {
+            size_t operator()(const LOGFONTW &logFont) const noexcept;
+        };
+
+        /**
+         * @brief 比较LOGFONTW是否相等的函数对象
+         */
+        struct _LogFontEqual {
+            bool operator()(const LOGFONTW &a, const LOGFONTW &b) const noexcept;
+        };
+
+        /**
+         * @brief 缓存的字体句柄信息
+         */
+        struct _HandleInfo {
+            LOGFONTW logFont; ///< 创建句柄时使用的LOGFONTW
+            int refCount;     ///< 引用计数
+        };
+
+        /**
+         * @brief 保护缓存数据的互斥量
+         */
+        std::mutex _mutex;
+
+        /**
+         * @brief LOGFONTW到字体句柄的映射
+         */
+        std::unordered_map<LOGFONTW, HFONT, _LogFontHash, _LogFontEqual> _handles;
+
+        /**
+         * @brief 字体句柄到其信息的映射
+         */
+        std::unordered_map<HFONT, _HandleInfo> _handleInfos;
+
+        /**
+         * @brief 统计信息
+         */
+        FontCacheStatistics _statistics;
+
+    public:
+        /**
+         * @brief 获取与指定LOGFONTW对应的字体句柄，并增加其引用计数
+         * @return 字体句柄，创建失败时返回NULL
+         */
+        static HFONT Acquire(const LOGFONTW &logFont);
+
+        /**
+         * @brief 获取与指定字体对应的字体句柄，并增加其引用计数
+         * @return 字体句柄，创建失败时返回NULL
+         */
+        static HFONT Acquire(const Font &font);
+
+        /**
+         * @brief 减少通过Acquire获取的字体句柄的引用计数，引用计数归零时销毁该句柄
+         * @note hfont为NULL或不是由缓存创建的句柄时不做任何操作
+         */
+        static void Release(HFONT hfont);
+
+        /**
+         * @brief 获取缓存的统计信息
+         */
+        static FontCacheStatistics GetStatistics();
+
+    private:
+        /**
+         * @brief 默认构造函数
+         */
+        FontCache() = default;
+
+        /**
+         * @brief 获取进程内唯一的缓存对象
+         */
+        static FontCache &_GetInstance();
+    };
+}
+
 // ITag.h
 
 
@@ -3248,6 +4438,184 @@ namespace sw
     };
 }
 
+// IdleScheduler.h
+
+
+namespace sw
+{
+    /**
+     * @brief 空闲任务的统计信息，时间单位为纳秒
+     */
+    struct IdleTaskStatistics {
+        int id              = 0; ///< 任务id
+        std::wstring name;       ///< 任务名称
+        uint64_t callCount  = 0; ///< 调用次数
+        uint64_t totalTime  = 0; ///< 调用耗时之和
+        uint64_t maxTime    = 0; ///< 单次调用的最长耗时
+    };
+
+    /**
+     * @brief 空闲任务调度器，在消息队列为空时按时间预算轮流调用已注册的任务
+     * @note 任务返回true表示仍有工作，返回false表示暂时没有工作，此后不再调用直到Reset
+     * @note 不是线程安全的，只能在同一线程中使用
+     */
+    class IdleScheduler
+    {
+    private:
+        /**
+         * @brief 已注册的任务
+         */
+        struct _Task {
+            Func<bool> task;               // 任务
+            bool hasWork = true;           // 是否仍有工作
+            bool removed = false;          // 是否已在Run执行期间被移除
+            IdleTaskStatistics statistics; // 统计信息
+        };
+
+        /**
+         * @brief 已注册的任务，按注册顺序排列
+         */
+        std::vector<std::unique_ptr<_Task>> _tasks;
+
+        /**
+         * @brief 下次Run从该索引开始调用
+         */
+        size_t _cursor = 0;
+
+        /**
+         * @brief 下一个任务id
+         */
+        int _nextId = 1;
+
+        /**
+         * @brief 是否正在执行Run
+         */
+        bool _isRunning = false;
+
+        /**
+         * @brief Run执行期间是否有任务被移除
+         */
+        bool _hasRemoved = false;
+
+    public:
+        /**
+         * @brief 注册任务
+         * @param name 任务名称，用于统计信息
+         * @param task 任务，返回是否仍有工作，每次调用应只处理一小部分工作
+         * @return 任务id，用于移除任务
+         */
+        int Add(const std::wstring &name, const Func<bool> &task);
+
+        /**
+         * @brief 移除任务，可在任务中调用
+         * @return 是否找到并移除了任务
+         */
+        bool Remove(int id);
+
+        /**
+         * @brief 判断是否有已注册的任务
+         */
+        bool IsEmpty() const noexcept;
+
+        /**
+         * @brief 将所有任务标记为有工作，通常在处理消息后调用
+         */
+        void Reset() noexcept;
+
+        /**
+         * @brief 轮流调用有工作的任务，直到没有任务有工作、超出时间预算或shouldYield返回true
+         * @note 为保证任务总能推进，每次调用至少执行一个有工作的任务，之后才检查预算与shouldYield
+         * @note 下次调用从上次最后执行的任务的下一个开始，避免靠前的任务占满预算
+         * @param budget 时间预算
+         * @param shouldYield 每执行一个任务后调用，返回true时停止执行，为空时只检查时间预算
+         * @return 是否仍有任务有工作
+         */
+        bool Run(std::chrono::nanoseconds budget, const Func<bool> &shouldYield = nullptr);
+
+        /**
+         * @brief 获取各任务的统计信息，按注册顺序排列
+         */
+        std::vector<IdleTaskStatistics> GetStatistics() const;
+
+        /**
+         * @brief 清除各任务的统计信息
+         */
+        void ResetStatistics() noexcept;
+
+    private:
+        /**
+         * @brief 删除Run执行期间被移除的任务
+         */
+        void _RemovePending();
+    };
+}
+
+// IncrementalItemSearch.h
+
+
+namespace sw
+{
+    /**
+     * @brief 按输入的字符增量查找子项，用于虚拟模式下的组合框等控件
+     * @note 不依赖窗口，查找由调用者提供的函数完成，例如IItemSearchIndex::FindPrefix
+     */
+    class IncrementalItemSearch
+    {
+    private:
+        /**
+         * @brief 已输入的文本
+         */
+        std::wstring _text;
+
+        /**
+         * @brief 最近一次输入的时间，单位为毫秒
+         */
+        uint32_t _lastTime = 0;
+
+        /**
+         * @brief 两次输入的最大间隔，超过后重新开始查找，单位为毫秒
+         */
+        uint32_t _timeout;
+
+    public:
+        /**
+         * @brief 初始化增量查找
+         * @param timeout 两次输入的最大间隔，单位为毫秒
+         */
+        explicit IncrementalItemSearch(uint32_t timeout = 1000);
+
+        /**
+         * @brief 处理输入的字符
+         * @param ch 输入的字符
+         * @param time 输入的时间，单位为毫秒，例如GetTickCount的返回值
+         * @param currentIndex 当前选中的子项索引，没有选中项时为-1
+         * @param findPrefix 查找函数，参数为前缀与startIndex，含义与IItemSearchIndex::FindPrefix相同
+         * @return 应选中的子项索引，未找到时返回-1
+         * @note 重复输入同一字符时依次查找以该字符开头的下一项，否则当前项仍然匹配时保持不变
+         */
+        int Input(wchar_t ch, uint32_t time, int currentIndex, const Func<const std::wstring &, int, int> &findPrefix);
+
+        /**
+         * @brief 清除已输入的文本
+         */
+        void Reset() noexcept;
+
+        /**
+         * @brief 获取已输入的文本
+         */
+        const std::wstring &GetText() const noexcept;
+
+        /**
+         * @brief 在count个子项中从startIndex的下一项开始循环查找第一个满足条件的子项
+         * @param count 子项数量
+         * @param startIndex 从该索引的下一项开始查找，到末尾后从头继续查找至该项，为-1或超出范围时从头查找整个列表
+         * @param match 判断指定索引处的子项是否满足条件
+         * @return 找到的子项索引，未找到时返回-1
+         */
+        static int FindNext(int count, int startIndex, const Func<int, bool> &match);
+    };
+}
+
 // Keys.h
 
 
@@ -5795,12 +7163,46 @@ namespace sw
          */
         static const Property<AppQuitMode> QuitMode;
 
+        /**
+         * @brief 当前线程消息循环每次执行空闲任务的时间预算，单位为毫秒，默认为8
+         * @note 该属性是线程局部的，每个线程有各自独立的值
+         */
+        static const Property<int> IdleBudget;
+
         /**
          * @brief 消息循环
          * @return 退出代码
+         * @note 进入消息循环前会创建当前线程的调度器，见Dispatcher::GetCurrent
+         * @note 每处理一条消息后调用Binding::FlushDeferredUpdates更新延迟绑定
+         * @note 消息队列为空时在IdleBudget内执行当前线程的空闲任务，有输入消息到达时立即停止
          */
         static int MsgLoop();
 
+        /**
+         * @brief 为当前线程的消息循环注册空闲任务
+         * @param name 任务名称，用于统计信息
+         * @param task 任务，每次调用应只处理一小部分工作，返回是否仍有工作，
+         *             返回false后在消息循环处理下一条消息前不再调用
+         * @return 任务id，用于移除任务
+         */
+        static int AddIdleTask(const std::wstring &name, const Func<bool> &task);
+
+        /**
+         * @brief 移除当前线程的空闲任务，可在空闲任务中调用
+         * @return 是否找到并移除了任务
+         */
+        static bool RemoveIdleTask(int id);
+
+        /**
+         * @brief 获取当前线程各空闲任务的调用次数与耗时
+         */
+        static std::vector<IdleTaskStatistics> GetIdleTaskStatistics();
+
+        /**
+         * @brief 清除当前线程各空闲任务的统计信息
+         */
+        static void ResetIdleTaskStatistics();
+
         /**
          * @brief 退出当前线程的消息循环
          * @param exitCode 退出代码
@@ -5984,6 +7386,130 @@ namespace sw
     };
 }
 
+// Dispatcher.h
+
+
+namespace sw
+{
+    /**
+     * @brief 线程的任务调度器，其他线程可以向其添加任务，任务在调度器所属线程的消息循环中批量执行
+     * @note 任务保存在DispatcherQueue中，同一时刻最多只有一条唤醒消息在消息队列中，不会因任务过多而占满消息队列
+     * @note 执行Render和Background优先级的任务时若有输入消息等待处理或超出时间预算则暂停，剩余任务通过计时器继续执行
+     */
+    class Dispatcher
+    {
+    private:
+        /**
+         * @brief 继续执行剩余任务的计时器id
+         */
+        static constexpr UINT_PTR _ContinueTimerId = 1;
+
+        /**
+         * @brief 每次执行Render和Background优先级任务的时间预算，单位为毫秒
+         */
+        static constexpr int _DrainBudgetMs = 8;
+
+        /**
+         * @brief 任务队列
+         */
+        DispatcherQueue _queue;
+
+        /**
+         * @brief 所属线程的id
+         */
+        DWORD _threadId;
+
+        /**
+         * @brief 接收唤醒消息的消息窗口
+         */
+        HWND _hwnd;
+
+        /**
+         * @brief 所属线程是否已退出
+         */
+        std::atomic<bool> _isShutdown{false};
+
+        /**
+         * @brief 是否已设置继续执行的计时器
+         */
+        bool _isTimerSet = false;
+
+    private:
+        /**
+         * @brief 为当前线程创建调度器
+         */
+        Dispatcher();
+
+    public:
+        /**
+         * @brief 释放未执行的任务
+         * @note 消息窗口在所属线程退出时销毁，最后一个引用可能由其他线程释放
+         */
+        ~Dispatcher();
+
+        Dispatcher(const Dispatcher &)            = delete;
+        Dispatcher &operator=(const Dispatcher &) = delete;
+
+        /**
+         * @brief 获取当前线程的调度器，不存在时创建
+         */
+        static std::shared_ptr<Dispatcher> GetCurrent();
+
+        /**
+         * @brief 获取指定线程的调度器，可在任意线程调用
+         * @return 指定线程的调度器，若该线程未创建调度器则返回nullptr
+         */
+        static std::shared_ptr<Dispatcher> FromThread(DWORD threadId);
+
+        /**
+         * @brief 获取调度器所属线程的id
+         */
+        DWORD GetThreadId() const noexcept;
+
+        /**
+         * @brief 判断当前线程是否为调度器所属线程
+         */
+        bool CheckAccess() const noexcept;
+
+        /**
+         * @brief 添加任务并立即返回，可在任意线程调用
+         * @param action 要执行的任务
+         * @param priority 优先级
+         * @param key 合并任务的键值，不为0时同一优先级中相同键值的任务在执行前只执行最后添加的一个，同一键值应始终使用同一优先级
+         * @return 若成功添加任务并已唤醒调度器所属线程则返回true；action为空或调度器所属线程已退出时返回false，任务不会执行；
+         *         唤醒消息投递失败（例如消息队列已满）时也返回false，此时任务已添加，将在之后任意一次成功的唤醒时执行，
+         *         调用者不应重复添加不带键值的任务
+         */
+        bool BeginInvoke(const Action<> &action, DispatcherPriority priority = DispatcherPriority::Render, uint64_t key = 0);
+
+        /**
+         * @brief 获取任务队列的统计信息，只能在调度器所属线程调用
+         */
+        DispatcherQueueMetrics GetMetrics() const;
+
+        /**
+         * @brief 清除任务队列的统计信息，只能在调度器所属线程调用
+         */
+        void ResetMetrics();
+
+    private:
+        /**
+         * @brief 处理唤醒消息与计时器消息，执行任务
+         */
+        void _OnWake();
+
+        /**
+         * @brief 线程退出时调用，销毁消息窗口
+         */
+        void _Shutdown();
+
+        /**
+         * @brief 消息窗口的窗口过程
+         */
+        static LRESULT CALLBACK _WndProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+    };
+}
+
 // FolderDialog.h
 
 
@@ -6542,6 +8068,58 @@ namespace sw
     template <typename T, typename = void>
     class BoxedObject;
 
+    class ObservableObject;         // ObservableObject.h
+    class INotifyPropertyChanged;   // INotifyPropertyChanged.h
+    class INotifyObjectDead;        // INotifyObjectDead.h
+    class INotifyCollectionChanged; // INotifyCollectionChanged.h
+    class IList;                    // IList.h
+
+    /**
+     * @brief 可通过DynamicObject::QueryInterface查询的常用类型
+     */
+    enum class InterfaceId {
+        None,                     ///< 不支持查询的类型
+        ObservableObject,         ///< ObservableObject
+        INotifyPropertyChanged,   ///< INotifyPropertyChanged
+        INotifyObjectDead,        ///< INotifyObjectDead
+        INotifyCollectionChanged, ///< INotifyCollectionChanged
+        IList,                    ///< IList
+    };
+
+    /**
+     * @brief 获取类型对应的InterfaceId，不支持查询的类型为InterfaceId::None
+     */
+    template <typename T>
+    struct _InterfaceIdOf : std::integral_constant<InterfaceId, InterfaceId::None> {
+    };
+
+    /**
+     * @brief _InterfaceIdOf偏特化版本，忽略const修饰
+     */
+    template <typename T>
+    struct _InterfaceIdOf<const T> : _InterfaceIdOf<T> {
+    };
+
+    template <>
+    struct _InterfaceIdOf<ObservableObject> : std::integral_constant<InterfaceId, InterfaceId::ObservableObject> {
+    };
+
+    template <>
+    struct _InterfaceIdOf<INotifyPropertyChanged> : std::integral_constant<InterfaceId, InterfaceId::INotifyPropertyChanged> {
+    };
+
+    template <>
+    struct _InterfaceIdOf<INotifyObjectDead> : std::integral_constant<InterfaceId, InterfaceId::INotifyObjectDead> {
+    };
+
+    template <>
+    struct _InterfaceIdOf<INotifyCollectionChanged> : std::integral_constant<InterfaceId, InterfaceId::INotifyCollectionChanged> {
+    };
+
+    template <>
+    struct _InterfaceIdOf<IList> : std::integral_constant<InterfaceId, InterfaceId::IList> {
+    };
+
     /**
      * @brief 动态对象基类
      */
@@ -6631,9 +8209,9 @@ namespace sw
             throw std::runtime_error("Reflection is disabled, cannot check type.");
 #else
             if (pout == nullptr) {
-                return dynamic_cast<T *>(this) != nullptr;
+                return _CastPtr<T>() != nullptr;
             } else {
-                *pout = dynamic_cast<T *>(this);
+                *pout = _CastPtr<T>();
                 return *pout != nullptr;
             }
 #endif
@@ -6653,9 +8231,9 @@ namespace sw
             throw std::runtime_error("Reflection is disabled, cannot check type.");
 #else
             if (pout == nullptr) {
-                return dynamic_cast<const T *>(this) != nullptr;
+                return _CastPtr<T>() != nullptr;
             } else {
-                *pout = dynamic_cast<const T *>(this);
+                *pout = _CastPtr<T>();
                 return *pout != nullptr;
             }
 #endif
@@ -6674,7 +8252,7 @@ namespace sw
 #if defined(SW_DISABLE_REFLECTION)
             throw std::runtime_error("Reflection is disabled, cannot perform dynamic cast.");
 #else
-            return dynamic_cast<T &>(*this);
+            return _CastRef<T>();
 #endif
         }
 
@@ -6691,7 +8269,7 @@ namespace sw
 #if defined(SW_DISABLE_REFLECTION)
             throw std::runtime_error("Reflection is disabled, cannot perform dynamic cast.");
 #else
-            return dynamic_cast<const T &>(*this);
+            return _CastRef<T>();
 #endif
         }
 
@@ -6851,28 +8429,91 @@ namespace sw
          * @note 若目标类型与当前类型不兼容，则行为未定义
          */
         template <typename T>
-        auto UnsafeCast()
-            -> typename std::enable_if<!std::is_base_of<DynamicObject, T>::value && !_IsStaticCastable<DynamicObject *, T *>::value, T &>::type;
+        auto UnsafeCast()
+            -> typename std::enable_if<!std::is_base_of<DynamicObject, T>::value && !_IsStaticCastable<DynamicObject *, T *>::value, T &>::type;
+
+        /**
+         * @brief 将对象不安全地转换为指定类型的引用
+         * @tparam T 目标类型
+         * @return 指定类型的引用
+         * @note 若目标类型与当前类型不兼容，则行为未定义
+         */
+        template <typename T>
+        auto UnsafeCast() const
+            -> typename std::enable_if<!std::is_base_of<DynamicObject, T>::value && _IsStaticCastable<DynamicObject *, T *>::value, const T &>::type;
+
+        /**
+         * @brief 将对象不安全地转换为指定类型的引用
+         * @tparam T 目标类型
+         * @return 指定类型的引用
+         * @note 若目标类型与当前类型不兼容，则行为未定义
+         */
+        template <typename T>
+        auto UnsafeCast() const
+            -> typename std::enable_if<!std::is_base_of<DynamicObject, T>::value && !_IsStaticCastable<DynamicObject *, T *>::value, const T &>::type;
+
+    protected:
+        /**
+         * @brief 查询对象实现的常用类型，用于代替dynamic_cast进行类型判断和转换
+         * @param id 要查询的类型
+         * @return 指向对应类型子对象的指针，若不支持查询该类型则返回nullptr
+         * @note 返回nullptr不代表对象一定不是该类型，IsType与DynamicCast此时会回退到dynamic_cast，
+         *       因此派生类可以只登记部分类型，重写时对未处理的类型应调用基类实现
+         */
+        virtual void *QueryInterface(InterfaceId id) noexcept
+        {
+            (void)id;
+            return nullptr;
+        }
+
+    private:
+        /**
+         * @brief 将当前对象转换为指定类型的指针，优先通过QueryInterface查询
+         * @return 转换后的指针，若对象不是该类型则返回nullptr
+         */
+        template <typename T>
+        T *_CastPtr() noexcept
+        {
+            if (_InterfaceIdOf<T>::value != InterfaceId::None) {
+                void *p = QueryInterface(_InterfaceIdOf<T>::value);
+                if (p != nullptr) return static_cast<T *>(p);
+            }
+            return dynamic_cast<T *>(this);
+        }
+
+        /**
+         * @brief 将当前对象转换为指定类型的常量指针，优先通过QueryInterface查询
+         * @return 转换后的指针，若对象不是该类型则返回nullptr
+         */
+        template <typename T>
+        const T *_CastPtr() const noexcept
+        {
+            return const_cast<DynamicObject *>(this)->_CastPtr<T>();
+        }
 
         /**
-         * @brief 将对象不安全地转换为指定类型的引用
-         * @tparam T 目标类型
-         * @return 指定类型的引用
-         * @note 若目标类型与当前类型不兼容，则行为未定义
+         * @brief 将当前对象转换为指定类型的引用，优先通过QueryInterface查询
+         * @throws std::bad_cast 如果对象不是该类型
          */
         template <typename T>
-        auto UnsafeCast() const
-            -> typename std::enable_if<!std::is_base_of<DynamicObject, T>::value && _IsStaticCastable<DynamicObject *, T *>::value, const T &>::type;
+        T &_CastRef()
+        {
+            T *p = _CastPtr<T>();
+            if (p == nullptr) throw std::bad_cast();
+            return *p;
+        }
 
         /**
-         * @brief 将对象不安全地转换为指定类型的引用
-         * @tparam T 目标类型
-         * @return 指定类型的引用
-         * @note 若目标类型与当前类型不兼容，则行为未定义
+         * @brief 将当前对象转换为指定类型的常量引用，优先通过QueryInterface查询
+         * @throws std::bad_cast 如果对象不是该类型
          */
         template <typename T>
-        auto UnsafeCast() const
-            -> typename std::enable_if<!std::is_base_of<DynamicObject, T>::value && !_IsStaticCastable<DynamicObject *, T *>::value, const T &>::type;
+        const T &_CastRef() const
+        {
+            const T *p = _CastPtr<T>();
+            if (p == nullptr) throw std::bad_cast();
+            return *p;
+        }
 
     private:
         /**
@@ -7373,9 +9014,9 @@ namespace sw
 #else
         if (!_isBoxedObject) {
             if (pout == nullptr) {
-                return dynamic_cast<T *>(this) != nullptr;
+                return _CastPtr<T>() != nullptr;
             } else {
-                *pout = dynamic_cast<T *>(this);
+                *pout = _CastPtr<T>();
                 return *pout != nullptr;
             }
         } else {
@@ -7447,9 +9088,9 @@ namespace sw
 #else
         if (!_isBoxedObject) {
             if (pout == nullptr) {
-                return dynamic_cast<const T *>(this) != nullptr;
+                return _CastPtr<T>() != nullptr;
             } else {
-                *pout = dynamic_cast<const T *>(this);
+                *pout = _CastPtr<T>();
                 return *pout != nullptr;
             }
         } else {
@@ -7520,7 +9161,7 @@ namespace sw
         throw std::runtime_error("Reflection is disabled, cannot perform dynamic cast.");
 #else
         if (!_isBoxedObject) {
-            return dynamic_cast<T &>(*this);
+            return _CastRef<T>();
         } else {
             void *rawPtr = GetBoxedRawPtr();
             if (rawPtr == nullptr || GetBoxedType() != typeid(T)) {
@@ -7572,7 +9213,7 @@ namespace sw
         throw std::runtime_error("Reflection is disabled, cannot perform dynamic cast.");
 #else
         if (!_isBoxedObject) {
-            return dynamic_cast<const T &>(*this);
+            return _CastRef<T>();
         } else {
             const void *rawPtr = GetBoxedRawPtr();
             if (rawPtr == nullptr || GetBoxedType() != typeid(T)) {
@@ -7734,6 +9375,21 @@ namespace sw
      */
     class Reflection
     {
+    private:
+        /**
+         * @brief 计算字段ID时使用的乘数（2^64除以黄金分割比）
+         */
+        static constexpr uint64_t _FieldIdMultiplier = 0x9e3779b97f4a7c15ull;
+
+        /**
+         * @brief 每组类类型与字段类型对应一个类型标记，以其地址作为计算字段ID的种子
+         * @note 标记不是常量，避免链接器合并内容相同的只读数据使不同类型的地址相同
+         */
+        template <typename T, typename TField>
+        struct _FieldTypeTag {
+            static char value;
+        };
+
     public:
         /**
          * @brief 静态类，不允许实例化
@@ -7751,21 +9407,19 @@ namespace sw
         template <typename T, typename TField>
         static FieldId GetFieldId(TField T::*field) noexcept
         {
-            auto pfunc = &Reflection::GetFieldId<T, TField>;
-
-            uint8_t buffer[sizeof(pfunc) + sizeof(field)];
-            memcpy(buffer, &pfunc, sizeof(pfunc));
-            memcpy(buffer + sizeof(pfunc), &field, sizeof(field));
+            // 成员指针按64位整数混合而非逐字节哈希，成员指针为常量时（如RaisePropertyChanged(&T::Prop)内联后）
+            // 整个计算可在编译期折叠，运行时只剩下与类型标记地址有关的几条指令
+            uint64_t words[(sizeof(field) + sizeof(uint64_t) - 1) / sizeof(uint64_t)] = {};
+            memcpy(words, &field, sizeof(field));
 
-            uint32_t prime = 16777619u;
-            uint32_t hash  = 2166136261u;
+            // 类型标记的地址区分偏移相同但所属类或字段类型不同的成员
+            uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&_FieldTypeTag<T, TField>::value));
+            hash *= _FieldIdMultiplier;
 
-            for (size_t i = 0; i < sizeof(buffer); ++i) {
-                hash ^= static_cast<uint32_t>(buffer[i]);
-                hash *= prime;
+            for (uint64_t word : words) {
+                hash = (hash ^ word) * _FieldIdMultiplier;
             }
-
-            return FieldId{hash};
+            return FieldId{static_cast<uint32_t>(hash >> 32)};
         }
 
         /**
@@ -8028,6 +9682,12 @@ namespace sw
             setter(boxed, std::forward<TValue>(value));
         }
     };
+
+    /**
+     * @brief 类型标记的定义
+     */
+    template <typename T, typename TField>
+    char Reflection::_FieldTypeTag<T, TField>::value = 0;
 }
 
 // 为sw::FieldId特化std::hash
@@ -9918,6 +11578,108 @@ namespace sw
     };
 }
 
+// RoutedEventHandlerTable.h
+
+
+namespace sw
+{
+    /**
+     * @brief 记录元素上已注册的路由事件处理函数的表
+     * @note 查找不会插入新项；内置路由事件类型各对应掩码中的一位，未注册的类型只需一次位测试即可排除，
+     *       用户自定义类型及超出掩码范围的内置类型共用最高位
+     * @note 处理函数单独分配，插入新项不会使已返回的引用失效，因此可以在事件处理函数中注册其他事件；
+     *       表中的项不会被删除，注销处理函数只会将其置空
+     */
+    class RoutedEventHandlerTable
+    {
+    private:
+        /**
+         * @brief 表项类型
+         */
+        using _Entry = std::pair<RoutedEventType, std::unique_ptr<RoutedEventHandler>>;
+
+        /**
+         * @brief 按事件类型升序排列的表项
+         */
+        std::vector<_Entry> _entries;
+
+        /**
+         * @brief 已注册事件类型的掩码
+         */
+        uint64_t _mask = 0;
+
+    public:
+        /**
+         * @brief 查找指定事件类型的处理函数
+         * @param eventType 路由事件类型
+         * @return 处理函数指针，若该类型从未注册过则返回nullptr
+         */
+        RoutedEventHandler *Find(RoutedEventType eventType) noexcept
+        {
+            if ((_mask & _GetMaskBit(eventType)) == 0) {
+                return nullptr;
+            }
+            auto it = _LowerBound(eventType);
+            return (it != _entries.end() && it->first == eventType) ? it->second.get() : nullptr;
+        }
+
+        /**
+         * @brief 查找指定事件类型的处理函数
+         * @param eventType 路由事件类型
+         * @return 处理函数指针，若该类型从未注册过则返回nullptr
+         */
+        const RoutedEventHandler *Find(RoutedEventType eventType) const noexcept
+        {
+            return const_cast<RoutedEventHandlerTable *>(this)->Find(eventType);
+        }
+
+        /**
+         * @brief 获取指定事件类型的处理函数，若不存在则插入一个空的处理函数
+         * @param eventType 路由事件类型
+         * @return 处理函数的引用
+         */
+        RoutedEventHandler &GetOrAdd(RoutedEventType eventType)
+        {
+            auto it = _LowerBound(eventType);
+            if (it == _entries.end() || it->first != eventType) {
+                it = _entries.emplace(it, eventType, std::unique_ptr<RoutedEventHandler>(new RoutedEventHandler));
+                _mask |= _GetMaskBit(eventType);
+            }
+            return *it->second;
+        }
+
+        /**
+         * @brief 获取表项数量
+         */
+        int Count() const noexcept
+        {
+            return static_cast<int>(_entries.size());
+        }
+
+    private:
+        /**
+         * @brief 获取事件类型对应的掩码位
+         */
+        static uint64_t _GetMaskBit(RoutedEventType eventType) noexcept
+        {
+            uint32_t index = eventType > RoutedEventType_UserEnd
+                                 ? static_cast<uint32_t>(eventType - RoutedEventType_UserEnd - 1)
+                                 : 63;
+            return uint64_t(1) << (index < 63 ? index : 63);
+        }
+
+        /**
+         * @brief 查找第一个类型不小于eventType的表项
+         */
+        std::vector<_Entry>::iterator _LowerBound(RoutedEventType eventType) noexcept
+        {
+            return std::lower_bound(
+                _entries.begin(), _entries.end(), eventType,
+                [](const _Entry &entry, RoutedEventType type) { return entry.first < type; });
+        }
+    };
+}
+
 // Variant.h
 
 
@@ -9950,19 +11712,106 @@ namespace sw
      *       通过Variant::MakeRef或显式构造ObjectRef可获得引用语义。
      * @note 持入Variant的类型其析构函数不应抛出异常 —— C++11起析构函数默认即为
      *       noexcept，Variant的多个noexcept移动操作依赖此前提。
+     * @note 内部对象（DynamicObject派生类型或BoxedObject<T>）足够小且可nothrow移动构造时直接存放在
+     *       Variant内部的缓冲区中，不进行堆分配，如int、double、bool、ObjectRef等，
+     *       此时拷贝与移动Variant同样不会分配内存。
      */
     class Variant final
     {
     private:
         /**
-         * @brief 内部动态对象指针
+         * @brief 内联缓冲区的大小
+         */
+        static constexpr std::size_t _InlineSize = 4 * sizeof(void *);
+
+        /**
+         * @brief 内联缓冲区的对齐
+         */
+        static constexpr std::size_t _InlineAlign = alignof(double) > alignof(void *) ? alignof(double) : alignof(void *);
+
+        /**
+         * @brief 内联缓冲区类型
+         */
+        struct _InlineBuffer {
+            alignas(_InlineAlign) unsigned char data[_InlineSize];
+        };
+
+        /**
+         * @brief 判断指定的DynamicObject类型是否可以存放在内联缓冲区中
+         */
+        template <typename U>
+        struct _IsInlineStorable
+            : std::integral_constant<
+                  bool,
+                  sizeof(U) <= _InlineSize &&
+                      alignof(U) <= _InlineAlign &&
+                      _InlineAlign % alignof(U) == 0 &&
+                      std::is_nothrow_move_constructible<U>::value> {
+        };
+
+        /**
+         * @brief 判断内部对象是否可拷贝，对于BoxedObject<T>取决于被装箱的类型T
+         */
+        template <typename U>
+        struct _IsCopyableObject : std::is_copy_constructible<U> {
+        };
+
+        /**
+         * @brief _IsCopyableObject模板特化（对于BoxedObject）
+         */
+        template <typename T>
+        struct _IsCopyableObject<BoxedObject<T>> : std::is_copy_constructible<T> {
+        };
+
+        /**
+         * @brief 内部对象的操作函数表，每种内部对象类型对应一个静态实例
+         */
+        struct _ObjectOps {
+            /**
+             * @brief 拷贝对象，内联存储时在buf中构造，否则在堆上构造
+             */
+            DynamicObject *(*copy)(const DynamicObject &obj, void *buf);
+
+            /**
+             * @brief 将内联存储的对象移动到buf中并析构原对象
+             */
+            DynamicObject *(*relocate)(DynamicObject &obj, void *buf);
+
+            /**
+             * @brief 销毁对象，内联存储时仅调用析构函数，否则delete对象
+             */
+            void (*destroy)(DynamicObject *obj);
+
+            /**
+             * @brief 将内联存储的对象移动到堆上并析构原对象，堆上的对象直接返回
+             */
+            DynamicObject *(*moveToHeap)(DynamicObject &obj);
+
+            /**
+             * @brief 获取同一类型对象存放在堆上时的操作函数表
+             */
+            const _ObjectOps *(*heapOps)();
+
+            /**
+             * @brief 对象是否存放在内联缓冲区中
+             */
+            bool isInline;
+        };
+
+        /**
+         * @brief 内部动态对象指针，指向_buf或堆上的对象
+         */
+        DynamicObject *_obj = nullptr;
+
+        /**
+         * @brief 内部对象的操作函数表
          */
-        std::unique_ptr<DynamicObject> _obj;
+        const _ObjectOps *_ops = nullptr;
 
         /**
-         * @brief 克隆对象函数指针
+         * @brief 内联缓冲区
          */
-        DynamicObject *(*_cloner)(const DynamicObject &) = nullptr;
+        _InlineBuffer _buf;
 
     public:
         /**
@@ -9987,8 +11836,7 @@ namespace sw
         Variant(ObjectRef ref)
         {
             if (ref.ptr != nullptr) {
-                _obj.reset(new BoxedObject<ObjectRef>(ref));
-                ResetCloner<ObjectRef>();
+                _Emplace<BoxedObject<ObjectRef>>(ref);
             }
         }
 
@@ -10012,8 +11860,8 @@ namespace sw
         Variant(const Variant &other)
         {
             if (other._obj != nullptr) {
-                _obj.reset(other._cloner(*other._obj));
-                _cloner = other._cloner;
+                _obj = other._ops->copy(*other._obj, _buf.data);
+                _ops = other._ops;
             }
         }
 
@@ -10021,9 +11869,16 @@ namespace sw
          * @brief 移动构造函数
          */
         Variant(Variant &&other) noexcept
-            : _obj(std::move(other._obj)), _cloner(other._cloner)
         {
-            other._cloner = nullptr;
+            _TakeFrom(other);
+        }
+
+        /**
+         * @brief 析构函数
+         */
+        ~Variant()
+        {
+            Reset();
         }
 
         /**
@@ -10098,8 +11953,13 @@ namespace sw
          */
         void Reset() noexcept
         {
-            _obj.reset();
-            _cloner = nullptr;
+            if (_obj != nullptr) {
+                DynamicObject *obj     = _obj;
+                const _ObjectOps *ops = _ops;
+                _obj                   = nullptr;
+                _ops                   = nullptr;
+                ops->destroy(obj);
+            }
         }
 
         /**
@@ -10122,8 +11982,7 @@ namespace sw
             if (ref.ptr == nullptr) {
                 Reset();
             } else {
-                _obj.reset(new BoxedObject<ObjectRef>(ref));
-                ResetCloner<ObjectRef>();
+                _Emplace<BoxedObject<ObjectRef>>(ref);
             }
         }
 
@@ -10140,8 +11999,10 @@ namespace sw
             if (other._obj == nullptr) {
                 Reset();
             } else {
-                _obj.reset(other._cloner(*other._obj));
-                _cloner = other._cloner;
+                // 先拷贝到临时缓冲区再替换，保证拷贝失败时当前值不变
+                _InlineBuffer tmp;
+                DynamicObject *obj = other._ops->copy(*other._obj, tmp.data);
+                _Replace(other._ops, obj);
             }
         }
 
@@ -10151,9 +12012,10 @@ namespace sw
         void Reset(Variant &&other) noexcept
         {
             if (this != &other) {
-                _obj          = std::move(other._obj);
-                _cloner       = other._cloner;
-                other._cloner = nullptr;
+                // other可能由当前对象持有，先将其内容转移到临时Variant中再释放当前对象
+                Variant tmp(std::move(other));
+                Reset();
+                _TakeFrom(tmp);
             }
         }
 
@@ -10169,8 +12031,7 @@ namespace sw
                 std::is_base_of<DynamicObject, typename std::decay<T>::type>::value>::type
         {
             using U = typename std::decay<T>::type;
-            _obj.reset(new U(std::forward<T>(obj)));
-            ResetCloner<U>();
+            _Emplace<U>(std::forward<T>(obj));
         }
 
         /**
@@ -10185,8 +12046,7 @@ namespace sw
                 !std::is_base_of<DynamicObject, typename std::decay<T>::type>::value>::type
         {
             using U = typename std::decay<T>::type;
-            _obj.reset(new BoxedObject<U>(std::forward<T>(obj)));
-            ResetCloner<U>();
+            _Emplace<BoxedObject<U>>(std::forward<T>(obj));
         }
 
         /**
@@ -10206,7 +12066,7 @@ namespace sw
             if (_obj->IsType<ObjectRef>(&ref)) {
                 return ref->ptr;
             }
-            return _obj.get();
+            return _obj;
         }
 
         /**
@@ -10226,7 +12086,7 @@ namespace sw
             if (_obj->IsType<ObjectRef>(&ref)) {
                 return ref->ptr;
             }
-            return _obj.get();
+            return _obj;
         }
 
         /**
@@ -10359,44 +12219,196 @@ namespace sw
 
     private:
         /**
-         * @brief 初始化克隆函数指针
-         * @tparam T 对象类型
+         * @brief 获取指定内部对象类型的操作函数表
+         * @tparam U 内部对象类型，为DynamicObject派生类型或BoxedObject<T>
+         * @tparam Inline 对象是否存放在内联缓冲区中
          */
-        template <typename T>
-        auto ResetCloner()
-            -> typename std::enable_if<std::is_copy_constructible<T>::value && std::is_base_of<DynamicObject, T>::value>::type
+        template <typename U, bool Inline = _IsInlineStorable<U>::value>
+        static const _ObjectOps *_GetOps() noexcept
         {
-            _cloner = [](const DynamicObject &other) -> DynamicObject * {
-                return new T(other.UnsafeCast<T>());
+            static const _ObjectOps ops = {
+                &Variant::_CopyObject<U, Inline>,
+                &Variant::_RelocateObject<U, Inline>,
+                &Variant::_DestroyObject<U, Inline>,
+                &Variant::_MoveObjectToHeap<U, Inline>,
+                &Variant::_GetOps<U, false>,
+                Inline,
             };
+            return &ops;
         }
 
         /**
-         * @brief 初始化克隆函数指针
-         * @tparam T 对象类型
+         * @brief 在buf或堆上构造内部对象
+         * @tparam U 内部对象类型
+         * @return 构造的对象指针
          */
-        template <typename T>
-        auto ResetCloner()
-            -> typename std::enable_if<std::is_copy_constructible<T>::value && !std::is_base_of<DynamicObject, T>::value>::type
+        template <typename U, bool Inline = _IsInlineStorable<U>::value, typename... Args>
+        static auto _ConstructObject(void *buf, Args &&...args)
+            -> typename std::enable_if<Inline, DynamicObject *>::type
         {
-            _cloner = [](const DynamicObject &other) -> DynamicObject * {
-                return new BoxedObject<T>(other.UnsafeCast<BoxedObject<T>>());
-            };
+            return new (buf) U(std::forward<Args>(args)...);
         }
 
         /**
-         * @brief 初始化克隆函数指针
-         * @tparam T 对象类型
-         * @note 当T不可拷贝时，克隆函数指针在被调用时抛出std::runtime_error，
+         * @brief 在buf或堆上构造内部对象
+         * @tparam U 内部对象类型
+         * @return 构造的对象指针
+         */
+        template <typename U, bool Inline = _IsInlineStorable<U>::value, typename... Args>
+        static auto _ConstructObject(void *, Args &&...args)
+            -> typename std::enable_if<!Inline, DynamicObject *>::type
+        {
+            return new U(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief 拷贝内部对象
+         * @tparam U 内部对象类型
+         */
+        template <typename U, bool Inline>
+        static auto _CopyObject(const DynamicObject &obj, void *buf)
+            -> typename std::enable_if<_IsCopyableObject<U>::value, DynamicObject *>::type
+        {
+            return _ConstructObject<U, Inline>(buf, obj.UnsafeCast<U>());
+        }
+
+        /**
+         * @brief 拷贝内部对象
+         * @tparam U 内部对象类型
+         * @note 当内部对象不可拷贝时，在被调用时抛出std::runtime_error，
          *       而非在编译期失败 —— 以便不可拷贝类型仍可被存放和移动。
          */
-        template <typename T>
-        auto ResetCloner()
-            -> typename std::enable_if<!std::is_copy_constructible<T>::value>::type
+        template <typename U, bool Inline>
+        static auto _CopyObject(const DynamicObject &, void *)
+            -> typename std::enable_if<!_IsCopyableObject<U>::value, DynamicObject *>::type
         {
-            _cloner = [](const DynamicObject &other) -> DynamicObject * {
-                throw std::runtime_error("Object is not copy constructible.");
-            };
+            throw std::runtime_error("Object is not copy constructible.");
+        }
+
+        /**
+         * @brief 将内联存储的对象移动到buf中并析构原对象
+         * @tparam U 内部对象类型
+         */
+        template <typename U, bool Inline>
+        static auto _RelocateObject(DynamicObject &obj, void *buf) noexcept
+            -> typename std::enable_if<Inline, DynamicObject *>::type
+        {
+            U &src       = obj.UnsafeCast<U>();
+            U *relocated = new (buf) U(std::move(src));
+            src.~U();
+            return relocated;
+        }
+
+        /**
+         * @brief 将内联存储的对象移动到buf中并析构原对象
+         * @tparam U 内部对象类型
+         * @note 堆上的对象通过转移指针完成移动，不会调用该函数
+         */
+        template <typename U, bool Inline>
+        static auto _RelocateObject(DynamicObject &obj, void *) noexcept
+            -> typename std::enable_if<!Inline, DynamicObject *>::type
+        {
+            return &obj;
+        }
+
+        /**
+         * @brief 将内联存储的对象移动到堆上并析构原对象
+         * @tparam U 内部对象类型
+         */
+        template <typename U, bool Inline>
+        static auto _MoveObjectToHeap(DynamicObject &obj)
+            -> typename std::enable_if<Inline, DynamicObject *>::type
+        {
+            U &src   = obj.UnsafeCast<U>();
+            U *moved = new U(std::move(src));
+            src.~U();
+            return moved;
+        }
+
+        /**
+         * @brief 将内联存储的对象移动到堆上并析构原对象
+         * @tparam U 内部对象类型
+         * @note 对象已在堆上时直接返回
+         */
+        template <typename U, bool Inline>
+        static auto _MoveObjectToHeap(DynamicObject &obj)
+            -> typename std::enable_if<!Inline, DynamicObject *>::type
+        {
+            return &obj;
+        }
+
+        /**
+         * @brief 销毁内部对象
+         * @tparam U 内部对象类型
+         */
+        template <typename U, bool Inline>
+        static auto _DestroyObject(DynamicObject *obj) noexcept
+            -> typename std::enable_if<Inline>::type
+        {
+            obj->~DynamicObject();
+        }
+
+        /**
+         * @brief 销毁内部对象
+         * @tparam U 内部对象类型
+         */
+        template <typename U, bool Inline>
+        static auto _DestroyObject(DynamicObject *obj) noexcept
+            -> typename std::enable_if<!Inline>::type
+        {
+            delete obj;
+        }
+
+        /**
+         * @brief 释放当前对象并接管新对象
+         * @param ops 新对象的操作函数表
+         * @param obj 新对象，内联存储时为临时缓冲区中的对象，会被移动到_buf中
+         */
+        void _Replace(const _ObjectOps *ops, DynamicObject *obj) noexcept
+        {
+            Reset();
+            if (obj != nullptr) {
+                _obj = ops->isInline ? ops->relocate(*obj, _buf.data) : obj;
+                _ops = ops;
+            }
+        }
+
+        /**
+         * @brief 接管另一个Variant的对象，调用前当前对象须为空
+         */
+        void _TakeFrom(Variant &other) noexcept
+        {
+            if (other._obj != nullptr) {
+                _obj = other._ops->isInline ? other._ops->relocate(*other._obj, _buf.data) : other._obj;
+                _ops = other._ops;
+
+                other._obj = nullptr;
+                other._ops = nullptr;
+            }
+        }
+
+        /**
+         * @brief 将内联存储的对象移动到堆上，使其地址在Variant移动后保持不变
+         */
+        void _MoveToHeap()
+        {
+            if (_obj != nullptr && _ops->isInline) {
+                _obj = _ops->moveToHeap(*_obj);
+                _ops = _ops->heapOps();
+            }
+        }
+
+        /**
+         * @brief 构造指定类型的内部对象并替换当前对象
+         * @tparam U 内部对象类型，为DynamicObject派生类型或BoxedObject<T>
+         * @note 新对象先在临时缓冲区中构造，因此args可以引用当前Variant中的对象
+         */
+        template <typename U, typename... Args>
+        void _Emplace(Args &&...args)
+        {
+            _InlineBuffer tmp;
+            DynamicObject *obj = _ConstructObject<U>(tmp.data, std::forward<Args>(args)...);
+            _Replace(_GetOps<U>(), obj);
         }
 
     public:
@@ -10417,8 +12429,8 @@ namespace sw
                 Variant>::type
         {
             Variant v;
-            v._obj.reset(new T(std::forward<Args>(args)...));
-            v.ResetCloner<T>();
+            v._obj = _ConstructObject<T>(v._buf.data, std::forward<Args>(args)...);
+            v._ops = _GetOps<T>();
             return v;
         }
 
@@ -10439,8 +12451,8 @@ namespace sw
                 Variant>::type
         {
             Variant v;
-            v._obj.reset(new BoxedObject<T>(std::forward<Args>(args)...));
-            v.ResetCloner<T>();
+            v._obj = _ConstructObject<BoxedObject<T>>(v._buf.data, std::forward<Args>(args)...);
+            v._ops = _GetOps<BoxedObject<T>>();
             return v;
         }
 
@@ -10451,9 +12463,14 @@ namespace sw
          * @note 避免对Variant调用泛型MakeRef时产生BoxedObject<Variant>嵌套包装。
          *       结果直接引用v.Object()返回的指针，因此当v本身已是引用语义时，
          *       结果与v共享同一被引用对象，不会形成多层引用链。
+         * @note 若v的对象存放在内联缓冲区中，会先将其移动到堆上，
+         *       使结果在v被移动后仍然有效。使用方需保证v的对象在结果存活期间不被销毁或替换。
          */
         static Variant MakeRef(Variant &v)
         {
+            if (v.Object() == v._obj) {
+                v._MoveToHeap();
+            }
             DynamicObject *p = v.Object();
             return p == nullptr ? Variant{} : MakeRef(*p);
         }
@@ -10474,8 +12491,7 @@ namespace sw
                 Variant>::type
         {
             Variant v;
-            v._obj.reset(new BoxedObject<ObjectRef>(ObjectRef{&obj}));
-            v.ResetCloner<ObjectRef>();
+            v._Emplace<BoxedObject<ObjectRef>>(ObjectRef{&obj});
             return v;
         }
 
@@ -10495,8 +12511,7 @@ namespace sw
                 Variant>::type
         {
             Variant v;
-            v._obj.reset(new BoxedObject<T>(BoxedObject<T>::MakeRef(obj)));
-            v.ResetCloner<T>();
+            v._Emplace<BoxedObject<T>>(BoxedObject<T>::MakeRef(obj));
             return v;
         }
     };
@@ -10714,6 +12729,44 @@ namespace sw
     };
 }
 
+// IItemGenerator.h
+
+
+namespace sw
+{
+    /**
+     * @brief 为虚拟化布局按需生成与回收子项容器的接口
+     */
+    class IItemGenerator
+    {
+    public:
+        /**
+         * @brief 默认虚析构函数
+         */
+        virtual ~IItemGenerator() = default;
+
+    public:
+        /**
+         * @brief 获取数据项的数量
+         */
+        virtual int GetItemCount() = 0;
+
+        /**
+         * @brief 为指定索引处的数据项实现化一个容器，可复用之前回收的容器
+         * @param index 数据项索引
+         * @return 用于呈现该数据项的容器，在被回收前应保持有效
+         */
+        virtual ILayout &RealizeItem(int index) = 0;
+
+        /**
+         * @brief 回收不再可见的容器
+         * @param index 容器所呈现的数据项索引
+         * @param container 由RealizeItem返回的容器
+         */
+        virtual void RecycleItem(int index, ILayout &container) = 0;
+    };
+}
+
 // IList.h
 
 
@@ -11041,6 +13094,19 @@ namespace sw
          * @param finalSize 可用于排列子元素的最终尺寸
          */
         virtual void ArrangeOverride(const Size &finalSize) = 0;
+
+        /**
+         * @brief 更新关联对象的可视区域，由关联对象在使用布局方式测量前调用
+         * @param viewport 可视区域，坐标相对于子元素的排列原点（已考虑滚动偏移）
+         * @note 默认实现为空，需要根据可视区域布局的布局方式可重写该函数
+         */
+        virtual void UpdateViewport(const Rect &viewport);
+
+        /**
+         * @brief 获取布局方式确定的内容尺寸，关联对象的滚动范围取该尺寸与子元素实际所占范围中的较大者
+         * @note 默认返回空尺寸，即仅按子元素的实际位置计算滚动范围
+         */
+        virtual Size GetContentExtent();
     };
 }
 
@@ -11465,6 +13531,16 @@ namespace sw
          */
         ObjectDeadEventHandler _objectDead;
 
+        /**
+         * @brief 按属性ID索引的属性更改事件委托，首次按ID订阅时创建
+         */
+        std::unique_ptr<std::unordered_map<FieldId, PropertyChangedEventHandler>> _propertyChangedTable;
+
+        /**
+         * @brief 正在分发按属性ID订阅的事件的嵌套层数
+         */
+        int _propertyChangedDispatchDepth = 0;
+
     public:
         /**
          * @brief 默认构造函数
@@ -11494,6 +13570,60 @@ namespace sw
             }
         }
 
+    public:
+        /**
+         * @brief 订阅指定属性的更改通知
+         * @param propertyId 属性ID
+         * @param handler 事件处理函数
+         * @note 与直接订阅PropertyChanged事件不同，处理函数仅在指定属性更改时被调用，
+         *       触发通知时只需查找一次属性ID，不会随其他属性的订阅数量增加而变慢
+         */
+        void AddPropertyChangedHandler(FieldId propertyId, const PropertyChangedEventHandler &handler)
+        {
+            if (handler == nullptr) {
+                return;
+            }
+
+            if (_propertyChangedTable == nullptr) {
+                _propertyChangedTable.reset(new std::unordered_map<FieldId, PropertyChangedEventHandler>);
+            }
+
+            if (_propertyChangedTable->empty()) {
+                _propertyChanged += PropertyChangedEventHandler(*this, &ObservableObject::_DispatchPropertyChanged);
+            }
+
+            (*_propertyChangedTable)[propertyId] += handler;
+        }
+
+        /**
+         * @brief 取消订阅指定属性的更改通知
+         * @param propertyId 属性ID
+         * @param handler 事件处理函数
+         * @return 若成功移除则返回true，否则返回false
+         */
+        bool RemovePropertyChangedHandler(FieldId propertyId, const PropertyChangedEventHandler &handler)
+        {
+            if (_propertyChangedTable == nullptr || handler == nullptr) {
+                return false;
+            }
+
+            auto it = _propertyChangedTable->find(propertyId);
+            if (it == _propertyChangedTable->end()) {
+                return false;
+            }
+
+            bool removed = it->second.Remove(handler);
+
+            // 分发过程中不删除表项，避免销毁正在调用的委托
+            if (removed && it->second == nullptr && _propertyChangedDispatchDepth == 0) {
+                _propertyChangedTable->erase(it);
+                if (_propertyChangedTable->empty()) {
+                    _propertyChanged -= PropertyChangedEventHandler(*this, &ObservableObject::_DispatchPropertyChanged);
+                }
+            }
+            return removed;
+        }
+
     protected:
         /**
          * @brief 获取属性更改事件委托的引用
@@ -11513,6 +13643,23 @@ namespace sw
             return _objectDead;
         }
 
+        /**
+         * @brief 查询对象实现的常用类型，用于代替dynamic_cast进行类型判断和转换
+         */
+        virtual void *QueryInterface(InterfaceId id) noexcept override
+        {
+            switch (id) {
+                case InterfaceId::ObservableObject:
+                    return this;
+                case InterfaceId::INotifyPropertyChanged:
+                    return static_cast<INotifyPropertyChanged *>(this);
+                case InterfaceId::INotifyObjectDead:
+                    return static_cast<INotifyObjectDead *>(this);
+                default:
+                    return DynamicObject::QueryInterface(id);
+            }
+        }
+
         /**
          * @brief 触发属性更改通知事件
          * @param propertyId 更改的属性ID
@@ -11538,6 +13685,40 @@ namespace sw
             FieldId id = Reflection::GetFieldId(property);
             RaisePropertyChanged(id);
         }
+
+    private:
+        /**
+         * @brief 将属性更改事件分发给按属性ID订阅的处理函数
+         * @note 该函数作为普通处理函数添加到PropertyChanged中，因此直接调用事件委托触发的通知同样会被分发
+         */
+        void _DispatchPropertyChanged(INotifyPropertyChanged &sender, PropertyChangedEventArgs &args)
+        {
+            FieldId propertyId = args.propertyId;
+            auto it            = _propertyChangedTable->find(propertyId);
+
+            if (it == _propertyChangedTable->end() || it->second == nullptr) {
+                return;
+            }
+
+            // 处理函数中可能订阅其他属性导致rehash，此处保存引用而非迭代器
+            PropertyChangedEventHandler &handler = it->second;
+
+            ++_propertyChangedDispatchDepth;
+            try {
+                handler(sender, args);
+            } catch (...) {
+                --_propertyChangedDispatchDepth;
+                throw;
+            }
+            --_propertyChangedDispatchDepth;
+
+            if (_propertyChangedDispatchDepth == 0 && handler == nullptr) {
+                _propertyChangedTable->erase(propertyId);
+                if (_propertyChangedTable->empty()) {
+                    _propertyChanged -= PropertyChangedEventHandler(*this, &ObservableObject::_DispatchPropertyChanged);
+                }
+            }
+        }
     };
 }
 
@@ -11563,6 +13744,19 @@ namespace sw
         TwoWay,
     };
 
+    /**
+     * @brief 源属性更改时更新目标属性的时机
+     */
+    enum class BindingUpdateMode {
+        /// 源属性更改时立即更新目标属性
+        Immediate,
+
+        /// 源属性更改时只将绑定加入引发更改的线程的队列，由该线程的Binding::FlushDeferredUpdates统一更新，
+        /// App::MsgLoop在每轮消息处理后调用，多次更改只以最新的源属性值更新一次。
+        /// 绑定只能在引发更改的线程中或该线程退出后销毁
+        Deferred,
+    };
+
     /**
      * @brief 数据绑定基类
      */
@@ -11649,6 +13843,39 @@ namespace sw
          */
         Func<Binding *, bool> _updateSourceFunc;
 
+        /**
+         * @brief 源属性更改时更新目标属性的时机
+         */
+        BindingUpdateMode _updateMode = BindingUpdateMode::Immediate;
+
+        /**
+         * @brief 等待延迟更新目标属性的绑定，每个线程一个
+         */
+        struct _DeferredQueue {
+            std::vector<Binding *> items; // 按首次标记的顺序排列，已取消的项为nullptr
+            size_t pendingCount = 0;      // items中不为nullptr的项数
+            bool isFlushing     = false;  // 是否正在执行FlushDeferredUpdates
+            Action<> requestHandler;      // 队列由空变为非空时调用
+
+            // 线程退出时解除队列中绑定与队列的关联
+            ~_DeferredQueue()
+            {
+                for (Binding *item : items) {
+                    if (item != nullptr) item->_deferredQueue = nullptr;
+                }
+            }
+        };
+
+        /**
+         * @brief 绑定所在的等待延迟更新的队列，不在队列中时为nullptr
+         */
+        _DeferredQueue *_deferredQueue = nullptr;
+
+        /**
+         * @brief 绑定在_deferredQueue->items中的索引
+         */
+        size_t _deferredIndex = 0;
+
     private:
         /**
          * @brief 默认构造函数
@@ -11673,6 +13900,7 @@ namespace sw
          */
         virtual ~Binding()
         {
+            CancelDeferredUpdate();
             UnregisterNotifications();
 
             if (_converterDeleter && _converter) {
@@ -11732,6 +13960,14 @@ namespace sw
             return _mode;
         }
 
+        /**
+         * @brief 获取源属性更改时更新目标属性的时机
+         */
+        BindingUpdateMode GetUpdateMode() const
+        {
+            return _updateMode;
+        }
+
         /**
          * @brief 获取目标对象
          */
@@ -11759,6 +13995,21 @@ namespace sw
             }
         }
 
+        /**
+         * @brief 修改源属性更改时更新目标属性的时机
+         * @note 从Deferred改为Immediate时若有等待中的更新则立即更新目标属性
+         */
+        void SetUpdateMode(BindingUpdateMode mode)
+        {
+            if (_updateMode != mode) {
+                _updateMode = mode;
+                if (mode == BindingUpdateMode::Immediate && _deferredQueue != nullptr) {
+                    CancelDeferredUpdate();
+                    UpdateTarget();
+                }
+            }
+        }
+
         /**
          * @brief 修改目标对象
          */
@@ -11807,14 +14058,23 @@ namespace sw
          */
         void RegisterNotifications()
         {
+            ObservableObject *targetObservable     = nullptr;
+            ObservableObject *sourceObservable     = nullptr;
             INotifyPropertyChanged *targetNotifObj = nullptr;
             INotifyPropertyChanged *sourceNotifObj = nullptr;
 
-            if (_targetObject != nullptr && _targetObject->IsType(&targetNotifObj)) {
+            // 对于ObservableObject按属性ID订阅，避免每次属性更改都调用对象上的所有绑定
+            if (_targetObject != nullptr && _targetObject->IsType(&targetObservable)) {
+                targetObservable->AddPropertyChangedHandler(
+                    _targetPropertyId, PropertyChangedEventHandler(*this, &Binding::OnTargetPropertyChanged));
+            } else if (_targetObject != nullptr && _targetObject->IsType(&targetNotifObj)) {
                 targetNotifObj->PropertyChanged +=
                     PropertyChangedEventHandler(*this, &Binding::OnTargetPropertyChanged);
             }
-            if (_sourceObject != nullptr && _sourceObject->IsType(&sourceNotifObj)) {
+            if (_sourceObject != nullptr && _sourceObject->IsType(&sourceObservable)) {
+                sourceObservable->AddPropertyChangedHandler(
+                    _sourcePropertyId, PropertyChangedEventHandler(*this, &Binding::OnSourcePropertyChanged));
+            } else if (_sourceObject != nullptr && _sourceObject->IsType(&sourceNotifObj)) {
                 sourceNotifObj->PropertyChanged +=
                     PropertyChangedEventHandler(*this, &Binding::OnSourcePropertyChanged);
             }
@@ -11837,14 +14097,23 @@ namespace sw
          */
         void UnregisterNotifications()
         {
+            ObservableObject *targetObservable     = nullptr;
+            ObservableObject *sourceObservable     = nullptr;
             INotifyPropertyChanged *targetNotifObj = nullptr;
             INotifyPropertyChanged *sourceNotifObj = nullptr;
 
-            if (_targetObject != nullptr && _targetObject->IsType(&targetNotifObj)) {
+            // 对于ObservableObject按属性ID订阅，避免每次属性更改都调用对象上的所有绑定
+            if (_targetObject != nullptr && _targetObject->IsType(&targetObservable)) {
+                targetObservable->RemovePropertyChangedHandler(
+                    _targetPropertyId, PropertyChangedEventHandler(*this, &Binding::OnTargetPropertyChanged));
+            } else if (_targetObject != nullptr && _targetObject->IsType(&targetNotifObj)) {
                 targetNotifObj->PropertyChanged -=
                     PropertyChangedEventHandler(*this, &Binding::OnTargetPropertyChanged);
             }
-            if (_sourceObject != nullptr && _sourceObject->IsType(&sourceNotifObj)) {
+            if (_sourceObject != nullptr && _sourceObject->IsType(&sourceObservable)) {
+                sourceObservable->RemovePropertyChangedHandler(
+                    _sourcePropertyId, PropertyChangedEventHandler(*this, &Binding::OnSourcePropertyChanged));
+            } else if (_sourceObject != nullptr && _sourceObject->IsType(&sourceNotifObj)) {
                 sourceNotifObj->PropertyChanged -=
                     PropertyChangedEventHandler(*this, &Binding::OnSourcePropertyChanged);
             }
@@ -11888,7 +14157,11 @@ namespace sw
 
             if (_mode == BindingMode::TwoWay ||
                 _mode == BindingMode::OneWay) {
-                UpdateTarget();
+                if (_updateMode == BindingUpdateMode::Deferred) {
+                    ScheduleDeferredUpdate();
+                } else {
+                    UpdateTarget();
+                }
             }
         }
 
@@ -11917,6 +14190,7 @@ namespace sw
                 case BindingMode::OneTime:
                 case BindingMode::OneWay:
                 case BindingMode::TwoWay: {
+                    CancelDeferredUpdate();
                     UpdateTarget();
                     break;
                 }
@@ -11927,6 +14201,54 @@ namespace sw
             }
         }
 
+        /**
+         * @brief 获取当前线程等待延迟更新的队列
+         */
+        static _DeferredQueue &GetDeferredQueue()
+        {
+            static thread_local _DeferredQueue queue;
+            return queue;
+        }
+
+        /**
+         * @brief 将绑定加入当前线程等待延迟更新的队列，已在队列中时保持原有位置
+         */
+        void ScheduleDeferredUpdate()
+        {
+            if (_deferredQueue != nullptr) {
+                return;
+            }
+
+            _DeferredQueue &queue = GetDeferredQueue();
+
+            _deferredQueue = &queue;
+            _deferredIndex = queue.items.size();
+            queue.items.push_back(this);
+
+            if (queue.pendingCount++ == 0 && !queue.isFlushing && queue.requestHandler) {
+                queue.requestHandler();
+            }
+        }
+
+        /**
+         * @brief 将绑定从所在的等待延迟更新的队列中移除
+         */
+        void CancelDeferredUpdate()
+        {
+            if (_deferredQueue == nullptr) {
+                return;
+            }
+
+            _DeferredQueue &queue = *_deferredQueue;
+
+            queue.items[_deferredIndex] = nullptr;
+            _deferredQueue              = nullptr;
+
+            if (--queue.pendingCount == 0 && !queue.isFlushing) {
+                queue.items.clear();
+            }
+        }
+
         /**
          * @brief 内部创建绑定对象函数
          * @param target 目标对象指针
@@ -11959,6 +14281,65 @@ namespace sw
         }
 
     public:
+        /**
+         * @brief 判断当前线程是否有等待延迟更新的绑定
+         */
+        static bool HasDeferredUpdates()
+        {
+            return GetDeferredQueue().pendingCount != 0;
+        }
+
+        /**
+         * @brief 设置当前线程的等待延迟更新的队列由空变为非空时调用的函数
+         * @note App::MsgLoop通过该函数让调度器在下一轮消息处理中调用FlushDeferredUpdates，
+         *       使空闲任务与模态消息循环中产生的延迟更新也能及时应用
+         */
+        static void SetDeferredUpdateRequestHandler(const Action<> &handler)
+        {
+            GetDeferredQueue().requestHandler = handler;
+        }
+
+        /**
+         * @brief 以源属性的最新值更新当前线程中所有等待延迟更新的绑定的目标属性
+         * @note 按绑定首次被标记的顺序更新，更新过程中新标记的绑定在同一次调用中更新
+         * @note 在更新目标属性的过程中嵌套调用时直接返回
+         * @note 更新目标属性时抛出异常会中断本次更新，尚未更新的绑定保留在队列中，在下次调用时更新
+         */
+        static void FlushDeferredUpdates()
+        {
+            _DeferredQueue &queue = GetDeferredQueue();
+
+            if (queue.isFlushing || queue.pendingCount == 0) {
+                return;
+            }
+
+            // 离开函数时（包括抛出异常时）结束刷新状态，使队列可以继续使用
+            struct _FlushScope {
+                _DeferredQueue &queue;
+
+                ~_FlushScope()
+                {
+                    if (queue.pendingCount == 0) {
+                        queue.items.clear();
+                    }
+                    queue.isFlushing = false;
+                }
+            } scope{queue};
+
+            queue.isFlushing = true;
+
+            // 更新目标属性时可能有新的绑定加入队列，因此按索引遍历
+            for (size_t i = 0; i < queue.items.size(); ++i) {
+                Binding *binding = queue.items[i];
+                if (binding != nullptr) {
+                    queue.items[i]          = nullptr;
+                    binding->_deferredQueue = nullptr;
+                    --queue.pendingCount;
+                    binding->UpdateTarget();
+                }
+            }
+        }
+
         /**
          * @brief 创建绑定对象
          * @param target 目标对象指针
@@ -12472,6 +14853,11 @@ namespace sw
          * @brief 记录移动项的原始索引
          */
         int oldIndex = -1;
+
+        /**
+         * @brief 从index开始连续变更的项数，Add、Remove与Replace可通过该字段描述一整段变更
+         */
+        int count = 1;
     };
 
     /**
@@ -12951,10 +15337,148 @@ namespace sw
     {
     public:
         /**
-         * @brief 排列方式
+         * @brief 排列方式
+         */
+        Orientation orientation = Orientation::Vertical;
+
+        /**
+         * @brief 测量元素所需尺寸，无需考虑边框和边距
+         * @param availableSize 可用的尺寸
+         * @return 返回元素需要占用的尺寸
+         */
+        virtual Size MeasureOverride(const Size &availableSize) override;
+
+        /**
+         * @brief 安排子元素的位置，可重写该函数以实现自定义布局
+         * @param finalSize 可用于排列子元素的最终尺寸
+         */
+        virtual void ArrangeOverride(const Size &finalSize) override;
+    };
+}
+
+// UniformGridLayout.h
+
+
+namespace sw
+{
+    /**
+     * @brief 均匀大小网格布局
+     */
+    class UniformGridLayout : public LayoutHost
+    {
+    public:
+        /**
+         * @brief 行数
+         */
+        int rows = 1;
+
+        /**
+         * @brief 列数
+         */
+        int columns = 1;
+
+        /**
+         * @brief 网格第一行中前导空白单元格的数量
+         */
+        int firstColumn = 0;
+
+        /**
+         * @brief 测量元素所需尺寸，无需考虑边框和边距
+         * @param availableSize 可用的尺寸
+         * @return 返回元素需要占用的尺寸
+         */
+        virtual Size MeasureOverride(const Size &availableSize) override;
+
+        /**
+         * @brief 安排子元素的位置，可重写该函数以实现自定义布局
+         * @param finalSize 可用于排列子元素的最终尺寸
+         */
+        virtual void ArrangeOverride(const Size &finalSize) override;
+    };
+}
+
+// VirtualizingStackLayout.h
+
+
+namespace sw
+{
+    /**
+     * @brief 虚拟化堆叠布局，只实现化与可视区域相交的子项
+     * @note 子项由generator按需生成，离开可视区域的子项会交还generator回收；
+     *       未实现化过的子项按estimatedItemExtent估算其在堆叠方向上的尺寸
+     * @note 该布局不使用关联对象的子元素列表，数据项增删后需调用ResetItems
+     */
+    class VirtualizingStackLayout : public LayoutHost
+    {
+    public:
+        /**
+         * @brief 排列方式
+         */
+        Orientation orientation = Orientation::Vertical;
+
+        /**
+         * @brief 未实现化过的子项在堆叠方向上的估计尺寸
+         */
+        double estimatedItemExtent = 20;
+
+        /**
+         * @brief 子项生成器，为nullptr时不布局任何子项
+         * @note 更换生成器前应先调用ResetItems，使已实现化的子项交还原生成器回收
+         */
+        IItemGenerator *generator = nullptr;
+
+    private:
+        /**
+         * @brief 最近一次更新的可视区域
+         */
+        Rect _viewport{};
+
+        /**
+         * @brief 各子项在堆叠方向上测量得到的尺寸，小于0表示尚未测量
+         */
+        std::vector<double> _itemExtents{};
+
+        /**
+         * @brief 已测量子项的尺寸之和
+         */
+        double _measuredExtentSum = 0;
+
+        /**
+         * @brief 已测量子项的数量
+         */
+        int _measuredCount = 0;
+
+        /**
+         * @brief 已测量子项在另一方向上的最大尺寸
+         */
+        double _maxCrossExtent = 0;
+
+        /**
+         * @brief 已实现化子项中第一项的索引
+         */
+        int _firstRealized = 0;
+
+        /**
+         * @brief 已实现化子项中第一项在堆叠方向上的位置
+         */
+        double _firstRealizedOffset = 0;
+
+        /**
+         * @brief 计算_firstRealizedOffset时使用的估计尺寸
+         */
+        double _offsetEstimate = 0;
+
+        /**
+         * @brief 已实现化的子项，按索引从_firstRealized开始连续存放
+         */
+        std::vector<ILayout *> _realizedItems{};
+
+        /**
+         * @brief 更新已实现化的子项时暂存原先的子项，复用其存储以避免每次布局分配内存
          */
-        Orientation orientation = Orientation::Vertical;
+        std::vector<ILayout *> _previousItems{};
 
+    public:
         /**
          * @brief 测量元素所需尺寸，无需考虑边框和边距
          * @param availableSize 可用的尺寸
@@ -12967,47 +15491,70 @@ namespace sw
          * @param finalSize 可用于排列子元素的最终尺寸
          */
         virtual void ArrangeOverride(const Size &finalSize) override;
-    };
-}
 
-// UniformGridLayout.h
+        /**
+         * @brief 更新关联对象的可视区域，由关联对象在使用布局方式测量前调用
+         * @param viewport 可视区域，坐标相对于子元素的排列原点（已考虑滚动偏移）
+         */
+        virtual void UpdateViewport(const Rect &viewport) override;
 
+        /**
+         * @brief 获取按已测量尺寸与估计尺寸计算的全部子项所占尺寸
+         */
+        virtual Size GetContentExtent() override;
 
-namespace sw
-{
-    /**
-     * @brief 均匀大小网格布局
-     */
-    class UniformGridLayout : public LayoutHost
-    {
-    public:
         /**
-         * @brief 行数
+         * @brief 回收所有已实现化的子项并清除已测量的尺寸，数据项改变后调用
          */
-        int rows = 1;
+        void ResetItems();
 
         /**
-         * @brief 列数
+         * @brief 获取已实现化子项中第一项的索引
          */
-        int columns = 1;
+        int GetFirstRealizedIndex() const;
 
         /**
-         * @brief 网格第一行中前导空白单元格的数量
+         * @brief 获取已实现化子项的数量
          */
-        int firstColumn = 0;
+        int GetRealizedCount() const;
 
+    private:
         /**
-         * @brief 测量元素所需尺寸，无需考虑边框和边距
-         * @param availableSize 可用的尺寸
-         * @return 返回元素需要占用的尺寸
+         * @brief 使记录的子项数量与generator一致，回收超出范围的子项
          */
-        virtual Size MeasureOverride(const Size &availableSize) override;
+        void _SyncItemCount();
 
         /**
-         * @brief 安排子元素的位置，可重写该函数以实现自定义布局
-         * @param finalSize 可用于排列子元素的最终尺寸
+         * @brief 获取指定子项在堆叠方向上的尺寸，未测量时返回估计尺寸
          */
-        virtual void ArrangeOverride(const Size &finalSize) override;
+        double _GetItemExtent(int index) const;
+
+        /**
+         * @brief 记录子项测量后的尺寸
+         */
+        void _SetItemMeasured(int index, const Size &desireSize);
+
+        /**
+         * @brief 查找包含指定位置的子项，从上次实现化的位置开始向前或向后查找
+         * @param position 堆叠方向上的位置
+         * @param offset 输出找到的子项在堆叠方向上的位置
+         * @return 子项索引，位置超出全部子项时返回最后一项
+         */
+        int _LocateItem(double position, double &offset);
+
+        /**
+         * @brief 更新已实现化的子项，使其覆盖堆叠方向上的指定范围
+         * @param start 范围起点
+         * @param length 范围长度
+         * @param crossAvailable 另一方向上的可用尺寸
+         * @param measureRealized 是否重新测量此前已实现化的子项
+         */
+        void _UpdateRealizedItems(double start, double length, double crossAvailable, bool measureRealized);
+
+        /**
+         * @brief 回收所有已实现化的子项
+         */
+        void _RecycleAll();
     };
 }
 
@@ -13108,6 +15655,16 @@ namespace sw
          */
         NotifyCollectionChangedEventHandler _collectionChanged;
 
+        /**
+         * @brief BeginUpdate的嵌套层数
+         */
+        int _updateDepth = 0;
+
+        /**
+         * @brief 延迟更新期间是否有被推迟的变更通知
+         */
+        bool _updatePending = false;
+
     public:
         /**
          * @brief 默认构造函数，创建空集合
@@ -13154,6 +15711,21 @@ namespace sw
             return _collectionChanged;
         }
 
+        /**
+         * @brief 查询对象实现的常用类型，用于代替dynamic_cast进行类型判断和转换
+         */
+        virtual void *QueryInterface(InterfaceId id) noexcept override
+        {
+            switch (id) {
+                case InterfaceId::INotifyCollectionChanged:
+                    return static_cast<INotifyCollectionChanged *>(this);
+                case InterfaceId::IList:
+                    return static_cast<IList *>(this);
+                default:
+                    return ObservableObject::QueryInterface(id);
+            }
+        }
+
         /**
          * @brief 触发集合变更事件
          * @param args 集合变更事件参数
@@ -13165,6 +15737,26 @@ namespace sw
             }
         }
 
+    private:
+        /**
+         * @brief 构造事件参数并触发集合变更事件，处于延迟更新期间时仅记录有待通知的变更
+         */
+        void _NotifyCollectionChanged(NotifyCollectionChangedAction action, int index = -1, int count = 1, int oldIndex = -1)
+        {
+            if (_updateDepth > 0) {
+                _updatePending = true;
+                return;
+            }
+
+            NotifyCollectionChangedEventArgs args{};
+            args.action   = action;
+            args.list     = this;
+            args.index    = index;
+            args.oldIndex = oldIndex;
+            args.count    = count;
+            OnCollectionChanged(args);
+        }
+
     public:
         /**
          * @brief 获取当前分配的容量
@@ -13189,10 +15781,41 @@ namespace sw
          */
         void Refresh()
         {
-            NotifyCollectionChangedEventArgs args{};
-            args.action = NotifyCollectionChangedAction::Reset;
-            args.list   = this;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Reset);
+        }
+
+        /**
+         * @brief 开始批量更新，在对应的EndUpdate调用之前不再逐项触发集合变更事件
+         * @note BeginUpdate可嵌套调用，每次调用都需要与一次EndUpdate配对
+         */
+        void BeginUpdate() noexcept
+        {
+            ++_updateDepth;
+        }
+
+        /**
+         * @brief 结束批量更新，若期间集合发生过变更，则在最外层调用时触发一次集合重置通知
+         * @throws std::logic_error 没有与之配对的BeginUpdate调用
+         */
+        void EndUpdate()
+        {
+            if (_updateDepth <= 0) {
+                throw std::logic_error("EndUpdate called without a matching BeginUpdate in ObservableCollection.");
+            }
+
+            if (--_updateDepth == 0 && _updatePending) {
+                _updatePending = false;
+                _NotifyCollectionChanged(NotifyCollectionChangedAction::Reset);
+            }
+        }
+
+        /**
+         * @brief 判断集合当前是否处于批量更新状态
+         * @return 处于BeginUpdate与EndUpdate之间返回true，否则返回false
+         */
+        bool IsUpdating() const noexcept
+        {
+            return _updateDepth > 0;
         }
 
         /**
@@ -13206,10 +15829,7 @@ namespace sw
 
             _items.Clear();
 
-            NotifyCollectionChangedEventArgs args{};
-            args.action = NotifyCollectionChangedAction::Reset;
-            args.list   = this;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Reset);
         }
 
         /**
@@ -13221,11 +15841,7 @@ namespace sw
             int index = _items.Count();
             _items.Add(value);
 
-            NotifyCollectionChangedEventArgs args{};
-            args.action = NotifyCollectionChangedAction::Add;
-            args.list   = this;
-            args.index  = index;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Add, index);
         }
 
         /**
@@ -13237,11 +15853,7 @@ namespace sw
             int index = _items.Count();
             _items.Add(std::move(value));
 
-            NotifyCollectionChangedEventArgs args{};
-            args.action = NotifyCollectionChangedAction::Add;
-            args.list   = this;
-            args.index  = index;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Add, index);
         }
 
         /**
@@ -13253,11 +15865,7 @@ namespace sw
         {
             _items.RemoveAt(index);
 
-            NotifyCollectionChangedEventArgs args{};
-            args.action = NotifyCollectionChangedAction::Remove;
-            args.list   = this;
-            args.index  = index;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Remove, index);
         }
 
         /**
@@ -13270,11 +15878,7 @@ namespace sw
         {
             _items.Insert(index, value);
 
-            NotifyCollectionChangedEventArgs args{};
-            args.action = NotifyCollectionChangedAction::Add;
-            args.list   = this;
-            args.index  = index;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Add, index);
         }
 
         /**
@@ -13287,11 +15891,7 @@ namespace sw
         {
             _items.Insert(index, std::move(value));
 
-            NotifyCollectionChangedEventArgs args{};
-            args.action = NotifyCollectionChangedAction::Add;
-            args.list   = this;
-            args.index  = index;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Add, index);
         }
 
         /**
@@ -13317,12 +15917,7 @@ namespace sw
             items.erase(items.begin() + static_cast<size_t>(oldIndex));
             items.insert(items.begin() + static_cast<size_t>(newIndex), std::move(value));
 
-            NotifyCollectionChangedEventArgs args{};
-            args.action   = NotifyCollectionChangedAction::Move;
-            args.list     = this;
-            args.index    = newIndex;
-            args.oldIndex = oldIndex;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Move, newIndex, 1, oldIndex);
         }
 
         /**
@@ -13369,15 +15964,149 @@ namespace sw
 
             _items.RemoveAt(index);
 
-            NotifyCollectionChangedEventArgs args{};
-            args.action = NotifyCollectionChangedAction::Remove;
-            args.list   = this;
-            args.index  = index;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Remove, index);
 
             return true;
         }
 
+        /**
+         * @brief 在集合末尾追加一段元素，并触发一次添加通知
+         * @param first 要追加元素的起始迭代器
+         * @param last 要追加元素的结束迭代器
+         */
+        template <typename TIter>
+        void AddRange(TIter first, TIter last)
+        {
+            InsertRange(_items.Count(), first, last);
+        }
+
+        /**
+         * @brief 在集合末尾追加一段元素，并触发一次添加通知
+         * @param list 要追加的元素列表
+         */
+        void AddRange(std::initializer_list<T> list)
+        {
+            InsertRange(_items.Count(), list.begin(), list.end());
+        }
+
+        /**
+         * @brief 在指定索引处插入一段元素，并触发一次添加通知
+         * @param index 插入位置
+         * @param first 要插入元素的起始迭代器
+         * @param last 要插入元素的结束迭代器
+         * @throws std::out_of_range 索引超出范围
+         */
+        template <typename TIter>
+        void InsertRange(int index, TIter first, TIter last)
+        {
+            if (index < 0 || index > _items.Count()) {
+                throw std::out_of_range("Index out of range in ObservableCollection::InsertRange.");
+            }
+
+            auto &items   = _items.GetInternalVector();
+            size_t before = items.size();
+            items.insert(items.begin() + static_cast<size_t>(index), first, last);
+
+            int count = static_cast<int>(items.size() - before);
+            if (count > 0) {
+                _NotifyCollectionChanged(NotifyCollectionChangedAction::Add, index, count);
+            }
+        }
+
+        /**
+         * @brief 在指定索引处插入一段元素，并触发一次添加通知
+         * @param index 插入位置
+         * @param list 要插入的元素列表
+         * @throws std::out_of_range 索引超出范围
+         */
+        void InsertRange(int index, std::initializer_list<T> list)
+        {
+            InsertRange(index, list.begin(), list.end());
+        }
+
+        /**
+         * @brief 移除从指定索引开始的连续若干元素，并触发一次移除通知
+         * @param index 要移除的第一个元素的索引
+         * @param count 要移除的元素数量
+         * @throws std::out_of_range 索引或数量超出范围
+         */
+        void RemoveRange(int index, int count)
+        {
+            if (index < 0 || count < 0 || count > _items.Count() - index) {
+                throw std::out_of_range("Index out of range in ObservableCollection::RemoveRange.");
+            }
+
+            if (count == 0) {
+                return;
+            }
+
+            auto &items = _items.GetInternalVector();
+            auto begin  = items.begin() + static_cast<size_t>(index);
+            items.erase(begin, begin + static_cast<size_t>(count));
+
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Remove, index, count);
+        }
+
+        /**
+         * @brief 用一段元素依次替换从指定索引开始的元素，并触发一次替换通知
+         * @param index 要替换的第一个元素的索引
+         * @param first 新元素的起始迭代器
+         * @param last 新元素的结束迭代器
+         * @throws std::out_of_range 索引或新元素数量超出范围
+         * @note 需要先计算新元素数量再复制，输入迭代器只能遍历一次，会先将元素复制到临时的std::vector中
+         */
+        template <typename TIter>
+        void ReplaceRange(int index, TIter first, TIter last)
+        {
+            _ReplaceRange(index, first, last, typename std::iterator_traits<TIter>::iterator_category{});
+        }
+
+        /**
+         * @brief 用一段元素依次替换从指定索引开始的元素，并触发一次替换通知
+         * @param index 要替换的第一个元素的索引
+         * @param list 新元素列表
+         * @throws std::out_of_range 索引或新元素数量超出范围
+         */
+        void ReplaceRange(int index, std::initializer_list<T> list)
+        {
+            ReplaceRange(index, list.begin(), list.end());
+        }
+
+    private:
+        /**
+         * @brief ReplaceRange的实现，输入迭代器先复制到临时的std::vector中
+         */
+        template <typename TIter>
+        void _ReplaceRange(int index, TIter first, TIter last, std::input_iterator_tag)
+        {
+            std::vector<T> values(first, last);
+            _ReplaceRange(index, values.begin(), values.end(), std::forward_iterator_tag{});
+        }
+
+        /**
+         * @brief ReplaceRange的实现，前向迭代器可以遍历多次，先计算数量再直接复制
+         */
+        template <typename TIter>
+        void _ReplaceRange(int index, TIter first, TIter last, std::forward_iterator_tag)
+        {
+            int count = static_cast<int>(std::distance(first, last));
+
+            if (index < 0 || count > _items.Count() - index) {
+                throw std::out_of_range("Index out of range in ObservableCollection::ReplaceRange.");
+            }
+
+            if (count == 0) {
+                return;
+            }
+
+            auto &items = _items.GetInternalVector();
+            std::copy(first, last, items.begin() + static_cast<size_t>(index));
+
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Replace, index, count);
+        }
+
+    public:
+
         /**
          * @brief 将集合转换为字符串表示
          * @return 集合的字符串表示
@@ -13448,11 +16177,7 @@ namespace sw
         {
             _items.SetAt(index, value);
 
-            NotifyCollectionChangedEventArgs args{};
-            args.action = NotifyCollectionChangedAction::Replace;
-            args.list   = this;
-            args.index  = index;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Replace, index);
         }
 
         /**
@@ -13466,11 +16191,7 @@ namespace sw
         {
             _items.SetAt(index, std::move(value));
 
-            NotifyCollectionChangedEventArgs args{};
-            args.action = NotifyCollectionChangedAction::Replace;
-            args.list   = this;
-            args.index  = index;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Replace, index);
         }
     };
 }
@@ -13552,6 +16273,22 @@ namespace sw
             _innerBinding->SetBindingMode(mode);
         }
 
+        /**
+         * @brief 获取源属性更改时更新目标属性的时机
+         */
+        BindingUpdateMode GetUpdateMode() const
+        {
+            return _innerBinding->GetUpdateMode();
+        }
+
+        /**
+         * @brief 设置源属性更改时更新目标属性的时机
+         */
+        void SetUpdateMode(BindingUpdateMode mode)
+        {
+            _innerBinding->SetUpdateMode(mode);
+        }
+
         /**
          * @brief 获取目标对象
          */
@@ -14091,6 +16828,17 @@ namespace sw
          */
         DataContextChangedEventHandler _dataContextChanged;
 
+        /**
+         * @brief 缓存的有效数据上下文，仅在当前元素的DataContext为空时使用
+         */
+        DynamicObject *_currentDataContext = nullptr;
+
+        /**
+         * @brief _currentDataContext是否有效
+         * @note 若某元素的缓存有效，则其继承数据上下文的祖先元素的缓存也一定有效，失效时可据此剪枝
+         */
+        bool _isCurrentDataContextValid = false;
+
     public:
         /**
          * @brief 数据上下文改变时触发该事件
@@ -14113,6 +16861,7 @@ namespace sw
         /**
          * @brief 当前元素的有效数据上下文
          * @note 若当前元素的DataContext不为nullptr则返回该值，否则递归获取父元素的DataContext
+         * @note 解析结果会被缓存，在DataContext或父元素改变时失效
          */
         const ReadOnlyProperty<DynamicObject *> CurrentDataContext;
 
@@ -14206,6 +16955,18 @@ namespace sw
          */
         virtual void OnCurrentDataContextChanged(DynamicObject *oldDataContext);
 
+        /**
+         * @brief 使当前元素及继承其数据上下文的子元素的CurrentDataContext缓存失效
+         * @note 父元素改变后应调用此函数，若当前元素自身设置了DataContext则不会影响任何缓存
+         */
+        void InvalidateCurrentDataContext();
+
+    private:
+        /**
+         * @brief 使当前元素及继承其数据上下文的子元素的CurrentDataContext缓存失效，不检查当前元素的DataContext
+         */
+        void _InvalidateCurrentDataContextTree();
+
     public:
         /**
          * @brief 获取逻辑树中的父元素
@@ -14371,7 +17132,8 @@ namespace sw
          */
         struct _ChildInfo {
             ILayout *instance;         ///< 子元素对象
-            GridLayoutTag layoutTag;   ///< 布局标记
+            uint64_t sourceTag;        ///< 子元素原始的布局标记，用于判断布局标记是否改变
+            GridLayoutTag layoutTag;   ///< 修正后的布局标记
             GridRCType rowMeasureType; ///< 元素measure行时的类型
             GridRCType colMeasureType; ///< 元素measure列时的类型
         };
@@ -14398,10 +17160,14 @@ namespace sw
          * @brief 一些内部数据
          */
         struct {
-            std::vector<_RowInfo> rowsInfo;       ///< 行信息
-            std::vector<_ColInfo> colsInfo;       ///< 列信息
-            std::vector<_ChildInfo> childrenInfo; ///< 子元素信息
-            std::vector<Rect> cells;              ///< 保存格信息
+            std::vector<_RowInfo> rowsInfo;         ///< 行信息
+            std::vector<_ColInfo> colsInfo;         ///< 列信息
+            std::vector<_ChildInfo> childrenInfo;   ///< 子元素信息，与子元素顺序相同
+            std::vector<int> colMeasureOrder;       ///< measure列时子元素的顺序，保存childrenInfo的索引
+            std::vector<int> rowMeasureOrder;       ///< measure行时子元素的顺序，保存childrenInfo的索引
+            std::vector<GridRow> rowsDefinition;    ///< 生成rowsInfo时使用的行定义
+            std::vector<GridColumn> colsDefinition; ///< 生成colsInfo时使用的列定义
+            std::vector<Rect> cells;                ///< 保存格信息
         } _internalData;
 
     public:
@@ -14430,10 +17196,25 @@ namespace sw
 
     private:
         /**
-         * @brief 更新内部数据
+         * @brief 更新内部数据，仅在行列定义、子元素或其布局标记改变时重新生成
          */
         void _UpdateInternalData();
 
+        /**
+         * @brief 判断内部数据是否仍与当前的行列定义、子元素及其布局标记一致
+         */
+        bool _IsInternalDataValid();
+
+        /**
+         * @brief 将非FixSize行/列的尺寸重置为0，以便重新measure
+         */
+        void _ResetTrackSizes();
+
+        /**
+         * @brief 重新生成内部数据，并确定measure时子元素的顺序
+         */
+        void _RebuildInternalData();
+
         /**
          * @brief 获取指定行列处的网格信息
          */
@@ -14534,6 +17315,22 @@ namespace sw
             _innerBinding->SetBindingMode(mode);
         }
 
+        /**
+         * @brief 获取源属性更改时更新目标属性的时机
+         */
+        BindingUpdateMode GetUpdateMode() const
+        {
+            return _innerBinding->GetUpdateMode();
+        }
+
+        /**
+         * @brief 设置源属性更改时更新目标属性的时机
+         */
+        void SetUpdateMode(BindingUpdateMode mode)
+        {
+            _innerBinding->SetUpdateMode(mode);
+        }
+
         /**
          * @brief 获取目标元素
          * @return 目标元素指针
@@ -14792,6 +17589,19 @@ namespace sw
          */
         std::vector<std::unique_ptr<MenuItem>> _subItems{};
 
+        /**
+         * @brief 菜单项索引，用于按ID或tag查找菜单项
+         */
+        struct _MenuItemIndex {
+            std::unordered_map<int, MenuItem *> ids;            ///< ID到菜单项的映射
+            std::unordered_multimap<uint64_t, MenuItem *> tags; ///< tag到菜单项的映射，tag为0的菜单项不加入索引
+        };
+
+        /**
+         * @brief 根菜单项中记录其下所有菜单项的索引，非根菜单项为nullptr
+         */
+        std::unique_ptr<_MenuItemIndex> _index{};
+
     public:
         /**
          * @brief 菜单项Id
@@ -14939,6 +17749,7 @@ namespace sw
          * @brief 查找对应ID的子菜单项
          * @param id 子菜单项ID
          * @return 指向子菜单项的指针，如果未找到则返回nullptr
+         * @note 菜单项位于根菜单项下时通过根菜单项的索引查找，无需遍历
          */
         MenuItem *FindChildById(int id);
 
@@ -14946,25 +17757,52 @@ namespace sw
          * @brief 查找对应tag的子菜单项
          * @param tag 子菜单项tag
          * @return 指向子菜单项的指针，如果未找到则返回nullptr
+         * @note 菜单项位于根菜单项下且tag不为0时通过根菜单项的索引查找，无需遍历
+         */
+        MenuItem *FindChildByTag(uint64_t tag);
+
+        /**
+         * @brief 获取菜单项描述信息的副本
+         * @return 菜单项描述信息副本
+         */
+        MenuItemDesc CopyDescTree() const;
+
+    private:
+        /**
+         * @brief 重建菜单项
+         */
+        void _ResetMenuItem();
+
+        /**
+         * @brief 更新菜单项状态
+         */
+        void _UpdateState();
+
+        /**
+         * @brief 获取当前菜单项所在的根菜单项的索引
+         * @return 索引指针，若当前菜单项不在根菜单项下则返回nullptr
+         */
+        _MenuItemIndex *_GetRootIndex();
+
+        /**
+         * @brief 判断当前菜单项是否为指定菜单项本身或其祖先
          */
-        MenuItem *FindChildByTag(uint64_t tag);
+        bool _IsSelfOrAncestorOf(MenuItem *item) const;
 
         /**
-         * @brief 获取菜单项描述信息的副本
-         * @return 菜单项描述信息副本
+         * @brief 将指定菜单项及其所有子孙菜单项加入索引
          */
-        MenuItemDesc CopyDescTree() const;
+        static void _AddToIndex(_MenuItemIndex *index, MenuItem *item);
 
-    private:
         /**
-         * @brief 重建菜单项
+         * @brief 将指定菜单项及其所有子孙菜单项从索引中移除
          */
-        void _ResetMenuItem();
+        static void _RemoveFromIndex(_MenuItemIndex *index, MenuItem *item);
 
         /**
-         * @brief 更新菜单项状态
+         * @brief 将菜单项的tag从索引中移除
          */
-        void _UpdateState();
+        static void _RemoveTagFromIndex(_MenuItemIndex *index, MenuItem *item);
 
         /**
          * @brief 插入子菜单到指定父菜单项的指定位置
@@ -15856,10 +18694,22 @@ namespace sw
         /**
          * @brief 在窗口线程上执行指定委托，并立即返回
          * @param action 要执行的委托
-         * @return 若成功将委托放入窗口线程的消息队列则返回true，否则返回false
+         * @return 若成功将委托放入窗口线程的调度器或消息队列则返回true，否则返回false
+         * @note 窗口线程有调度器时以Render优先级放入调度器，否则投递WM_InvokeAction消息
          */
         bool InvokeAsync(const Action<> &action);
 
+        /**
+         * @brief 以指定优先级在窗口线程上执行指定委托，并立即返回
+         * @param action 要执行的委托
+         * @param priority 优先级，窗口线程没有调度器时忽略
+         * @param key 合并委托的键值，不为0时同一优先级中相同键值的委托在执行前只执行最后一个，窗口线程没有调度器时忽略
+         * @return 若成功将委托放入窗口线程的调度器并唤醒该线程，或成功投递到消息队列则返回true，否则返回false，
+         *         含义与Dispatcher::BeginInvoke的返回值相同
+         * @note 委托执行前窗口已被销毁或句柄已被重置时不会执行
+         */
+        bool InvokeAsync(const Action<> &action, DispatcherPriority priority, uint64_t key = 0);
+
         /**
          * @brief 获取当前窗口所属线程的线程id
          */
@@ -16523,6 +19373,10 @@ namespace sw
         /// 字体改变时更新布局
         FontChanged = 1 << 5,
 
+        /// 框架内部使用，表示已投递布局更新消息且尚未处理
+        /// @note 该标记仅在根元素上设置，用于合并同一轮消息循环中的多次布局更新请求
+        LayoutPending = 1 << 28,
+
         /// 框架内部使用，表示布局已失效
         /// @note 该标记指示了Measure函数的结果已失效，需要重新调用Measure函数来更新尺寸
         MeasureInvalidated = 1 << 29,
@@ -16538,6 +19392,47 @@ namespace sw
      */
     _SW_ENUM_ENABLE_BIT_OPERATIONS(LayoutUpdateCondition);
 
+    /**
+     * @brief 布局更新的统计数据
+     * @note 统计数据按线程记录
+     */
+    struct LayoutUpdateStatistics {
+        /**
+         * @brief 请求布局更新的次数
+         */
+        uint64_t invalidationCount = 0;
+
+        /**
+         * @brief 合并到已挂起的布局更新中的请求次数
+         */
+        uint64_t mergedInvalidationCount = 0;
+
+        /**
+         * @brief 实际执行的布局更新次数
+         */
+        uint64_t layoutPassCount = 0;
+
+        /**
+         * @brief 最近一次布局更新处理的请求数
+         */
+        uint32_t lastPassInvalidationCount = 0;
+
+        /**
+         * @brief 单次布局更新处理的最大请求数
+         */
+        uint32_t maxPassInvalidationCount = 0;
+
+        /**
+         * @brief Arrange时因位置和尺寸未变而跳过SetWindowPos或DeferWindowPos的次数
+         */
+        uint64_t skippedWindowPosCount = 0;
+
+        /**
+         * @brief Arrange时因位置、尺寸未变且测量未失效而跳过ArrangeOverride的次数
+         */
+        uint64_t skippedArrangeOverrideCount = 0;
+    };
+
     /**
      * @brief 表示界面中的元素
      */
@@ -16609,9 +19504,9 @@ namespace sw
         std::vector<UIElement *> _layoutVisibleChildren{};
 
         /**
-         * @brief 记录路由事件的map
+         * @brief 记录路由事件处理函数的表
          */
-        std::unordered_map<RoutedEventType, RoutedEventHandler> _eventMap{};
+        RoutedEventHandlerTable _eventTable{};
 
         /**
          * @brief 布局标记
@@ -16683,30 +19578,40 @@ namespace sw
          */
         HCURSOR _hCursor = NULL;
 
+        /**
+         * @brief 响应WM_CTLCOLORxxx时返回的背景画刷，由BrushCache::Acquire获取，背景色改变或元素析构时释放
+         */
+        HBRUSH _hCtlColorBrush = NULL;
+
+        /**
+         * @brief _hCtlColorBrush的颜色
+         */
+        COLORREF _ctlColorBrushColor = 0;
+
         /**
          * @brief 上一次Measure函数调用时的可用大小
          */
         Size _lastMeasureAvailableSize{};
 
         /**
-         * @brief 用于存储批量调整子元素位置时调用DeferWindowPos的句柄
+         * @brief 当前挂起的布局更新所合并的请求数，仅对根元素有效
          */
-        HDWP _hdwpChildren = NULL;
+        uint32_t _pendingInvalidationCount = 0;
 
         /**
-         * @brief OnColor函数中使用的背景画刷句柄
+         * @brief 用于存储批量调整子元素位置时调用DeferWindowPos的句柄
          */
-        HBRUSH _hCtlColorBrush = NULL;
+        HDWP _hdwpChildren = NULL;
 
         /**
-         * @brief 记录上一次调用OnColor时的文本颜色
+         * @brief 上一次Arrange时设置的窗口位置和尺寸（像素，right和bottom分别为宽和高）
          */
-        COLORREF _lastTextColor = 0;
+        RECT _lastArrangedRect{};
 
         /**
-         * @brief 记录上一次调用OnColor时的背景颜色
+         * @brief _lastArrangedRect是否有效
          */
-        COLORREF _lastBackColor = 0;
+        bool _hasArrangedRect = false;
 
         /**
          * @brief 当前元素是否响应鼠标事件
@@ -17038,10 +19943,27 @@ namespace sw
         bool IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition condition);
 
         /**
-         * @brief 使元素的布局状态失效，并立即触发布局更新
+         * @brief 使元素的布局状态失效，并请求更新布局
+         * @note 布局更新不会立即执行，而是向根元素投递一次WM_UpdateLayout消息，在当前消息循环中绘制之前完成，
+         *       在此之前的多次调用会合并为一次布局更新，若需要立即获取布局结果可调用UpdateLayoutNow函数
          */
         void InvalidateMeasure();
 
+        /**
+         * @brief 若当前元素所在的界面有挂起的布局更新，则立即执行布局更新
+         */
+        void UpdateLayoutNow();
+
+        /**
+         * @brief 获取当前线程的布局更新统计数据
+         */
+        static LayoutUpdateStatistics GetLayoutUpdateStatistics();
+
+        /**
+         * @brief 重置当前线程的布局更新统计数据
+         */
+        static void ResetLayoutUpdateStatistics();
+
         /**
          * @brief 尝试将当前元素移动到可视区域内
          * @return 若函数成功则返回true，否则返回false
@@ -17198,6 +20120,13 @@ namespace sw
          */
         virtual void ArrangeOverride(const Size &finalSize);
 
+        /**
+         * @brief 处理WM_UpdateLayout消息时调用该函数，清除挂起的布局更新并记录统计数据
+         * @param deferred 消息是否由InvalidateMeasure延迟投递
+         * @return 是否需要执行布局更新，若延迟投递的请求已被UpdateLayoutNow提前处理则返回false
+         */
+        bool AcceptLayoutUpdate(bool deferred);
+
         /**
          * @brief 设置背景颜色
          * @param color 要设置的颜色
@@ -17480,6 +20409,13 @@ namespace sw
          */
         void _SetMeasureInvalidated();
 
+        /**
+         * @brief 判断窗口是否已按上一次Arrange的结果位于指定位置
+         * @param pxRect 窗口的位置和尺寸（像素，right和bottom分别为宽和高）
+         * @return 若上一次Arrange设置的位置和尺寸与pxRect相同，且窗口当前的位置和尺寸也与之相同则返回true
+         */
+        bool _IsArrangedAt(const RECT &pxRect);
+
         /**
          * @brief 更新_layoutVisibleChildren的内容
          */
@@ -17653,7 +20589,7 @@ namespace sw
         template <typename T>
         void AddHandler(RoutedEventType eventType, T &obj, void (T::*handler)(UIElement &, RoutedEventArgs &))
         {
-            if (handler) this->_eventMap[eventType].Add(obj, handler);
+            if (handler) this->_eventTable.GetOrAdd(eventType).Add(obj, handler);
         }
 
         /**
@@ -17727,7 +20663,9 @@ namespace sw
         template <typename T>
         bool RemoveHandler(RoutedEventType eventType, T &obj, void (T::*handler)(UIElement &, RoutedEventArgs &))
         {
-            return handler == nullptr ? false : this->_eventMap[eventType].Remove(obj, handler);
+            if (handler == nullptr) return false;
+            auto eventHandler = this->_eventTable.Find(eventType);
+            return eventHandler != nullptr && eventHandler->Remove(obj, handler);
         }
 
         /**
@@ -18361,6 +21299,9 @@ namespace sw
                 return TBase::MeasureOverride(availableSize);
             }
 
+            _UpdateLayoutViewport(*layout, this->ClientRect->GetSize());
+
+            LayoutProfiler::Scope profilerScope(layout, LayoutPass::Measure);
             return layout->MeasureOverride(availableSize);
         }
 
@@ -18380,6 +21321,7 @@ namespace sw
                 _MeasureAndArrangeWithoutResize(*layout, finalSize);
             } else {
                 // 已设置布局方式且AutoSize为true，此时子元素已Measure，调用Arrange即可
+                LayoutProfiler::Scope profilerScope(layout, LayoutPass::Arrange);
                 layout->ArrangeOverride(finalSize);
             }
         }
@@ -18574,7 +21516,9 @@ namespace sw
          */
         void UpdateScrollRange()
         {
-            if (_GetLayout() == nullptr) {
+            LayoutHost *layout = _GetLayout();
+
+            if (layout == nullptr) {
                 // 当未设置布局方式时滚动条和控件位置需要手动设置
                 // 将以下俩字段设为false确保xxxScrollLimit属性在未设置布局方式时仍可用
                 _horizontalScrollDisabled = false;
@@ -18582,8 +21526,10 @@ namespace sw
                 return;
             }
 
+            Size contentExtent = layout->GetContentExtent();
+
             if (HorizontalScrollBar) {
-                double childRightmost = this->GetChildRightmost(true);
+                double childRightmost = Utils::Max(this->GetChildRightmost(true), contentExtent.width);
 
                 if (int(childRightmost - this->ClientWidth) > 0) {
                     _horizontalScrollDisabled = false;
@@ -18604,7 +21550,7 @@ namespace sw
             }
 
             if (VerticalScrollBar) {
-                double childBottommost = this->GetChildBottommost(true);
+                double childBottommost = Utils::Max(this->GetChildBottommost(true), contentExtent.height);
 
                 if (int(childBottommost - this->ClientHeight) > 0) {
                     _verticalScrollDisabled = false;
@@ -18708,14 +21654,29 @@ namespace sw
             }
         }
 
+        /**
+         * @brief 将当前滚动位置与客户区尺寸作为可视区域通知布局对象
+         */
+        void _UpdateLayoutViewport(LayoutHost &layout, const Size &clientSize)
+        {
+            layout.UpdateViewport(sw::Rect{-this->GetInternalArrangeOffsetX(), -this->GetInternalArrangeOffsetY(), clientSize.width, clientSize.height});
+        }
+
         /**
          * @brief 使用设定的布局方式对子元素进行Measure和Arrange，不改变当前的尺寸和DesireSize
          */
         void _MeasureAndArrangeWithoutResize(LayoutHost &layout, const Size &clientSize)
         {
             if (layout.IsAssociated(this)) {
-                layout.MeasureOverride(clientSize);
-                layout.ArrangeOverride(clientSize);
+                _UpdateLayoutViewport(layout, clientSize);
+                {
+                    LayoutProfiler::Scope profilerScope(&layout, LayoutPass::Measure);
+                    layout.MeasureOverride(clientSize);
+                }
+                {
+                    LayoutProfiler::Scope profilerScope(&layout, LayoutPass::Arrange);
+                    layout.ArrangeOverride(clientSize);
+                }
             }
         }
     };
@@ -19401,6 +22362,7 @@ namespace sw
         /**
          * @brief 当数据源集合发生变更时调用该函数
          * @param args 包含集合变更信息的事件参数
+         * @note 对于Add、Remove与Replace，args.count给出从args.index开始连续变更的项数，子类应一次处理整段变更
          */
         virtual void OnCurrentItemsSourceCollectionChanged(const NotifyCollectionChangedEventArgs &args) = 0;
 
@@ -20160,6 +23122,31 @@ namespace sw
          */
         bool _acceptTab = false;
 
+        /**
+         * @brief 通过AppendText追加、尚未写入控件的文本
+         */
+        std::wstring _pendingAppendText{};
+
+        /**
+         * @brief 是否已投递写入追加文本的消息
+         */
+        bool _isAppendPosted = false;
+
+        /**
+         * @brief 是否正在写入追加文本，此时控件发出的EN_CHANGE不使储存的文本失效
+         */
+        bool _isAppending = false;
+
+        /**
+         * @brief 追加文本后保留的最大行数，0表示不限制
+         */
+        int _maxLineCount = 0;
+
+        /**
+         * @brief 追加文本后保留的最大字符数，0表示不限制
+         */
+        int _maxTextLength = 0;
+
     public:
         /**
          * @brief 是否只读
@@ -20181,6 +23168,17 @@ namespace sw
          */
         const Property<bool> AcceptTab;
 
+        /**
+         * @brief 通过AppendText或AppendLines追加文本后保留的最大行数，超出时从开头删除多余的行，0表示不限制
+         * @note 行数为控件中显示的行数，自动换行时一行文本可能占用多行
+         */
+        const Property<int> MaxLineCount;
+
+        /**
+         * @brief 通过AppendText或AppendLines追加文本后保留的最大字符数，超出时从开头按行删除，0表示不限制
+         */
+        const Property<int> MaxTextLength;
+
     public:
         /**
          * @brief 初始化TextBoxBase
@@ -20204,6 +23202,12 @@ namespace sw
          */
         virtual std::wstring &GetInternalText() override;
 
+        /**
+         * @brief 设置窗口文本，尚未写入的追加文本将被丢弃
+         * @param value 要设置的文本
+         */
+        virtual void SetInternalText(const std::wstring &value) override;
+
         /**
          * @brief 当父窗口接收到控件的WM_COMMAND时调用该函数
          * @param code 通知代码
@@ -20226,6 +23230,12 @@ namespace sw
          */
         virtual bool OnKeyDown(VirtualKey key, const KeyFlags &flags) override;
 
+        /**
+         * @brief 控件句柄发生改变时调用该函数
+         * @param hwnd 新的控件句柄
+         */
+        virtual void OnHandleChanged(HWND hwnd) override;
+
     public:
         /**
          * @brief 选择指定文本内容
@@ -20255,6 +23265,24 @@ namespace sw
          */
         void Clear();
 
+        /**
+         * @brief 在末尾追加文本，不读取和重新设置整个文本
+         * @note 同一轮消息循环中的多次追加会合并为一次写入，在此之前读取Text属性或调用FlushAppendText会立即写入
+         * @param text 要追加的文本
+         */
+        void AppendText(const std::wstring &text);
+
+        /**
+         * @brief 在末尾追加若干行文本，每行末尾添加换行符
+         * @param lines 要追加的行
+         */
+        void AppendLines(const std::vector<std::wstring> &lines);
+
+        /**
+         * @brief 立即将尚未写入的追加文本写入控件，并按MaxLineCount和MaxTextLength删除开头多余的文本
+         */
+        void FlushAppendText();
+
     private:
         /**
          * @brief 读取HorizontalContentAlignment属性时调用
@@ -20265,6 +23293,12 @@ namespace sw
          * @brief 写入HorizontalContentAlignment属性时调用
          */
         void _SetHorzContentAlignment(sw::HorizontalAlignment value);
+
+        /**
+         * @brief 计算按MaxLineCount和MaxTextLength需要从开头删除的字符数
+         * @param endsWithNewLine 文本是否以换行符结尾，此时不计末尾的空行
+         */
+        int _GetAppendTrimLength(bool endsWithNewLine);
     };
 }
 
@@ -21403,6 +24437,16 @@ namespace sw
          */
         ObservableCollection<std::wstring> _items;
 
+        /**
+         * @brief 虚拟模式下用于查找子项的索引，为nullptr时逐项比较显示文本
+         */
+        IItemSearchIndex *_searchIndex = nullptr;
+
+        /**
+         * @brief 虚拟模式下输入字符时的增量查找
+         */
+        IncrementalItemSearch _incrementalSearch;
+
     public:
         /**
          * @brief 列表框的子项集合，当未设置ItemsSource时使用该集合作为数据源
@@ -21414,6 +24458,20 @@ namespace sw
          */
         const Property<bool> IsEditable;
 
+        /**
+         * @brief 是否以虚拟模式显示子项，虚拟模式下控件为自绘且不保存子项文本，
+         *        绘制时才通过GetDisplayText从数据源读取，适用于子项较多的情况
+         * @note 虚拟模式下输入字符时通过FindString按前缀查找并选中子项
+         * @note 原生组合框没有只设置数量的存储方式，控件中仍为每个子项保留一个不含文本的占位项，
+         *       子项数量变化时发送的消息数与变化量成正比，从空列表绑定n个子项仍需n次CB_ADDSTRING
+         */
+        const Property<bool> VirtualMode;
+
+        /**
+         * @brief 虚拟模式下FindString使用的索引，为nullptr时逐项比较显示文本
+         */
+        const Property<IItemSearchIndex *> SearchIndex;
+
     public:
         /**
          * @brief 初始化组合框
@@ -21435,6 +24493,14 @@ namespace sw
          */
         void CloseDropDown();
 
+        /**
+         * @brief 查找显示文本以指定前缀开头的子项，不区分大小写
+         * @param prefix 要查找的前缀
+         * @param startIndex 从该索引的下一项开始查找，到末尾后从头继续查找至该项，为-1时从头查找整个列表
+         * @return 找到的子项索引，未找到时返回-1
+         */
+        int FindString(const std::wstring &prefix, int startIndex = -1);
+
     protected:
         /**
          * @brief 获取默认数据源，当ItemsSource未设置时使用该数据源
@@ -21483,6 +24549,33 @@ namespace sw
          */
         virtual void OnSelectionChanged() override;
 
+        /**
+         * @brief 字体改变时调用该函数
+         * @param hfont 字体句柄
+         */
+        virtual void FontChanged(HFONT hfont) override;
+
+        /**
+         * @brief 控件句柄发生改变时调用该函数
+         * @param hwnd 新的控件句柄
+         */
+        virtual void OnHandleChanged(HWND hwnd) override;
+
+        /**
+         * @brief 接收到WM_CHAR时调用该函数
+         * @param ch 按键的字符代码
+         * @param flags 附加信息
+         * @return 若已处理该消息则返回true，否则返回false以调用DefaultWndProc
+         */
+        virtual bool OnChar(wchar_t ch, const KeyFlags &flags) override;
+
+        /**
+         * @brief 父窗口接收到WM_DRAWITEM后且父窗口OnDrawItem函数返回false时调用发出通知控件的该函数
+         * @param pDrawItem 包含有关要绘制的项和所需绘图类型的信息的结构体指针
+         * @return 若已处理该消息则返回true，否则返回false以调用DefaultWndProc
+         */
+        virtual bool OnDrawItemSelf(DRAWITEMSTRUCT *pDrawItem) override;
+
         /**
          * @brief 获取子项要显示的文本
          * @param index 子项索引
@@ -21519,6 +24612,24 @@ namespace sw
          * @param index 要删除的项的索引
          */
         void _DeleteString(int index);
+
+        /**
+         * @brief 虚拟模式下调整控件中占位项的数量
+         * @param count 新的子项数量
+         * @note 只添加或删除差额部分的占位项，数量不变时不发送消息
+         */
+        void _SetCount(int count);
+
+        /**
+         * @brief 虚拟模式下根据字体更新子项和选择框的高度
+         */
+        void _UpdateItemHeight();
+
+        /**
+         * @brief 虚拟模式下处理输入的字符，按已输入的文本查找并选中子项
+         * @param ch 输入的字符
+         */
+        void _IncrementalSearch(wchar_t ch);
     };
 }
 
@@ -23227,6 +26338,125 @@ namespace sw
     };
 }
 
+// VirtualizingStackPanel.h
+
+
+namespace sw
+{
+    /**
+     * @brief 虚拟化堆叠面板，按数据源中的项生成子元素，只为可视区域内的项创建子元素
+     * @note 子元素由面板创建并持有，离开可视区域的子元素会被隐藏并在之后呈现其他项时复用
+     * @note 面板按滚动条位置确定可视区域，通常与VerticalScrollBar（水平排列时为HorizontalScrollBar）一同使用
+     */
+    class VirtualizingStackPanel : public Panel, public IItemGenerator
+    {
+    private:
+        /**
+         * @brief 默认布局对象
+         */
+        VirtualizingStackLayout _virtualizingLayout{};
+
+        /**
+         * @brief 数据源
+         */
+        IList *_itemsSource = nullptr;
+
+        /**
+         * @brief 若数据源实现了INotifyCollectionChanged接口，则指向该接口以便订阅事件；否则为nullptr
+         */
+        INotifyCollectionChanged *_notifyCollectionChanged = nullptr;
+
+        /**
+         * @brief 面板创建的全部子元素
+         */
+        std::vector<std::unique_ptr<UIElement>> _itemContainers{};
+
+        /**
+         * @brief 已回收、可供复用的子元素
+         */
+        std::vector<UIElement *> _recycledContainers{};
+
+    public:
+        /**
+         * @brief 排列方式
+         */
+        const Property<sw::Orientation> Orientation;
+
+        /**
+         * @brief 未实现化过的项在堆叠方向上的估计尺寸
+         */
+        const Property<double> EstimatedItemExtent;
+
+        /**
+         * @brief 数据源
+         */
+        const Property<IList *> ItemsSource;
+
+        /**
+         * @brief 当前已创建的子元素数量，包括已回收的子元素
+         */
+        const ReadOnlyProperty<int> ItemContainerCount;
+
+    public:
+        /**
+         * @brief 初始化VirtualizingStackPanel
+         */
+        VirtualizingStackPanel();
+
+        /**
+         * @brief 析构函数
+         */
+        virtual ~VirtualizingStackPanel();
+
+        /**
+         * @brief 获取数据源中项的数量
+         */
+        virtual int GetItemCount() override;
+
+        /**
+         * @brief 为指定索引处的项准备一个子元素，优先复用已回收的子元素
+         */
+        virtual ILayout &RealizeItem(int index) override;
+
+        /**
+         * @brief 隐藏不再可见的子元素以供复用
+         */
+        virtual void RecycleItem(int index, ILayout &container) override;
+
+    protected:
+        /**
+         * @brief 获取默认布局对象
+         */
+        virtual LayoutHost *GetDefaultLayout() override final;
+
+        /**
+         * @brief 创建用于呈现项的子元素，默认创建Label
+         * @return 新创建的子元素，其所有权转交给面板
+         */
+        virtual UIElement *CreateItemContainer();
+
+        /**
+         * @brief 使子元素呈现指定的项，子元素被创建或复用时调用
+         * @param container 子元素
+         * @param index 项的索引
+         * @param item 包含项数据的Variant对象
+         * @note 默认实现在项为std::wstring时将其设为子元素的文本
+         */
+        virtual void PrepareItemContainer(UIElement &container, int index, const Variant &item);
+
+    private:
+        /**
+         * @brief 回收全部子元素并重新布局
+         */
+        void _ResetItems();
+
+        /**
+         * @brief 处理数据源集合变更事件的函数
+         */
+        void _CollectionChangedEventHandler(INotifyCollectionChanged &sender, NotifyCollectionChangedEventArgs &args);
+    };
+}
+
 // WrapPanel.h
 
 
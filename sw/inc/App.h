@@ -2,8 +2,10 @@
 
 #include "Delegate.h"
 #include "Event.h"
+#include "IdleScheduler.h"
 #include "Property.h"
 #include <string>
+#include <vector>
 #include <windows.h>
 
 namespace sw
@@ -60,12 +62,46 @@ namespace sw
          */
         static const Property<AppQuitMode> QuitMode;
 
+        /**
+         * @brief 当前线程消息循环每次执行空闲任务的时间预算，单位为毫秒，默认为8
+         * @note 该属性是线程局部的，每个线程有各自独立的值
+         */
+        static const Property<int> IdleBudget;
+
         /**
          * @brief 消息循环
          * @return 退出代码
+         * @note 进入消息循环前会创建当前线程的调度器，见Dispatcher::GetCurrent
+         * @note 每处理一条消息后调用Binding::FlushDeferredUpdates更新延迟绑定
+         * @note 消息队列为空时在IdleBudget内执行当前线程的空闲任务，有输入消息到达时立即停止
          */
         static int MsgLoop();
 
+        /**
+         * @brief 为当前线程的消息循环注册空闲任务
+         * @param name 任务名称，用于统计信息
+         * @param task 任务，每次调用应只处理一小部分工作，返回是否仍有工作，
+         *             返回false后在消息循环处理下一条消息前不再调用
+         * @return 任务id，用于移除任务
+         */
+        static int AddIdleTask(const std::wstring &name, const Func<bool> &task);
+
+        /**
+         * @brief 移除当前线程的空闲任务，可在空闲任务中调用
+         * @return 是否找到并移除了任务
+         */
+        static bool RemoveIdleTask(int id);
+
+        /**
+         * @brief 获取当前线程各空闲任务的调用次数与耗时
+         */
+        static std::vector<IdleTaskStatistics> GetIdleTaskStatistics();
+
+        /**
+         * @brief 清除当前线程各空闲任务的统计信息
+         */
+        static void ResetIdleTaskStatistics();
+
         /**
          * @brief 退出当前线程的消息循环
          * @param exitCode 退出代码
@@ -4,6 +4,8 @@
 #include "INotifyObjectDead.h"
 #include "INotifyPropertyChanged.h"
 #include "IValueConverter.h"
+#include "ObservableObject.h"
+#include <vector>
 
 namespace sw
 {
@@ -24,6 +26,19 @@ namespace sw
         TwoWay,
     };
 
+    /**
+     * @brief 源属性更改时更新目标属性的时机
+     */
+    enum class BindingUpdateMode {
+        /// 源属性更改时立即更新目标属性
+        Immediate,
+
+        /// 源属性更改时只将绑定加入引发更改的线程的队列，由该线程的Binding::FlushDeferredUpdates统一更新，
+        /// App::MsgLoop在每轮消息处理后调用，多次更改只以最新的源属性值更新一次。
+        /// 绑定只能在引发更改的线程中或该线程退出后销毁
+        Deferred,
+    };
+
     /**
      * @brief 数据绑定基类
      */
@@ -110,6 +125,39 @@ namespace sw
          */
         Func<Binding *, bool> _updateSourceFunc;
 
+        /**
+         * @brief 源属性更改时更新目标属性的时机
+         */
+        BindingUpdateMode _updateMode = BindingUpdateMode::Immediate;
+
+        /**
+         * @brief 等待延迟更新目标属性的绑定，每个线程一个
+         */
+        struct _DeferredQueue {
+            std::vector<Binding *> items; // 按首次标记的顺序排列，已取消的项为nullptr
+            size_t pendingCount = 0;      // items中不为nullptr的项数
+            bool isFlushing     = false;  // 是否正在执行FlushDeferredUpdates
+            Action<> requestHandler;      // 队列由空变为非空时调用
+
+            // 线程退出时解除队列中绑定与队列的关联
+            ~_DeferredQueue()
+            {
+                for (Binding *item : items) {
+                    if (item != nullptr) item->_deferredQueue = nullptr;
+                }
+            }
+        };
+
+        /**
+         * @brief 绑定所在的等待延迟更新的队列，不在队列中时为nullptr
+         */
+        _DeferredQueue *_deferredQueue = nullptr;
+
+        /**
+         * @brief 绑定在_deferredQueue->items中的索引
+         */
+        size_t _deferredIndex = 0;
+
     private:
         /**
          * @brief 默认构造函数
@@ -134,6 +182,7 @@ namespace sw
          */
         virtual ~Binding()
         {
+            CancelDeferredUpdate();
             UnregisterNotifications();
 
             if (_converterDeleter && _converter) {
@@ -193,6 +242,14 @@ namespace sw
             return _mode;
         }
 
+        /**
+         * @brief 获取源属性更改时更新目标属性的时机
+         */
+        BindingUpdateMode GetUpdateMode() const
+        {
+            return _updateMode;
+        }
+
         /**
          * @brief 获取目标对象
          */
@@ -220,6 +277,21 @@ namespace sw
             }
         }
 
+        /**
+         * @brief 修改源属性更改时更新目标属性的时机
+         * @note 从Deferred改为Immediate时若有等待中的更新则立即更新目标属性
+         */
+        void SetUpdateMode(BindingUpdateMode mode)
+        {
+            if (_updateMode != mode) {
+                _updateMode = mode;
+                if (mode == BindingUpdateMode::Immediate && _deferredQueue != nullptr) {
+                    CancelDeferredUpdate();
+                    UpdateTarget();
+                }
+            }
+        }
+
         /**
          * @brief 修改目标对象
          */
@@ -268,14 +340,23 @@ namespace sw
          */
         void RegisterNotifications()
         {
+            ObservableObject *targetObservable     = nullptr;
+            ObservableObject *sourceObservable     = nullptr;
             INotifyPropertyChanged *targetNotifObj = nullptr;
             INotifyPropertyChanged *sourceNotifObj = nullptr;
 
-            if (_targetObject != nullptr && _targetObject->IsType(&targetNotifObj)) {
+            // 对于ObservableObject按属性ID订阅，避免每次属性更改都调用对象上的所有绑定
+            if (_targetObject != nullptr && _targetObject->IsType(&targetObservable)) {
+                targetObservable->AddPropertyChangedHandler(
+                    _targetPropertyId, PropertyChangedEventHandler(*this, &Binding::OnTargetPropertyChanged));
+            } else if (_targetObject != nullptr && _targetObject->IsType(&targetNotifObj)) {
                 targetNotifObj->PropertyChanged +=
                     PropertyChangedEventHandler(*this, &Binding::OnTargetPropertyChanged);
             }
-            if (_sourceObject != nullptr && _sourceObject->IsType(&sourceNotifObj)) {
+            if (_sourceObject != nullptr && _sourceObject->IsType(&sourceObservable)) {
+                sourceObservable->AddPropertyChangedHandler(
+                    _sourcePropertyId, PropertyChangedEventHandler(*this, &Binding::OnSourcePropertyChanged));
+            } else if (_sourceObject != nullptr && _sourceObject->IsType(&sourceNotifObj)) {
                 sourceNotifObj->PropertyChanged +=
                     PropertyChangedEventHandler(*this, &Binding::OnSourcePropertyChanged);
             }
@@ -298,14 +379,23 @@ namespace sw
          */
         void UnregisterNotifications()
         {
+            ObservableObject *targetObservable     = nullptr;
+            ObservableObject *sourceObservable     = nullptr;
             INotifyPropertyChanged *targetNotifObj = nullptr;
             INotifyPropertyChanged *sourceNotifObj = nullptr;
 
-            if (_targetObject != nullptr && _targetObject->IsType(&targetNotifObj)) {
+            // 对于ObservableObject按属性ID订阅，避免每次属性更改都调用对象上的所有绑定
+            if (_targetObject != nullptr && _targetObject->IsType(&targetObservable)) {
+                targetObservable->RemovePropertyChangedHandler(
+                    _targetPropertyId, PropertyChangedEventHandler(*this, &Binding::OnTargetPropertyChanged));
+            } else if (_targetObject != nullptr && _targetObject->IsType(&targetNotifObj)) {
                 targetNotifObj->PropertyChanged -=
                     PropertyChangedEventHandler(*this, &Binding::OnTargetPropertyChanged);
             }
-            if (_sourceObject != nullptr && _sourceObject->IsType(&sourceNotifObj)) {
+            if (_sourceObject != nullptr && _sourceObject->IsType(&sourceObservable)) {
+                sourceObservable->RemovePropertyChangedHandler(
+                    _sourcePropertyId, PropertyChangedEventHandler(*this, &Binding::OnSourcePropertyChanged));
+            } else if (_sourceObject != nullptr && _sourceObject->IsType(&sourceNotifObj)) {
                 sourceNotifObj->PropertyChanged -=
                     PropertyChangedEventHandler(*this, &Binding::OnSourcePropertyChanged);
             }
@@ -349,7 +439,11 @@ namespace sw
 
             if (_mode == BindingMode::TwoWay ||
                 _mode == BindingMode::OneWay) {
-                UpdateTarget();
+                if (_updateMode == BindingUpdateMode::Deferred) {
+                    ScheduleDeferredUpdate();
+                } else {
+                    UpdateTarget();
+                }
             }
         }
 
@@ -378,6 +472,7 @@ namespace sw
                 case BindingMode::OneTime:
                 case BindingMode::OneWay:
                 case BindingMode::TwoWay: {
+                    CancelDeferredUpdate();
                     UpdateTarget();
                     break;
                 }
@@ -388,6 +483,54 @@ namespace sw
             }
         }
 
+        /**
+         * @brief 获取当前线程等待延迟更新的队列
+         */
+        static _DeferredQueue &GetDeferredQueue()
+        {
+            static thread_local _DeferredQueue queue;
+            return queue;
+        }
+
+        /**
+         * @brief 将绑定加入当前线程等待延迟更新的队列，已在队列中时保持原有位置
+         */
+        void ScheduleDeferredUpdate()
+        {
+            if (_deferredQueue != nullptr) {
+                return;
+            }
+
+            _DeferredQueue &queue = GetDeferredQueue();
+
+            _deferredQueue = &queue;
+            _deferredIndex = queue.items.size();
+            queue.items.push_back(this);
+
+            if (queue.pendingCount++ == 0 && !queue.isFlushing && queue.requestHandler) {
+                queue.requestHandler();
+            }
+        }
+
+        /**
+         * @brief 将绑定从所在的等待延迟更新的队列中移除
+         */
+        void CancelDeferredUpdate()
+        {
+            if (_deferredQueue == nullptr) {
+                return;
+            }
+
+            _DeferredQueue &queue = *_deferredQueue;
+
+            queue.items[_deferredIndex] = nullptr;
+            _deferredQueue              = nullptr;
+
+            if (--queue.pendingCount == 0 && !queue.isFlushing) {
+                queue.items.clear();
+            }
+        }
+
         /**
          * @brief 内部创建绑定对象函数
          * @param target 目标对象指针
@@ -420,6 +563,65 @@ namespace sw
         }
 
     public:
+        /**
+         * @brief 判断当前线程是否有等待延迟更新的绑定
+         */
+        static bool HasDeferredUpdates()
+        {
+            return GetDeferredQueue().pendingCount != 0;
+        }
+
+        /**
+         * @brief 设置当前线程的等待延迟更新的队列由空变为非空时调用的函数
+         * @note App::MsgLoop通过该函数让调度器在下一轮消息处理中调用FlushDeferredUpdates，
+         *       使空闲任务与模态消息循环中产生的延迟更新也能及时应用
+         */
+        static void SetDeferredUpdateRequestHandler(const Action<> &handler)
+        {
+            GetDeferredQueue().requestHandler = handler;
+        }
+
+        /**
+         * @brief 以源属性的最新值更新当前线程中所有等待延迟更新的绑定的目标属性
+         * @note 按绑定首次被标记的顺序更新，更新过程中新标记的绑定在同一次调用中更新
+         * @note 在更新目标属性的过程中嵌套调用时直接返回
+         * @note 更新目标属性时抛出异常会中断本次更新，尚未更新的绑定保留在队列中，在下次调用时更新
+         */
+        static void FlushDeferredUpdates()
+        {
+            _DeferredQueue &queue = GetDeferredQueue();
+
+            if (queue.isFlushing || queue.pendingCount == 0) {
+                return;
+            }
+
+            // 离开函数时（包括抛出异常时）结束刷新状态，使队列可以继续使用
+            struct _FlushScope {
+                _DeferredQueue &queue;
+
+                ~_FlushScope()
+                {
+                    if (queue.pendingCount == 0) {
+                        queue.items.clear();
+                    }
+                    queue.isFlushing = false;
+                }
+            } scope{queue};
+
+            queue.isFlushing = true;
+
+            // 更新目标属性时可能有新的绑定加入队列，因此按索引遍历
+            for (size_t i = 0; i < queue.items.size(); ++i) {
+                Binding *binding = queue.items[i];
+                if (binding != nullptr) {
+                    queue.items[i]          = nullptr;
+                    binding->_deferredQueue = nullptr;
+                    --queue.pendingCount;
+                    binding->UpdateTarget();
+                }
+            }
+        }
+
         /**
          * @brief 创建绑定对象
          * @param target 目标对象指针
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <windows.h>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+namespace sw
+{
+    /**
+     * @brief 画刷缓存的统计信息
+     */
+    struct BrushCacheStatistics {
+        uint64_t createdCount = 0; ///< 新建画刷的次数
+        uint64_t reusedCount  = 0; ///< 复用已缓存画刷的次数
+        uint64_t evictedCount = 0; ///< 销毁已缓存画刷的次数，包括超出容量与调用Clear时
+        int brushCount        = 0; ///< 当前缓存的画刷数量
+        int acquiredCount     = 0; ///< 当前通过Acquire持有引用、不会被销毁的画刷数量
+    };
+
+    /**
+     * @brief 线程内的纯色画刷缓存，按颜色缓存最近使用的画刷，超出容量时销毁最久未使用的画刷
+     * @note 画刷由缓存持有，调用方不能销毁获取到的画刷。通过GetBrush获取的画刷不应长期保存：
+     *       之后获取其他颜色的画刷可能使其被销毁，应在每次绘制时重新获取；
+     *       需要在返回后继续使用的画刷（例如响应WM_CTLCOLORxxx时返回给系统的画刷）应通过Acquire获取，
+     *       在引用计数归零前不会被销毁
+     * @note 每个线程拥有独立的缓存，线程结束时销毁该线程缓存的所有画刷
+     */
+    class BrushCache
+    {
+    public:
+        /**
+         * @brief 默认容量
+         */
+        static constexpr int DefaultCapacity = 32;
+
+    private:
+        /**
+         * @brief 缓存的画刷信息
+         */
+        struct _BrushInfo {
+            COLORREF color;
+            HBRUSH hBrush;
+            int refCount;
+        };
+
+        /**
+         * @brief 缓存的画刷，按最近使用的顺序排列，表头为最近使用的画刷
+         */
+        std::list<_BrushInfo> _brushes;
+
+        /**
+         * @brief 颜色到_brushes中对应项的映射
+         */
+        std::unordered_map<COLORREF, std::list<_BrushInfo>::iterator> _index;
+
+        /**
+         * @brief 画刷句柄到_brushes中对应项的映射，用于Release
+         */
+        std::unordered_map<HBRUSH, std::list<_BrushInfo>::iterator> _handles;
+
+        /**
+         * @brief 最多缓存的画刷数量
+         */
+        int _capacity = DefaultCapacity;
+
+        /**
+         * @brief 统计信息
+         */
+        BrushCacheStatistics _statistics;
+
+    public:
+        /**
+         * @brief 析构函数，销毁缓存的所有画刷
+         */
+        ~BrushCache();
+
+        /**
+         * @brief 获取指定颜色的纯色画刷
+         * @return 画刷句柄，创建失败时返回NULL
+         */
+        static HBRUSH GetBrush(COLORREF color);
+
+        /**
+         * @brief 获取指定颜色的纯色画刷，并增加其引用计数
+         * @return 画刷句柄，创建失败时返回NULL
+         * @note 引用计数不为零的画刷不会因超出容量或调用Clear而被销毁，使用完后需在同一线程调用Release
+         */
+        static HBRUSH Acquire(COLORREF color);
+
+        /**
+         * @brief 减少通过Acquire获取的画刷的引用计数，归零后按最近使用的顺序参与淘汰
+         * @note 传入NULL、不是由当前线程的缓存创建的句柄或在线程的缓存销毁后调用时不做任何操作
+         */
+        static void Release(HBRUSH hBrush);
+
+        /**
+         * @brief 获取当前线程缓存的容量
+         */
+        static int GetCapacity();
+
+        /**
+         * @brief 设置当前线程缓存的容量，缓存的画刷多于该值时立即销毁最久未使用的画刷
+         * @param capacity 容量，小于1时按1处理
+         * @note 通过Acquire持有引用的画刷不计入容量
+         */
+        static void SetCapacity(int capacity);
+
+        /**
+         * @brief 销毁当前线程缓存的所有未被引用的画刷
+         * @note 通过Acquire持有引用的画刷（例如控件正在使用的背景画刷）不会被销毁，因此可以在窗口存在时调用
+         */
+        static void Clear();
+
+        /**
+         * @brief 获取当前线程缓存的统计信息
+         */
+        static BrushCacheStatistics GetStatistics();
+
+    private:
+        /**
+         * @brief 默认构造函数
+         */
+        BrushCache() = default;
+
+        /**
+         * @brief 获取当前线程的缓存对象
+         */
+        static BrushCache &_GetInstance();
+
+        /**
+         * @brief 当前线程的缓存对象是否已销毁，线程结束时静态对象的析构函数可能在其后调用Release
+         */
+        static bool &_IsDestroyed();
+
+        /**
+         * @brief 获取指定颜色的画刷并将其标记为最近使用，不存在时创建
+         */
+        std::list<_BrushInfo>::iterator _Get(COLORREF color);
+
+        /**
+         * @brief 销毁最久未使用且未被引用的画刷，直到未被引用的画刷数量不超过maxCount
+         */
+        void _Trim(int maxCount);
+    };
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "IItemSearchIndex.h"
+#include "IncrementalItemSearch.h"
 #include "ItemsControl.h"
 #include "ObservableCollection.h"
 
@@ -26,6 +28,16 @@ namespace sw
          */
         ObservableCollection<std::wstring> _items;
 
+        /**
+         * @brief 虚拟模式下用于查找子项的索引，为nullptr时逐项比较显示文本
+         */
+        IItemSearchIndex *_searchIndex = nullptr;
+
+        /**
+         * @brief 虚拟模式下输入字符时的增量查找
+         */
+        IncrementalItemSearch _incrementalSearch;
+
     public:
         /**
          * @brief 列表框的子项集合，当未设置ItemsSource时使用该集合作为数据源
@@ -37,6 +49,20 @@ namespace sw
          */
         const Property<bool> IsEditable;
 
+        /**
+         * @brief 是否以虚拟模式显示子项，虚拟模式下控件为自绘且不保存子项文本，
+         *        绘制时才通过GetDisplayText从数据源读取，适用于子项较多的情况
+         * @note 虚拟模式下输入字符时通过FindString按前缀查找并选中子项
+         * @note 原生组合框没有只设置数量的存储方式，控件中仍为每个子项保留一个不含文本的占位项，
+         *       子项数量变化时发送的消息数与变化量成正比，从空列表绑定n个子项仍需n次CB_ADDSTRING
+         */
+        const Property<bool> VirtualMode;
+
+        /**
+         * @brief 虚拟模式下FindString使用的索引，为nullptr时逐项比较显示文本
+         */
+        const Property<IItemSearchIndex *> SearchIndex;
+
     public:
         /**
          * @brief 初始化组合框
@@ -58,6 +84,14 @@ namespace sw
          */
         void CloseDropDown();
 
+        /**
+         * @brief 查找显示文本以指定前缀开头的子项，不区分大小写
+         * @param prefix 要查找的前缀
+         * @param startIndex 从该索引的下一项开始查找，到末尾后从头继续查找至该项，为-1时从头查找整个列表
+         * @return 找到的子项索引，未找到时返回-1
+         */
+        int FindString(const std::wstring &prefix, int startIndex = -1);
+
     protected:
         /**
          * @brief 获取默认数据源，当ItemsSource未设置时使用该数据源
@@ -106,6 +140,33 @@ namespace sw
          */
         virtual void OnSelectionChanged() override;
 
+        /**
+         * @brief 字体改变时调用该函数
+         * @param hfont 字体句柄
+         */
+        virtual void FontChanged(HFONT hfont) override;
+
+        /**
+         * @brief 控件句柄发生改变时调用该函数
+         * @param hwnd 新的控件句柄
+         */
+        virtual void OnHandleChanged(HWND hwnd) override;
+
+        /**
+         * @brief 接收到WM_CHAR时调用该函数
+         * @param ch 按键的字符代码
+         * @param flags 附加信息
+         * @return 若已处理该消息则返回true，否则返回false以调用DefaultWndProc
+         */
+        virtual bool OnChar(wchar_t ch, const KeyFlags &flags) override;
+
+        /**
+         * @brief 父窗口接收到WM_DRAWITEM后且父窗口OnDrawItem函数返回false时调用发出通知控件的该函数
+         * @param pDrawItem 包含有关要绘制的项和所需绘图类型的信息的结构体指针
+         * @return 若已处理该消息则返回true，否则返回false以调用DefaultWndProc
+         */
+        virtual bool OnDrawItemSelf(DRAWITEMSTRUCT *pDrawItem) override;
+
         /**
          * @brief 获取子项要显示的文本
          * @param index 子项索引
@@ -142,5 +203,23 @@ namespace sw
          * @param index 要删除的项的索引
          */
         void _DeleteString(int index);
+
+        /**
+         * @brief 虚拟模式下调整控件中占位项的数量
+         * @param count 新的子项数量
+         * @note 只添加或删除差额部分的占位项，数量不变时不发送消息
+         */
+        void _SetCount(int count);
+
+        /**
+         * @brief 虚拟模式下根据字体更新子项和选择框的高度
+         */
+        void _UpdateItemHeight();
+
+        /**
+         * @brief 虚拟模式下处理输入的字符，按已输入的文本查找并选中子项
+         * @param ch 输入的字符
+         */
+        void _IncrementalSearch(wchar_t ch);
     };
 }
@@ -61,6 +61,10 @@ namespace sw
 
     /**
      * @brief 用于存储和管理多个可调用对象的列表，针对单个可调用对象的情况进行优化
+     * @note 第一个可调用对象若足够小（不超过对象指针加成员函数指针的大小）且可无异常移动，
+     *       可通过Emplace直接构造在内部缓冲区中，不会分配堆内存
+     * @note 存储多个可调用对象时列表采用写时复制：GetSnapshot返回的快照与列表共享存储，
+     *       仅当快照仍被持有时修改列表才会复制存储，因此调用委托时无需复制列表
      */
     template <typename T>
     class CallableList
@@ -81,20 +85,73 @@ namespace sw
          */
         using TSharedList = std::vector<std::shared_ptr<TCallable>>;
 
+        /**
+         * @brief 指向共享列表存储的智能指针类型别名
+         */
+        using TListPtr = std::shared_ptr<TSharedList>;
+
+        /**
+         * @brief 只读列表快照类型别名
+         */
+        using TSnapshot = std::shared_ptr<const TSharedList>;
+
     private:
+        /**
+         * @brief 仅用于计算成员函数指针的最大尺寸的不完整类型
+         */
+        struct _IncompleteClass;
+
+        /**
+         * @brief 内联缓冲区大小，可容纳虚表指针、对象指针与任意成员函数指针
+         */
+        static constexpr size_t _InlineSize =
+            sizeof(void *) * 2 + sizeof(void (_IncompleteClass::*)());
+
+        /**
+         * @brief 内联存储的可调用对象的类型相关操作
+         */
+        struct _InlineOps {
+            void (*copy)(void *dst, const TCallable &src);     ///< 在dst处拷贝构造src
+            void (*relocate)(void *dst, TCallable &src);       ///< 将src移动到dst并析构src
+            TCallable *(*moveToHeap)(TCallable &src);          ///< 将src移动到新分配的堆对象中
+        };
+
+        /**
+         * @brief 判断TImpl能否内联存储
+         */
+        template <typename TImpl>
+        struct _IsInlineStorable : std::integral_constant<
+                                       bool,
+                                       sizeof(TImpl) <= _InlineSize &&
+                                           alignof(TImpl) <= alignof(void *) &&
+                                           std::is_nothrow_move_constructible<TImpl>::value &&
+                                           std::is_copy_constructible<TImpl>::value> {
+        };
+
         /**
          * @brief 内部存储可调用对象的联合体
          */
         mutable union {
             alignas(TSinglePtr) uint8_t _single[sizeof(TSinglePtr)];
-            alignas(TSharedList) uint8_t _list[sizeof(TSharedList)];
+            alignas(TListPtr) uint8_t _list[sizeof(TListPtr)];
         } _data = {};
 
+        /**
+         * @brief 内联存储可调用对象的缓冲区
+         */
+        alignas(void *) mutable uint8_t _inline[_InlineSize];
+
+        /**
+         * @brief 当状态为STATE_INLINE时内联对象的类型相关操作
+         */
+        const _InlineOps *_ops = nullptr;
+
         /**
          * @brief 当前状态枚举
          */
         enum : uint8_t {
             STATE_NONE,   ///< 未存储任何可调用对象
+            STATE_INLINE, ///< 在内部缓冲区中储存了一个可调用对象
             STATE_SINGLE, ///< 储存了一个可调用对象
             STATE_LIST,   ///< 储存了多个可调用对象
         } _state = STATE_NONE;
@@ -125,9 +182,9 @@ namespace sw
 
         /**
          * @brief 拷贝赋值运算
-         * @note 强异常安全：先在本地完成可能抛异常的 Clone / vector 拷贝，
-         *       全部成功后再原子地切换 *this 的状态。提交阶段（_Reset(state) 与
-         *       unique_ptr/vector 的移动赋值）均为 noexcept，不会导致中间不一致。
+         * @note 强异常安全：先在本地完成可能抛异常的 Clone / 内联对象拷贝，全部成功后再原子地切换 *this 的状态。
+         *       提交阶段（_Reset(state)、智能指针的赋值与内联对象的移动）均为 noexcept，不会导致中间不一致。
+         * @note 多个可调用对象时与other共享列表存储，之后任一方被修改时才会复制
          */
         CallableList &operator=(const CallableList &other)
         {
@@ -140,6 +197,12 @@ namespace sw
                     _Reset();
                     break;
                 }
+                case STATE_INLINE: {
+                    CallableList copied;
+                    copied._EmplaceCopy(other);
+                    *this = std::move(copied);
+                    break;
+                }
                 case STATE_SINGLE: {
                     std::unique_ptr<TCallable> cloned(other._GetSingle()->Clone());
                     _Reset(STATE_SINGLE);
@@ -147,9 +210,9 @@ namespace sw
                     break;
                 }
                 case STATE_LIST: {
-                    TSharedList copied = other._GetList();
+                    TListPtr shared = other._GetListPtr();
                     _Reset(STATE_LIST);
-                    _GetList() = std::move(copied);
+                    _GetListPtr() = std::move(shared);
                     break;
                 }
             }
@@ -171,13 +234,20 @@ namespace sw
                 case STATE_NONE: {
                     break;
                 }
+                case STATE_INLINE: {
+                    other._ops->relocate(_inline, other._GetInline());
+                    _ops         = other._ops;
+                    _state       = STATE_INLINE;
+                    other._state = STATE_NONE;
+                    break;
+                }
                 case STATE_SINGLE: {
                     _GetSingle() = std::move(other._GetSingle());
                     other._Reset();
                     break;
                 }
                 case STATE_LIST: {
-                    _GetList() = std::move(other._GetList());
+                    _GetListPtr() = std::move(other._GetListPtr());
                     other._Reset();
                     break;
                 }
@@ -200,6 +270,7 @@ namespace sw
         size_t Count() const noexcept
         {
             switch (_state) {
+                case STATE_INLINE:
                 case STATE_SINGLE: {
                     return 1;
                 }
@@ -233,11 +304,10 @@ namespace sw
          * @brief 添加一个可调用对象到列表中
          * @note 传入对象的生命周期将由CallableList管理
          * @note 异常安全：
-         *       - SINGLE→LIST 升级时使用 reserve(2) 避免后续 emplace_back 触发扩容，
-         *         并使用 shared_ptr(unique_ptr&&) 接管所有权，构造失败时原 unique_ptr
-         *         不会释放其管理的对象。
+         *       - SINGLE/INLINE→LIST 升级时使用 reserve(2) 避免后续 emplace_back 触发扩容，
+         *         并使用 shared_ptr 接管所有权，构造失败时原对象保持不变，传入对象会被正确释放。
          *       - STATE_LIST 分支先把裸指针转交给本地 shared_ptr，再 emplace_back，
-         *         即使 vector 扩容失败，本地 shared_ptr 析构时也会正确释放对象。
+         *         即使复制列表存储或 vector 扩容失败，本地 shared_ptr 析构时也会正确释放对象。
          */
         void Add(TCallable *callable)
         {
@@ -253,32 +323,68 @@ namespace sw
                     _GetSingle() = std::move(owned);
                     break;
                 }
+                case STATE_INLINE: {
+                    TListPtr list = std::make_shared<TSharedList>();
+                    list->reserve(2);
+                    std::shared_ptr<TCallable> incoming(std::move(owned));
+                    std::shared_ptr<TCallable> current(_ops->moveToHeap(_GetInline()));
+                    list->emplace_back(std::move(current));
+                    list->emplace_back(std::move(incoming));
+                    _Reset(STATE_LIST);
+                    _GetListPtr() = std::move(list);
+                    break;
+                }
                 case STATE_SINGLE: {
-                    TSharedList list;
-                    list.reserve(2);
+                    TListPtr list = std::make_shared<TSharedList>();
+                    list->reserve(2);
                     std::shared_ptr<TCallable> incoming(std::move(owned));
                     std::shared_ptr<TCallable> current(std::move(_GetSingle()));
-                    list.emplace_back(std::move(current));
-                    list.emplace_back(std::move(incoming));
+                    list->emplace_back(std::move(current));
+                    list->emplace_back(std::move(incoming));
                     _Reset(STATE_LIST);
-                    _GetList() = std::move(list);
+                    _GetListPtr() = std::move(list);
                     break;
                 }
                 case STATE_LIST: {
                     std::shared_ptr<TCallable> sp(std::move(owned));
-                    _GetList().emplace_back(std::move(sp));
+                    _GetMutableList().emplace_back(std::move(sp));
                     break;
                 }
             }
         }
 
+        /**
+         * @brief 构造一个TImpl类型的可调用对象并添加到列表中
+         * @note 列表为空且TImpl可以内联存储时直接在内部缓冲区中构造，否则在堆上构造后调用Add
+         */
+        template <typename TImpl, typename... TArgs>
+        void Emplace(TArgs &&...args)
+        {
+            _Emplace<TImpl>(_IsInlineStorable<TImpl>{}, std::forward<TArgs>(args)...);
+        }
+
+        /**
+         * @brief 添加other中指定索引处可调用对象的副本
+         * @note 若该对象在other中内联存储且当前列表为空，副本同样内联存储，不会分配内存
+         */
+        void AddCopy(const CallableList &other, size_t index)
+        {
+            if (index == 0 && other._state == STATE_INLINE && _state == STATE_NONE) {
+                _EmplaceCopy(other);
+            } else if (TCallable *callable = other.GetAt(index)) {
+                Add(callable->Clone());
+            }
+        }
+
         /**
          * @brief 移除指定索引处的可调用对象
          * @return 如果成功移除则返回true，否则返回false
+         * @throw std::bad_alloc 列表存储被快照共享且复制存储失败时
          */
-        bool RemoveAt(size_t index) noexcept
+        bool RemoveAt(size_t index)
         {
             switch (_state) {
+                case STATE_INLINE:
                 case STATE_SINGLE: {
                     if (index != 0) {
                         return false;
@@ -288,10 +394,10 @@ namespace sw
                     }
                 }
                 case STATE_LIST: {
-                    auto &list = _GetList();
-                    if (index >= list.size()) {
+                    if (index >= _GetList().size()) {
                         return false;
                     }
+                    auto &list = _GetMutableList();
                     list.erase(list.begin() + index);
                     if (list.empty()) {
                         _Reset();
@@ -314,6 +420,9 @@ namespace sw
         TCallable *GetAt(size_t index) const noexcept
         {
             switch (_state) {
+                case STATE_INLINE: {
+                    return index == 0 ? &_GetInline() : nullptr;
+                }
                 case STATE_SINGLE: {
                     return index == 0 ? _GetSingle().get() : nullptr;
                 }
@@ -336,7 +445,131 @@ namespace sw
             return GetAt(index);
         }
 
+        /**
+         * @brief 获取存储多个可调用对象时的只读快照
+         * @return 与列表共享存储的快照，若当前未处于多个可调用对象的状态则返回nullptr
+         * @note 获取快照不会分配内存。持有快照期间对列表的修改会先复制存储，快照内容保持不变，
+         *       因此可以在遍历快照时安全地添加或移除可调用对象
+         */
+        TSnapshot GetSnapshot() const noexcept
+        {
+            return _state == STATE_LIST ? TSnapshot(_GetListPtr()) : TSnapshot();
+        }
+
+        /**
+         * @brief 判断唯一的可调用对象是否内联存储
+         */
+        bool IsInline() const noexcept
+        {
+            return _state == STATE_INLINE;
+        }
+
+        /**
+         * @brief 内联存储的可调用对象的局部副本
+         * @note 内联对象执行时若向所在列表添加其他可调用对象，会被移至堆上并析构，
+         *       调用其局部副本可保证对象在调用返回前始终有效
+         */
+        class InlineCopy
+        {
+        public:
+            /**
+             * @brief 拷贝list中内联存储的可调用对象，list的状态须为STATE_INLINE
+             */
+            explicit InlineCopy(const CallableList &list)
+            {
+                list._ops->copy(_buf, list._GetInline());
+            }
+
+            InlineCopy(const InlineCopy &)            = delete;
+            InlineCopy &operator=(const InlineCopy &) = delete;
+
+            /**
+             * @brief 析构副本
+             */
+            ~InlineCopy()
+            {
+                (*this)->~TCallable();
+            }
+
+            /**
+             * @brief 访问副本
+             */
+            TCallable *operator->() noexcept
+            {
+                return reinterpret_cast<TCallable *>(_buf);
+            }
+
+        private:
+            /**
+             * @brief 存放副本的缓冲区
+             */
+            alignas(void *) uint8_t _buf[_InlineSize];
+        };
+
     private:
+        /**
+         * @brief 内部函数，获取TImpl类型的内联操作表
+         */
+        template <typename TImpl>
+        static const _InlineOps *_GetInlineOps() noexcept
+        {
+            static const _InlineOps ops = {
+                [](void *dst, const TCallable &src) {
+                    new (dst) TImpl(static_cast<const TImpl &>(src));
+                },
+                [](void *dst, TCallable &src) {
+                    new (dst) TImpl(std::move(static_cast<TImpl &>(src)));
+                    static_cast<TImpl &>(src).~TImpl();
+                },
+                [](TCallable &src) -> TCallable * {
+                    return new TImpl(std::move(static_cast<TImpl &>(src)));
+                },
+            };
+            return &ops;
+        }
+
+        /**
+         * @brief 内部函数，Emplace的内联存储实现
+         */
+        template <typename TImpl, typename... TArgs>
+        void _Emplace(std::true_type, TArgs &&...args)
+        {
+            if (_state != STATE_NONE) {
+                Add(new TImpl(std::forward<TArgs>(args)...));
+            } else {
+                new (_inline) TImpl(std::forward<TArgs>(args)...);
+                _ops   = _GetInlineOps<TImpl>();
+                _state = STATE_INLINE;
+            }
+        }
+
+        /**
+         * @brief 内部函数，Emplace的堆存储实现
+         */
+        template <typename TImpl, typename... TArgs>
+        void _Emplace(std::false_type, TArgs &&...args)
+        {
+            Add(new TImpl(std::forward<TArgs>(args)...));
+        }
+
+        /**
+         * @brief 内部函数，当前状态为STATE_NONE且other状态为STATE_INLINE时，拷贝other的内联对象
+         */
+        void _EmplaceCopy(const CallableList &other)
+        {
+            other._ops->copy(_inline, other._GetInline());
+            _ops   = other._ops;
+            _state = STATE_INLINE;
+        }
+
+        /**
+         * @brief 内部函数，当状态为STATE_INLINE时返回内联存储的可调用对象的引用
+         */
+        TCallable &_GetInline() const noexcept
+        {
+            return *reinterpret_cast<TCallable *>(_inline);
+        }
+
         /**
          * @brief 内部函数，当状态为STATE_SINGLE时返回单个可调用对象的引用，
          */
@@ -346,11 +579,31 @@ namespace sw
         }
 
         /**
-         * @brief 内部函数，当状态为STATE_LIST时返回可调用对象列表的引用
+         * @brief 内部函数，当状态为STATE_LIST时返回列表存储智能指针的引用
+         */
+        constexpr TListPtr &_GetListPtr() const noexcept
+        {
+            return *reinterpret_cast<TListPtr *>(_data._list);
+        }
+
+        /**
+         * @brief 内部函数，当状态为STATE_LIST时返回可调用对象列表的只读引用
          */
-        constexpr TSharedList &_GetList() const noexcept
+        const TSharedList &_GetList() const noexcept
         {
-            return *reinterpret_cast<TSharedList *>(_data._list);
+            return *_GetListPtr();
+        }
+
+        /**
+         * @brief 内部函数，当状态为STATE_LIST时返回可修改的可调用对象列表，若存储被快照共享则先复制
+         */
+        TSharedList &_GetMutableList()
+        {
+            auto &ptr = _GetListPtr();
+            if (ptr.use_count() > 1) {
+                ptr = std::make_shared<TSharedList>(*ptr);
+            }
+            return *ptr;
         }
 
         /**
@@ -362,13 +615,18 @@ namespace sw
                 case STATE_NONE: {
                     break;
                 }
+                case STATE_INLINE: {
+                    _GetInline().~TCallable();
+                    _state = STATE_NONE;
+                    break;
+                }
                 case STATE_SINGLE: {
                     _GetSingle().~TSinglePtr();
                     _state = STATE_NONE;
                     break;
                 }
                 case STATE_LIST: {
-                    _GetList().~TSharedList();
+                    _GetListPtr().~TListPtr();
                     _state = STATE_NONE;
                     break;
                 }
@@ -389,7 +647,7 @@ namespace sw
                     break;
                 }
                 case STATE_LIST: {
-                    new (_data._list) TSharedList();
+                    new (_data._list) TListPtr();
                     _state = STATE_LIST;
                     break;
                 }
@@ -502,10 +760,16 @@ namespace sw
             }
 
         public:
-            // 禁用拷贝/移动：默认实现会按字节拷贝 _storage，不会调用 T 的构造函数，
-            // 对非平凡可拷贝类型会破坏不变式。需要克隆请走 Clone()。
-            _CallableWrapperImpl(const _CallableWrapperImpl &)            = delete;
-            _CallableWrapperImpl(_CallableWrapperImpl &&)                 = delete;
+            // 拷贝/移动构造经由 T 的构造函数完成（默认实现会按字节拷贝 _storage），
+            // 供 CallableList 内联存储时拷贝与搬移使用。赋值没有用途，保持禁用。
+            _CallableWrapperImpl(const _CallableWrapperImpl &other)
+                : _CallableWrapperImpl(other.GetValue())
+            {
+            }
+            _CallableWrapperImpl(_CallableWrapperImpl &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+                : _CallableWrapperImpl(std::move(other.GetValue()))
+            {
+            }
             _CallableWrapperImpl &operator=(const _CallableWrapperImpl &) = delete;
             _CallableWrapperImpl &operator=(_CallableWrapperImpl &&)      = delete;
         };
@@ -549,9 +813,9 @@ namespace sw
             }
 
         public:
-            // 禁用拷贝/移动：与 _CallableWrapperImpl 保持一致，需要克隆请走 Clone()。
-            _MemberFuncWrapper(const _MemberFuncWrapper &)            = delete;
-            _MemberFuncWrapper(_MemberFuncWrapper &&)                 = delete;
+            // 仅包含指针，拷贝/移动构造可直接使用默认实现；与 _CallableWrapperImpl 保持一致禁用赋值。
+            _MemberFuncWrapper(const _MemberFuncWrapper &)            = default;
+            _MemberFuncWrapper(_MemberFuncWrapper &&)                 = default;
             _MemberFuncWrapper &operator=(const _MemberFuncWrapper &) = delete;
             _MemberFuncWrapper &operator=(_MemberFuncWrapper &&)      = delete;
         };
@@ -592,9 +856,9 @@ namespace sw
             }
 
         public:
-            // 禁用拷贝/移动：与 _CallableWrapperImpl 保持一致，需要克隆请走 Clone()。
-            _ConstMemberFuncWrapper(const _ConstMemberFuncWrapper &)            = delete;
-            _ConstMemberFuncWrapper(_ConstMemberFuncWrapper &&)                 = delete;
+            // 仅包含指针，拷贝/移动构造可直接使用默认实现；与 _CallableWrapperImpl 保持一致禁用赋值。
+            _ConstMemberFuncWrapper(const _ConstMemberFuncWrapper &)            = default;
+            _ConstMemberFuncWrapper(_ConstMemberFuncWrapper &&)                 = default;
             _ConstMemberFuncWrapper &operator=(const _ConstMemberFuncWrapper &) = delete;
             _ConstMemberFuncWrapper &operator=(_ConstMemberFuncWrapper &&)      = delete;
         };
@@ -662,7 +926,7 @@ namespace sw
         Delegate(const Delegate &other)
         {
             for (size_t i = 0; i < other._data.Count(); ++i) {
-                _data.Add(other._data[i]->Clone());
+                _data.AddCopy(other._data, i);
             }
         }
 
@@ -686,7 +950,7 @@ namespace sw
             CallableList<TRet(Args...)> copied;
 
             for (size_t i = 0; i < other._data.Count(); ++i) {
-                copied.Add(other._data[i]->Clone());
+                copied.AddCopy(other._data, i);
             }
             _data = std::move(copied);
             return *this;
@@ -721,7 +985,7 @@ namespace sw
                 if (delegate._data.IsEmpty()) {
                     return;
                 } else if (delegate._data.Count() == 1) {
-                    _data.Add(delegate._data[0]->Clone());
+                    _data.AddCopy(delegate._data, 0);
                     return;
                 }
             }
@@ -734,7 +998,7 @@ namespace sw
         void Add(TRet (*func)(Args...))
         {
             if (func != nullptr) {
-                _data.Add(new _CallableWrapper<decltype(func)>(func));
+                _Emplace<_CallableWrapper<decltype(func)>>(func);
             }
         }
 
@@ -745,7 +1009,7 @@ namespace sw
         auto Add(const T &callable)
             -> typename std::enable_if<!std::is_base_of<_ICallable, T>::value, void>::type
         {
-            _data.Add(new _CallableWrapper<T>(callable));
+            _Emplace<_CallableWrapper<T>>(callable);
         }
 
         /**
@@ -754,7 +1018,7 @@ namespace sw
         template <typename T>
         void Add(T &obj, TRet (T::*func)(Args...))
         {
-            _data.Add(new _MemberFuncWrapper<T>(obj, func));
+            _Emplace<_MemberFuncWrapper<T>>(obj, func);
         }
 
         /**
@@ -763,7 +1027,7 @@ namespace sw
         template <typename T>
         void Add(const T &obj, TRet (T::*func)(Args...) const)
         {
-            _data.Add(new _ConstMemberFuncWrapper<T>(obj, func));
+            _Emplace<_ConstMemberFuncWrapper<T>>(obj, func);
         }
 
         /**
@@ -1026,6 +1290,8 @@ namespace sw
          * @return 返回一个包含所有可调用对象返回值的vector
          * @note 多播调用时，前 N-1 次按左值传参，仅最后一次执行 std::forward，
          *       避免对 move-only 类型或右值引用形参反复 move 同一对象。
+         * @note 多播调用遍历调用开始时的快照：调用期间新增的可调用对象不会被调用，
+         *       被移除的可调用对象仍会在本次调用中执行
          */
         template <typename U = TRet>
         auto InvokeAll(Args... args) const
@@ -1036,9 +1302,15 @@ namespace sw
             if (count == 0) {
                 _ThrowEmptyDelegateError();
             } else if (count == 1) {
-                results.emplace_back(_data[0]->Invoke(std::forward<Args>(args)...));
+                if (_data.IsInline()) {
+                    typename CallableList<TRet(Args...)>::InlineCopy callable(_data);
+                    results.emplace_back(callable->Invoke(std::forward<Args>(args)...));
+                } else {
+                    results.emplace_back(_data[0]->Invoke(std::forward<Args>(args)...));
+                }
             } else {
-                auto list = _data;
+                auto snapshot = _data.GetSnapshot();
+                auto &list    = *snapshot;
                 results.reserve(count);
                 for (size_t i = 0; i + 1 < count; ++i) {
                     results.emplace_back(list[i]->Invoke(args...));
@@ -1049,6 +1321,53 @@ namespace sw
         }
 
     private:
+        /**
+         * @brief 判断T能否通过const引用调用
+         */
+        template <typename T, typename = void>
+        struct _IsConstInvocable : std::false_type {
+        };
+
+        template <typename T>
+        struct _IsConstInvocable<
+            T, decltype(void(std::declval<const T &>()(std::declval<Args>()...)))> : std::true_type {
+        };
+
+        /**
+         * @brief 判断包装类型是否可以内联存储在CallableList中
+         * @note 仅内联存储平凡可拷贝且调用时不修改自身的可调用对象（函数指针、非mutable的lambda、成员函数指针），
+         *       调用时直接调用其局部副本，结果与调用原对象相同
+         */
+        template <typename TImpl>
+        struct _IsInlinePayload : std::true_type {
+        };
+
+        template <typename T>
+        struct _IsInlinePayload<_CallableWrapperImpl<T>>
+            : std::integral_constant<bool, std::is_trivially_copyable<T>::value && _IsConstInvocable<T>::value> {
+        };
+
+        /**
+         * @brief 内部函数，构造一个TImpl类型的可调用对象并添加到委托中
+         */
+        template <typename TImpl, typename... TArgs>
+        void _Emplace(TArgs &&...args)
+        {
+            _EmplaceImpl<TImpl>(_IsInlinePayload<TImpl>{}, std::forward<TArgs>(args)...);
+        }
+
+        template <typename TImpl, typename... TArgs>
+        void _EmplaceImpl(std::true_type, TArgs &&...args)
+        {
+            _data.template Emplace<TImpl>(std::forward<TArgs>(args)...);
+        }
+
+        template <typename TImpl, typename... TArgs>
+        void _EmplaceImpl(std::false_type, TArgs &&...args)
+        {
+            _data.Add(new TImpl(std::forward<TArgs>(args)...));
+        }
+
         /**
          * @brief 内部函数，用于从后向前查找并移除一个可调用对象
          */
@@ -1074,6 +1393,7 @@ namespace sw
          * @brief 内部函数，Invoke和operator()的实现
          * @note 多播调用时，前 N-1 次按左值传参，仅最后一次执行 std::forward，
          *       避免对 move-only 类型或右值引用形参反复 move 同一对象。
+         * @note 多播调用遍历写时复制的快照，调用路径上不会分配内存
          */
         inline TRet _InvokeImpl(Args... args) const
         {
@@ -1081,9 +1401,15 @@ namespace sw
             if (count == 0) {
                 _ThrowEmptyDelegateError();
             } else if (count == 1) {
+                if (_data.IsInline()) {
+                    // 调用内联对象的局部副本，处理函数修改当前委托时不会影响正在执行的对象
+                    typename CallableList<TRet(Args...)>::InlineCopy callable(_data);
+                    return callable->Invoke(std::forward<Args>(args)...);
+                }
                 return _data[0]->Invoke(std::forward<Args>(args)...);
             } else {
-                auto list = _data;
+                auto snapshot = _data.GetSnapshot();
+                auto &list    = *snapshot;
                 for (size_t i = 0; i + 1 < count; ++i)
                     list[i]->Invoke(args...);
                 return list[count - 1]->Invoke(std::forward<Args>(args)...);
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "Delegate.h"
+#include "DispatcherQueue.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <windows.h>
+
+namespace sw
+{
+    /**
+     * @brief 线程的任务调度器，其他线程可以向其添加任务，任务在调度器所属线程的消息循环中批量执行
+     * @note 任务保存在DispatcherQueue中，同一时刻最多只有一条唤醒消息在消息队列中，不会因任务过多而占满消息队列
+     * @note 执行Render和Background优先级的任务时若有输入消息等待处理或超出时间预算则暂停，剩余任务通过计时器继续执行
+     */
+    class Dispatcher
+    {
+    private:
+        /**
+         * @brief 继续执行剩余任务的计时器id
+         */
+        static constexpr UINT_PTR _ContinueTimerId = 1;
+
+        /**
+         * @brief 每次执行Render和Background优先级任务的时间预算，单位为毫秒
+         */
+        static constexpr int _DrainBudgetMs = 8;
+
+        /**
+         * @brief 任务队列
+         */
+        DispatcherQueue _queue;
+
+        /**
+         * @brief 所属线程的id
+         */
+        DWORD _threadId;
+
+        /**
+         * @brief 接收唤醒消息的消息窗口
+         */
+        HWND _hwnd;
+
+        /**
+         * @brief 所属线程是否已退出
+         */
+        std::atomic<bool> _isShutdown{false};
+
+        /**
+         * @brief 是否已设置继续执行的计时器
+         */
+        bool _isTimerSet = false;
+
+    private:
+        /**
+         * @brief 为当前线程创建调度器
+         */
+        Dispatcher();
+
+    public:
+        /**
+         * @brief 释放未执行的任务
+         * @note 消息窗口在所属线程退出时销毁，最后一个引用可能由其他线程释放
+         */
+        ~Dispatcher();
+
+        Dispatcher(const Dispatcher &)            = delete;
+        Dispatcher &operator=(const Dispatcher &) = delete;
+
+        /**
+         * @brief 获取当前线程的调度器，不存在时创建
+         */
+        static std::shared_ptr<Dispatcher> GetCurrent();
+
+        /**
+         * @brief 获取指定线程的调度器，可在任意线程调用
+         * @return 指定线程的调度器，若该线程未创建调度器则返回nullptr
+         */
+        static std::shared_ptr<Dispatcher> FromThread(DWORD threadId);
+
+        /**
+         * @brief 获取调度器所属线程的id
+         */
+        DWORD GetThreadId() const noexcept;
+
+        /**
+         * @brief 判断当前线程是否为调度器所属线程
+         */
+        bool CheckAccess() const noexcept;
+
+        /**
+         * @brief 添加任务并立即返回，可在任意线程调用
+         * @param action 要执行的任务
+         * @param priority 优先级
+         * @param key 合并任务的键值，不为0时同一优先级中相同键值的任务在执行前只执行最后添加的一个，同一键值应始终使用同一优先级
+         * @return 若成功添加任务并已唤醒调度器所属线程则返回true；action为空或调度器所属线程已退出时返回false，任务不会执行；
+         *         唤醒消息投递失败（例如消息队列已满）时也返回false，此时任务已添加，将在之后任意一次成功的唤醒时执行，
+         *         调用者不应重复添加不带键值的任务
+         */
+        bool BeginInvoke(const Action<> &action, DispatcherPriority priority = DispatcherPriority::Render, uint64_t key = 0);
+
+        /**
+         * @brief 获取任务队列的统计信息，只能在调度器所属线程调用
+         */
+        DispatcherQueueMetrics GetMetrics() const;
+
+        /**
+         * @brief 清除任务队列的统计信息，只能在调度器所属线程调用
+         */
+        void ResetMetrics();
+
+    private:
+        /**
+         * @brief 处理唤醒消息与计时器消息，执行任务
+         */
+        void _OnWake();
+
+        /**
+         * @brief 线程退出时调用，销毁消息窗口
+         */
+        void _Shutdown();
+
+        /**
+         * @brief 消息窗口的窗口过程
+         */
+        static LRESULT CALLBACK _WndProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+    };
+}
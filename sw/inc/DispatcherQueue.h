@@ -0,0 +1,178 @@
+#pragma once
+
+#include "Delegate.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+
+namespace sw
+{
+    /**
+     * @brief 调度器中任务的优先级，数值越小优先级越高
+     */
+    enum class DispatcherPriority {
+        Input,      ///< 响应输入的任务
+        Render,     ///< 更新界面的任务
+        Background, ///< 后台任务
+    };
+
+    /**
+     * @brief 调度队列的统计信息，时间单位为纳秒
+     */
+    struct DispatcherQueueMetrics {
+        size_t depth            = 0; ///< 当前等待执行的任务数量，包括将被合并的任务
+        size_t maxDepth         = 0; ///< 等待执行的任务数量的最大值
+        uint64_t enqueuedCount  = 0; ///< 入队的任务数量
+        uint64_t executedCount  = 0; ///< 已执行的任务数量
+        uint64_t coalescedCount = 0; ///< 因同一键值有更新的任务而被丢弃的任务数量
+        uint64_t batchCount     = 0; ///< 调用Drain的次数
+        uint64_t totalLatency   = 0; ///< 已执行任务从入队到开始执行的时间之和
+        uint64_t maxLatency     = 0; ///< 已执行任务从入队到开始执行的最长时间
+    };
+
+    /**
+     * @brief 多生产者单消费者的任务队列，任意线程可以无锁地添加任务，由单个线程批量执行
+     * @note 每个优先级使用一个无锁链表，Drain按优先级从高到低执行，同一优先级内按入队顺序执行
+     * @note 键值不为0的任务在执行前若有相同优先级、相同键值的任务入队，则只执行最后入队的任务。
+     *       键值按优先级分别合并，不同优先级的任务执行顺序与入队顺序无关，因此同一键值应始终使用同一优先级，
+     *       否则先入队的高优先级任务可能先于后入队的低优先级任务执行，反之亦然
+     */
+    class DispatcherQueue
+    {
+    private:
+        /**
+         * @brief 优先级的数量
+         */
+        static constexpr int _PriorityCount = 3;
+
+        /**
+         * @brief 链表节点
+         */
+        struct _Node {
+            std::atomic<_Node *> next{nullptr}; // 下一节点
+            Action<> action;                    // 任务
+            uint64_t key         = 0;           // 合并任务的键值，0表示不合并
+            uint64_t enqueueTime = 0;           // 入队时间
+            bool superseded      = false;       // 是否已被相同键值的任务取代
+        };
+
+        /**
+         * @brief 一个优先级的任务链表，生产者在head处添加，消费者从tail处取出
+         */
+        struct _Level {
+            std::atomic<_Node *> head; // 最后入队的节点
+            _Node *tail;               // 下一个要取出的节点，仅由消费者访问
+            _Node stub;                // 哨兵节点
+            std::deque<_Node *> taken; // 已取出尚未执行的节点，仅由消费者访问
+
+            std::unordered_map<uint64_t, _Node *> pendingKeys; // taken中每个键值最后入队的节点，仅由消费者访问
+
+            _Level() : head(&stub), tail(&stub) {}
+        };
+
+        /**
+         * @brief 各优先级的任务链表
+         */
+        _Level _levels[_PriorityCount];
+
+        /**
+         * @brief 是否已请求消费者执行任务
+         */
+        std::atomic<bool> _wakeRequested{false};
+
+        /**
+         * @brief 计时起点
+         */
+        const std::chrono::steady_clock::time_point _epoch = std::chrono::steady_clock::now();
+
+        /**
+         * @brief 统计信息，生产者更新的计数使用原子操作
+         */
+        std::atomic<size_t> _depth{0};
+        std::atomic<size_t> _maxDepth{0};
+        std::atomic<uint64_t> _enqueuedCount{0};
+        uint64_t _executedCount  = 0;
+        uint64_t _coalescedCount = 0;
+        uint64_t _batchCount     = 0;
+        uint64_t _totalLatency   = 0;
+        uint64_t _maxLatency     = 0;
+
+    public:
+        /**
+         * @brief 创建空队列
+         */
+        DispatcherQueue() = default;
+
+        /**
+         * @brief 释放未执行的任务
+         */
+        ~DispatcherQueue();
+
+        DispatcherQueue(const DispatcherQueue &)            = delete;
+        DispatcherQueue &operator=(const DispatcherQueue &) = delete;
+
+        /**
+         * @brief 添加任务，可在任意线程调用
+         * @param action 要执行的任务
+         * @param priority 优先级
+         * @param key 合并任务的键值，不为0时同一优先级中相同键值的任务在执行前只保留最后一个
+         * @return 若调用者需要唤醒消费者执行Drain则返回true，否则表示已有唤醒请求尚未处理
+         */
+        bool Enqueue(const Action<> &action, DispatcherPriority priority, uint64_t key = 0);
+
+        /**
+         * @brief 撤销唤醒请求，使下次Enqueue重新返回true，用于唤醒消费者失败时
+         */
+        void CancelWakeRequest() noexcept;
+
+        /**
+         * @brief 执行任务，只能由消费者线程调用
+         * @note 每个优先级在开始执行时取出已入队的全部任务作为一批，此后入队的同一优先级的任务留到下次调用
+         * @param shouldYield 开始执行Render和Background优先级的每个任务前调用，返回true时停止执行，
+         *                    剩余任务保留到下次调用，为空时执行全部任务
+         * @return 是否仍有未执行的任务，返回true时调用者应安排再次调用Drain
+         */
+        bool Drain(const Func<bool> &shouldYield = nullptr);
+
+        /**
+         * @brief 获取统计信息，只能由消费者线程调用
+         */
+        DispatcherQueueMetrics GetMetrics() const;
+
+        /**
+         * @brief 清除除depth以外的统计信息，只能由消费者线程调用
+         */
+        void ResetMetrics();
+
+    private:
+        /**
+         * @brief 获取当前时间
+         */
+        uint64_t _Now() const noexcept;
+
+        /**
+         * @brief 将节点添加到链表
+         */
+        static void _Push(_Level &level, _Node *node) noexcept;
+
+        /**
+         * @brief 从链表取出一个节点
+         * @return 取出的节点，链表为空或有生产者尚未完成添加时返回nullptr
+         */
+        static _Node *_Pop(_Level &level) noexcept;
+
+        /**
+         * @brief 将链表中的节点全部移动到taken中，并标记被相同键值的任务取代的节点
+         */
+        void _Take(_Level &level);
+
+        /**
+         * @brief 执行taken中的节点
+         * @return 是否因shouldYield返回true而停止
+         */
+        bool _Run(_Level &level, const Func<bool> *shouldYield);
+    };
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Font.h"
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace sw
+{
+    /**
+     * @brief 字体缓存的统计信息
+     */
+    struct FontCacheStatistics {
+        uint64_t hitCount  = 0; ///< 获取字体句柄时命中缓存的次数
+        uint64_t missCount = 0; ///< 获取字体句柄时新建句柄的次数
+        int handleCount    = 0; ///< 当前缓存的字体句柄数量
+        int referenceCount = 0; ///< 当前所有字体句柄的引用计数之和
+    };
+
+    /**
+     * @brief 进程内共享的字体句柄缓存，相同LOGFONTW的字体共用同一个HFONT
+     * @note 句柄带有引用计数，通过Acquire获取的句柄在不再使用时须调用Release，引用计数归零时句柄被销毁
+     * @note 可在多个线程中使用
+     */
+    class FontCache
+    {
+    private:
+        /**
+         * @brief 计算LOGFONTW哈希值的函数对象
+         */
+        struct _LogFontHash {
+            size_t operator()(const LOGFONTW &logFont) const noexcept;
+        };
+
+        /**
+         * @brief 比较LOGFONTW是否相等的函数对象
+         */
+        struct _LogFontEqual {
+            bool operator()(const LOGFONTW &a, const LOGFONTW &b) const noexcept;
+        };
+
+        /**
+         * @brief 缓存的字体句柄信息
+         */
+        struct _HandleInfo {
+            LOGFONTW logFont; ///< 创建句柄时使用的LOGFONTW
+            int refCount;     ///< 引用计数
+        };
+
+        /**
+         * @brief 保护缓存数据的互斥量
+         */
+        std::mutex _mutex;
+
+        /**
+         * @brief LOGFONTW到字体句柄的映射
+         */
+        std::unordered_map<LOGFONTW, HFONT, _LogFontHash, _LogFontEqual> _handles;
+
+        /**
+         * @brief 字体句柄到其信息的映射
+         */
+        std::unordered_map<HFONT, _HandleInfo> _handleInfos;
+
+        /**
+         * @brief 统计信息
+         */
+        FontCacheStatistics _statistics;
+
+    public:
+        /**
+         * @brief 获取与指定LOGFONTW对应的字体句柄，并增加其引用计数
+         * @return 字体句柄，创建失败时返回NULL
+         */
+        static HFONT Acquire(const LOGFONTW &logFont);
+
+        /**
+         * @brief 获取与指定字体对应的字体句柄，并增加其引用计数
+         * @return 字体句柄，创建失败时返回NULL
+         */
+        static HFONT Acquire(const Font &font);
+
+        /**
+         * @brief 减少通过Acquire获取的字体句柄的引用计数，引用计数归零时销毁该句柄
+         * @note hfont为NULL或不是由缓存创建的句柄时不做任何操作
+         */
+        static void Release(HFONT hfont);
+
+        /**
+         * @brief 获取缓存的统计信息
+         */
+        static FontCacheStatistics GetStatistics();
+
+    private:
+        /**
+         * @brief 默认构造函数
+         */
+        FontCache() = default;
+
+        /**
+         * @brief 获取进程内唯一的缓存对象
+         */
+        static FontCache &_GetInstance();
+    };
+}
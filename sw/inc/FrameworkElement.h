@@ -56,6 +56,17 @@ namespace sw
          */
         DataContextChangedEventHandler _dataContextChanged;
 
+        /**
+         * @brief 缓存的有效数据上下文，仅在当前元素的DataContext为空时使用
+         */
+        DynamicObject *_currentDataContext = nullptr;
+
+        /**
+         * @brief _currentDataContext是否有效
+         * @note 若某元素的缓存有效，则其继承数据上下文的祖先元素的缓存也一定有效，失效时可据此剪枝
+         */
+        bool _isCurrentDataContextValid = false;
+
     public:
         /**
          * @brief 数据上下文改变时触发该事件
@@ -78,6 +89,7 @@ namespace sw
         /**
          * @brief 当前元素的有效数据上下文
          * @note 若当前元素的DataContext不为nullptr则返回该值，否则递归获取父元素的DataContext
+         * @note 解析结果会被缓存，在DataContext或父元素改变时失效
          */
         const ReadOnlyProperty<DynamicObject *> CurrentDataContext;
 
@@ -171,6 +183,18 @@ namespace sw
          */
         virtual void OnCurrentDataContextChanged(DynamicObject *oldDataContext);
 
+        /**
+         * @brief 使当前元素及继承其数据上下文的子元素的CurrentDataContext缓存失效
+         * @note 父元素改变后应调用此函数，若当前元素自身设置了DataContext则不会影响任何缓存
+         */
+        void InvalidateCurrentDataContext();
+
+    private:
+        /**
+         * @brief 使当前元素及继承其数据上下文的子元素的CurrentDataContext缓存失效，不检查当前元素的DataContext
+         */
+        void _InvalidateCurrentDataContextTree();
+
     public:
         /**
          * @brief 获取逻辑树中的父元素
@@ -143,7 +143,8 @@ namespace sw
          */
         struct _ChildInfo {
             ILayout *instance;         ///< 子元素对象
-            GridLayoutTag layoutTag;   ///< 布局标记
+            uint64_t sourceTag;        ///< 子元素原始的布局标记，用于判断布局标记是否改变
+            GridLayoutTag layoutTag;   ///< 修正后的布局标记
             GridRCType rowMeasureType; ///< 元素measure行时的类型
             GridRCType colMeasureType; ///< 元素measure列时的类型
         };
@@ -170,10 +171,14 @@ namespace sw
          * @brief 一些内部数据
          */
         struct {
-            std::vector<_RowInfo> rowsInfo;       ///< 行信息
-            std::vector<_ColInfo> colsInfo;       ///< 列信息
-            std::vector<_ChildInfo> childrenInfo; ///< 子元素信息
-            std::vector<Rect> cells;              ///< 保存格信息
+            std::vector<_RowInfo> rowsInfo;         ///< 行信息
+            std::vector<_ColInfo> colsInfo;         ///< 列信息
+            std::vector<_ChildInfo> childrenInfo;   ///< 子元素信息，与子元素顺序相同
+            std::vector<int> colMeasureOrder;       ///< measure列时子元素的顺序，保存childrenInfo的索引
+            std::vector<int> rowMeasureOrder;       ///< measure行时子元素的顺序，保存childrenInfo的索引
+            std::vector<GridRow> rowsDefinition;    ///< 生成rowsInfo时使用的行定义
+            std::vector<GridColumn> colsDefinition; ///< 生成colsInfo时使用的列定义
+            std::vector<Rect> cells;                ///< 保存格信息
         } _internalData;
 
     public:
@@ -202,10 +207,25 @@ namespace sw
 
     private:
         /**
-         * @brief 更新内部数据
+         * @brief 更新内部数据，仅在行列定义、子元素或其布局标记改变时重新生成
          */
         void _UpdateInternalData();
 
+        /**
+         * @brief 判断内部数据是否仍与当前的行列定义、子元素及其布局标记一致
+         */
+        bool _IsInternalDataValid();
+
+        /**
+         * @brief 将非FixSize行/列的尺寸重置为0，以便重新measure
+         */
+        void _ResetTrackSizes();
+
+        /**
+         * @brief 重新生成内部数据，并确定measure时子元素的顺序
+         */
+        void _RebuildInternalData();
+
         /**
          * @brief 获取指定行列处的网格信息
          */
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "ILayout.h"
+
+namespace sw
+{
+    /**
+     * @brief 为虚拟化布局按需生成与回收子项容器的接口
+     */
+    class IItemGenerator
+    {
+    public:
+        /**
+         * @brief 默认虚析构函数
+         */
+        virtual ~IItemGenerator() = default;
+
+    public:
+        /**
+         * @brief 获取数据项的数量
+         */
+        virtual int GetItemCount() = 0;
+
+        /**
+         * @brief 为指定索引处的数据项实现化一个容器，可复用之前回收的容器
+         * @param index 数据项索引
+         * @return 用于呈现该数据项的容器，在被回收前应保持有效
+         */
+        virtual ILayout &RealizeItem(int index) = 0;
+
+        /**
+         * @brief 回收不再可见的容器
+         * @param index 容器所呈现的数据项索引
+         * @param container 由RealizeItem返回的容器
+         */
+        virtual void RecycleItem(int index, ILayout &container) = 0;
+    };
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+
+namespace sw
+{
+    /**
+     * @brief 按显示文本前缀查找子项的索引接口，用于虚拟模式下的组合框等控件
+     */
+    class IItemSearchIndex
+    {
+    public:
+        /**
+         * @brief 默认虚析构函数
+         */
+        virtual ~IItemSearchIndex() = default;
+
+    public:
+        /**
+         * @brief 查找显示文本以指定前缀开头的子项，不区分大小写
+         * @param prefix 要查找的前缀
+         * @param startIndex 从该索引的下一项开始查找，到末尾后从头继续查找至该项，为-1时从头查找整个列表
+         * @return 找到的子项索引，未找到时返回-1
+         * @note 索引应自行跟踪数据源的变化，保证返回的索引与数据源一致
+         */
+        virtual int FindPrefix(const std::wstring &prefix, int startIndex) = 0;
+    };
+}
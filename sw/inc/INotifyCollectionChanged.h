@@ -52,6 +52,11 @@ namespace sw
          * @brief 记录移动项的原始索引
          */
         int oldIndex = -1;
+
+        /**
+         * @brief 从index开始连续变更的项数，Add、Remove与Replace可通过该字段描述一整段变更
+         */
+        int count = 1;
     };
 
     /**
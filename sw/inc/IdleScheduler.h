@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Delegate.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sw
+{
+    /**
+     * @brief 空闲任务的统计信息，时间单位为纳秒
+     */
+    struct IdleTaskStatistics {
+        int id              = 0; ///< 任务id
+        std::wstring name;       ///< 任务名称
+        uint64_t callCount  = 0; ///< 调用次数
+        uint64_t totalTime  = 0; ///< 调用耗时之和
+        uint64_t maxTime    = 0; ///< 单次调用的最长耗时
+    };
+
+    /**
+     * @brief 空闲任务调度器，在消息队列为空时按时间预算轮流调用已注册的任务
+     * @note 任务返回true表示仍有工作，返回false表示暂时没有工作，此后不再调用直到Reset
+     * @note 不是线程安全的，只能在同一线程中使用
+     */
+    class IdleScheduler
+    {
+    private:
+        /**
+         * @brief 已注册的任务
+         */
+        struct _Task {
+            Func<bool> task;               // 任务
+            bool hasWork = true;           // 是否仍有工作
+            bool removed = false;          // 是否已在Run执行期间被移除
+            IdleTaskStatistics statistics; // 统计信息
+        };
+
+        /**
+         * @brief 已注册的任务，按注册顺序排列
+         */
+        std::vector<std::unique_ptr<_Task>> _tasks;
+
+        /**
+         * @brief 下次Run从该索引开始调用
+         */
+        size_t _cursor = 0;
+
+        /**
+         * @brief 下一个任务id
+         */
+        int _nextId = 1;
+
+        /**
+         * @brief 是否正在执行Run
+         */
+        bool _isRunning = false;
+
+        /**
+         * @brief Run执行期间是否有任务被移除
+         */
+        bool _hasRemoved = false;
+
+    public:
+        /**
+         * @brief 注册任务
+         * @param name 任务名称，用于统计信息
+         * @param task 任务，返回是否仍有工作，每次调用应只处理一小部分工作
+         * @return 任务id，用于移除任务
+         */
+        int Add(const std::wstring &name, const Func<bool> &task);
+
+        /**
+         * @brief 移除任务，可在任务中调用
+         * @return 是否找到并移除了任务
+         */
+        bool Remove(int id);
+
+        /**
+         * @brief 判断是否有已注册的任务
+         */
+        bool IsEmpty() const noexcept;
+
+        /**
+         * @brief 将所有任务标记为有工作，通常在处理消息后调用
+         */
+        void Reset() noexcept;
+
+        /**
+         * @brief 轮流调用有工作的任务，直到没有任务有工作、超出时间预算或shouldYield返回true
+         * @note 为保证任务总能推进，每次调用至少执行一个有工作的任务，之后才检查预算与shouldYield
+         * @note 下次调用从上次最后执行的任务的下一个开始，避免靠前的任务占满预算
+         * @param budget 时间预算
+         * @param shouldYield 每执行一个任务后调用，返回true时停止执行，为空时只检查时间预算
+         * @return 是否仍有任务有工作
+         */
+        bool Run(std::chrono::nanoseconds budget, const Func<bool> &shouldYield = nullptr);
+
+        /**
+         * @brief 获取各任务的统计信息，按注册顺序排列
+         */
+        std::vector<IdleTaskStatistics> GetStatistics() const;
+
+        /**
+         * @brief 清除各任务的统计信息
+         */
+        void ResetStatistics() noexcept;
+
+    private:
+        /**
+         * @brief 删除Run执行期间被移除的任务
+         */
+        void _RemovePending();
+    };
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Delegate.h"
+#include <cstdint>
+#include <string>
+
+namespace sw
+{
+    /**
+     * @brief 按输入的字符增量查找子项，用于虚拟模式下的组合框等控件
+     * @note 不依赖窗口，查找由调用者提供的函数完成，例如IItemSearchIndex::FindPrefix
+     */
+    class IncrementalItemSearch
+    {
+    private:
+        /**
+         * @brief 已输入的文本
+         */
+        std::wstring _text;
+
+        /**
+         * @brief 最近一次输入的时间，单位为毫秒
+         */
+        uint32_t _lastTime = 0;
+
+        /**
+         * @brief 两次输入的最大间隔，超过后重新开始查找，单位为毫秒
+         */
+        uint32_t _timeout;
+
+    public:
+        /**
+         * @brief 初始化增量查找
+         * @param timeout 两次输入的最大间隔，单位为毫秒
+         */
+        explicit IncrementalItemSearch(uint32_t timeout = 1000);
+
+        /**
+         * @brief 处理输入的字符
+         * @param ch 输入的字符
+         * @param time 输入的时间，单位为毫秒，例如GetTickCount的返回值
+         * @param currentIndex 当前选中的子项索引，没有选中项时为-1
+         * @param findPrefix 查找函数，参数为前缀与startIndex，含义与IItemSearchIndex::FindPrefix相同
+         * @return 应选中的子项索引，未找到时返回-1
+         * @note 重复输入同一字符时依次查找以该字符开头的下一项，否则当前项仍然匹配时保持不变
+         */
+        int Input(wchar_t ch, uint32_t time, int currentIndex, const Func<const std::wstring &, int, int> &findPrefix);
+
+        /**
+         * @brief 清除已输入的文本
+         */
+        void Reset() noexcept;
+
+        /**
+         * @brief 获取已输入的文本
+         */
+        const std::wstring &GetText() const noexcept;
+
+        /**
+         * @brief 在count个子项中从startIndex的下一项开始循环查找第一个满足条件的子项
+         * @param count 子项数量
+         * @param startIndex 从该索引的下一项开始查找，到末尾后从头继续查找至该项，为-1或超出范围时从头查找整个列表
+         * @param match 判断指定索引处的子项是否满足条件
+         * @return 找到的子项索引，未找到时返回-1
+         */
+        static int FindNext(int count, int startIndex, const Func<int, bool> &match);
+    };
+}
@@ -99,6 +99,7 @@ namespace sw
         /**
          * @brief 当数据源集合发生变更时调用该函数
          * @param args 包含集合变更信息的事件参数
+         * @note 对于Add、Remove与Replace，args.count给出从args.index开始连续变更的项数，子类应一次处理整段变更
          */
         virtual void OnCurrentItemsSourceCollectionChanged(const NotifyCollectionChangedEventArgs &args) = 0;
 
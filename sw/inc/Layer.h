@@ -2,8 +2,10 @@
 
 #include "Dip.h"
 #include "LayoutHost.h"
+#include "LayoutProfiler.h"
 #include "ScrollEnums.h"
 #include "UIElement.h"
+#include "Utils.h"
 #include <cmath>
 
 namespace sw
@@ -388,6 +390,9 @@ namespace sw
                 return TBase::MeasureOverride(availableSize);
             }
 
+            _UpdateLayoutViewport(*layout, this->ClientRect->GetSize());
+
+            LayoutProfiler::Scope profilerScope(layout, LayoutPass::Measure);
             return layout->MeasureOverride(availableSize);
         }
 
@@ -407,6 +412,7 @@ namespace sw
                 _MeasureAndArrangeWithoutResize(*layout, finalSize);
             } else {
                 // 已设置布局方式且AutoSize为true，此时子元素已Measure，调用Arrange即可
+                LayoutProfiler::Scope profilerScope(layout, LayoutPass::Arrange);
                 layout->ArrangeOverride(finalSize);
             }
         }
@@ -601,7 +607,9 @@ namespace sw
          */
         void UpdateScrollRange()
         {
-            if (_GetLayout() == nullptr) {
+            LayoutHost *layout = _GetLayout();
+
+            if (layout == nullptr) {
                 // 当未设置布局方式时滚动条和控件位置需要手动设置
                 // 将以下俩字段设为false确保xxxScrollLimit属性在未设置布局方式时仍可用
                 _horizontalScrollDisabled = false;
@@ -609,8 +617,10 @@ namespace sw
                 return;
             }
 
+            Size contentExtent = layout->GetContentExtent();
+
             if (HorizontalScrollBar) {
-                double childRightmost = this->GetChildRightmost(true);
+                double childRightmost = Utils::Max(this->GetChildRightmost(true), contentExtent.width);
 
                 if (int(childRightmost - this->ClientWidth) > 0) {
                     _horizontalScrollDisabled = false;
@@ -631,7 +641,7 @@ namespace sw
             }
 
             if (VerticalScrollBar) {
-                double childBottommost = this->GetChildBottommost(true);
+                double childBottommost = Utils::Max(this->GetChildBottommost(true), contentExtent.height);
 
                 if (int(childBottommost - this->ClientHeight) > 0) {
                     _verticalScrollDisabled = false;
@@ -735,14 +745,29 @@ namespace sw
             }
         }
 
+        /**
+         * @brief 将当前滚动位置与客户区尺寸作为可视区域通知布局对象
+         */
+        void _UpdateLayoutViewport(LayoutHost &layout, const Size &clientSize)
+        {
+            layout.UpdateViewport(sw::Rect{-this->GetInternalArrangeOffsetX(), -this->GetInternalArrangeOffsetY(), clientSize.width, clientSize.height});
+        }
+
         /**
          * @brief 使用设定的布局方式对子元素进行Measure和Arrange，不改变当前的尺寸和DesireSize
          */
         void _MeasureAndArrangeWithoutResize(LayoutHost &layout, const Size &clientSize)
         {
             if (layout.IsAssociated(this)) {
-                layout.MeasureOverride(clientSize);
-                layout.ArrangeOverride(clientSize);
+                _UpdateLayoutViewport(layout, clientSize);
+                {
+                    LayoutProfiler::Scope profilerScope(&layout, LayoutPass::Measure);
+                    layout.MeasureOverride(clientSize);
+                }
+                {
+                    LayoutProfiler::Scope profilerScope(&layout, LayoutPass::Arrange);
+                    layout.ArrangeOverride(clientSize);
+                }
             }
         }
     };
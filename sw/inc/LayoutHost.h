@@ -57,5 +57,18 @@ namespace sw
          * @param finalSize 可用于排列子元素的最终尺寸
          */
         virtual void ArrangeOverride(const Size &finalSize) = 0;
+
+        /**
+         * @brief 更新关联对象的可视区域，由关联对象在使用布局方式测量前调用
+         * @param viewport 可视区域，坐标相对于子元素的排列原点（已考虑滚动偏移）
+         * @note 默认实现为空，需要根据可视区域布局的布局方式可重写该函数
+         */
+        virtual void UpdateViewport(const Rect &viewport);
+
+        /**
+         * @brief 获取布局方式确定的内容尺寸，关联对象的滚动范围取该尺寸与子元素实际所占范围中的较大者
+         * @note 默认返回空尺寸，即仅按子元素的实际位置计算滚动范围
+         */
+        virtual Size GetContentExtent();
     };
 }
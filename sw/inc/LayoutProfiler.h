@@ -0,0 +1,241 @@
+#pragma once
+
+// 定义SW_DISABLE_LAYOUT_PROFILER可以移除Measure和Arrange中的统计代码
+// #define SW_DISABLE_LAYOUT_PROFILER
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace sw
+{
+    /**
+     * @brief 布局过程的阶段
+     */
+    enum class LayoutPass {
+        Measure, ///< 测量
+        Arrange, ///< 排列
+    };
+
+    /**
+     * @brief 某个元素或布局对象在布局过程中的统计信息，时间单位为纳秒
+     * @note 包含时间为整个调用的耗时，独占时间为包含时间减去其中嵌套的其他对象的包含时间
+     */
+    struct LayoutProfileRecord {
+        const void *object            = nullptr; ///< 元素或布局对象的地址
+        const void *parent            = nullptr; ///< 最近一次调用时外层对象的地址，最外层对象为nullptr
+        const char *typeName          = "";      ///< 对象的类型名称
+        uint64_t measureCount         = 0;       ///< 实际执行测量的次数
+        uint64_t measureSkipCount     = 0;       ///< 因布局未失效且可用尺寸未变而跳过测量的次数
+        uint64_t arrangeCount         = 0;       ///< 执行排列的次数
+        uint64_t setWindowPosCount    = 0;       ///< 调用SetWindowPos的次数
+        uint64_t deferWindowPosCount  = 0;       ///< 调用DeferWindowPos的次数
+        uint64_t measureInclusiveTime = 0;       ///< 测量的包含时间
+        uint64_t measureExclusiveTime = 0;       ///< 测量的独占时间
+        uint64_t arrangeInclusiveTime = 0;       ///< 排列的包含时间
+        uint64_t arrangeExclusiveTime = 0;       ///< 排列的独占时间
+    };
+
+    /**
+     * @brief 布局过程的统计工具，记录每个元素及布局对象的测量、排列次数与耗时，可导出为JSON树或Chrome Trace格式
+     * @note 每个线程拥有独立的统计数据，默认不启用，启用后只统计当前线程的布局过程
+     * @note 统计数据以对象地址区分，对象销毁后其地址可能被新对象复用，建议在每次统计前调用Reset
+     * @note 定义SW_DISABLE_LAYOUT_PROFILER后布局过程中不再调用任何统计函数，SetEnabled无效
+     */
+    class LayoutProfiler
+    {
+    public:
+        /**
+         * @brief 最多记录的Chrome Trace事件数量，超出后丢弃新事件
+         */
+        static constexpr size_t MaxTraceEventCount = 1000000;
+
+        /**
+         * @brief 记录一次测量或排列调用的范围对象，构造时开始计时，析构时结束计时
+         * @note 统计未启用时构造和析构不做任何操作
+         */
+        class Scope
+        {
+        private:
+            /**
+             * @brief 是否正在计时
+             */
+            bool _active = false;
+
+        public:
+            /**
+             * @brief 开始记录对象的一次测量或排列调用
+             * @param obj 元素或布局对象，以其地址区分不同对象
+             * @param pass 布局阶段
+             */
+            template <typename T>
+            Scope(const T *obj, LayoutPass pass)
+            {
+#if !defined(SW_DISABLE_LAYOUT_PROFILER)
+                if (LayoutProfiler::IsEnabled()) {
+                    _active = LayoutProfiler::_Begin(obj, typeid(*obj), pass);
+                }
+#endif
+            }
+
+            /**
+             * @brief 结束计时
+             */
+            ~Scope()
+            {
+                if (_active) LayoutProfiler::_End();
+            }
+
+            Scope(const Scope &)            = delete;
+            Scope &operator=(const Scope &) = delete;
+        };
+
+    private:
+        /**
+         * @brief 正在进行的调用
+         */
+        struct _Frame {
+            size_t record;      // 在_records中的索引
+            LayoutPass pass;    // 布局阶段
+            uint64_t startTime; // 开始时间
+            uint64_t childTime; // 嵌套调用的包含时间之和
+        };
+
+        /**
+         * @brief Chrome Trace中的一个完整事件
+         */
+        struct _TraceEvent {
+            size_t record;      // 在_records中的索引
+            LayoutPass pass;    // 布局阶段
+            uint64_t startTime; // 开始时间
+            uint64_t duration;  // 持续时间
+        };
+
+        /**
+         * @brief 是否启用统计
+         */
+        bool _enabled = false;
+
+        /**
+         * @brief 是否记录Chrome Trace事件
+         */
+        bool _traceEnabled = false;
+
+        /**
+         * @brief 按首次出现顺序排列的统计记录
+         */
+        std::vector<LayoutProfileRecord> _records;
+
+        /**
+         * @brief 对象地址到_records中索引的映射
+         */
+        std::unordered_map<const void *, size_t> _index;
+
+        /**
+         * @brief 调用栈
+         */
+        std::vector<_Frame> _stack;
+
+        /**
+         * @brief Chrome Trace事件
+         */
+        std::vector<_TraceEvent> _events;
+
+        /**
+         * @brief 因超出MaxTraceEventCount而丢弃的事件数量
+         */
+        size_t _droppedEventCount = 0;
+
+        /**
+         * @brief 计时起点，Chrome Trace中的时间戳相对于该时间
+         */
+        std::chrono::steady_clock::time_point _epoch = std::chrono::steady_clock::now();
+
+    public:
+        /**
+         * @brief 判断当前线程是否启用了统计
+         */
+        static bool IsEnabled() noexcept;
+
+        /**
+         * @brief 启用或禁用当前线程的统计，禁用时保留已有的统计数据
+         * @param enabled 是否启用
+         * @param trace 是否同时记录每次调用的Chrome Trace事件，事件较多时会占用较多内存
+         */
+        static void SetEnabled(bool enabled, bool trace = false);
+
+        /**
+         * @brief 清除当前线程的统计数据
+         * @note 不能在布局过程中调用
+         */
+        static void Reset();
+
+        /**
+         * @brief 记录一次因布局未失效且可用尺寸未变而跳过的测量
+         */
+        static void RecordMeasureSkipped(const void *obj);
+
+        /**
+         * @brief 记录一次SetWindowPos调用
+         */
+        static void RecordSetWindowPos(const void *obj);
+
+        /**
+         * @brief 记录一次DeferWindowPos调用
+         */
+        static void RecordDeferWindowPos(const void *obj);
+
+        /**
+         * @brief 获取当前线程的统计记录，按对象首次出现的顺序排列
+         */
+        static std::vector<LayoutProfileRecord> GetRecords();
+
+        /**
+         * @brief 将当前线程的统计记录按调用关系导出为JSON树
+         * @return UTF-8编码的JSON字符串
+         */
+        static std::string ToJson();
+
+        /**
+         * @brief 将当前线程记录的事件导出为Chrome Trace格式，可在chrome://tracing或Perfetto中打开
+         * @return UTF-8编码的JSON字符串，SetEnabled时未启用trace则事件列表为空
+         */
+        static std::string ToChromeTrace();
+
+    private:
+        /**
+         * @brief 获取当前线程的实例
+         */
+        static LayoutProfiler &_GetInstance() noexcept;
+
+        /**
+         * @brief 获取当前时间
+         */
+        uint64_t _Now() const noexcept;
+
+        /**
+         * @brief 获取对象对应的记录，若不存在则创建
+         */
+        LayoutProfileRecord &_GetRecord(const void *obj);
+
+        /**
+         * @brief 开始记录一次调用，由Scope调用
+         * @return 是否已入栈，入栈后需调用_End
+         */
+        static bool _Begin(const void *obj, const std::type_info &type, LayoutPass pass);
+
+        /**
+         * @brief 结束最近一次开始的调用，由Scope调用
+         */
+        static void _End() noexcept;
+
+        /**
+         * @brief 将索引为index的记录及其子记录写入JSON
+         */
+        void _WriteJsonNode(std::string &out, size_t index, const std::vector<std::vector<size_t>> &children) const;
+    };
+}
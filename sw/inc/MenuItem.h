@@ -6,6 +6,7 @@
 #include <initializer_list>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <windows.h>
 
 namespace sw
@@ -105,6 +106,19 @@ namespace sw
          */
         std::vector<std::unique_ptr<MenuItem>> _subItems{};
 
+        /**
+         * @brief 菜单项索引，用于按ID或tag查找菜单项
+         */
+        struct _MenuItemIndex {
+            std::unordered_map<int, MenuItem *> ids;            ///< ID到菜单项的映射
+            std::unordered_multimap<uint64_t, MenuItem *> tags; ///< tag到菜单项的映射，tag为0的菜单项不加入索引
+        };
+
+        /**
+         * @brief 根菜单项中记录其下所有菜单项的索引，非根菜单项为nullptr
+         */
+        std::unique_ptr<_MenuItemIndex> _index{};
+
     public:
         /**
          * @brief 菜单项Id
@@ -252,6 +266,7 @@ namespace sw
          * @brief 查找对应ID的子菜单项
          * @param id 子菜单项ID
          * @return 指向子菜单项的指针，如果未找到则返回nullptr
+         * @note 菜单项位于根菜单项下时通过根菜单项的索引查找，无需遍历
          */
         MenuItem *FindChildById(int id);
 
@@ -259,6 +274,7 @@ namespace sw
          * @brief 查找对应tag的子菜单项
          * @param tag 子菜单项tag
          * @return 指向子菜单项的指针，如果未找到则返回nullptr
+         * @note 菜单项位于根菜单项下且tag不为0时通过根菜单项的索引查找，无需遍历
          */
         MenuItem *FindChildByTag(uint64_t tag);
 
@@ -279,6 +295,32 @@ namespace sw
          */
         void _UpdateState();
 
+        /**
+         * @brief 获取当前菜单项所在的根菜单项的索引
+         * @return 索引指针，若当前菜单项不在根菜单项下则返回nullptr
+         */
+        _MenuItemIndex *_GetRootIndex();
+
+        /**
+         * @brief 判断当前菜单项是否为指定菜单项本身或其祖先
+         */
+        bool _IsSelfOrAncestorOf(MenuItem *item) const;
+
+        /**
+         * @brief 将指定菜单项及其所有子孙菜单项加入索引
+         */
+        static void _AddToIndex(_MenuItemIndex *index, MenuItem *item);
+
+        /**
+         * @brief 将指定菜单项及其所有子孙菜单项从索引中移除
+         */
+        static void _RemoveFromIndex(_MenuItemIndex *index, MenuItem *item);
+
+        /**
+         * @brief 将菜单项的tag从索引中移除
+         */
+        static void _RemoveTagFromIndex(_MenuItemIndex *index, MenuItem *item);
+
         /**
          * @brief 插入子菜单到指定父菜单项的指定位置
          * @param parent 父菜单项指针
@@ -3,8 +3,11 @@
 #include "INotifyCollectionChanged.h"
 #include "List.h"
 #include "ObservableObject.h"
+#include <algorithm>
 #include <initializer_list>
+#include <iterator>
 #include <stdexcept>
+#include <vector>
 
 namespace sw
 {
@@ -29,6 +32,16 @@ namespace sw
          */
         NotifyCollectionChangedEventHandler _collectionChanged;
 
+        /**
+         * @brief BeginUpdate的嵌套层数
+         */
+        int _updateDepth = 0;
+
+        /**
+         * @brief 延迟更新期间是否有被推迟的变更通知
+         */
+        bool _updatePending = false;
+
     public:
         /**
          * @brief 默认构造函数，创建空集合
@@ -75,6 +88,21 @@ namespace sw
             return _collectionChanged;
         }
 
+        /**
+         * @brief 查询对象实现的常用类型，用于代替dynamic_cast进行类型判断和转换
+         */
+        virtual void *QueryInterface(InterfaceId id) noexcept override
+        {
+            switch (id) {
+                case InterfaceId::INotifyCollectionChanged:
+                    return static_cast<INotifyCollectionChanged *>(this);
+                case InterfaceId::IList:
+                    return static_cast<IList *>(this);
+                default:
+                    return ObservableObject::QueryInterface(id);
+            }
+        }
+
         /**
          * @brief 触发集合变更事件
          * @param args 集合变更事件参数
@@ -86,6 +114,26 @@ namespace sw
             }
         }
 
+    private:
+        /**
+         * @brief 构造事件参数并触发集合变更事件，处于延迟更新期间时仅记录有待通知的变更
+         */
+        void _NotifyCollectionChanged(NotifyCollectionChangedAction action, int index = -1, int count = 1, int oldIndex = -1)
+        {
+            if (_updateDepth > 0) {
+                _updatePending = true;
+                return;
+            }
+
+            NotifyCollectionChangedEventArgs args{};
+            args.action   = action;
+            args.list     = this;
+            args.index    = index;
+            args.oldIndex = oldIndex;
+            args.count    = count;
+            OnCollectionChanged(args);
+        }
+
     public:
         /**
          * @brief 获取当前分配的容量
@@ -110,10 +158,41 @@ namespace sw
          */
         void Refresh()
         {
-            NotifyCollectionChangedEventArgs args{};
-            args.action = NotifyCollectionChangedAction::Reset;
-            args.list   = this;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Reset);
+        }
+
+        /**
+         * @brief 开始批量更新，在对应的EndUpdate调用之前不再逐项触发集合变更事件
+         * @note BeginUpdate可嵌套调用，每次调用都需要与一次EndUpdate配对
+         */
+        void BeginUpdate() noexcept
+        {
+            ++_updateDepth;
+        }
+
+        /**
+         * @brief 结束批量更新，若期间集合发生过变更，则在最外层调用时触发一次集合重置通知
+         * @throws std::logic_error 没有与之配对的BeginUpdate调用
+         */
+        void EndUpdate()
+        {
+            if (_updateDepth <= 0) {
+                throw std::logic_error("EndUpdate called without a matching BeginUpdate in ObservableCollection.");
+            }
+
+            if (--_updateDepth == 0 && _updatePending) {
+                _updatePending = false;
+                _NotifyCollectionChanged(NotifyCollectionChangedAction::Reset);
+            }
+        }
+
+        /**
+         * @brief 判断集合当前是否处于批量更新状态
+         * @return 处于BeginUpdate与EndUpdate之间返回true，否则返回false
+         */
+        bool IsUpdating() const noexcept
+        {
+            return _updateDepth > 0;
         }
 
         /**
@@ -127,10 +206,7 @@ namespace sw
 
             _items.Clear();
 
-            NotifyCollectionChangedEventArgs args{};
-            args.action = NotifyCollectionChangedAction::Reset;
-            args.list   = this;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Reset);
         }
 
         /**
@@ -142,11 +218,7 @@ namespace sw
             int index = _items.Count();
             _items.Add(value);
 
-            NotifyCollectionChangedEventArgs args{};
-            args.action = NotifyCollectionChangedAction::Add;
-            args.list   = this;
-            args.index  = index;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Add, index);
         }
 
         /**
@@ -158,11 +230,7 @@ namespace sw
             int index = _items.Count();
             _items.Add(std::move(value));
 
-            NotifyCollectionChangedEventArgs args{};
-            args.action = NotifyCollectionChangedAction::Add;
-            args.list   = this;
-            args.index  = index;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Add, index);
         }
 
         /**
@@ -174,11 +242,7 @@ namespace sw
         {
             _items.RemoveAt(index);
 
-            NotifyCollectionChangedEventArgs args{};
-            args.action = NotifyCollectionChangedAction::Remove;
-            args.list   = this;
-            args.index  = index;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Remove, index);
         }
 
         /**
@@ -191,11 +255,7 @@ namespace sw
         {
             _items.Insert(index, value);
 
-            NotifyCollectionChangedEventArgs args{};
-            args.action = NotifyCollectionChangedAction::Add;
-            args.list   = this;
-            args.index  = index;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Add, index);
         }
 
         /**
@@ -208,11 +268,7 @@ namespace sw
         {
             _items.Insert(index, std::move(value));
 
-            NotifyCollectionChangedEventArgs args{};
-            args.action = NotifyCollectionChangedAction::Add;
-            args.list   = this;
-            args.index  = index;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Add, index);
         }
 
         /**
@@ -238,12 +294,7 @@ namespace sw
             items.erase(items.begin() + static_cast<size_t>(oldIndex));
             items.insert(items.begin() + static_cast<size_t>(newIndex), std::move(value));
 
-            NotifyCollectionChangedEventArgs args{};
-            args.action   = NotifyCollectionChangedAction::Move;
-            args.list     = this;
-            args.index    = newIndex;
-            args.oldIndex = oldIndex;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Move, newIndex, 1, oldIndex);
         }
 
         /**
@@ -290,15 +341,149 @@ namespace sw
 
             _items.RemoveAt(index);
 
-            NotifyCollectionChangedEventArgs args{};
-            args.action = NotifyCollectionChangedAction::Remove;
-            args.list   = this;
-            args.index  = index;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Remove, index);
 
             return true;
         }
 
+        /**
+         * @brief 在集合末尾追加一段元素，并触发一次添加通知
+         * @param first 要追加元素的起始迭代器
+         * @param last 要追加元素的结束迭代器
+         */
+        template <typename TIter>
+        void AddRange(TIter first, TIter last)
+        {
+            InsertRange(_items.Count(), first, last);
+        }
+
+        /**
+         * @brief 在集合末尾追加一段元素，并触发一次添加通知
+         * @param list 要追加的元素列表
+         */
+        void AddRange(std::initializer_list<T> list)
+        {
+            InsertRange(_items.Count(), list.begin(), list.end());
+        }
+
+        /**
+         * @brief 在指定索引处插入一段元素，并触发一次添加通知
+         * @param index 插入位置
+         * @param first 要插入元素的起始迭代器
+         * @param last 要插入元素的结束迭代器
+         * @throws std::out_of_range 索引超出范围
+         */
+        template <typename TIter>
+        void InsertRange(int index, TIter first, TIter last)
+        {
+            if (index < 0 || index > _items.Count()) {
+                throw std::out_of_range("Index out of range in ObservableCollection::InsertRange.");
+            }
+
+            auto &items   = _items.GetInternalVector();
+            size_t before = items.size();
+            items.insert(items.begin() + static_cast<size_t>(index), first, last);
+
+            int count = static_cast<int>(items.size() - before);
+            if (count > 0) {
+                _NotifyCollectionChanged(NotifyCollectionChangedAction::Add, index, count);
+            }
+        }
+
+        /**
+         * @brief 在指定索引处插入一段元素，并触发一次添加通知
+         * @param index 插入位置
+         * @param list 要插入的元素列表
+         * @throws std::out_of_range 索引超出范围
+         */
+        void InsertRange(int index, std::initializer_list<T> list)
+        {
+            InsertRange(index, list.begin(), list.end());
+        }
+
+        /**
+         * @brief 移除从指定索引开始的连续若干元素，并触发一次移除通知
+         * @param index 要移除的第一个元素的索引
+         * @param count 要移除的元素数量
+         * @throws std::out_of_range 索引或数量超出范围
+         */
+        void RemoveRange(int index, int count)
+        {
+            if (index < 0 || count < 0 || count > _items.Count() - index) {
+                throw std::out_of_range("Index out of range in ObservableCollection::RemoveRange.");
+            }
+
+            if (count == 0) {
+                return;
+            }
+
+            auto &items = _items.GetInternalVector();
+            auto begin  = items.begin() + static_cast<size_t>(index);
+            items.erase(begin, begin + static_cast<size_t>(count));
+
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Remove, index, count);
+        }
+
+        /**
+         * @brief 用一段元素依次替换从指定索引开始的元素，并触发一次替换通知
+         * @param index 要替换的第一个元素的索引
+         * @param first 新元素的起始迭代器
+         * @param last 新元素的结束迭代器
+         * @throws std::out_of_range 索引或新元素数量超出范围
+         * @note 需要先计算新元素数量再复制，输入迭代器只能遍历一次，会先将元素复制到临时的std::vector中
+         */
+        template <typename TIter>
+        void ReplaceRange(int index, TIter first, TIter last)
+        {
+            _ReplaceRange(index, first, last, typename std::iterator_traits<TIter>::iterator_category{});
+        }
+
+        /**
+         * @brief 用一段元素依次替换从指定索引开始的元素，并触发一次替换通知
+         * @param index 要替换的第一个元素的索引
+         * @param list 新元素列表
+         * @throws std::out_of_range 索引或新元素数量超出范围
+         */
+        void ReplaceRange(int index, std::initializer_list<T> list)
+        {
+            ReplaceRange(index, list.begin(), list.end());
+        }
+
+    private:
+        /**
+         * @brief ReplaceRange的实现，输入迭代器先复制到临时的std::vector中
+         */
+        template <typename TIter>
+        void _ReplaceRange(int index, TIter first, TIter last, std::input_iterator_tag)
+        {
+            std::vector<T> values(first, last);
+            _ReplaceRange(index, values.begin(), values.end(), std::forward_iterator_tag{});
+        }
+
+        /**
+         * @brief ReplaceRange的实现，前向迭代器可以遍历多次，先计算数量再直接复制
+         */
+        template <typename TIter>
+        void _ReplaceRange(int index, TIter first, TIter last, std::forward_iterator_tag)
+        {
+            int count = static_cast<int>(std::distance(first, last));
+
+            if (index < 0 || count > _items.Count() - index) {
+                throw std::out_of_range("Index out of range in ObservableCollection::ReplaceRange.");
+            }
+
+            if (count == 0) {
+                return;
+            }
+
+            auto &items = _items.GetInternalVector();
+            std::copy(first, last, items.begin() + static_cast<size_t>(index));
+
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Replace, index, count);
+        }
+
+    public:
+
         /**
          * @brief 将集合转换为字符串表示
          * @return 集合的字符串表示
@@ -369,11 +554,7 @@ namespace sw
         {
             _items.SetAt(index, value);
 
-            NotifyCollectionChangedEventArgs args{};
-            args.action = NotifyCollectionChangedAction::Replace;
-            args.list   = this;
-            args.index  = index;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Replace, index);
         }
 
         /**
@@ -387,11 +568,7 @@ namespace sw
         {
             _items.SetAt(index, std::move(value));
 
-            NotifyCollectionChangedEventArgs args{};
-            args.action = NotifyCollectionChangedAction::Replace;
-            args.list   = this;
-            args.index  = index;
-            OnCollectionChanged(args);
+            _NotifyCollectionChanged(NotifyCollectionChangedAction::Replace, index);
         }
     };
 }
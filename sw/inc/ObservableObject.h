@@ -2,6 +2,8 @@
 
 #include "INotifyObjectDead.h"
 #include "INotifyPropertyChanged.h"
+#include <memory>
+#include <unordered_map>
 
 namespace sw
 {
@@ -23,6 +25,16 @@ namespace sw
          */
         ObjectDeadEventHandler _objectDead;
 
+        /**
+         * @brief 按属性ID索引的属性更改事件委托，首次按ID订阅时创建
+         */
+        std::unique_ptr<std::unordered_map<FieldId, PropertyChangedEventHandler>> _propertyChangedTable;
+
+        /**
+         * @brief 正在分发按属性ID订阅的事件的嵌套层数
+         */
+        int _propertyChangedDispatchDepth = 0;
+
     public:
         /**
          * @brief 默认构造函数
@@ -52,6 +64,60 @@ namespace sw
             }
         }
 
+    public:
+        /**
+         * @brief 订阅指定属性的更改通知
+         * @param propertyId 属性ID
+         * @param handler 事件处理函数
+         * @note 与直接订阅PropertyChanged事件不同，处理函数仅在指定属性更改时被调用，
+         *       触发通知时只需查找一次属性ID，不会随其他属性的订阅数量增加而变慢
+         */
+        void AddPropertyChangedHandler(FieldId propertyId, const PropertyChangedEventHandler &handler)
+        {
+            if (handler == nullptr) {
+                return;
+            }
+
+            if (_propertyChangedTable == nullptr) {
+                _propertyChangedTable.reset(new std::unordered_map<FieldId, PropertyChangedEventHandler>);
+            }
+
+            if (_propertyChangedTable->empty()) {
+                _propertyChanged += PropertyChangedEventHandler(*this, &ObservableObject::_DispatchPropertyChanged);
+            }
+
+            (*_propertyChangedTable)[propertyId] += handler;
+        }
+
+        /**
+         * @brief 取消订阅指定属性的更改通知
+         * @param propertyId 属性ID
+         * @param handler 事件处理函数
+         * @return 若成功移除则返回true，否则返回false
+         */
+        bool RemovePropertyChangedHandler(FieldId propertyId, const PropertyChangedEventHandler &handler)
+        {
+            if (_propertyChangedTable == nullptr || handler == nullptr) {
+                return false;
+            }
+
+            auto it = _propertyChangedTable->find(propertyId);
+            if (it == _propertyChangedTable->end()) {
+                return false;
+            }
+
+            bool removed = it->second.Remove(handler);
+
+            // 分发过程中不删除表项，避免销毁正在调用的委托
+            if (removed && it->second == nullptr && _propertyChangedDispatchDepth == 0) {
+                _propertyChangedTable->erase(it);
+                if (_propertyChangedTable->empty()) {
+                    _propertyChanged -= PropertyChangedEventHandler(*this, &ObservableObject::_DispatchPropertyChanged);
+                }
+            }
+            return removed;
+        }
+
     protected:
         /**
          * @brief 获取属性更改事件委托的引用
@@ -71,6 +137,23 @@ namespace sw
             return _objectDead;
         }
 
+        /**
+         * @brief 查询对象实现的常用类型，用于代替dynamic_cast进行类型判断和转换
+         */
+        virtual void *QueryInterface(InterfaceId id) noexcept override
+        {
+            switch (id) {
+                case InterfaceId::ObservableObject:
+                    return this;
+                case InterfaceId::INotifyPropertyChanged:
+                    return static_cast<INotifyPropertyChanged *>(this);
+                case InterfaceId::INotifyObjectDead:
+                    return static_cast<INotifyObjectDead *>(this);
+                default:
+                    return DynamicObject::QueryInterface(id);
+            }
+        }
+
         /**
          * @brief 触发属性更改通知事件
          * @param propertyId 更改的属性ID
@@ -96,5 +179,39 @@ namespace sw
             FieldId id = Reflection::GetFieldId(property);
             RaisePropertyChanged(id);
         }
+
+    private:
+        /**
+         * @brief 将属性更改事件分发给按属性ID订阅的处理函数
+         * @note 该函数作为普通处理函数添加到PropertyChanged中，因此直接调用事件委托触发的通知同样会被分发
+         */
+        void _DispatchPropertyChanged(INotifyPropertyChanged &sender, PropertyChangedEventArgs &args)
+        {
+            FieldId propertyId = args.propertyId;
+            auto it            = _propertyChangedTable->find(propertyId);
+
+            if (it == _propertyChangedTable->end() || it->second == nullptr) {
+                return;
+            }
+
+            // 处理函数中可能订阅其他属性导致rehash，此处保存引用而非迭代器
+            PropertyChangedEventHandler &handler = it->second;
+
+            ++_propertyChangedDispatchDepth;
+            try {
+                handler(sender, args);
+            } catch (...) {
+                --_propertyChangedDispatchDepth;
+                throw;
+            }
+            --_propertyChangedDispatchDepth;
+
+            if (_propertyChangedDispatchDepth == 0 && handler == nullptr) {
+                _propertyChangedTable->erase(propertyId);
+                if (_propertyChangedTable->empty()) {
+                    _propertyChanged -= PropertyChangedEventHandler(*this, &ObservableObject::_DispatchPropertyChanged);
+                }
+            }
+        }
     };
 }
@@ -20,6 +20,58 @@ namespace sw
     template <typename T, typename = void>
     class BoxedObject;
 
+    class ObservableObject;         // ObservableObject.h
+    class INotifyPropertyChanged;   // INotifyPropertyChanged.h
+    class INotifyObjectDead;        // INotifyObjectDead.h
+    class INotifyCollectionChanged; // INotifyCollectionChanged.h
+    class IList;                    // IList.h
+
+    /**
+     * @brief 可通过DynamicObject::QueryInterface查询的常用类型
+     */
+    enum class InterfaceId {
+        None,                     ///< 不支持查询的类型
+        ObservableObject,         ///< ObservableObject
+        INotifyPropertyChanged,   ///< INotifyPropertyChanged
+        INotifyObjectDead,        ///< INotifyObjectDead
+        INotifyCollectionChanged, ///< INotifyCollectionChanged
+        IList,                    ///< IList
+    };
+
+    /**
+     * @brief 获取类型对应的InterfaceId，不支持查询的类型为InterfaceId::None
+     */
+    template <typename T>
+    struct _InterfaceIdOf : std::integral_constant<InterfaceId, InterfaceId::None> {
+    };
+
+    /**
+     * @brief _InterfaceIdOf偏特化版本，忽略const修饰
+     */
+    template <typename T>
+    struct _InterfaceIdOf<const T> : _InterfaceIdOf<T> {
+    };
+
+    template <>
+    struct _InterfaceIdOf<ObservableObject> : std::integral_constant<InterfaceId, InterfaceId::ObservableObject> {
+    };
+
+    template <>
+    struct _InterfaceIdOf<INotifyPropertyChanged> : std::integral_constant<InterfaceId, InterfaceId::INotifyPropertyChanged> {
+    };
+
+    template <>
+    struct _InterfaceIdOf<INotifyObjectDead> : std::integral_constant<InterfaceId, InterfaceId::INotifyObjectDead> {
+    };
+
+    template <>
+    struct _InterfaceIdOf<INotifyCollectionChanged> : std::integral_constant<InterfaceId, InterfaceId::INotifyCollectionChanged> {
+    };
+
+    template <>
+    struct _InterfaceIdOf<IList> : std::integral_constant<InterfaceId, InterfaceId::IList> {
+    };
+
     /**
      * @brief 动态对象基类
      */
@@ -109,9 +161,9 @@ namespace sw
             throw std::runtime_error("Reflection is disabled, cannot check type.");
 #else
             if (pout == nullptr) {
-                return dynamic_cast<T *>(this) != nullptr;
+                return _CastPtr<T>() != nullptr;
             } else {
-                *pout = dynamic_cast<T *>(this);
+                *pout = _CastPtr<T>();
                 return *pout != nullptr;
             }
 #endif
@@ -131,9 +183,9 @@ namespace sw
             throw std::runtime_error("Reflection is disabled, cannot check type.");
 #else
             if (pout == nullptr) {
-                return dynamic_cast<const T *>(this) != nullptr;
+                return _CastPtr<T>() != nullptr;
             } else {
-                *pout = dynamic_cast<const T *>(this);
+                *pout = _CastPtr<T>();
                 return *pout != nullptr;
             }
 #endif
@@ -152,7 +204,7 @@ namespace sw
 #if defined(SW_DISABLE_REFLECTION)
             throw std::runtime_error("Reflection is disabled, cannot perform dynamic cast.");
 #else
-            return dynamic_cast<T &>(*this);
+            return _CastRef<T>();
 #endif
         }
 
@@ -169,7 +221,7 @@ namespace sw
 #if defined(SW_DISABLE_REFLECTION)
             throw std::runtime_error("Reflection is disabled, cannot perform dynamic cast.");
 #else
-            return dynamic_cast<const T &>(*this);
+            return _CastRef<T>();
 #endif
         }
 
@@ -352,6 +404,69 @@ namespace sw
         auto UnsafeCast() const
             -> typename std::enable_if<!std::is_base_of<DynamicObject, T>::value && !_IsStaticCastable<DynamicObject *, T *>::value, const T &>::type;
 
+    protected:
+        /**
+         * @brief 查询对象实现的常用类型，用于代替dynamic_cast进行类型判断和转换
+         * @param id 要查询的类型
+         * @return 指向对应类型子对象的指针，若不支持查询该类型则返回nullptr
+         * @note 返回nullptr不代表对象一定不是该类型，IsType与DynamicCast此时会回退到dynamic_cast，
+         *       因此派生类可以只登记部分类型，重写时对未处理的类型应调用基类实现
+         */
+        virtual void *QueryInterface(InterfaceId id) noexcept
+        {
+            (void)id;
+            return nullptr;
+        }
+
+    private:
+        /**
+         * @brief 将当前对象转换为指定类型的指针，优先通过QueryInterface查询
+         * @return 转换后的指针，若对象不是该类型则返回nullptr
+         */
+        template <typename T>
+        T *_CastPtr() noexcept
+        {
+            if (_InterfaceIdOf<T>::value != InterfaceId::None) {
+                void *p = QueryInterface(_InterfaceIdOf<T>::value);
+                if (p != nullptr) return static_cast<T *>(p);
+            }
+            return dynamic_cast<T *>(this);
+        }
+
+        /**
+         * @brief 将当前对象转换为指定类型的常量指针，优先通过QueryInterface查询
+         * @return 转换后的指针，若对象不是该类型则返回nullptr
+         */
+        template <typename T>
+        const T *_CastPtr() const noexcept
+        {
+            return const_cast<DynamicObject *>(this)->_CastPtr<T>();
+        }
+
+        /**
+         * @brief 将当前对象转换为指定类型的引用，优先通过QueryInterface查询
+         * @throws std::bad_cast 如果对象不是该类型
+         */
+        template <typename T>
+        T &_CastRef()
+        {
+            T *p = _CastPtr<T>();
+            if (p == nullptr) throw std::bad_cast();
+            return *p;
+        }
+
+        /**
+         * @brief 将当前对象转换为指定类型的常量引用，优先通过QueryInterface查询
+         * @throws std::bad_cast 如果对象不是该类型
+         */
+        template <typename T>
+        const T &_CastRef() const
+        {
+            const T *p = _CastPtr<T>();
+            if (p == nullptr) throw std::bad_cast();
+            return *p;
+        }
+
     private:
         /**
          * @brief 获取装箱对象的类型信息
@@ -851,9 +966,9 @@ namespace sw
 #else
         if (!_isBoxedObject) {
             if (pout == nullptr) {
-                return dynamic_cast<T *>(this) != nullptr;
+                return _CastPtr<T>() != nullptr;
             } else {
-                *pout = dynamic_cast<T *>(this);
+                *pout = _CastPtr<T>();
                 return *pout != nullptr;
             }
         } else {
@@ -925,9 +1040,9 @@ namespace sw
 #else
         if (!_isBoxedObject) {
             if (pout == nullptr) {
-                return dynamic_cast<const T *>(this) != nullptr;
+                return _CastPtr<T>() != nullptr;
             } else {
-                *pout = dynamic_cast<const T *>(this);
+                *pout = _CastPtr<T>();
                 return *pout != nullptr;
             }
         } else {
@@ -998,7 +1113,7 @@ namespace sw
         throw std::runtime_error("Reflection is disabled, cannot perform dynamic cast.");
 #else
         if (!_isBoxedObject) {
-            return dynamic_cast<T &>(*this);
+            return _CastRef<T>();
         } else {
             void *rawPtr = GetBoxedRawPtr();
             if (rawPtr == nullptr || GetBoxedType() != typeid(T)) {
@@ -1050,7 +1165,7 @@ namespace sw
         throw std::runtime_error("Reflection is disabled, cannot perform dynamic cast.");
 #else
         if (!_isBoxedObject) {
-            return dynamic_cast<const T &>(*this);
+            return _CastRef<T>();
         } else {
             const void *rawPtr = GetBoxedRawPtr();
             if (rawPtr == nullptr || GetBoxedType() != typeid(T)) {
@@ -1212,6 +1327,21 @@ namespace sw
      */
     class Reflection
     {
+    private:
+        /**
+         * @brief 计算字段ID时使用的乘数（2^64除以黄金分割比）
+         */
+        static constexpr uint64_t _FieldIdMultiplier = 0x9e3779b97f4a7c15ull;
+
+        /**
+         * @brief 每组类类型与字段类型对应一个类型标记，以其地址作为计算字段ID的种子
+         * @note 标记不是常量，避免链接器合并内容相同的只读数据使不同类型的地址相同
+         */
+        template <typename T, typename TField>
+        struct _FieldTypeTag {
+            static char value;
+        };
+
     public:
         /**
          * @brief 静态类，不允许实例化
@@ -1229,21 +1359,19 @@ namespace sw
         template <typename T, typename TField>
         static FieldId GetFieldId(TField T::*field) noexcept
         {
-            auto pfunc = &Reflection::GetFieldId<T, TField>;
-
-            uint8_t buffer[sizeof(pfunc) + sizeof(field)];
-            memcpy(buffer, &pfunc, sizeof(pfunc));
-            memcpy(buffer + sizeof(pfunc), &field, sizeof(field));
+            // 成员指针按64位整数混合而非逐字节哈希，成员指针为常量时（如RaisePropertyChanged(&T::Prop)内联后）
+            // 整个计算可在编译期折叠，运行时只剩下与类型标记地址有关的几条指令
+            uint64_t words[(sizeof(field) + sizeof(uint64_t) - 1) / sizeof(uint64_t)] = {};
+            memcpy(words, &field, sizeof(field));
 
-            uint32_t prime = 16777619u;
-            uint32_t hash  = 2166136261u;
+            // 类型标记的地址区分偏移相同但所属类或字段类型不同的成员
+            uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&_FieldTypeTag<T, TField>::value));
+            hash *= _FieldIdMultiplier;
 
-            for (size_t i = 0; i < sizeof(buffer); ++i) {
-                hash ^= static_cast<uint32_t>(buffer[i]);
-                hash *= prime;
+            for (uint64_t word : words) {
+                hash = (hash ^ word) * _FieldIdMultiplier;
             }
-
-            return FieldId{hash};
+            return FieldId{static_cast<uint32_t>(hash >> 32)};
         }
 
         /**
@@ -1506,6 +1634,12 @@ namespace sw
             setter(boxed, std::forward<TValue>(value));
         }
     };
+
+    /**
+     * @brief 类型标记的定义
+     */
+    template <typename T, typename TField>
+    char Reflection::_FieldTypeTag<T, TField>::value = 0;
 }
 
 // 为sw::FieldId特化std::hash
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "RoutedEvent.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace sw
+{
+    /**
+     * @brief 记录元素上已注册的路由事件处理函数的表
+     * @note 查找不会插入新项；内置路由事件类型各对应掩码中的一位，未注册的类型只需一次位测试即可排除，
+     *       用户自定义类型及超出掩码范围的内置类型共用最高位
+     * @note 处理函数单独分配，插入新项不会使已返回的引用失效，因此可以在事件处理函数中注册其他事件；
+     *       表中的项不会被删除，注销处理函数只会将其置空
+     */
+    class RoutedEventHandlerTable
+    {
+    private:
+        /**
+         * @brief 表项类型
+         */
+        using _Entry = std::pair<RoutedEventType, std::unique_ptr<RoutedEventHandler>>;
+
+        /**
+         * @brief 按事件类型升序排列的表项
+         */
+        std::vector<_Entry> _entries;
+
+        /**
+         * @brief 已注册事件类型的掩码
+         */
+        uint64_t _mask = 0;
+
+    public:
+        /**
+         * @brief 查找指定事件类型的处理函数
+         * @param eventType 路由事件类型
+         * @return 处理函数指针，若该类型从未注册过则返回nullptr
+         */
+        RoutedEventHandler *Find(RoutedEventType eventType) noexcept
+        {
+            if ((_mask & _GetMaskBit(eventType)) == 0) {
+                return nullptr;
+            }
+            auto it = _LowerBound(eventType);
+            return (it != _entries.end() && it->first == eventType) ? it->second.get() : nullptr;
+        }
+
+        /**
+         * @brief 查找指定事件类型的处理函数
+         * @param eventType 路由事件类型
+         * @return 处理函数指针，若该类型从未注册过则返回nullptr
+         */
+        const RoutedEventHandler *Find(RoutedEventType eventType) const noexcept
+        {
+            return const_cast<RoutedEventHandlerTable *>(this)->Find(eventType);
+        }
+
+        /**
+         * @brief 获取指定事件类型的处理函数，若不存在则插入一个空的处理函数
+         * @param eventType 路由事件类型
+         * @return 处理函数的引用
+         */
+        RoutedEventHandler &GetOrAdd(RoutedEventType eventType)
+        {
+            auto it = _LowerBound(eventType);
+            if (it == _entries.end() || it->first != eventType) {
+                it = _entries.emplace(it, eventType, std::unique_ptr<RoutedEventHandler>(new RoutedEventHandler));
+                _mask |= _GetMaskBit(eventType);
+            }
+            return *it->second;
+        }
+
+        /**
+         * @brief 获取表项数量
+         */
+        int Count() const noexcept
+        {
+            return static_cast<int>(_entries.size());
+        }
+
+    private:
+        /**
+         * @brief 获取事件类型对应的掩码位
+         */
+        static uint64_t _GetMaskBit(RoutedEventType eventType) noexcept
+        {
+            uint32_t index = eventType > RoutedEventType_UserEnd
+                                 ? static_cast<uint32_t>(eventType - RoutedEventType_UserEnd - 1)
+                                 : 63;
+            return uint64_t(1) << (index < 63 ? index : 63);
+        }
+
+        /**
+         * @brief 查找第一个类型不小于eventType的表项
+         */
+        std::vector<_Entry>::iterator _LowerBound(RoutedEventType eventType) noexcept
+        {
+            return std::lower_bound(
+                _entries.begin(), _entries.end(), eventType,
+                [](const _Entry &entry, RoutedEventType type) { return entry.first < type; });
+        }
+    };
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+namespace sw
+{
+    /**
+     * @brief 线程内可复用的临时数组，用于遍历元素树等需要临时栈的场景
+     * @note 构造时从当前线程的缓冲池取出一个数组，析构时清空并放回，数组已分配的容量会保留到下次使用，
+     *       因此反复执行的遍历在稳定后不会再进行堆分配
+     * @note 遍历过程中的回调再次进入时会从池中取出另一个数组，不会与外层共用同一数组
+     */
+    template <typename T>
+    class ScratchBuffer
+    {
+    private:
+        /**
+         * @brief 当前线程中空闲的数组
+         */
+        using _Pool = std::vector<std::unique_ptr<std::vector<T>>>;
+
+        /**
+         * @brief 当前使用的数组
+         */
+        std::unique_ptr<std::vector<T>> _buffer;
+
+    public:
+        /**
+         * @brief 从当前线程的缓冲池取出一个空数组
+         */
+        ScratchBuffer()
+        {
+            _Pool &pool = _GetPool();
+            if (pool.empty()) {
+                _buffer.reset(new std::vector<T>);
+            } else {
+                _buffer = std::move(pool.back());
+                pool.pop_back();
+            }
+        }
+
+        /**
+         * @brief 清空数组并放回当前线程的缓冲池
+         */
+        ~ScratchBuffer()
+        {
+            _buffer->clear();
+            try {
+                _GetPool().push_back(std::move(_buffer));
+            } catch (...) {
+                // 放回失败时直接释放数组
+            }
+        }
+
+        ScratchBuffer(const ScratchBuffer &)            = delete;
+        ScratchBuffer &operator=(const ScratchBuffer &) = delete;
+
+        /**
+         * @brief 获取数组
+         */
+        std::vector<T> &operator*() noexcept
+        {
+            return *_buffer;
+        }
+
+        /**
+         * @brief 访问数组的成员
+         */
+        std::vector<T> *operator->() noexcept
+        {
+            return _buffer.get();
+        }
+
+    private:
+        /**
+         * @brief 获取当前线程的缓冲池
+         */
+        static _Pool &_GetPool()
+        {
+            static thread_local _Pool pool;
+            return pool;
+        }
+    };
+}
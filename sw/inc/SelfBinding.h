@@ -76,6 +76,22 @@ namespace sw
             _innerBinding->SetBindingMode(mode);
         }
 
+        /**
+         * @brief 获取源属性更改时更新目标属性的时机
+         */
+        BindingUpdateMode GetUpdateMode() const
+        {
+            return _innerBinding->GetUpdateMode();
+        }
+
+        /**
+         * @brief 设置源属性更改时更新目标属性的时机
+         */
+        void SetUpdateMode(BindingUpdateMode mode)
+        {
+            _innerBinding->SetUpdateMode(mode);
+        }
+
         /**
          * @brief 获取目标对象
          */
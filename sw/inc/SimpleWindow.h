@@ -11,6 +11,7 @@
 #include "Binding.h"
 #include "BindingCastHelper.h"
 #include "BmpBox.h"
+#include "BrushCache.h"
 #include "Button.h"
 #include "ButtonBase.h"
 #include "Canvas.h"
@@ -28,6 +29,8 @@
 #include "DateTimePicker.h"
 #include "Delegate.h"
 #include "Dip.h"
+#include "Dispatcher.h"
+#include "DispatcherQueue.h"
 #include "DockLayout.h"
 #include "DockPanel.h"
 #include "DockSplitter.h"
@@ -38,6 +41,7 @@
 #include "FillLayout.h"
 #include "FolderDialog.h"
 #include "Font.h"
+#include "FontCache.h"
 #include "FontDialog.h"
 #include "FrameworkElement.h"
 #include "Grid.h"
@@ -49,6 +53,8 @@
 #include "HwndWrapper.h"
 #include "IComparable.h"
 #include "IDialog.h"
+#include "IItemGenerator.h"
+#include "IItemSearchIndex.h"
 #include "ILayout.h"
 #include "IList.h"
 #include "INotifyCollectionChanged.h"
@@ -60,7 +66,9 @@
 #include "IValueConverter.h"
 #include "Icon.h"
 #include "IconBox.h"
+#include "IdleScheduler.h"
 #include "ImageList.h"
+#include "IncrementalItemSearch.h"
 #include "Internal.h"
 #include "ItemsControl.h"
 #include "Keys.h"
@@ -68,6 +76,7 @@
 #include "Label.h"
 #include "Layer.h"
 #include "LayoutHost.h"
+#include "LayoutProfiler.h"
 #include "List.h"
 #include "ListBox.h"
 #include "ListView.h"
@@ -91,6 +100,8 @@
 #include "Reflection.h"
 #include "RoutedEvent.h"
 #include "RoutedEventArgs.h"
+#include "RoutedEventHandlerTable.h"
+#include "ScratchBuffer.h"
 #include "Screen.h"
 #include "ScrollEnums.h"
 #include "SelfBinding.h"
@@ -116,6 +127,8 @@
 #include "UniformGridLayout.h"
 #include "Utils.h"
 #include "Variant.h"
+#include "VirtualizingStackLayout.h"
+#include "VirtualizingStackPanel.h"
 #include "Window.h"
 #include "WndBase.h"
 #include "WndMsg.h"
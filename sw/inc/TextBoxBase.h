@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Control.h"
+#include <string>
+#include <vector>
 
 namespace sw
 {
@@ -20,6 +22,31 @@ namespace sw
          */
         bool _acceptTab = false;
 
+        /**
+         * @brief 通过AppendText追加、尚未写入控件的文本
+         */
+        std::wstring _pendingAppendText{};
+
+        /**
+         * @brief 是否已投递写入追加文本的消息
+         */
+        bool _isAppendPosted = false;
+
+        /**
+         * @brief 是否正在写入追加文本，此时控件发出的EN_CHANGE不使储存的文本失效
+         */
+        bool _isAppending = false;
+
+        /**
+         * @brief 追加文本后保留的最大行数，0表示不限制
+         */
+        int _maxLineCount = 0;
+
+        /**
+         * @brief 追加文本后保留的最大字符数，0表示不限制
+         */
+        int _maxTextLength = 0;
+
     public:
         /**
          * @brief 是否只读
@@ -41,6 +68,17 @@ namespace sw
          */
         const Property<bool> AcceptTab;
 
+        /**
+         * @brief 通过AppendText或AppendLines追加文本后保留的最大行数，超出时从开头删除多余的行，0表示不限制
+         * @note 行数为控件中显示的行数，自动换行时一行文本可能占用多行
+         */
+        const Property<int> MaxLineCount;
+
+        /**
+         * @brief 通过AppendText或AppendLines追加文本后保留的最大字符数，超出时从开头按行删除，0表示不限制
+         */
+        const Property<int> MaxTextLength;
+
     public:
         /**
          * @brief 初始化TextBoxBase
@@ -64,6 +102,12 @@ namespace sw
          */
         virtual std::wstring &GetInternalText() override;
 
+        /**
+         * @brief 设置窗口文本，尚未写入的追加文本将被丢弃
+         * @param value 要设置的文本
+         */
+        virtual void SetInternalText(const std::wstring &value) override;
+
         /**
          * @brief 当父窗口接收到控件的WM_COMMAND时调用该函数
          * @param code 通知代码
@@ -86,6 +130,12 @@ namespace sw
          */
         virtual bool OnKeyDown(VirtualKey key, const KeyFlags &flags) override;
 
+        /**
+         * @brief 控件句柄发生改变时调用该函数
+         * @param hwnd 新的控件句柄
+         */
+        virtual void OnHandleChanged(HWND hwnd) override;
+
     public:
         /**
          * @brief 选择指定文本内容
@@ -115,6 +165,24 @@ namespace sw
          */
         void Clear();
 
+        /**
+         * @brief 在末尾追加文本，不读取和重新设置整个文本
+         * @note 同一轮消息循环中的多次追加会合并为一次写入，在此之前读取Text属性或调用FlushAppendText会立即写入
+         * @param text 要追加的文本
+         */
+        void AppendText(const std::wstring &text);
+
+        /**
+         * @brief 在末尾追加若干行文本，每行末尾添加换行符
+         * @param lines 要追加的行
+         */
+        void AppendLines(const std::vector<std::wstring> &lines);
+
+        /**
+         * @brief 立即将尚未写入的追加文本写入控件，并按MaxLineCount和MaxTextLength删除开头多余的文本
+         */
+        void FlushAppendText();
+
     private:
         /**
          * @brief 读取HorizontalContentAlignment属性时调用
@@ -125,5 +193,11 @@ namespace sw
          * @brief 写入HorizontalContentAlignment属性时调用
          */
         void _SetHorzContentAlignment(sw::HorizontalAlignment value);
+
+        /**
+         * @brief 计算按MaxLineCount和MaxTextLength需要从开头删除的字符数
+         * @param endsWithNewLine 文本是否以换行符结尾，此时不计末尾的空行
+         */
+        int _GetAppendTrimLength(bool endsWithNewLine);
     };
 }
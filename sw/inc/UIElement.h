@@ -9,6 +9,7 @@
 #include "ILayout.h"
 #include "RoutedEvent.h"
 #include "RoutedEventArgs.h"
+#include "RoutedEventHandlerTable.h"
 #include "Thickness.h"
 #include "WndBase.h"
 #include <cstdint>
@@ -44,6 +45,10 @@ namespace sw
         /// 字体改变时更新布局
         FontChanged = 1 << 5,
 
+        /// 框架内部使用，表示已投递布局更新消息且尚未处理
+        /// @note 该标记仅在根元素上设置，用于合并同一轮消息循环中的多次布局更新请求
+        LayoutPending = 1 << 28,
+
         /// 框架内部使用，表示布局已失效
         /// @note 该标记指示了Measure函数的结果已失效，需要重新调用Measure函数来更新尺寸
         MeasureInvalidated = 1 << 29,
@@ -59,6 +64,47 @@ namespace sw
      */
     _SW_ENUM_ENABLE_BIT_OPERATIONS(LayoutUpdateCondition);
 
+    /**
+     * @brief 布局更新的统计数据
+     * @note 统计数据按线程记录
+     */
+    struct LayoutUpdateStatistics {
+        /**
+         * @brief 请求布局更新的次数
+         */
+        uint64_t invalidationCount = 0;
+
+        /**
+         * @brief 合并到已挂起的布局更新中的请求次数
+         */
+        uint64_t mergedInvalidationCount = 0;
+
+        /**
+         * @brief 实际执行的布局更新次数
+         */
+        uint64_t layoutPassCount = 0;
+
+        /**
+         * @brief 最近一次布局更新处理的请求数
+         */
+        uint32_t lastPassInvalidationCount = 0;
+
+        /**
+         * @brief 单次布局更新处理的最大请求数
+         */
+        uint32_t maxPassInvalidationCount = 0;
+
+        /**
+         * @brief Arrange时因位置和尺寸未变而跳过SetWindowPos或DeferWindowPos的次数
+         */
+        uint64_t skippedWindowPosCount = 0;
+
+        /**
+         * @brief Arrange时因位置、尺寸未变且测量未失效而跳过ArrangeOverride的次数
+         */
+        uint64_t skippedArrangeOverrideCount = 0;
+    };
+
     /**
      * @brief 表示界面中的元素
      */
@@ -130,9 +176,9 @@ namespace sw
         std::vector<UIElement *> _layoutVisibleChildren{};
 
         /**
-         * @brief 记录路由事件的map
+         * @brief 记录路由事件处理函数的表
          */
-        std::unordered_map<RoutedEventType, RoutedEventHandler> _eventMap{};
+        RoutedEventHandlerTable _eventTable{};
 
         /**
          * @brief 布局标记
@@ -204,30 +250,40 @@ namespace sw
          */
         HCURSOR _hCursor = NULL;
 
+        /**
+         * @brief 响应WM_CTLCOLORxxx时返回的背景画刷，由BrushCache::Acquire获取，背景色改变或元素析构时释放
+         */
+        HBRUSH _hCtlColorBrush = NULL;
+
+        /**
+         * @brief _hCtlColorBrush的颜色
+         */
+        COLORREF _ctlColorBrushColor = 0;
+
         /**
          * @brief 上一次Measure函数调用时的可用大小
          */
         Size _lastMeasureAvailableSize{};
 
         /**
-         * @brief 用于存储批量调整子元素位置时调用DeferWindowPos的句柄
+         * @brief 当前挂起的布局更新所合并的请求数，仅对根元素有效
          */
-        HDWP _hdwpChildren = NULL;
+        uint32_t _pendingInvalidationCount = 0;
 
         /**
-         * @brief OnColor函数中使用的背景画刷句柄
+         * @brief 用于存储批量调整子元素位置时调用DeferWindowPos的句柄
          */
-        HBRUSH _hCtlColorBrush = NULL;
+        HDWP _hdwpChildren = NULL;
 
         /**
-         * @brief 记录上一次调用OnColor时的文本颜色
+         * @brief 上一次Arrange时设置的窗口位置和尺寸（像素，right和bottom分别为宽和高）
          */
-        COLORREF _lastTextColor = 0;
+        RECT _lastArrangedRect{};
 
         /**
-         * @brief 记录上一次调用OnColor时的背景颜色
+         * @brief _lastArrangedRect是否有效
          */
-        COLORREF _lastBackColor = 0;
+        bool _hasArrangedRect = false;
 
         /**
          * @brief 当前元素是否响应鼠标事件
@@ -559,10 +615,27 @@ namespace sw
         bool IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition condition);
 
         /**
-         * @brief 使元素的布局状态失效，并立即触发布局更新
+         * @brief 使元素的布局状态失效，并请求更新布局
+         * @note 布局更新不会立即执行，而是向根元素投递一次WM_UpdateLayout消息，在当前消息循环中绘制之前完成，
+         *       在此之前的多次调用会合并为一次布局更新，若需要立即获取布局结果可调用UpdateLayoutNow函数
          */
         void InvalidateMeasure();
 
+        /**
+         * @brief 若当前元素所在的界面有挂起的布局更新，则立即执行布局更新
+         */
+        void UpdateLayoutNow();
+
+        /**
+         * @brief 获取当前线程的布局更新统计数据
+         */
+        static LayoutUpdateStatistics GetLayoutUpdateStatistics();
+
+        /**
+         * @brief 重置当前线程的布局更新统计数据
+         */
+        static void ResetLayoutUpdateStatistics();
+
         /**
          * @brief 尝试将当前元素移动到可视区域内
          * @return 若函数成功则返回true，否则返回false
@@ -719,6 +792,13 @@ namespace sw
          */
         virtual void ArrangeOverride(const Size &finalSize);
 
+        /**
+         * @brief 处理WM_UpdateLayout消息时调用该函数，清除挂起的布局更新并记录统计数据
+         * @param deferred 消息是否由InvalidateMeasure延迟投递
+         * @return 是否需要执行布局更新，若延迟投递的请求已被UpdateLayoutNow提前处理则返回false
+         */
+        bool AcceptLayoutUpdate(bool deferred);
+
         /**
          * @brief 设置背景颜色
          * @param color 要设置的颜色
@@ -1001,6 +1081,13 @@ namespace sw
          */
         void _SetMeasureInvalidated();
 
+        /**
+         * @brief 判断窗口是否已按上一次Arrange的结果位于指定位置
+         * @param pxRect 窗口的位置和尺寸（像素，right和bottom分别为宽和高）
+         * @return 若上一次Arrange设置的位置和尺寸与pxRect相同，且窗口当前的位置和尺寸也与之相同则返回true
+         */
+        bool _IsArrangedAt(const RECT &pxRect);
+
         /**
          * @brief 更新_layoutVisibleChildren的内容
          */
@@ -1174,7 +1261,7 @@ namespace sw
         template <typename T>
         void AddHandler(RoutedEventType eventType, T &obj, void (T::*handler)(UIElement &, RoutedEventArgs &))
         {
-            if (handler) this->_eventMap[eventType].Add(obj, handler);
+            if (handler) this->_eventTable.GetOrAdd(eventType).Add(obj, handler);
         }
 
         /**
@@ -1248,7 +1335,9 @@ namespace sw
         template <typename T>
         bool RemoveHandler(RoutedEventType eventType, T &obj, void (T::*handler)(UIElement &, RoutedEventArgs &))
         {
-            return handler == nullptr ? false : this->_eventMap[eventType].Remove(obj, handler);
+            if (handler == nullptr) return false;
+            auto eventHandler = this->_eventTable.Find(eventType);
+            return eventHandler != nullptr && eventHandler->Remove(obj, handler);
         }
 
         /**
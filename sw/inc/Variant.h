@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Reflection.h"
+#include <cstddef>
+#include <new>
 
 namespace sw
 {
@@ -31,19 +33,106 @@ namespace sw
      *       通过Variant::MakeRef或显式构造ObjectRef可获得引用语义。
      * @note 持入Variant的类型其析构函数不应抛出异常 —— C++11起析构函数默认即为
      *       noexcept，Variant的多个noexcept移动操作依赖此前提。
+     * @note 内部对象（DynamicObject派生类型或BoxedObject<T>）足够小且可nothrow移动构造时直接存放在
+     *       Variant内部的缓冲区中，不进行堆分配，如int、double、bool、ObjectRef等，
+     *       此时拷贝与移动Variant同样不会分配内存。
      */
     class Variant final
     {
     private:
         /**
-         * @brief 内部动态对象指针
+         * @brief 内联缓冲区的大小
          */
-        std::unique_ptr<DynamicObject> _obj;
+        static constexpr std::size_t _InlineSize = 4 * sizeof(void *);
 
         /**
-         * @brief 克隆对象函数指针
+         * @brief 内联缓冲区的对齐
          */
-        DynamicObject *(*_cloner)(const DynamicObject &) = nullptr;
+        static constexpr std::size_t _InlineAlign = alignof(double) > alignof(void *) ? alignof(double) : alignof(void *);
+
+        /**
+         * @brief 内联缓冲区类型
+         */
+        struct _InlineBuffer {
+            alignas(_InlineAlign) unsigned char data[_InlineSize];
+        };
+
+        /**
+         * @brief 判断指定的DynamicObject类型是否可以存放在内联缓冲区中
+         */
+        template <typename U>
+        struct _IsInlineStorable
+            : std::integral_constant<
+                  bool,
+                  sizeof(U) <= _InlineSize &&
+                      alignof(U) <= _InlineAlign &&
+                      _InlineAlign % alignof(U) == 0 &&
+                      std::is_nothrow_move_constructible<U>::value> {
+        };
+
+        /**
+         * @brief 判断内部对象是否可拷贝，对于BoxedObject<T>取决于被装箱的类型T
+         */
+        template <typename U>
+        struct _IsCopyableObject : std::is_copy_constructible<U> {
+        };
+
+        /**
+         * @brief _IsCopyableObject模板特化（对于BoxedObject）
+         */
+        template <typename T>
+        struct _IsCopyableObject<BoxedObject<T>> : std::is_copy_constructible<T> {
+        };
+
+        /**
+         * @brief 内部对象的操作函数表，每种内部对象类型对应一个静态实例
+         */
+        struct _ObjectOps {
+            /**
+             * @brief 拷贝对象，内联存储时在buf中构造，否则在堆上构造
+             */
+            DynamicObject *(*copy)(const DynamicObject &obj, void *buf);
+
+            /**
+             * @brief 将内联存储的对象移动到buf中并析构原对象
+             */
+            DynamicObject *(*relocate)(DynamicObject &obj, void *buf);
+
+            /**
+             * @brief 销毁对象，内联存储时仅调用析构函数，否则delete对象
+             */
+            void (*destroy)(DynamicObject *obj);
+
+            /**
+             * @brief 将内联存储的对象移动到堆上并析构原对象，堆上的对象直接返回
+             */
+            DynamicObject *(*moveToHeap)(DynamicObject &obj);
+
+            /**
+             * @brief 获取同一类型对象存放在堆上时的操作函数表
+             */
+            const _ObjectOps *(*heapOps)();
+
+            /**
+             * @brief 对象是否存放在内联缓冲区中
+             */
+            bool isInline;
+        };
+
+        /**
+         * @brief 内部动态对象指针，指向_buf或堆上的对象
+         */
+        DynamicObject *_obj = nullptr;
+
+        /**
+         * @brief 内部对象的操作函数表
+         */
+        const _ObjectOps *_ops = nullptr;
+
+        /**
+         * @brief 内联缓冲区
+         */
+        _InlineBuffer _buf;
 
     public:
         /**
@@ -68,8 +157,7 @@ namespace sw
         Variant(ObjectRef ref)
         {
             if (ref.ptr != nullptr) {
-                _obj.reset(new BoxedObject<ObjectRef>(ref));
-                ResetCloner<ObjectRef>();
+                _Emplace<BoxedObject<ObjectRef>>(ref);
             }
         }
 
@@ -93,8 +181,8 @@ namespace sw
         Variant(const Variant &other)
         {
             if (other._obj != nullptr) {
-                _obj.reset(other._cloner(*other._obj));
-                _cloner = other._cloner;
+                _obj = other._ops->copy(*other._obj, _buf.data);
+                _ops = other._ops;
             }
         }
 
@@ -102,9 +190,16 @@ namespace sw
          * @brief 移动构造函数
          */
         Variant(Variant &&other) noexcept
-            : _obj(std::move(other._obj)), _cloner(other._cloner)
         {
-            other._cloner = nullptr;
+            _TakeFrom(other);
+        }
+
+        /**
+         * @brief 析构函数
+         */
+        ~Variant()
+        {
+            Reset();
         }
 
         /**
@@ -179,8 +274,13 @@ namespace sw
          */
         void Reset() noexcept
         {
-            _obj.reset();
-            _cloner = nullptr;
+            if (_obj != nullptr) {
+                DynamicObject *obj     = _obj;
+                const _ObjectOps *ops = _ops;
+                _obj                   = nullptr;
+                _ops                   = nullptr;
+                ops->destroy(obj);
+            }
         }
 
         /**
@@ -203,8 +303,7 @@ namespace sw
             if (ref.ptr == nullptr) {
                 Reset();
             } else {
-                _obj.reset(new BoxedObject<ObjectRef>(ref));
-                ResetCloner<ObjectRef>();
+                _Emplace<BoxedObject<ObjectRef>>(ref);
             }
         }
 
@@ -221,8 +320,10 @@ namespace sw
             if (other._obj == nullptr) {
                 Reset();
             } else {
-                _obj.reset(other._cloner(*other._obj));
-                _cloner = other._cloner;
+                // 先拷贝到临时缓冲区再替换，保证拷贝失败时当前值不变
+                _InlineBuffer tmp;
+                DynamicObject *obj = other._ops->copy(*other._obj, tmp.data);
+                _Replace(other._ops, obj);
             }
         }
 
@@ -232,9 +333,10 @@ namespace sw
         void Reset(Variant &&other) noexcept
         {
             if (this != &other) {
-                _obj          = std::move(other._obj);
-                _cloner       = other._cloner;
-                other._cloner = nullptr;
+                // other可能由当前对象持有，先将其内容转移到临时Variant中再释放当前对象
+                Variant tmp(std::move(other));
+                Reset();
+                _TakeFrom(tmp);
             }
         }
 
@@ -250,8 +352,7 @@ namespace sw
                 std::is_base_of<DynamicObject, typename std::decay<T>::type>::value>::type
         {
             using U = typename std::decay<T>::type;
-            _obj.reset(new U(std::forward<T>(obj)));
-            ResetCloner<U>();
+            _Emplace<U>(std::forward<T>(obj));
         }
 
         /**
@@ -266,8 +367,7 @@ namespace sw
                 !std::is_base_of<DynamicObject, typename std::decay<T>::type>::value>::type
         {
             using U = typename std::decay<T>::type;
-            _obj.reset(new BoxedObject<U>(std::forward<T>(obj)));
-            ResetCloner<U>();
+            _Emplace<BoxedObject<U>>(std::forward<T>(obj));
         }
 
         /**
@@ -287,7 +387,7 @@ namespace sw
             if (_obj->IsType<ObjectRef>(&ref)) {
                 return ref->ptr;
             }
-            return _obj.get();
+            return _obj;
         }
 
         /**
@@ -307,7 +407,7 @@ namespace sw
             if (_obj->IsType<ObjectRef>(&ref)) {
                 return ref->ptr;
             }
-            return _obj.get();
+            return _obj;
         }
 
         /**
@@ -440,44 +540,196 @@ namespace sw
 
     private:
         /**
-         * @brief 初始化克隆函数指针
-         * @tparam T 对象类型
+         * @brief 获取指定内部对象类型的操作函数表
+         * @tparam U 内部对象类型，为DynamicObject派生类型或BoxedObject<T>
+         * @tparam Inline 对象是否存放在内联缓冲区中
          */
-        template <typename T>
-        auto ResetCloner()
-            -> typename std::enable_if<std::is_copy_constructible<T>::value && std::is_base_of<DynamicObject, T>::value>::type
+        template <typename U, bool Inline = _IsInlineStorable<U>::value>
+        static const _ObjectOps *_GetOps() noexcept
         {
-            _cloner = [](const DynamicObject &other) -> DynamicObject * {
-                return new T(other.UnsafeCast<T>());
+            static const _ObjectOps ops = {
+                &Variant::_CopyObject<U, Inline>,
+                &Variant::_RelocateObject<U, Inline>,
+                &Variant::_DestroyObject<U, Inline>,
+                &Variant::_MoveObjectToHeap<U, Inline>,
+                &Variant::_GetOps<U, false>,
+                Inline,
             };
+            return &ops;
         }
 
         /**
-         * @brief 初始化克隆函数指针
-         * @tparam T 对象类型
+         * @brief 在buf或堆上构造内部对象
+         * @tparam U 内部对象类型
+         * @return 构造的对象指针
          */
-        template <typename T>
-        auto ResetCloner()
-            -> typename std::enable_if<std::is_copy_constructible<T>::value && !std::is_base_of<DynamicObject, T>::value>::type
+        template <typename U, bool Inline = _IsInlineStorable<U>::value, typename... Args>
+        static auto _ConstructObject(void *buf, Args &&...args)
+            -> typename std::enable_if<Inline, DynamicObject *>::type
         {
-            _cloner = [](const DynamicObject &other) -> DynamicObject * {
-                return new BoxedObject<T>(other.UnsafeCast<BoxedObject<T>>());
-            };
+            return new (buf) U(std::forward<Args>(args)...);
         }
 
         /**
-         * @brief 初始化克隆函数指针
-         * @tparam T 对象类型
-         * @note 当T不可拷贝时，克隆函数指针在被调用时抛出std::runtime_error，
+         * @brief 在buf或堆上构造内部对象
+         * @tparam U 内部对象类型
+         * @return 构造的对象指针
+         */
+        template <typename U, bool Inline = _IsInlineStorable<U>::value, typename... Args>
+        static auto _ConstructObject(void *, Args &&...args)
+            -> typename std::enable_if<!Inline, DynamicObject *>::type
+        {
+            return new U(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief 拷贝内部对象
+         * @tparam U 内部对象类型
+         */
+        template <typename U, bool Inline>
+        static auto _CopyObject(const DynamicObject &obj, void *buf)
+            -> typename std::enable_if<_IsCopyableObject<U>::value, DynamicObject *>::type
+        {
+            return _ConstructObject<U, Inline>(buf, obj.UnsafeCast<U>());
+        }
+
+        /**
+         * @brief 拷贝内部对象
+         * @tparam U 内部对象类型
+         * @note 当内部对象不可拷贝时，在被调用时抛出std::runtime_error，
          *       而非在编译期失败 —— 以便不可拷贝类型仍可被存放和移动。
          */
-        template <typename T>
-        auto ResetCloner()
-            -> typename std::enable_if<!std::is_copy_constructible<T>::value>::type
+        template <typename U, bool Inline>
+        static auto _CopyObject(const DynamicObject &, void *)
+            -> typename std::enable_if<!_IsCopyableObject<U>::value, DynamicObject *>::type
         {
-            _cloner = [](const DynamicObject &other) -> DynamicObject * {
-                throw std::runtime_error("Object is not copy constructible.");
-            };
+            throw std::runtime_error("Object is not copy constructible.");
+        }
+
+        /**
+         * @brief 将内联存储的对象移动到buf中并析构原对象
+         * @tparam U 内部对象类型
+         */
+        template <typename U, bool Inline>
+        static auto _RelocateObject(DynamicObject &obj, void *buf) noexcept
+            -> typename std::enable_if<Inline, DynamicObject *>::type
+        {
+            U &src       = obj.UnsafeCast<U>();
+            U *relocated = new (buf) U(std::move(src));
+            src.~U();
+            return relocated;
+        }
+
+        /**
+         * @brief 将内联存储的对象移动到buf中并析构原对象
+         * @tparam U 内部对象类型
+         * @note 堆上的对象通过转移指针完成移动，不会调用该函数
+         */
+        template <typename U, bool Inline>
+        static auto _RelocateObject(DynamicObject &obj, void *) noexcept
+            -> typename std::enable_if<!Inline, DynamicObject *>::type
+        {
+            return &obj;
+        }
+
+        /**
+         * @brief 将内联存储的对象移动到堆上并析构原对象
+         * @tparam U 内部对象类型
+         */
+        template <typename U, bool Inline>
+        static auto _MoveObjectToHeap(DynamicObject &obj)
+            -> typename std::enable_if<Inline, DynamicObject *>::type
+        {
+            U &src   = obj.UnsafeCast<U>();
+            U *moved = new U(std::move(src));
+            src.~U();
+            return moved;
+        }
+
+        /**
+         * @brief 将内联存储的对象移动到堆上并析构原对象
+         * @tparam U 内部对象类型
+         * @note 对象已在堆上时直接返回
+         */
+        template <typename U, bool Inline>
+        static auto _MoveObjectToHeap(DynamicObject &obj)
+            -> typename std::enable_if<!Inline, DynamicObject *>::type
+        {
+            return &obj;
+        }
+
+        /**
+         * @brief 销毁内部对象
+         * @tparam U 内部对象类型
+         */
+        template <typename U, bool Inline>
+        static auto _DestroyObject(DynamicObject *obj) noexcept
+            -> typename std::enable_if<Inline>::type
+        {
+            obj->~DynamicObject();
+        }
+
+        /**
+         * @brief 销毁内部对象
+         * @tparam U 内部对象类型
+         */
+        template <typename U, bool Inline>
+        static auto _DestroyObject(DynamicObject *obj) noexcept
+            -> typename std::enable_if<!Inline>::type
+        {
+            delete obj;
+        }
+
+        /**
+         * @brief 释放当前对象并接管新对象
+         * @param ops 新对象的操作函数表
+         * @param obj 新对象，内联存储时为临时缓冲区中的对象，会被移动到_buf中
+         */
+        void _Replace(const _ObjectOps *ops, DynamicObject *obj) noexcept
+        {
+            Reset();
+            if (obj != nullptr) {
+                _obj = ops->isInline ? ops->relocate(*obj, _buf.data) : obj;
+                _ops = ops;
+            }
+        }
+
+        /**
+         * @brief 接管另一个Variant的对象，调用前当前对象须为空
+         */
+        void _TakeFrom(Variant &other) noexcept
+        {
+            if (other._obj != nullptr) {
+                _obj = other._ops->isInline ? other._ops->relocate(*other._obj, _buf.data) : other._obj;
+                _ops = other._ops;
+
+                other._obj = nullptr;
+                other._ops = nullptr;
+            }
+        }
+
+        /**
+         * @brief 将内联存储的对象移动到堆上，使其地址在Variant移动后保持不变
+         */
+        void _MoveToHeap()
+        {
+            if (_obj != nullptr && _ops->isInline) {
+                _obj = _ops->moveToHeap(*_obj);
+                _ops = _ops->heapOps();
+            }
+        }
+
+        /**
+         * @brief 构造指定类型的内部对象并替换当前对象
+         * @tparam U 内部对象类型，为DynamicObject派生类型或BoxedObject<T>
+         * @note 新对象先在临时缓冲区中构造，因此args可以引用当前Variant中的对象
+         */
+        template <typename U, typename... Args>
+        void _Emplace(Args &&...args)
+        {
+            _InlineBuffer tmp;
+            DynamicObject *obj = _ConstructObject<U>(tmp.data, std::forward<Args>(args)...);
+            _Replace(_GetOps<U>(), obj);
         }
 
     public:
@@ -498,8 +750,8 @@ namespace sw
                 Variant>::type
         {
             Variant v;
-            v._obj.reset(new T(std::forward<Args>(args)...));
-            v.ResetCloner<T>();
+            v._obj = _ConstructObject<T>(v._buf.data, std::forward<Args>(args)...);
+            v._ops = _GetOps<T>();
             return v;
         }
 
@@ -520,8 +772,8 @@ namespace sw
                 Variant>::type
         {
             Variant v;
-            v._obj.reset(new BoxedObject<T>(std::forward<Args>(args)...));
-            v.ResetCloner<T>();
+            v._obj = _ConstructObject<BoxedObject<T>>(v._buf.data, std::forward<Args>(args)...);
+            v._ops = _GetOps<BoxedObject<T>>();
             return v;
         }
 
@@ -532,9 +784,14 @@ namespace sw
          * @note 避免对Variant调用泛型MakeRef时产生BoxedObject<Variant>嵌套包装。
          *       结果直接引用v.Object()返回的指针，因此当v本身已是引用语义时，
          *       结果与v共享同一被引用对象，不会形成多层引用链。
+         * @note 若v的对象存放在内联缓冲区中，会先将其移动到堆上，
+         *       使结果在v被移动后仍然有效。使用方需保证v的对象在结果存活期间不被销毁或替换。
          */
         static Variant MakeRef(Variant &v)
         {
+            if (v.Object() == v._obj) {
+                v._MoveToHeap();
+            }
             DynamicObject *p = v.Object();
             return p == nullptr ? Variant{} : MakeRef(*p);
         }
@@ -555,8 +812,7 @@ namespace sw
                 Variant>::type
         {
             Variant v;
-            v._obj.reset(new BoxedObject<ObjectRef>(ObjectRef{&obj}));
-            v.ResetCloner<ObjectRef>();
+            v._Emplace<BoxedObject<ObjectRef>>(ObjectRef{&obj});
             return v;
         }
 
@@ -576,8 +832,7 @@ namespace sw
                 Variant>::type
         {
             Variant v;
-            v._obj.reset(new BoxedObject<T>(BoxedObject<T>::MakeRef(obj)));
-            v.ResetCloner<T>();
+            v._Emplace<BoxedObject<T>>(BoxedObject<T>::MakeRef(obj));
             return v;
         }
     };
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "Alignment.h"
+#include "IItemGenerator.h"
+#include "LayoutHost.h"
+#include <vector>
+
+namespace sw
+{
+    /**
+     * @brief 虚拟化堆叠布局，只实现化与可视区域相交的子项
+     * @note 子项由generator按需生成，离开可视区域的子项会交还generator回收；
+     *       未实现化过的子项按estimatedItemExtent估算其在堆叠方向上的尺寸
+     * @note 该布局不使用关联对象的子元素列表，数据项增删后需调用ResetItems
+     */
+    class VirtualizingStackLayout : public LayoutHost
+    {
+    public:
+        /**
+         * @brief 排列方式
+         */
+        Orientation orientation = Orientation::Vertical;
+
+        /**
+         * @brief 未实现化过的子项在堆叠方向上的估计尺寸
+         */
+        double estimatedItemExtent = 20;
+
+        /**
+         * @brief 子项生成器，为nullptr时不布局任何子项
+         * @note 更换生成器前应先调用ResetItems，使已实现化的子项交还原生成器回收
+         */
+        IItemGenerator *generator = nullptr;
+
+    private:
+        /**
+         * @brief 最近一次更新的可视区域
+         */
+        Rect _viewport{};
+
+        /**
+         * @brief 各子项在堆叠方向上测量得到的尺寸，小于0表示尚未测量
+         */
+        std::vector<double> _itemExtents{};
+
+        /**
+         * @brief 已测量子项的尺寸之和
+         */
+        double _measuredExtentSum = 0;
+
+        /**
+         * @brief 已测量子项的数量
+         */
+        int _measuredCount = 0;
+
+        /**
+         * @brief 已测量子项在另一方向上的最大尺寸
+         */
+        double _maxCrossExtent = 0;
+
+        /**
+         * @brief 已实现化子项中第一项的索引
+         */
+        int _firstRealized = 0;
+
+        /**
+         * @brief 已实现化子项中第一项在堆叠方向上的位置
+         */
+        double _firstRealizedOffset = 0;
+
+        /**
+         * @brief 计算_firstRealizedOffset时使用的估计尺寸
+         */
+        double _offsetEstimate = 0;
+
+        /**
+         * @brief 已实现化的子项，按索引从_firstRealized开始连续存放
+         */
+        std::vector<ILayout *> _realizedItems{};
+
+        /**
+         * @brief 更新已实现化的子项时暂存原先的子项，复用其存储以避免每次布局分配内存
+         */
+        std::vector<ILayout *> _previousItems{};
+
+    public:
+        /**
+         * @brief 测量元素所需尺寸，无需考虑边框和边距
+         * @param availableSize 可用的尺寸
+         * @return 返回元素需要占用的尺寸
+         */
+        virtual Size MeasureOverride(const Size &availableSize) override;
+
+        /**
+         * @brief 安排子元素的位置，可重写该函数以实现自定义布局
+         * @param finalSize 可用于排列子元素的最终尺寸
+         */
+        virtual void ArrangeOverride(const Size &finalSize) override;
+
+        /**
+         * @brief 更新关联对象的可视区域，由关联对象在使用布局方式测量前调用
+         * @param viewport 可视区域，坐标相对于子元素的排列原点（已考虑滚动偏移）
+         */
+        virtual void UpdateViewport(const Rect &viewport) override;
+
+        /**
+         * @brief 获取按已测量尺寸与估计尺寸计算的全部子项所占尺寸
+         */
+        virtual Size GetContentExtent() override;
+
+        /**
+         * @brief 回收所有已实现化的子项并清除已测量的尺寸，数据项改变后调用
+         */
+        void ResetItems();
+
+        /**
+         * @brief 获取已实现化子项中第一项的索引
+         */
+        int GetFirstRealizedIndex() const;
+
+        /**
+         * @brief 获取已实现化子项的数量
+         */
+        int GetRealizedCount() const;
+
+    private:
+        /**
+         * @brief 使记录的子项数量与generator一致，回收超出范围的子项
+         */
+        void _SyncItemCount();
+
+        /**
+         * @brief 获取指定子项在堆叠方向上的尺寸，未测量时返回估计尺寸
+         */
+        double _GetItemExtent(int index) const;
+
+        /**
+         * @brief 记录子项测量后的尺寸
+         */
+        void _SetItemMeasured(int index, const Size &desireSize);
+
+        /**
+         * @brief 查找包含指定位置的子项，从上次实现化的位置开始向前或向后查找
+         * @param position 堆叠方向上的位置
+         * @param offset 输出找到的子项在堆叠方向上的位置
+         * @return 子项索引，位置超出全部子项时返回最后一项
+         */
+        int _LocateItem(double position, double &offset);
+
+        /**
+         * @brief 更新已实现化的子项，使其覆盖堆叠方向上的指定范围
+         * @param start 范围起点
+         * @param length 范围长度
+         * @param crossAvailable 另一方向上的可用尺寸
+         * @param measureRealized 是否重新测量此前已实现化的子项
+         */
+        void _UpdateRealizedItems(double start, double length, double crossAvailable, bool measureRealized);
+
+        /**
+         * @brief 回收所有已实现化的子项
+         */
+        void _RecycleAll();
+    };
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "IItemGenerator.h"
+#include "IList.h"
+#include "INotifyCollectionChanged.h"
+#include "Panel.h"
+#include "VirtualizingStackLayout.h"
+#include <memory>
+#include <vector>
+
+namespace sw
+{
+    /**
+     * @brief 虚拟化堆叠面板，按数据源中的项生成子元素，只为可视区域内的项创建子元素
+     * @note 子元素由面板创建并持有，离开可视区域的子元素会被隐藏并在之后呈现其他项时复用
+     * @note 面板按滚动条位置确定可视区域，通常与VerticalScrollBar（水平排列时为HorizontalScrollBar）一同使用
+     */
+    class VirtualizingStackPanel : public Panel, public IItemGenerator
+    {
+    private:
+        /**
+         * @brief 默认布局对象
+         */
+        VirtualizingStackLayout _virtualizingLayout{};
+
+        /**
+         * @brief 数据源
+         */
+        IList *_itemsSource = nullptr;
+
+        /**
+         * @brief 若数据源实现了INotifyCollectionChanged接口，则指向该接口以便订阅事件；否则为nullptr
+         */
+        INotifyCollectionChanged *_notifyCollectionChanged = nullptr;
+
+        /**
+         * @brief 面板创建的全部子元素
+         */
+        std::vector<std::unique_ptr<UIElement>> _itemContainers{};
+
+        /**
+         * @brief 已回收、可供复用的子元素
+         */
+        std::vector<UIElement *> _recycledContainers{};
+
+    public:
+        /**
+         * @brief 排列方式
+         */
+        const Property<sw::Orientation> Orientation;
+
+        /**
+         * @brief 未实现化过的项在堆叠方向上的估计尺寸
+         */
+        const Property<double> EstimatedItemExtent;
+
+        /**
+         * @brief 数据源
+         */
+        const Property<IList *> ItemsSource;
+
+        /**
+         * @brief 当前已创建的子元素数量，包括已回收的子元素
+         */
+        const ReadOnlyProperty<int> ItemContainerCount;
+
+    public:
+        /**
+         * @brief 初始化VirtualizingStackPanel
+         */
+        VirtualizingStackPanel();
+
+        /**
+         * @brief 析构函数
+         */
+        virtual ~VirtualizingStackPanel();
+
+        /**
+         * @brief 获取数据源中项的数量
+         */
+        virtual int GetItemCount() override;
+
+        /**
+         * @brief 为指定索引处的项准备一个子元素，优先复用已回收的子元素
+         */
+        virtual ILayout &RealizeItem(int index) override;
+
+        /**
+         * @brief 隐藏不再可见的子元素以供复用
+         */
+        virtual void RecycleItem(int index, ILayout &container) override;
+
+    protected:
+        /**
+         * @brief 获取默认布局对象
+         */
+        virtual LayoutHost *GetDefaultLayout() override final;
+
+        /**
+         * @brief 创建用于呈现项的子元素，默认创建Label
+         * @return 新创建的子元素，其所有权转交给面板
+         */
+        virtual UIElement *CreateItemContainer();
+
+        /**
+         * @brief 使子元素呈现指定的项，子元素被创建或复用时调用
+         * @param container 子元素
+         * @param index 项的索引
+         * @param item 包含项数据的Variant对象
+         * @note 默认实现在项为std::wstring时将其设为子元素的文本
+         */
+        virtual void PrepareItemContainer(UIElement &container, int index, const Variant &item);
+
+    private:
+        /**
+         * @brief 回收全部子元素并重新布局
+         */
+        void _ResetItems();
+
+        /**
+         * @brief 处理数据源集合变更事件的函数
+         */
+        void _CollectionChangedEventHandler(INotifyCollectionChanged &sender, NotifyCollectionChangedEventArgs &args);
+    };
+}
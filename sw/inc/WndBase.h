@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Delegate.h"
+#include "DispatcherQueue.h"
 #include "Font.h"
 #include "FrameworkElement.h"
 #include "HitTestResult.h"
@@ -872,10 +873,22 @@ namespace sw
         /**
          * @brief 在窗口线程上执行指定委托，并立即返回
          * @param action 要执行的委托
-         * @return 若成功将委托放入窗口线程的消息队列则返回true，否则返回false
+         * @return 若成功将委托放入窗口线程的调度器或消息队列则返回true，否则返回false
+         * @note 窗口线程有调度器时以Render优先级放入调度器，否则投递WM_InvokeAction消息
          */
         bool InvokeAsync(const Action<> &action);
 
+        /**
+         * @brief 以指定优先级在窗口线程上执行指定委托，并立即返回
+         * @param action 要执行的委托
+         * @param priority 优先级，窗口线程没有调度器时忽略
+         * @param key 合并委托的键值，不为0时同一优先级中相同键值的委托在执行前只执行最后一个，窗口线程没有调度器时忽略
+         * @return 若成功将委托放入窗口线程的调度器并唤醒该线程，或成功投递到消息队列则返回true，否则返回false，
+         *         含义与Dispatcher::BeginInvoke的返回值相同
+         * @note 委托执行前窗口已被销毁或句柄已被重置时不会执行
+         */
+        bool InvokeAsync(const Action<> &action, DispatcherPriority priority, uint64_t key = 0);
+
         /**
          * @brief 获取当前窗口所属线程的线程id
          */
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <windows.h>
+#include <cstddef>
+#include <vector>
+
+namespace sw
+{
+    class WndBase; // WndBase.h
+
+    /**
+     * @brief 窗口句柄到WndBase对象的映射表，使用开放寻址（线性探测）实现，框架内部使用
+     * @note WndBase为每个线程维护一个表，只记录当前线程创建的窗口，表中没有的句柄回退到窗口属性查找；
+     *       该表只能由WndBase访问，不通过SimpleWindow.h导出
+     * @note 表只保存指针，不检查指针的有效性，窗口销毁时应及时移除对应项
+     */
+    class WndBaseTable
+    {
+        friend class WndBase;
+
+    public:
+        /**
+         * @brief 初始容量
+         */
+        static constexpr size_t InitialCapacity = 16;
+
+    private:
+        /**
+         * @brief 表项，句柄为NULL表示空位
+         */
+        struct _Slot {
+            HWND hwnd    = NULL;
+            WndBase *wnd = nullptr;
+        };
+
+        /**
+         * @brief 表项数组，长度为0或2的幂
+         */
+        std::vector<_Slot> _slots;
+
+        /**
+         * @brief 已使用的表项数量
+         */
+        size_t _count = 0;
+
+    public:
+        /**
+         * @brief 查找窗口句柄对应的对象
+         * @return 对象指针，若表中没有该句柄则返回nullptr
+         */
+        WndBase *Find(HWND hwnd) const noexcept;
+
+        /**
+         * @brief 记录窗口句柄对应的对象，若已存在则替换
+         * @note hwnd为NULL时不做任何操作
+         */
+        void Set(HWND hwnd, WndBase *wnd);
+
+        /**
+         * @brief 移除窗口句柄对应的项
+         */
+        void Remove(HWND hwnd) noexcept;
+
+        /**
+         * @brief 获取表中记录的窗口数量
+         */
+        size_t GetCount() const noexcept;
+
+    private:
+        /**
+         * @brief 获取WndBase使用的当前线程的表
+         */
+        static WndBaseTable &_GetCurrent() noexcept;
+
+        /**
+         * @brief 计算句柄的哈希值
+         */
+        static size_t _Hash(HWND hwnd) noexcept;
+
+        /**
+         * @brief 查找句柄所在的位置，若不存在则返回探测到的第一个空位
+         * @note 调用前需保证_slots不为空
+         */
+        size_t _Probe(HWND hwnd) const noexcept;
+
+        /**
+         * @brief 以指定容量重建表
+         */
+        void _Rehash(size_t capacity);
+    };
+}
@@ -1,5 +1,10 @@
 #include "App.h"
+#include "Binding.h"
+#include "Dispatcher.h"
 #include "Path.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
 
 namespace
 {
@@ -13,6 +18,16 @@ namespace
      */
     thread_local sw::Action<MSG &> _nullHwndMsgHandler;
 
+    /**
+     * @brief 当前线程消息循环每次执行空闲任务的时间预算，单位为毫秒
+     */
+    thread_local int _idleBudget = 8;
+
+    /**
+     * @brief 当前线程消息循环的空闲任务
+     */
+    thread_local sw::IdleScheduler _idleScheduler;
+
     /**
      * @brief 获取当前exe文件路径
      */
@@ -110,21 +125,95 @@ const sw::Property<sw::AppQuitMode> sw::App::QuitMode(
         }) //
 );
 
+const sw::Property<int> sw::App::IdleBudget(
+    Property<int>::Init()
+        .Getter([]() -> int {
+            return _idleBudget;
+        })
+        .Setter([](int value) {
+            _idleBudget = (std::max)(value, 0);
+        }) //
+);
+
 int sw::App::MsgLoop()
 {
+    // 创建当前线程的调度器，此后其他线程的InvokeAsync通过调度器批量执行
+    std::shared_ptr<Dispatcher> dispatcher = Dispatcher::GetCurrent();
+
+    // 有绑定等待延迟更新时通过调度器唤醒，空闲任务以及DefWindowProc等模态消息循环中产生的更新也能及时应用
+    Binding::SetDeferredUpdateRequestHandler([dispatcher]() {
+        dispatcher->BeginInvoke([]() { Binding::FlushDeferredUpdates(); });
+    });
+
     MSG msg;
-    while (GetMessageW(&msg, NULL, 0, 0) > 0) {
-        if (msg.hwnd == NULL) {
-            if (_nullHwndMsgHandler)
-                _nullHwndMsgHandler(msg);
+    bool hasIdleWork  = true;
+    bool resetPending = false;
+
+    while (true) {
+        if (PeekMessageW(&msg, NULL, 0, 0, PM_REMOVE)) {
+            if (msg.message == WM_QUIT) {
+                break;
+            }
+            if (msg.hwnd == NULL) {
+                if (_nullHwndMsgHandler)
+                    _nullHwndMsgHandler(msg);
+            } else {
+                TranslateMessage(&msg);
+                DispatchMessageW(&msg);
+            }
+            // 每处理一条消息更新一次延迟绑定，期间源属性的多次更改只应用最新值
+            Binding::FlushDeferredUpdates();
+
+            // 处理消息可能产生新的工作，下次空闲时重新调用所有任务
+            hasIdleWork  = true;
+            resetPending = true;
+            continue;
+        }
+
+        if (hasIdleWork && !_idleScheduler.IsEmpty()) {
+            if (resetPending) {
+                _idleScheduler.Reset();
+                resetPending = false;
+            }
+            // 消息队列为空，在预算内执行空闲任务，有输入时立即让出
+            hasIdleWork = _idleScheduler.Run(
+                std::chrono::milliseconds(_idleBudget),
+                []() { return HIWORD(GetQueueStatus(QS_INPUT)) != 0; });
         } else {
-            TranslateMessage(&msg);
-            DispatchMessageW(&msg);
+            hasIdleWork = false;
+        }
+
+        // 等待新消息前应用空闲任务产生的延迟更新，剩余的更新（在外层刷新中嵌套运行时）由外层刷新应用，不会空转
+        Binding::FlushDeferredUpdates();
+
+        if (!hasIdleWork) {
+            // 没有空闲工作时等待新消息，MWMO_INPUTAVAILABLE使已经在队列中但被查看过的输入也能唤醒
+            MsgWaitForMultipleObjectsEx(0, NULL, INFINITE, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
         }
     }
     return (int)msg.wParam;
 }
 
+int sw::App::AddIdleTask(const std::wstring &name, const Func<bool> &task)
+{
+    return _idleScheduler.Add(name, task);
+}
+
+bool sw::App::RemoveIdleTask(int id)
+{
+    return _idleScheduler.Remove(id);
+}
+
+std::vector<sw::IdleTaskStatistics> sw::App::GetIdleTaskStatistics()
+{
+    return _idleScheduler.GetStatistics();
+}
+
+void sw::App::ResetIdleTaskStatistics()
+{
+    _idleScheduler.ResetStatistics();
+}
+
 void sw::App::QuitMsgLoop(int exitCode)
 {
     PostQuitMessage(exitCode);
@@ -1,4 +1,5 @@
 #include "BmpBox.h"
+#include "BrushCache.h"
 #include <cmath>
 
 sw::BmpBox::BmpBox()
@@ -89,7 +90,7 @@ bool sw::BmpBox::OnPaint()
     HBITMAP hBitmap    = CreateCompatibleBitmap(hdc, width, height);
     HBITMAP hBitmapOld = (HBITMAP)SelectObject(hdcMem, hBitmap);
 
-    HBRUSH hBackColorBrush = CreateSolidBrush(static_cast<COLORREF>(this->GetRealBackColor()));
+    HBRUSH hBackColorBrush = BrushCache::GetBrush(static_cast<COLORREF>(this->GetRealBackColor()));
     FillRect(hdcMem, &clientRect, hBackColorBrush);
 
     if (this->_hBitmap != NULL &&
@@ -146,7 +147,6 @@ bool sw::BmpBox::OnPaint()
 
     SelectObject(hdcMem, hBitmapOld);
     DeleteObject(hBitmap);
-    DeleteObject(hBackColorBrush);
     DeleteDC(hdcMem);
 
     EndPaint(hwnd, &ps);
@@ -0,0 +1,135 @@
+#include "BrushCache.h"
+
+constexpr int sw::BrushCache::DefaultCapacity;
+
+sw::BrushCache::~BrushCache()
+{
+    for (auto &item : this->_brushes) {
+        DeleteObject(item.hBrush);
+    }
+    _IsDestroyed() = true;
+}
+
+HBRUSH sw::BrushCache::GetBrush(COLORREF color)
+{
+    BrushCache &cache = _GetInstance();
+
+    auto it = cache._Get(color);
+    return it == cache._brushes.end() ? NULL : it->hBrush;
+}
+
+HBRUSH sw::BrushCache::Acquire(COLORREF color)
+{
+    BrushCache &cache = _GetInstance();
+
+    auto it = cache._Get(color);
+    if (it == cache._brushes.end()) {
+        return NULL;
+    }
+
+    if (it->refCount++ == 0) {
+        ++cache._statistics.acquiredCount;
+    }
+    return it->hBrush;
+}
+
+void sw::BrushCache::Release(HBRUSH hBrush)
+{
+    if (hBrush == NULL || _IsDestroyed()) {
+        return;
+    }
+
+    BrushCache &cache = _GetInstance();
+
+    auto it = cache._handles.find(hBrush);
+    if (it == cache._handles.end() || it->second->refCount <= 0) {
+        return;
+    }
+
+    if (--it->second->refCount == 0) {
+        --cache._statistics.acquiredCount;
+        cache._Trim(cache._capacity);
+    }
+}
+
+int sw::BrushCache::GetCapacity()
+{
+    return _GetInstance()._capacity;
+}
+
+void sw::BrushCache::SetCapacity(int capacity)
+{
+    BrushCache &cache = _GetInstance();
+
+    cache._capacity = capacity < 1 ? 1 : capacity;
+    cache._Trim(cache._capacity);
+}
+
+void sw::BrushCache::Clear()
+{
+    _GetInstance()._Trim(0);
+}
+
+sw::BrushCacheStatistics sw::BrushCache::GetStatistics()
+{
+    return _GetInstance()._statistics;
+}
+
+sw::BrushCache &sw::BrushCache::_GetInstance()
+{
+    static thread_local BrushCache cache;
+    return cache;
+}
+
+bool &sw::BrushCache::_IsDestroyed()
+{
+    static thread_local bool destroyed = false;
+    return destroyed;
+}
+
+std::list<sw::BrushCache::_BrushInfo>::iterator sw::BrushCache::_Get(COLORREF color)
+{
+    auto it = this->_index.find(color);
+
+    if (it != this->_index.end()) {
+        // 移至表头，标记为最近使用
+        this->_brushes.splice(this->_brushes.begin(), this->_brushes, it->second);
+        ++this->_statistics.reusedCount;
+        return it->second;
+    }
+
+    HBRUSH hBrush = CreateSolidBrush(color);
+    if (hBrush == NULL) {
+        return this->_brushes.end();
+    }
+
+    // 先腾出位置再插入，保证新画刷不会被立即销毁
+    this->_Trim(this->_capacity - 1);
+    this->_brushes.push_front(_BrushInfo{color, hBrush, 0});
+    this->_index.emplace(color, this->_brushes.begin());
+    this->_handles.emplace(hBrush, this->_brushes.begin());
+
+    ++this->_statistics.createdCount;
+    this->_statistics.brushCount = static_cast<int>(this->_brushes.size());
+    return this->_brushes.begin();
+}
+
+void sw::BrushCache::_Trim(int maxCount)
+{
+    // 被引用的画刷不计入数量，也不会被销毁
+    int count = static_cast<int>(this->_brushes.size()) - this->_statistics.acquiredCount;
+
+    for (auto it = this->_brushes.end(); count > maxCount && it != this->_brushes.begin();) {
+        --it;
+        if (it->refCount > 0) {
+            continue;
+        }
+        DeleteObject(it->hBrush);
+        this->_index.erase(it->color);
+        this->_handles.erase(it->hBrush);
+        it = this->_brushes.erase(it);
+        ++this->_statistics.evictedCount;
+        --count;
+    }
+    this->_statistics.brushCount = static_cast<int>(this->_brushes.size());
+}
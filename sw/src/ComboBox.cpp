@@ -21,6 +21,34 @@ sw::ComboBox::ComboBox()
                       self->OnSelectionChanged();
                       self->RaisePropertyChanged(&ComboBox::IsEditable);
                   }
+              })),
+
+      VirtualMode(
+          Property<bool>::Init(this)
+              .Getter([](ComboBox *self) -> bool {
+                  return (self->GetStyle() & (CBS_OWNERDRAWFIXED | CBS_HASSTRINGS)) == CBS_OWNERDRAWFIXED;
+              })
+              .Setter([](ComboBox *self, bool value) {
+                  if (self->VirtualMode != value) {
+                      auto baseStyle = self->GetStyle() & ~(CBS_OWNERDRAWFIXED | CBS_HASSTRINGS);
+                      self->SetStyle(baseStyle | (value ? CBS_OWNERDRAWFIXED : CBS_HASSTRINGS));
+                      self->ResetHandle();
+                      self->Refresh();
+                      self->OnSelectionChanged();
+                      self->RaisePropertyChanged(&ComboBox::VirtualMode);
+                  }
+              })),
+
+      SearchIndex(
+          Property<IItemSearchIndex *>::Init(this)
+              .Getter([](ComboBox *self) -> IItemSearchIndex * {
+                  return self->_searchIndex;
+              })
+              .Setter([](ComboBox *self, IItemSearchIndex *value) {
+                  if (self->_searchIndex != value) {
+                      self->_searchIndex = value;
+                      self->RaisePropertyChanged(&ComboBox::SearchIndex);
+                  }
               }))
 {
     InitControl(
@@ -54,6 +82,27 @@ void sw::ComboBox::CloseDropDown()
     SendMessageW(CB_SHOWDROPDOWN, FALSE, 0);
 }
 
+int sw::ComboBox::FindString(const std::wstring &prefix, int startIndex)
+{
+    if (!VirtualMode) {
+        return (int)SendMessageW(CB_FINDSTRING, startIndex, reinterpret_cast<LPARAM>(prefix.c_str()));
+    }
+
+    if (_searchIndex != nullptr) {
+        return _searchIndex->FindPrefix(prefix, startIndex);
+    }
+
+    IList *items = GetCurrentItemsSource();
+    int count    = items ? items->Count() : 0;
+    int length   = static_cast<int>(prefix.size());
+
+    return IncrementalItemSearch::FindNext(count, startIndex, [&](int index) -> bool {
+        std::wstring text = GetDisplayText(index, items->GetVariantAt(index));
+        return static_cast<int>(text.size()) >= length &&
+               CompareStringOrdinal(text.c_str(), length, prefix.c_str(), length, TRUE) == CSTR_EQUAL;
+    });
+}
+
 sw::IList *sw::ComboBox::GetDefaultItemsSource()
 {
     return &_items;
@@ -74,19 +123,31 @@ void sw::ComboBox::OnCurrentItemsSourceCollectionChanged(const NotifyCollectionC
     switch (args.action) {
         case NotifyCollectionChangedAction::Add:
             if (index >= args.index) {
-                index++;
+                index += args.count;
+            }
+            if (VirtualMode) {
+                _SetCount(args.list->Count());
+            } else {
+                for (int i = args.index; i < args.index + args.count; ++i) {
+                    _InsertString(i, GetDisplayText(i, args.list->GetVariantAt(i)));
+                }
             }
-            _InsertString(args.index, GetDisplayText(args.index, args.list->GetVariantAt(args.index)));
             itemsCountChanged = true;
             break;
 
         case NotifyCollectionChangedAction::Remove:
-            if (index == args.index) {
+            if (index >= args.index && index < args.index + args.count) {
                 index = -1;
-            } else if (index > args.index) {
-                index--;
+            } else if (index >= args.index + args.count) {
+                index -= args.count;
+            }
+            if (VirtualMode) {
+                _SetCount(args.list->Count());
+            } else {
+                for (int i = 0; i < args.count; ++i) {
+                    _DeleteString(args.index);
+                }
             }
-            _DeleteString(args.index);
             itemsCountChanged = true;
             break;
 
@@ -96,8 +157,16 @@ void sw::ComboBox::OnCurrentItemsSourceCollectionChanged(const NotifyCollectionC
             break;
 
         case NotifyCollectionChangedAction::Replace:
-            _DeleteString(args.index);
-            _InsertString(args.index, GetDisplayText(args.index, args.list->GetVariantAt(args.index)));
+            if (VirtualMode) {
+                if (index >= args.index && index < args.index + args.count) {
+                    _UpdateSelectedText();
+                }
+            } else {
+                for (int i = args.index; i < args.index + args.count; ++i) {
+                    _DeleteString(i);
+                    _InsertString(i, GetDisplayText(i, args.list->GetVariantAt(i)));
+                }
+            }
             break;
 
         case NotifyCollectionChangedAction::Move:
@@ -108,8 +177,10 @@ void sw::ComboBox::OnCurrentItemsSourceCollectionChanged(const NotifyCollectionC
             } else if (index < args.oldIndex && index >= args.index) {
                 index++;
             }
-            _DeleteString(args.oldIndex);
-            _InsertString(args.index, GetDisplayText(args.index, args.list->GetVariantAt(args.index)));
+            if (!VirtualMode) {
+                _DeleteString(args.oldIndex);
+                _InsertString(args.index, GetDisplayText(args.index, args.list->GetVariantAt(args.index)));
+            }
             break;
     }
 
@@ -164,6 +235,75 @@ void sw::ComboBox::OnSelectionChanged()
     TBase::OnSelectionChanged();
 }
 
+void sw::ComboBox::FontChanged(HFONT hfont)
+{
+    if (VirtualMode) {
+        _UpdateItemHeight();
+    }
+    TBase::FontChanged(hfont);
+}
+
+void sw::ComboBox::OnHandleChanged(HWND hwnd)
+{
+    if (VirtualMode) {
+        _UpdateItemHeight();
+    }
+    TBase::OnHandleChanged(hwnd);
+}
+
+bool sw::ComboBox::OnChar(wchar_t ch, const KeyFlags &flags)
+{
+    if (TBase::OnChar(ch, flags)) {
+        return true;
+    }
+
+    // 虚拟模式下控件中的项没有文本，由控件自身查找会匹配不到任何项
+    if (VirtualMode && ch >= L' ') {
+        _IncrementalSearch(ch);
+        return true;
+    }
+    return false;
+}
+
+bool sw::ComboBox::OnDrawItemSelf(DRAWITEMSTRUCT *pDrawItem)
+{
+    if (!VirtualMode) {
+        return TBase::OnDrawItemSelf(pDrawItem);
+    }
+
+    IList *items = GetCurrentItemsSource();
+
+    int index = static_cast<int>(pDrawItem->itemID);
+    int count = items ? items->Count() : 0;
+
+    HDC hdc   = pDrawItem->hDC;
+    RECT rect = pDrawItem->rcItem;
+
+    std::wstring text;
+    if (index >= 0 && index < count) {
+        text = GetDisplayText(index, items->GetVariantAt(index));
+    }
+
+    if (pDrawItem->itemState & ODS_SELECTED) {
+        ::SetBkColor(hdc, GetSysColor(COLOR_HIGHLIGHT));
+        ::SetTextColor(hdc, GetSysColor(COLOR_HIGHLIGHTTEXT));
+    } else {
+        ::SetBkColor(hdc, static_cast<COLORREF>(GetRealBackColor()));
+        ::SetTextColor(hdc, pDrawItem->itemState & ODS_DISABLED ? GetSysColor(COLOR_GRAYTEXT) : static_cast<COLORREF>(GetRealTextColor()));
+    }
+
+    ::ExtTextOutW(hdc, rect.left, rect.top, ETO_OPAQUE, &rect, nullptr, 0, nullptr);
+
+    RECT textRect = rect;
+    textRect.left += GetSystemMetrics(SM_CXBORDER) * 2;
+    ::DrawTextW(hdc, text.c_str(), -1, &textRect, DT_LEFT | DT_VCENTER | DT_SINGLELINE | DT_NOPREFIX);
+
+    if (pDrawItem->itemState & ODS_FOCUS) {
+        ::DrawFocusRect(hdc, &rect);
+    }
+    return true;
+}
+
 std::wstring sw::ComboBox::GetDisplayText(int index, const Variant &item)
 {
     std::wstring text;
@@ -188,6 +328,12 @@ void sw::ComboBox::_UpdateSelectedText()
 
 void sw::ComboBox::_UpdateItems()
 {
+    if (VirtualMode) {
+        IList *items = GetCurrentItemsSource();
+        _SetCount(items ? items->Count() : 0);
+        return;
+    }
+
     SendMessageW(CB_RESETCONTENT, 0, 0);
 
     if (IList *items = GetCurrentItemsSource()) {
@@ -212,3 +358,68 @@ void sw::ComboBox::_DeleteString(int index)
 {
     SendMessageW(CB_DELETESTRING, index, 0);
 }
+
+void sw::ComboBox::_SetCount(int count)
+{
+    int current = (int)SendMessageW(CB_GETCOUNT, 0, 0);
+
+    if (count == current) {
+        return;
+    }
+
+    // 删除的项多于保留的项时清空后重新添加
+    if (count < current - count) {
+        SendMessageW(CB_RESETCONTENT, 0, 0);
+        current = 0;
+    }
+
+    if (count > current) {
+        // 虚拟模式下控件不保存文本，添加的项只是占位，绘制时从数据源读取
+        SendMessageW(CB_INITSTORAGE, count - current, 0);
+        for (; current < count; ++current) {
+            SendMessageW(CB_ADDSTRING, 0, 0);
+        }
+    } else {
+        for (; current > count; --current) {
+            SendMessageW(CB_DELETESTRING, current - 1, 0);
+        }
+    }
+}
+
+void sw::ComboBox::_UpdateItemHeight()
+{
+    HWND hwnd   = Handle;
+    HDC hdc     = GetDC(hwnd);
+    HFONT hFont = (HFONT)SendMessageW(WM_GETFONT, 0, 0);
+
+    if (hFont == NULL) {
+        hFont = (HFONT)GetStockObject(DEFAULT_GUI_FONT);
+    }
+
+    HFONT hFontOld = (HFONT)SelectObject(hdc, hFont);
+
+    TEXTMETRIC tm{};
+    GetTextMetrics(hdc, &tm);
+
+    int cyItem = tm.tmHeight + tm.tmExternalLeading;
+    cyItem += GetSystemMetrics(SM_CYBORDER) * 2;
+
+    SelectObject(hdc, hFontOld);
+    ReleaseDC(hwnd, hdc);
+
+    SendMessageW(CB_SETITEMHEIGHT, (WPARAM)-1, cyItem);
+    SendMessageW(CB_SETITEMHEIGHT, 0, cyItem);
+}
+
+void sw::ComboBox::_IncrementalSearch(wchar_t ch)
+{
+    int found = _incrementalSearch.Input(
+        ch, GetTickCount(), GetSelectedIndex(),
+        [this](const std::wstring &prefix, int startIndex) -> int {
+            return FindString(prefix, startIndex);
+        });
+
+    if (found >= 0) {
+        SetSelectedIndex(found);
+    }
+}
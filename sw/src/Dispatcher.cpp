@@ -0,0 +1,216 @@
+#include "Dispatcher.h"
+#include "App.h"
+#include "WndMsg.h"
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+    /**
+     * @brief 消息窗口的窗口类名
+     */
+    constexpr wchar_t _DispatcherClassName[] = L"sw::Dispatcher";
+
+    /**
+     * @brief 各线程的调度器
+     */
+    struct _DispatcherRegistry {
+        std::mutex mutex;
+        std::unordered_map<DWORD, std::weak_ptr<sw::Dispatcher>> dispatchers;
+    };
+
+    /**
+     * @brief 获取调度器表
+     */
+    _DispatcherRegistry &_GetRegistry()
+    {
+        static _DispatcherRegistry registry;
+        return registry;
+    }
+
+    /**
+     * @brief 当前线程上次通过FromThread获取的调度器，避免每次添加任务都访问调度器表
+     */
+    thread_local DWORD _cachedThreadId = 0;
+    thread_local std::weak_ptr<sw::Dispatcher> _cachedDispatcher;
+}
+
+constexpr UINT_PTR sw::Dispatcher::_ContinueTimerId;
+constexpr int sw::Dispatcher::_DrainBudgetMs;
+
+sw::Dispatcher::Dispatcher()
+    : _threadId(GetCurrentThreadId()), _hwnd(NULL)
+{
+    static ATOM wndClsAtom = []() -> ATOM {
+        WNDCLASSEXW wc{};
+        wc.cbSize        = sizeof(wc);
+        wc.hInstance     = App::Instance;
+        wc.lpfnWndProc   = Dispatcher::_WndProc;
+        wc.lpszClassName = _DispatcherClassName;
+        return RegisterClassExW(&wc);
+    }();
+
+    (void)wndClsAtom; // 消除未使用变量警告
+
+    this->_hwnd = CreateWindowExW(
+        0, _DispatcherClassName, L"", 0, 0, 0, 0, 0, HWND_MESSAGE, NULL, App::Instance, NULL);
+
+    if (this->_hwnd == NULL) {
+        // 没有消息窗口时无法唤醒，BeginInvoke总是失败，调用者回退到其他方式
+        this->_isShutdown.store(true);
+    } else {
+        SetWindowLongPtrW(this->_hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(this));
+    }
+}
+
+sw::Dispatcher::~Dispatcher()
+{
+}
+
+std::shared_ptr<sw::Dispatcher> sw::Dispatcher::GetCurrent()
+{
+    static thread_local class _ThreadHolder
+    {
+    public:
+        // 当前线程的调度器
+        std::shared_ptr<Dispatcher> dispatcher;
+
+        // 线程退出时会调用析构函数
+        ~_ThreadHolder()
+        {
+            if (this->dispatcher != nullptr) {
+                _DispatcherRegistry &registry = _GetRegistry();
+                {
+                    std::lock_guard<std::mutex> lock(registry.mutex);
+                    registry.dispatchers.erase(this->dispatcher->_threadId);
+                }
+                this->dispatcher->_Shutdown();
+            }
+        }
+    } holder;
+
+    if (holder.dispatcher == nullptr) {
+        holder.dispatcher.reset(new Dispatcher);
+
+        _DispatcherRegistry &registry = _GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.dispatchers[holder.dispatcher->_threadId] = holder.dispatcher;
+    }
+    return holder.dispatcher;
+}
+
+std::shared_ptr<sw::Dispatcher> sw::Dispatcher::FromThread(DWORD threadId)
+{
+    if (threadId == _cachedThreadId) {
+        std::shared_ptr<Dispatcher> result = _cachedDispatcher.lock();
+        if (result != nullptr) {
+            return result;
+        }
+    }
+
+    std::shared_ptr<Dispatcher> result;
+    {
+        _DispatcherRegistry &registry = _GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        auto it = registry.dispatchers.find(threadId);
+        if (it != registry.dispatchers.end()) {
+            result = it->second.lock();
+        }
+    }
+
+    if (result != nullptr) {
+        _cachedThreadId   = threadId;
+        _cachedDispatcher = result;
+    }
+    return result;
+}
+
+DWORD sw::Dispatcher::GetThreadId() const noexcept
+{
+    return this->_threadId;
+}
+
+bool sw::Dispatcher::CheckAccess() const noexcept
+{
+    return this->_threadId == GetCurrentThreadId();
+}
+
+bool sw::Dispatcher::BeginInvoke(const Action<> &action, DispatcherPriority priority, uint64_t key)
+{
+    if (action == nullptr || this->_isShutdown.load()) {
+        return false;
+    }
+
+    if (!this->_queue.Enqueue(action, priority, key) ||
+        PostMessageW(this->_hwnd, WM_DispatcherWake, 0, 0)) {
+        return true;
+    }
+
+    // 在所属线程中添加时改用计时器唤醒，计时器消息不占用消息队列
+    if (this->CheckAccess() && !this->_isShutdown.load()) {
+        if (this->_isTimerSet || SetTimer(this->_hwnd, _ContinueTimerId, USER_TIMER_MINIMUM, NULL) != 0) {
+            this->_isTimerSet = true;
+            return true;
+        }
+    }
+
+    // 消息队列已满时投递失败，撤销唤醒请求以便下次添加任务时重试，已添加的任务随下次成功的唤醒执行
+    this->_queue.CancelWakeRequest();
+    return false;
+}
+
+sw::DispatcherQueueMetrics sw::Dispatcher::GetMetrics() const
+{
+    return this->_queue.GetMetrics();
+}
+
+void sw::Dispatcher::ResetMetrics()
+{
+    this->_queue.ResetMetrics();
+}
+
+void sw::Dispatcher::_OnWake()
+{
+    if (this->_isTimerSet) {
+        KillTimer(this->_hwnd, _ContinueTimerId);
+        this->_isTimerSet = false;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_DrainBudgetMs);
+
+    bool hasRemaining = this->_queue.Drain([deadline]() -> bool {
+        return HIWORD(GetQueueStatus(QS_INPUT)) != 0 ||
+               std::chrono::steady_clock::now() >= deadline;
+    });
+
+    if (hasRemaining && !this->_isShutdown.load()) {
+        // 计时器消息在输入消息之后才会被取出，剩余任务不会阻塞输入的处理
+        this->_isTimerSet = SetTimer(this->_hwnd, _ContinueTimerId, USER_TIMER_MINIMUM, NULL) != 0;
+
+        if (!this->_isTimerSet) {
+            PostMessageW(this->_hwnd, WM_DispatcherWake, 0, 0);
+        }
+    }
+}
+
+void sw::Dispatcher::_Shutdown()
+{
+    this->_isShutdown.store(true);
+
+    if (this->_hwnd != NULL) {
+        SetWindowLongPtrW(this->_hwnd, GWLP_USERDATA, 0);
+        DestroyWindow(this->_hwnd);
+    }
+}
+
+LRESULT CALLBACK sw::Dispatcher::_WndProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+{
+    if (uMsg == WM_DispatcherWake || (uMsg == WM_TIMER && wParam == _ContinueTimerId)) {
+        auto pDispatcher = reinterpret_cast<Dispatcher *>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
+        if (pDispatcher) pDispatcher->_OnWake();
+        return 0;
+    }
+    return DefWindowProcW(hwnd, uMsg, wParam, lParam);
+}
@@ -0,0 +1,187 @@
+#include "DispatcherQueue.h"
+#include <algorithm>
+#include <memory>
+
+constexpr int sw::DispatcherQueue::_PriorityCount;
+
+sw::DispatcherQueue::~DispatcherQueue()
+{
+    for (_Level &level : this->_levels) {
+        this->_Take(level);
+        for (_Node *node : level.taken) {
+            delete node;
+        }
+        level.taken.clear();
+        level.pendingKeys.clear();
+    }
+}
+
+bool sw::DispatcherQueue::Enqueue(const Action<> &action, DispatcherPriority priority, uint64_t key)
+{
+    _Node *node       = new _Node;
+    node->action      = action;
+    node->key         = key;
+    node->enqueueTime = this->_Now();
+
+    size_t depth = this->_depth.fetch_add(1, std::memory_order_relaxed) + 1;
+    size_t max   = this->_maxDepth.load(std::memory_order_relaxed);
+    while (depth > max && !this->_maxDepth.compare_exchange_weak(max, depth, std::memory_order_relaxed)) {
+    }
+    this->_enqueuedCount.fetch_add(1, std::memory_order_relaxed);
+
+    _Push(this->_levels[static_cast<int>(priority)], node);
+
+    // 添加完成后再检查唤醒请求，消费者在Drain开始时清除请求，因此Drain取不到的任务总会有新的唤醒请求
+    return !this->_wakeRequested.exchange(true, std::memory_order_acq_rel);
+}
+
+void sw::DispatcherQueue::CancelWakeRequest() noexcept
+{
+    this->_wakeRequested.store(false, std::memory_order_seq_cst);
+}
+
+bool sw::DispatcherQueue::Drain(const Func<bool> &shouldYield)
+{
+    this->_wakeRequested.store(false, std::memory_order_seq_cst);
+    ++this->_batchCount;
+
+    const Func<bool> *yield = shouldYield ? &shouldYield : nullptr;
+
+    for (int i = 0; i < _PriorityCount; ++i) {
+        _Level &level = this->_levels[i];
+        this->_Take(level);
+
+        // Input优先级的任务总是全部执行
+        if (this->_Run(level, i == static_cast<int>(DispatcherPriority::Input) ? nullptr : yield)) {
+            break;
+        }
+    }
+
+    for (_Level &level : this->_levels) {
+        if (!level.taken.empty() || level.tail != &level.stub || level.head.load(std::memory_order_acquire) != &level.stub) {
+            return true;
+        }
+    }
+    return false;
+}
+
+sw::DispatcherQueueMetrics sw::DispatcherQueue::GetMetrics() const
+{
+    DispatcherQueueMetrics metrics;
+    metrics.depth          = this->_depth.load(std::memory_order_relaxed);
+    metrics.maxDepth       = this->_maxDepth.load(std::memory_order_relaxed);
+    metrics.enqueuedCount  = this->_enqueuedCount.load(std::memory_order_relaxed);
+    metrics.executedCount  = this->_executedCount;
+    metrics.coalescedCount = this->_coalescedCount;
+    metrics.batchCount     = this->_batchCount;
+    metrics.totalLatency   = this->_totalLatency;
+    metrics.maxLatency     = this->_maxLatency;
+    return metrics;
+}
+
+void sw::DispatcherQueue::ResetMetrics()
+{
+    this->_maxDepth.store(this->_depth.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    this->_enqueuedCount.store(0, std::memory_order_relaxed);
+    this->_executedCount  = 0;
+    this->_coalescedCount = 0;
+    this->_batchCount     = 0;
+    this->_totalLatency   = 0;
+    this->_maxLatency     = 0;
+}
+
+uint64_t sw::DispatcherQueue::_Now() const noexcept
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->_epoch).count());
+}
+
+void sw::DispatcherQueue::_Push(_Level &level, _Node *node) noexcept
+{
+    node->next.store(nullptr, std::memory_order_relaxed);
+    _Node *prev = level.head.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+}
+
+sw::DispatcherQueue::_Node *sw::DispatcherQueue::_Pop(_Level &level) noexcept
+{
+    _Node *tail = level.tail;
+    _Node *next = tail->next.load(std::memory_order_acquire);
+
+    if (tail == &level.stub) {
+        if (next == nullptr) {
+            return nullptr;
+        }
+        level.tail = next;
+        tail       = next;
+        next       = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next != nullptr) {
+        level.tail = next;
+        return tail;
+    }
+
+    // tail不是最后入队的节点时，有生产者已交换head但尚未链接next，留到下次取出
+    if (tail != level.head.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+
+    // tail是最后一个节点，重新放入哨兵节点后才能将其取出
+    _Push(level, &level.stub);
+    next = tail->next.load(std::memory_order_acquire);
+
+    if (next != nullptr) {
+        level.tail = next;
+        return tail;
+    }
+    return nullptr;
+}
+
+void sw::DispatcherQueue::_Take(_Level &level)
+{
+    while (_Node *node = _Pop(level)) {
+        if (node->key != 0) {
+            auto result = level.pendingKeys.emplace(node->key, node);
+            if (!result.second) {
+                result.first->second->superseded = true;
+                result.first->second             = node;
+                ++this->_coalescedCount;
+            }
+        }
+        level.taken.push_back(node);
+    }
+}
+
+bool sw::DispatcherQueue::_Run(_Level &level, const Func<bool> *shouldYield)
+{
+    while (!level.taken.empty()) {
+        _Node *front = level.taken.front();
+
+        if (!front->superseded && shouldYield != nullptr && (*shouldYield)()) {
+            return true;
+        }
+
+        std::unique_ptr<_Node> node(front);
+        level.taken.pop_front();
+        this->_depth.fetch_sub(1, std::memory_order_relaxed);
+
+        if (node->superseded) {
+            continue;
+        }
+
+        if (node->key != 0) {
+            level.pendingKeys.erase(node->key);
+        }
+
+        uint64_t latency = this->_Now() - node->enqueueTime;
+        this->_totalLatency += latency;
+        this->_maxLatency = (std::max)(this->_maxLatency, latency);
+        ++this->_executedCount;
+
+        if (node->action) {
+            node->action();
+        }
+    }
+    return false;
+}
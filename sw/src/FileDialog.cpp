@@ -216,8 +216,10 @@ void sw::FileDialog::_FiltersCollectionChangedHandler(
     INotifyCollectionChanged &sender, NotifyCollectionChangedEventArgs &args)
 {
     if (args.action == NotifyCollectionChangedAction::Add &&
-        args.index == _filters.Count() - 1) {
-        _AppendFilterToBuffer(_filters.GetAt(args.index));
+        args.index + args.count == _filters.Count()) {
+        for (int i = args.index; i < _filters.Count(); ++i) {
+            _AppendFilterToBuffer(_filters.GetAt(i));
+        }
     } else {
         _ResetFilterBuffer();
     }
@@ -0,0 +1,121 @@
+#include "FontCache.h"
+#include <cwchar>
+#include <functional>
+
+size_t sw::FontCache::_LogFontHash::operator()(const LOGFONTW &logFont) const noexcept
+{
+    size_t result = 0;
+
+    auto combine = [&result](size_t value) {
+        result ^= value + 0x9e3779b9 + (result << 6) + (result >> 2);
+    };
+
+    combine(std::hash<LONG>{}(logFont.lfHeight));
+    combine(std::hash<LONG>{}(logFont.lfWidth));
+    combine(std::hash<LONG>{}(logFont.lfEscapement));
+    combine(std::hash<LONG>{}(logFont.lfOrientation));
+    combine(std::hash<LONG>{}(logFont.lfWeight));
+
+    combine((size_t)logFont.lfItalic |
+            (size_t)logFont.lfUnderline << 8 |
+            (size_t)logFont.lfStrikeOut << 16 |
+            (size_t)logFont.lfCharSet << 24);
+    combine((size_t)logFont.lfOutPrecision |
+            (size_t)logFont.lfClipPrecision << 8 |
+            (size_t)logFont.lfQuality << 16 |
+            (size_t)logFont.lfPitchAndFamily << 24);
+
+    for (int i = 0; i < LF_FACESIZE && logFont.lfFaceName[i] != L'\0'; ++i) {
+        combine(std::hash<wchar_t>{}(logFont.lfFaceName[i]));
+    }
+    return result;
+}
+
+bool sw::FontCache::_LogFontEqual::operator()(const LOGFONTW &a, const LOGFONTW &b) const noexcept
+{
+    // 字体名称之后的内容不参与比较
+    return a.lfHeight == b.lfHeight &&
+           a.lfWidth == b.lfWidth &&
+           a.lfEscapement == b.lfEscapement &&
+           a.lfOrientation == b.lfOrientation &&
+           a.lfWeight == b.lfWeight &&
+           a.lfItalic == b.lfItalic &&
+           a.lfUnderline == b.lfUnderline &&
+           a.lfStrikeOut == b.lfStrikeOut &&
+           a.lfCharSet == b.lfCharSet &&
+           a.lfOutPrecision == b.lfOutPrecision &&
+           a.lfClipPrecision == b.lfClipPrecision &&
+           a.lfQuality == b.lfQuality &&
+           a.lfPitchAndFamily == b.lfPitchAndFamily &&
+           std::wcsncmp(a.lfFaceName, b.lfFaceName, LF_FACESIZE) == 0;
+}
+
+HFONT sw::FontCache::Acquire(const LOGFONTW &logFont)
+{
+    FontCache &cache = _GetInstance();
+    std::lock_guard<std::mutex> lock(cache._mutex);
+
+    auto it = cache._handles.find(logFont);
+
+    if (it != cache._handles.end()) {
+        ++cache._handleInfos.find(it->second)->second.refCount;
+        ++cache._statistics.hitCount;
+        ++cache._statistics.referenceCount;
+        return it->second;
+    }
+
+    HFONT hfont = CreateFontIndirectW(&logFont);
+    ++cache._statistics.missCount;
+
+    if (hfont != NULL) {
+        cache._handles.emplace(logFont, hfont);
+        cache._handleInfos.emplace(hfont, _HandleInfo{logFont, 1});
+        ++cache._statistics.handleCount;
+        ++cache._statistics.referenceCount;
+    }
+    return hfont;
+}
+
+HFONT sw::FontCache::Acquire(const Font &font)
+{
+    LOGFONTW logFont = font;
+    return Acquire(logFont);
+}
+
+void sw::FontCache::Release(HFONT hfont)
+{
+    if (hfont == NULL) {
+        return;
+    }
+
+    FontCache &cache = _GetInstance();
+    std::lock_guard<std::mutex> lock(cache._mutex);
+
+    auto it = cache._handleInfos.find(hfont);
+    if (it == cache._handleInfos.end()) {
+        return;
+    }
+
+    --cache._statistics.referenceCount;
+
+    if (--it->second.refCount == 0) {
+        cache._handles.erase(it->second.logFont);
+        cache._handleInfos.erase(it);
+        --cache._statistics.handleCount;
+        DeleteObject(hfont);
+    }
+}
+
+sw::FontCacheStatistics sw::FontCache::GetStatistics()
+{
+    FontCache &cache = _GetInstance();
+    std::lock_guard<std::mutex> lock(cache._mutex);
+    return cache._statistics;
+}
+
+sw::FontCache &sw::FontCache::_GetInstance()
+{
+    // 不析构缓存对象，避免静态对象析构时释放字体句柄访问已销毁的缓存
+    static FontCache *instance = new FontCache;
+    return *instance;
+}
@@ -1,5 +1,6 @@
 #include "FrameworkElement.h"
 #include "DataBinding.h"
+#include "ScratchBuffer.h"
 
 sw::FrameworkElement::FrameworkElement()
     : DataContextChanged(
@@ -22,23 +23,25 @@ sw::FrameworkElement::FrameworkElement()
                   if (!self->_dataContext.ReferenceEquals(value)) {
                       auto oldDataContext = self->CurrentDataContext.Get();
                       self->_dataContext  = value;
+                      self->_InvalidateCurrentDataContextTree();
                       self->RaisePropertyChanged(&FrameworkElement::DataContext);
-                      if (oldDataContext != self->_dataContext.Object()) {
-                          self->OnCurrentDataContextChanged(oldDataContext);
-                      }
+                      // 小对象存放在Variant内部的缓冲区中，新旧对象的地址可能相同，不能通过指针判断是否改变
+                      self->OnCurrentDataContextChanged(oldDataContext);
                   }
               })),
 
       CurrentDataContext(
           Property<DynamicObject *>::Init(this)
               .Getter([](FrameworkElement *self) -> DynamicObject * {
-                  DynamicObject *result     = nullptr;
-                  FrameworkElement *element = self;
-                  do {
-                      result  = element->_dataContext.Object();
-                      element = element->GetParent();
-                  } while (result == nullptr && element != nullptr);
-                  return result;
+                  if (DynamicObject *result = self->_dataContext.Object()) {
+                      return result;
+                  }
+                  if (!self->_isCurrentDataContextValid) {
+                      FrameworkElement *parent         = self->GetParent();
+                      self->_currentDataContext        = parent ? parent->CurrentDataContext.Get() : nullptr;
+                      self->_isCurrentDataContextValid = true;
+                  }
+                  return self->_currentDataContext;
               }))
 {
 }
@@ -117,13 +120,13 @@ void sw::FrameworkElement::OnTagChanged()
 
 void sw::FrameworkElement::OnCurrentDataContextChanged(DynamicObject *oldDataContext)
 {
-    std::vector<FrameworkElement *> stack;
-    stack.push_back(this);
+    ScratchBuffer<FrameworkElement *> stack;
+    stack->push_back(this);
 
-    while (!stack.empty()) //
+    while (!stack->empty()) //
     {
-        auto current = stack.back();
-        stack.pop_back();
+        auto current = stack->back();
+        stack->pop_back();
 
         current->RaisePropertyChanged(
             &FrameworkElement::CurrentDataContext);
@@ -141,7 +144,42 @@ void sw::FrameworkElement::OnCurrentDataContextChanged(DynamicObject *oldDataCon
             auto &child = current->GetChildAt(i);
 
             if (child._dataContext.IsNull()) {
-                stack.push_back(&child);
+                stack->push_back(&child);
+            }
+        }
+    }
+}
+
+void sw::FrameworkElement::InvalidateCurrentDataContext()
+{
+    // 自身设置了DataContext时，父元素的变化不会影响当前元素及其子元素
+    if (this->_dataContext.IsNull()) {
+        this->_InvalidateCurrentDataContextTree();
+    }
+}
+
+void sw::FrameworkElement::_InvalidateCurrentDataContextTree()
+{
+    ScratchBuffer<FrameworkElement *> stack;
+    stack->push_back(this);
+
+    this->_isCurrentDataContextValid = false;
+
+    while (!stack->empty()) //
+    {
+        auto current = stack->back();
+        stack->pop_back();
+
+        int childCount = current->GetChildCount();
+
+        for (int i = 0; i < childCount; ++i) //
+        {
+            auto &child = current->GetChildAt(i);
+
+            // 缓存已失效的子元素，其后代的缓存也必然已失效
+            if (child._dataContext.IsNull() && child._isCurrentDataContextValid) {
+                child._isCurrentDataContextValid = false;
+                stack->push_back(&child);
             }
         }
     }
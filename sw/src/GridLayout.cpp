@@ -3,6 +3,41 @@
 #include <algorithm>
 #include <cmath>
 
+namespace
+{
+    /**
+     * @brief 判断两组行定义是否相同
+     */
+    bool IsSameDefinitions(const std::vector<sw::GridRow> &a, const std::vector<sw::GridRow> &b)
+    {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i].type != b[i].type || a[i].height != b[i].height) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 判断两组列定义是否相同
+     */
+    bool IsSameDefinitions(const std::vector<sw::GridColumn> &a, const std::vector<sw::GridColumn> &b)
+    {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i].type != b[i].type || a[i].width != b[i].width) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
 sw::GridLayoutTag::GridLayoutTag(
     uint16_t row, uint16_t column, uint16_t rowSpan, uint16_t columnSpan)
     : row(row), column(column), rowSpan(rowSpan), columnSpan(columnSpan)
@@ -112,23 +147,11 @@ sw::Size sw::GridLayout::MeasureOverride(const Size &availableSize)
 
     // Measure列
 
-    // 对childrenInfo进行排序
+    // 按照_UpdateInternalData中确定的顺序measure
     // 优先级 FixSize > AutoSize > FillRemain
     // 对于优先级相同的则按照columnSpan从小到大排序
-    std::sort(
-        this->_internalData.childrenInfo.begin(),
-        this->_internalData.childrenInfo.end(),
-        [](const _ChildInfo &a, const _ChildInfo &b) -> bool {
-            if (a.colMeasureType != b.colMeasureType) {
-                // 先FixSize，后AutoSize，最后FillRemain
-                return a.colMeasureType < b.colMeasureType;
-            } else {
-                // 若类型相同，则按照跨列数从小到大measure
-                return a.layoutTag.columnSpan < b.layoutTag.columnSpan;
-            }
-        });
-
-    for (_ChildInfo &childInfo : this->_internalData.childrenInfo) {
+    for (int childIndex : this->_internalData.colMeasureOrder) {
+        _ChildInfo &childInfo = this->_internalData.childrenInfo[childIndex];
         bool breakFlag = false; // 标记是否退出循环
 
         switch (childInfo.colMeasureType) {
@@ -259,28 +282,17 @@ sw::Size sw::GridLayout::MeasureOverride(const Size &availableSize)
 
     // Measure行
 
-    // 对childrenInfo进行排序
+    // 按照_UpdateInternalData中确定的顺序measure
     // 优先级 FixSize > AutoSize > FillRemain
     // 对于优先级相同的则按照rowSpan从小到大排序
-    std::sort(
-        this->_internalData.childrenInfo.begin(),
-        this->_internalData.childrenInfo.end(),
-        [](const _ChildInfo &a, const _ChildInfo &b) -> bool {
-            if (a.rowMeasureType != b.rowMeasureType) {
-                // 先FixSize，后AutoSize，最后FillRemain
-                return a.rowMeasureType < b.rowMeasureType;
-            } else {
-                // 若类型相同，则按照跨列数从小到大measure
-                return a.layoutTag.rowSpan < b.layoutTag.rowSpan;
-            }
-        });
+    const std::vector<int> &rowMeasureOrder = this->_internalData.rowMeasureOrder;
 
     int measureIndex = 0;
 
     // Measure行类型为FixSize的元素
     while (measureIndex < childCount &&
-           this->_internalData.childrenInfo[measureIndex].rowMeasureType == GridRCType::FixSize) {
-        _ChildInfo &childInfo = this->_internalData.childrenInfo[measureIndex++];
+           this->_internalData.childrenInfo[rowMeasureOrder[measureIndex]].rowMeasureType == GridRCType::FixSize) {
+        _ChildInfo &childInfo = this->_internalData.childrenInfo[rowMeasureOrder[measureIndex++]];
 
         Size measureSize{};
         for (int i = 0; i < childInfo.layoutTag.columnSpan; ++i)
@@ -292,8 +304,8 @@ sw::Size sw::GridLayout::MeasureOverride(const Size &availableSize)
 
     // Measure行类型为AutoSize的元素
     while (measureIndex < childCount &&
-           this->_internalData.childrenInfo[measureIndex].rowMeasureType == GridRCType::AutoSize) {
-        _ChildInfo &childInfo = this->_internalData.childrenInfo[measureIndex++];
+           this->_internalData.childrenInfo[rowMeasureOrder[measureIndex]].rowMeasureType == GridRCType::AutoSize) {
+        _ChildInfo &childInfo = this->_internalData.childrenInfo[rowMeasureOrder[measureIndex++]];
 
         Size measureSize{0, INFINITY};
         for (int i = 0; i < childInfo.layoutTag.columnSpan; ++i) {
@@ -337,7 +349,7 @@ sw::Size sw::GridLayout::MeasureOverride(const Size &availableSize)
     if (heightSizeToContent) {
         // 高度由内容决定，依据所占宽度最大元素为基准计算列宽度
         while (measureIndex < childCount) {
-            _ChildInfo &childInfo = this->_internalData.childrenInfo[measureIndex++];
+            _ChildInfo &childInfo = this->_internalData.childrenInfo[rowMeasureOrder[measureIndex++]];
 
             Size measureSize{0, INFINITY};
             for (int i = 0; i < childInfo.layoutTag.columnSpan; ++i)
@@ -412,7 +424,7 @@ sw::Size sw::GridLayout::MeasureOverride(const Size &availableSize)
         }
         // Measure
         while (measureIndex < childCount) {
-            _ChildInfo &childInfo = this->_internalData.childrenInfo[measureIndex++];
+            _ChildInfo &childInfo = this->_internalData.childrenInfo[rowMeasureOrder[measureIndex++]];
 
             Size measureSize{};
             for (int i = 0; i < childInfo.layoutTag.columnSpan; ++i)
@@ -473,6 +485,60 @@ void sw::GridLayout::ArrangeOverride(const Size &finalSize)
 
 void sw::GridLayout::_UpdateInternalData()
 {
+    if (this->_IsInternalDataValid()) {
+        // 行列定义、子元素及其布局标记均未改变，沿用已排好序的子元素信息，
+        // 只需重置非FixSize行/列的尺寸，由本次measure重新计算。
+        // ILayout无法得知子元素的测量结果是否已失效，因此AutoSize行/列总是重新测量并累加子元素的尺寸；
+        // 固定尺寸单元格中的子元素每次收到相同的可用尺寸，未失效时由UIElement::Measure直接返回
+        this->_ResetTrackSizes();
+    } else {
+        this->_RebuildInternalData();
+    }
+}
+
+bool sw::GridLayout::_IsInternalDataValid()
+{
+    if (this->_internalData.rowsInfo.empty() ||
+        !IsSameDefinitions(this->rows.GetInternalVector(), this->_internalData.rowsDefinition) ||
+        !IsSameDefinitions(this->columns.GetInternalVector(), this->_internalData.colsDefinition)) {
+        return false;
+    }
+
+    int childCount = this->GetChildLayoutCount();
+
+    if (childCount != (int)this->_internalData.childrenInfo.size()) {
+        return false;
+    }
+
+    for (int i = 0; i < childCount; ++i) {
+        ILayout &item         = this->GetChildLayoutAt(i);
+        _ChildInfo &childInfo = this->_internalData.childrenInfo[i];
+        if (childInfo.instance != &item || childInfo.sourceTag != item.GetLayoutTag()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void sw::GridLayout::_ResetTrackSizes()
+{
+    for (_RowInfo &rowInfo : this->_internalData.rowsInfo) {
+        if (rowInfo.row.type != GridRCType::FixSize) {
+            rowInfo.size = 0;
+        }
+    }
+    for (_ColInfo &colInfo : this->_internalData.colsInfo) {
+        if (colInfo.col.type != GridRCType::FixSize) {
+            colInfo.size = 0;
+        }
+    }
+}
+
+void sw::GridLayout::_RebuildInternalData()
+{
+    this->_internalData.rowsDefinition = this->rows.GetInternalVector();
+    this->_internalData.colsDefinition = this->columns.GetInternalVector();
+
     this->_internalData.rowsInfo.clear();
     this->_internalData.colsInfo.clear();
     this->_internalData.childrenInfo.clear();
@@ -631,6 +697,7 @@ void sw::GridLayout::_UpdateInternalData()
             }
 
             info.instance       = &item;
+            info.sourceTag      = item.GetLayoutTag();
             info.layoutTag      = tag;
             info.rowMeasureType = rowMeasureType;
             info.colMeasureType = colMeasureType;
@@ -639,6 +706,51 @@ void sw::GridLayout::_UpdateInternalData()
         }
     }
 
+    // measure顺序
+    {
+        int childCount = (int)this->_internalData.childrenInfo.size();
+
+        std::vector<int> &colOrder = this->_internalData.colMeasureOrder;
+        std::vector<int> &rowOrder = this->_internalData.rowMeasureOrder;
+
+        colOrder.resize(childCount);
+        rowOrder.resize(childCount);
+
+        for (int i = 0; i < childCount; ++i) {
+            colOrder[i] = rowOrder[i] = i;
+        }
+
+        const std::vector<_ChildInfo> &childrenInfo = this->_internalData.childrenInfo;
+
+        // 先FixSize，后AutoSize，最后FillRemain
+        // 若类型相同，则按照跨列数从小到大measure
+        std::sort(colOrder.begin(), colOrder.end(), [&childrenInfo](int a, int b) -> bool {
+            const _ChildInfo &infoA = childrenInfo[a];
+            const _ChildInfo &infoB = childrenInfo[b];
+            if (infoA.colMeasureType != infoB.colMeasureType) {
+                return infoA.colMeasureType < infoB.colMeasureType;
+            } else if (infoA.layoutTag.columnSpan != infoB.layoutTag.columnSpan) {
+                return infoA.layoutTag.columnSpan < infoB.layoutTag.columnSpan;
+            } else {
+                return a < b;
+            }
+        });
+
+        // 先FixSize，后AutoSize，最后FillRemain
+        // 若类型相同，则按照跨行数从小到大measure
+        std::sort(rowOrder.begin(), rowOrder.end(), [&childrenInfo](int a, int b) -> bool {
+            const _ChildInfo &infoA = childrenInfo[a];
+            const _ChildInfo &infoB = childrenInfo[b];
+            if (infoA.rowMeasureType != infoB.rowMeasureType) {
+                return infoA.rowMeasureType < infoB.rowMeasureType;
+            } else if (infoA.layoutTag.rowSpan != infoB.layoutTag.rowSpan) {
+                return infoA.layoutTag.rowSpan < infoB.layoutTag.rowSpan;
+            } else {
+                return a < b;
+            }
+        });
+    }
+
     // cells
     {
         this->_internalData.cells.resize(this->_internalData.rowsInfo.size() * this->_internalData.colsInfo.size());
@@ -1,4 +1,5 @@
 #include "GroupBox.h"
+#include "BrushCache.h"
 #include "Utils.h"
 
 namespace
@@ -49,7 +50,7 @@ void sw::GroupBox::OnDrawBorder(HDC hdc, RECT &rect)
         COLORREF oldTextColor = ::SetTextColor(hdc, textColor);
         HGDIOBJ hOldFont      = ::SelectObject(hdc, GetFontHandle());
 
-        HBRUSH hBrush = CreateSolidBrush(backColor);
+        HBRUSH hBrush = BrushCache::GetBrush(backColor);
 
         RECT rtHeaderRow = {
             rect.left,
@@ -93,10 +94,6 @@ void sw::GroupBox::OnDrawBorder(HDC hdc, RECT &rect)
 
         ::SetTextColor(hdc, oldTextColor);
         ::SetBkColor(hdc, oldBackColor);
-
-        if (hBrush != NULL) {
-            DeleteObject(hBrush);
-        }
     }
 
     rect.left += borderThicknessX;
@@ -0,0 +1,145 @@
+#include "IdleScheduler.h"
+#include <algorithm>
+
+int sw::IdleScheduler::Add(const std::wstring &name, const Func<bool> &task)
+{
+    std::unique_ptr<_Task> item(new _Task);
+    item->task            = task;
+    item->statistics.id   = this->_nextId++;
+    item->statistics.name = name;
+
+    int id = item->statistics.id;
+    this->_tasks.push_back(std::move(item));
+    return id;
+}
+
+bool sw::IdleScheduler::Remove(int id)
+{
+    for (size_t i = 0; i < this->_tasks.size(); ++i) {
+        _Task &item = *this->_tasks[i];
+
+        if (item.removed || item.statistics.id != id) {
+            continue;
+        }
+
+        if (this->_isRunning) {
+            // 任务可能正在执行，延迟到Run结束时删除
+            item.removed      = true;
+            item.hasWork      = false;
+            this->_hasRemoved = true;
+        } else {
+            this->_tasks.erase(this->_tasks.begin() + i);
+            if (this->_cursor > i) --this->_cursor;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool sw::IdleScheduler::IsEmpty() const noexcept
+{
+    for (const auto &item : this->_tasks) {
+        if (!item->removed) return false;
+    }
+    return true;
+}
+
+void sw::IdleScheduler::Reset() noexcept
+{
+    for (auto &item : this->_tasks) {
+        item->hasWork = !item->removed;
+    }
+}
+
+bool sw::IdleScheduler::Run(std::chrono::nanoseconds budget, const Func<bool> &shouldYield)
+{
+    using clock = std::chrono::steady_clock;
+
+    if (this->_isRunning) {
+        return false; // 任务中嵌套的消息循环不执行空闲任务，由外层的Run继续
+    }
+
+    this->_isRunning = true;
+    clock::time_point start = clock::now();
+
+    // 连续检查一轮都没有找到有工作的任务时停止
+    size_t index = this->_cursor;
+    size_t idle  = 0;
+
+    while (idle < this->_tasks.size()) {
+        if (index >= this->_tasks.size()) {
+            index = 0;
+        }
+        _Task &item = *this->_tasks[index++];
+
+        if (!item.hasWork) {
+            ++idle;
+            continue;
+        }
+        this->_cursor = index;
+
+        clock::time_point begin = clock::now();
+        item.hasWork            = item.task() && !item.removed;
+        clock::time_point end   = clock::now();
+
+        uint64_t cost = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+        item.statistics.callCount += 1;
+        item.statistics.totalTime += cost;
+        item.statistics.maxTime = (std::max)(item.statistics.maxTime, cost);
+
+        idle = 0;
+
+        if (end - start >= budget || (shouldYield && shouldYield())) {
+            break;
+        }
+    }
+
+    this->_isRunning = false;
+    this->_RemovePending();
+
+    for (const auto &item : this->_tasks) {
+        if (item->hasWork) return true;
+    }
+    return false;
+}
+
+std::vector<sw::IdleTaskStatistics> sw::IdleScheduler::GetStatistics() const
+{
+    std::vector<IdleTaskStatistics> result;
+    result.reserve(this->_tasks.size());
+
+    for (const auto &item : this->_tasks) {
+        if (!item->removed) result.push_back(item->statistics);
+    }
+    return result;
+}
+
+void sw::IdleScheduler::ResetStatistics() noexcept
+{
+    for (auto &item : this->_tasks) {
+        item->statistics.callCount = 0;
+        item->statistics.totalTime = 0;
+        item->statistics.maxTime   = 0;
+    }
+}
+
+void sw::IdleScheduler::_RemovePending()
+{
+    if (!this->_hasRemoved) {
+        return;
+    }
+    this->_hasRemoved = false;
+
+    size_t cursor = this->_cursor;
+    size_t kept   = 0;
+
+    for (size_t i = 0; i < this->_tasks.size(); ++i) {
+        if (this->_tasks[i]->removed) {
+            if (i < this->_cursor) --cursor;
+        } else {
+            this->_tasks[kept++] = std::move(this->_tasks[i]);
+        }
+    }
+    this->_tasks.resize(kept);
+    this->_cursor = cursor;
+}
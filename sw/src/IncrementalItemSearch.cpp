@@ -0,0 +1,46 @@
+#include "IncrementalItemSearch.h"
+
+sw::IncrementalItemSearch::IncrementalItemSearch(uint32_t timeout)
+    : _timeout(timeout)
+{
+}
+
+int sw::IncrementalItemSearch::Input(wchar_t ch, uint32_t time, int currentIndex, const Func<const std::wstring &, int, int> &findPrefix)
+{
+    if (time - this->_lastTime > this->_timeout) {
+        this->_text.clear();
+    }
+    this->_lastTime = time;
+    this->_text += ch;
+
+    if (this->_text.find_first_not_of(ch) == std::wstring::npos) {
+        // 重复输入同一字符时依次选中以该字符开头的下一项
+        return findPrefix(this->_text.substr(0, 1), currentIndex);
+    } else {
+        // 当前项仍然匹配时保持不变
+        return findPrefix(this->_text, currentIndex < 0 ? -1 : currentIndex - 1);
+    }
+}
+
+void sw::IncrementalItemSearch::Reset() noexcept
+{
+    this->_text.clear();
+}
+
+const std::wstring &sw::IncrementalItemSearch::GetText() const noexcept
+{
+    return this->_text;
+}
+
+int sw::IncrementalItemSearch::FindNext(int count, int startIndex, const Func<int, bool> &match)
+{
+    int first = (startIndex < 0 || startIndex >= count) ? 0 : startIndex + 1;
+
+    for (int i = 0; i < count; ++i) {
+        int index = (first + i) % count;
+        if (match(index)) {
+            return index;
+        }
+    }
+    return -1;
+}
@@ -21,3 +21,12 @@ sw::ILayout &sw::LayoutHost::GetChildLayoutAt(int index) const
 {
     return this->_associatedObj->GetChildLayoutAt(index);
 }
+
+void sw::LayoutHost::UpdateViewport(const Rect &viewport)
+{
+}
+
+sw::Size sw::LayoutHost::GetContentExtent()
+{
+    return Size{};
+}
@@ -0,0 +1,301 @@
+#include "LayoutProfiler.h"
+#include <cstdio>
+#include <utility>
+
+namespace
+{
+    /**
+     * @brief 将字符串转义后以JSON字符串的形式追加到out
+     */
+    void _AppendJsonString(std::string &out, const char *str)
+    {
+        out += '"';
+        for (; *str; ++str) {
+            char ch = *str;
+            switch (ch) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default: {
+                    if (static_cast<unsigned char>(ch) < 0x20) {
+                        char buf[8];
+                        snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(ch));
+                        out += buf;
+                    } else {
+                        out += ch;
+                    }
+                    break;
+                }
+            }
+        }
+        out += '"';
+    }
+
+    /**
+     * @brief 将对象地址以JSON字符串的形式追加到out
+     */
+    void _AppendJsonAddress(std::string &out, const void *obj)
+    {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "\"0x%llx\"", static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(obj)));
+        out += buf;
+    }
+
+    /**
+     * @brief 将整数追加到out
+     */
+    void _AppendNumber(std::string &out, uint64_t value)
+    {
+        out += std::to_string(value);
+    }
+
+    /**
+     * @brief 将纳秒数以微秒为单位追加到out，用于Chrome Trace的时间戳
+     */
+    void _AppendMicroseconds(std::string &out, uint64_t ns)
+    {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%llu.%03u", static_cast<unsigned long long>(ns / 1000), static_cast<unsigned>(ns % 1000));
+        out += buf;
+    }
+}
+
+constexpr size_t sw::LayoutProfiler::MaxTraceEventCount;
+
+bool sw::LayoutProfiler::IsEnabled() noexcept
+{
+    return _GetInstance()._enabled;
+}
+
+void sw::LayoutProfiler::SetEnabled(bool enabled, bool trace)
+{
+    LayoutProfiler &profiler = _GetInstance();
+
+    profiler._enabled      = enabled;
+    profiler._traceEnabled = enabled && trace;
+}
+
+void sw::LayoutProfiler::Reset()
+{
+    LayoutProfiler &profiler = _GetInstance();
+
+    profiler._records.clear();
+    profiler._index.clear();
+    profiler._stack.clear();
+    profiler._events.clear();
+    profiler._droppedEventCount = 0;
+    profiler._epoch             = std::chrono::steady_clock::now();
+}
+
+void sw::LayoutProfiler::RecordMeasureSkipped(const void *obj)
+{
+    LayoutProfiler &profiler = _GetInstance();
+
+    if (profiler._enabled) {
+        ++profiler._GetRecord(obj).measureSkipCount;
+    }
+}
+
+void sw::LayoutProfiler::RecordSetWindowPos(const void *obj)
+{
+    LayoutProfiler &profiler = _GetInstance();
+
+    if (profiler._enabled) {
+        ++profiler._GetRecord(obj).setWindowPosCount;
+    }
+}
+
+void sw::LayoutProfiler::RecordDeferWindowPos(const void *obj)
+{
+    LayoutProfiler &profiler = _GetInstance();
+
+    if (profiler._enabled) {
+        ++profiler._GetRecord(obj).deferWindowPosCount;
+    }
+}
+
+std::vector<sw::LayoutProfileRecord> sw::LayoutProfiler::GetRecords()
+{
+    return _GetInstance()._records;
+}
+
+std::string sw::LayoutProfiler::ToJson()
+{
+    LayoutProfiler &profiler = _GetInstance();
+
+    // 按记录的parent字段建立树，外层对象没有记录的视为根节点
+    std::vector<size_t> roots;
+    std::vector<std::vector<size_t>> children(profiler._records.size());
+
+    for (size_t i = 0; i < profiler._records.size(); ++i) {
+        auto it = profiler._index.find(profiler._records[i].parent);
+        if (profiler._records[i].parent == nullptr || it == profiler._index.end()) {
+            roots.push_back(i);
+        } else {
+            children[it->second].push_back(i);
+        }
+    }
+
+    std::string out = "{\"elements\":[";
+    for (size_t i = 0; i < roots.size(); ++i) {
+        if (i != 0) out += ',';
+        profiler._WriteJsonNode(out, roots[i], children);
+    }
+    out += "]}";
+    return out;
+}
+
+std::string sw::LayoutProfiler::ToChromeTrace()
+{
+    LayoutProfiler &profiler = _GetInstance();
+
+    std::string out = "{\"traceEvents\":[";
+    for (size_t i = 0; i < profiler._events.size(); ++i) {
+        const _TraceEvent &event          = profiler._events[i];
+        const LayoutProfileRecord &record = profiler._records[event.record];
+
+        if (i != 0) out += ',';
+        out += "{\"name\":";
+        _AppendJsonString(out, record.typeName);
+        out += event.pass == LayoutPass::Measure ? ",\"cat\":\"Measure\"" : ",\"cat\":\"Arrange\"";
+        out += ",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":";
+        _AppendMicroseconds(out, event.startTime);
+        out += ",\"dur\":";
+        _AppendMicroseconds(out, event.duration);
+        out += ",\"args\":{\"object\":";
+        _AppendJsonAddress(out, record.object);
+        out += "}}";
+    }
+    out += "],\"displayTimeUnit\":\"ns\",\"otherData\":{\"droppedEvents\":";
+    _AppendNumber(out, profiler._droppedEventCount);
+    out += "}}";
+    return out;
+}
+
+sw::LayoutProfiler &sw::LayoutProfiler::_GetInstance() noexcept
+{
+    static thread_local LayoutProfiler instance;
+    return instance;
+}
+
+uint64_t sw::LayoutProfiler::_Now() const noexcept
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _epoch).count());
+}
+
+sw::LayoutProfileRecord &sw::LayoutProfiler::_GetRecord(const void *obj)
+{
+    auto it = _index.find(obj);
+    if (it != _index.end()) {
+        return _records[it->second];
+    }
+
+    _index.emplace(obj, _records.size());
+    _records.emplace_back();
+    _records.back().object = obj;
+    return _records.back();
+}
+
+bool sw::LayoutProfiler::_Begin(const void *obj, const std::type_info &type, LayoutPass pass)
+{
+    LayoutProfiler &profiler = _GetInstance();
+
+    LayoutProfileRecord &record = profiler._GetRecord(obj);
+    record.typeName             = type.name();
+
+    // 外层调用属于同一对象时（如Layer::Arrange调用UIElement::Arrange）保留原有的外层对象
+    if (!profiler._stack.empty()) {
+        const void *outer = profiler._records[profiler._stack.back().record].object;
+        if (outer != obj) record.parent = outer;
+    } else {
+        record.parent = nullptr;
+    }
+
+    if (pass == LayoutPass::Measure) {
+        ++record.measureCount;
+    } else {
+        ++record.arrangeCount;
+    }
+
+    size_t index = static_cast<size_t>(&record - profiler._records.data());
+    profiler._stack.push_back(_Frame{index, pass, profiler._Now(), 0});
+    return true;
+}
+
+void sw::LayoutProfiler::_End() noexcept
+{
+    LayoutProfiler &profiler = _GetInstance();
+
+    // 布局过程中调用了Reset
+    if (profiler._stack.empty()) {
+        return;
+    }
+
+    _Frame frame = profiler._stack.back();
+    profiler._stack.pop_back();
+
+    uint64_t duration  = profiler._Now() - frame.startTime;
+    uint64_t exclusive = duration > frame.childTime ? duration - frame.childTime : 0;
+
+    LayoutProfileRecord &record = profiler._records[frame.record];
+    if (frame.pass == LayoutPass::Measure) {
+        record.measureInclusiveTime += duration;
+        record.measureExclusiveTime += exclusive;
+    } else {
+        record.arrangeInclusiveTime += duration;
+        record.arrangeExclusiveTime += exclusive;
+    }
+
+    if (!profiler._stack.empty()) {
+        profiler._stack.back().childTime += duration;
+    }
+
+    if (profiler._traceEnabled) {
+        if (profiler._events.size() < MaxTraceEventCount) {
+            try {
+                profiler._events.push_back(_TraceEvent{frame.record, frame.pass, frame.startTime, duration});
+            } catch (...) {
+                ++profiler._droppedEventCount;
+            }
+        } else {
+            ++profiler._droppedEventCount;
+        }
+    }
+}
+
+void sw::LayoutProfiler::_WriteJsonNode(std::string &out, size_t index, const std::vector<std::vector<size_t>> &children) const
+{
+    const LayoutProfileRecord &record = _records[index];
+
+    out += "{\"type\":";
+    _AppendJsonString(out, record.typeName);
+    out += ",\"object\":";
+    _AppendJsonAddress(out, record.object);
+    out += ",\"measure\":{\"count\":";
+    _AppendNumber(out, record.measureCount);
+    out += ",\"skipped\":";
+    _AppendNumber(out, record.measureSkipCount);
+    out += ",\"inclusiveNs\":";
+    _AppendNumber(out, record.measureInclusiveTime);
+    out += ",\"exclusiveNs\":";
+    _AppendNumber(out, record.measureExclusiveTime);
+    out += "},\"arrange\":{\"count\":";
+    _AppendNumber(out, record.arrangeCount);
+    out += ",\"inclusiveNs\":";
+    _AppendNumber(out, record.arrangeInclusiveTime);
+    out += ",\"exclusiveNs\":";
+    _AppendNumber(out, record.arrangeExclusiveTime);
+    out += "},\"setWindowPos\":";
+    _AppendNumber(out, record.setWindowPosCount);
+    out += ",\"deferWindowPos\":";
+    _AppendNumber(out, record.deferWindowPosCount);
+    out += ",\"children\":[";
+    for (size_t i = 0; i < children[index].size(); ++i) {
+        if (i != 0) out += ',';
+        _WriteJsonNode(out, children[index][i], children);
+    }
+    out += "]}";
+}
@@ -695,15 +695,21 @@ void sw::ListView::_ColumnsCollectionChangedHandler(
 {
     switch (args.action) {
         case NotifyCollectionChangedAction::Add:
-            _InsertColumn(args.index, _columns.GetAt(args.index));
+            for (int i = args.index; i < args.index + args.count; ++i) {
+                _InsertColumn(i, _columns.GetAt(i));
+            }
             break;
 
         case NotifyCollectionChangedAction::Remove:
-            _DeleteColumn(args.index);
+            for (int i = 0; i < args.count; ++i) {
+                _DeleteColumn(args.index);
+            }
             break;
 
         case NotifyCollectionChangedAction::Replace:
-            _SetColumn(args.index, _columns.GetAt(args.index));
+            for (int i = args.index; i < args.index + args.count; ++i) {
+                _SetColumn(i, _columns.GetAt(i));
+            }
             break;
 
         case NotifyCollectionChangedAction::Move:
@@ -170,6 +170,7 @@ sw::MenuItem *sw::MenuItem::CreateRoot(bool isPopup)
 {
     MenuItem *root = new MenuItem({});
     root->_isRoot  = true;
+    root->_index.reset(new _MenuItemIndex);
 
     if (!isPopup) {
         root->_hMenu = CreateMenu();
@@ -190,7 +191,14 @@ void sw::MenuItem::OnTagChanged()
         newTagValue = tagVariant.UnsafeCast<uint64_t>();
     }
     if (_desc.tag != newTagValue) {
+        _MenuItemIndex *index = _isRoot ? nullptr : _GetRootIndex();
+        if (index != nullptr) {
+            _RemoveTagFromIndex(index, this);
+        }
         _desc.tag = newTagValue;
+        if (index != nullptr && newTagValue != 0) {
+            index->tags.emplace(newTagValue, this);
+        }
         RaisePropertyChanged(&MenuItem::Tag);
     }
 }
@@ -255,6 +263,11 @@ bool sw::MenuItem::RemoveChildAt(int index)
         return false;
     }
 
+    _MenuItemIndex *rootIndex = _GetRootIndex();
+    if (rootIndex != nullptr) {
+        _RemoveFromIndex(rootIndex, _subItems[index].get());
+    }
+
     DeleteMenu(_hMenu, index, MF_BYPOSITION);
     _subItems.erase(_subItems.begin() + index);
 
@@ -280,6 +293,12 @@ void sw::MenuItem::ClearChildren()
             DeleteMenu(_hMenu, i, MF_BYPOSITION);
         }
     }
+    _MenuItemIndex *rootIndex = _GetRootIndex();
+    if (rootIndex != nullptr) {
+        for (auto &child : _subItems) {
+            _RemoveFromIndex(rootIndex, child.get());
+        }
+    }
     _subItems.clear();
     _ResetMenuItem();
 }
@@ -301,6 +320,12 @@ void sw::MenuItem::ResetChildren(std::initializer_list<MenuItemDesc> descs)
         return;
     }
 
+    _MenuItemIndex *rootIndex = _GetRootIndex();
+    if (rootIndex != nullptr) {
+        for (auto &child : _subItems) {
+            _RemoveFromIndex(rootIndex, child.get());
+        }
+    }
     _subItems.clear();
 
     for (auto &desc : descs) {
@@ -332,6 +357,17 @@ void sw::MenuItem::ResetChildren(std::initializer_list<MenuItemDesc> descs)
 
 sw::MenuItem *sw::MenuItem::FindChildById(int id)
 {
+    if (_id == id) {
+        return this;
+    }
+
+    _MenuItemIndex *index = _GetRootIndex();
+    if (index != nullptr) {
+        auto it = index->ids.find(id);
+        return it != index->ids.end() && _IsSelfOrAncestorOf(it->second) ? it->second : nullptr;
+    }
+
+    // 不在根菜单项下的菜单项没有索引，遍历查找
     std::vector<MenuItem *> stack;
     stack.push_back(this);
 
@@ -351,6 +387,29 @@ sw::MenuItem *sw::MenuItem::FindChildById(int id)
 
 sw::MenuItem *sw::MenuItem::FindChildByTag(uint64_t tag)
 {
+    if (_desc.tag == tag) {
+        return this;
+    }
+
+    _MenuItemIndex *index = _GetRootIndex();
+    if (index != nullptr && tag != 0) {
+        MenuItem *found = nullptr;
+        int count       = 0;
+
+        auto range = index->tags.equal_range(tag);
+        for (auto it = range.first; it != range.second && count < 2; ++it) {
+            if (_IsSelfOrAncestorOf(it->second)) {
+                found = it->second;
+                ++count;
+            }
+        }
+        if (count < 2) {
+            return found;
+        }
+    }
+
+    // 不在根菜单项下的菜单项没有索引，tag为0的菜单项也不加入索引，遍历查找；
+    // 子树中有多个菜单项的tag相同时索引中的顺序不确定，同样遍历查找，返回先序遍历中的第一个
     std::vector<MenuItem *> stack;
     stack.push_back(this);
 
@@ -361,8 +420,8 @@ sw::MenuItem *sw::MenuItem::FindChildByTag(uint64_t tag)
         if (current->_desc.tag == tag) {
             return current;
         }
-        for (auto &child : current->_subItems) {
-            stack.push_back(child.get());
+        for (auto it = current->_subItems.rbegin(); it != current->_subItems.rend(); ++it) {
+            stack.push_back(it->get());
         }
     }
     return nullptr;
@@ -491,12 +550,87 @@ void sw::MenuItem::_UpdateState()
 void sw::MenuItem::_SetParent(MenuItem *parent, MenuItem *child, int index)
 {
     child->_parent = parent;
+    child->InvalidateCurrentDataContext();
 
     if (index == -1) {
         parent->_subItems.emplace_back(child);
     } else {
         parent->_subItems.insert(parent->_subItems.begin() + index, std::unique_ptr<MenuItem>(child));
     }
+
+    _MenuItemIndex *rootIndex = parent->_GetRootIndex();
+    if (rootIndex != nullptr) {
+        _AddToIndex(rootIndex, child);
+    }
+}
+
+sw::MenuItem::_MenuItemIndex *sw::MenuItem::_GetRootIndex()
+{
+    MenuItem *item = this;
+    while (item->_parent != nullptr) {
+        item = item->_parent;
+    }
+    return item->_index.get();
+}
+
+bool sw::MenuItem::_IsSelfOrAncestorOf(MenuItem *item) const
+{
+    for (; item != nullptr; item = item->_parent) {
+        if (item == this) return true;
+    }
+    return false;
+}
+
+void sw::MenuItem::_AddToIndex(_MenuItemIndex *index, MenuItem *item)
+{
+    std::vector<MenuItem *> stack;
+    stack.push_back(item);
+
+    while (!stack.empty()) {
+        MenuItem *current = stack.back();
+        stack.pop_back();
+
+        index->ids[current->_id] = current;
+        if (current->_desc.tag != 0) {
+            index->tags.emplace(current->_desc.tag, current);
+        }
+        for (auto &child : current->_subItems) {
+            stack.push_back(child.get());
+        }
+    }
+}
+
+void sw::MenuItem::_RemoveFromIndex(_MenuItemIndex *index, MenuItem *item)
+{
+    std::vector<MenuItem *> stack;
+    stack.push_back(item);
+
+    while (!stack.empty()) {
+        MenuItem *current = stack.back();
+        stack.pop_back();
+
+        index->ids.erase(current->_id);
+        _RemoveTagFromIndex(index, current);
+
+        for (auto &child : current->_subItems) {
+            stack.push_back(child.get());
+        }
+    }
+}
+
+void sw::MenuItem::_RemoveTagFromIndex(_MenuItemIndex *index, MenuItem *item)
+{
+    if (item->_desc.tag == 0) {
+        return;
+    }
+
+    auto range = index->tags.equal_range(item->_desc.tag);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == item) {
+            index->tags.erase(it);
+            return;
+        }
+    }
 }
 
 int sw::MenuItem::_GenerateMenuItemID()
@@ -1,5 +1,6 @@
 #include "Panel.h"
 #include "App.h"
+#include "BrushCache.h"
 #include "Cursor.h"
 #include "Utils.h"
 #include "WndMsg.h"
@@ -82,7 +83,7 @@ LRESULT sw::Panel::WndProc(ProcMsg &refMsg)
         }
 
         case WM_UpdateLayout: {
-            if (IsInHierarchy)
+            if (AcceptLayoutUpdate(refMsg.wParam != FALSE) && IsInHierarchy)
                 UpdateLayout();
             return 0;
         }
@@ -110,11 +111,10 @@ bool sw::Panel::OnPaint()
         ps.rcPaint.top < ps.rcPaint.bottom) //
     {
         auto color    = static_cast<COLORREF>(GetRealBackColor());
-        HBRUSH hBrush = CreateSolidBrush(color);
+        HBRUSH hBrush = BrushCache::GetBrush(color);
 
         if (hBrush != NULL) {
             FillRect(hdc, &ps.rcPaint, hBrush);
-            DeleteObject(hBrush);
         }
     }
 
@@ -183,11 +183,10 @@ bool sw::Panel::OnNcPaint(HRGN hRgn)
                 if (hdcMem != NULL && hBmpWnd != NULL) {
                     HBITMAP hBmpOld = (HBITMAP)SelectObject(hdcMem, hBmpWnd);
                     if (hBmpOld != NULL) {
-                        HBRUSH hBrush = CreateSolidBrush(static_cast<COLORREF>(GetRealBackColor()));
+                        HBRUSH hBrush = BrushCache::GetBrush(static_cast<COLORREF>(GetRealBackColor()));
                         if (hBrush != NULL) {
                             // 先在内存DC中完成整块非客户区绘制，再一次性提交，减少绘制步骤外露。
                             FillRect(hdcMem, &rtWindow, hBrush);
-                            DeleteObject(hBrush);
 
                             RECT rect = rtWindow;
                             OnDrawBorder(hdcMem, rect);
@@ -277,7 +276,7 @@ void sw::Panel::OnDrawPadding(HDC hdc, RECT &rect)
     rect = rtPaddingInner;
     if (hdc == NULL) return;
 
-    HBRUSH hBrush = CreateSolidBrush(static_cast<COLORREF>(GetRealBackColor()));
+    HBRUSH hBrush = BrushCache::GetBrush(static_cast<COLORREF>(GetRealBackColor()));
     if (hBrush == NULL) return;
 
     auto clamp = [](LONG value, LONG minValue, LONG maxValue) -> LONG {
@@ -304,6 +303,4 @@ void sw::Panel::OnDrawPadding(HDC hdc, RECT &rect)
     fillRect(rtPaddingOuter.left, rtPaintInner.bottom, rtPaddingOuter.right, rtPaddingOuter.bottom);
     fillRect(rtPaddingOuter.left, rtPaintInner.top, rtPaintInner.left, rtPaintInner.bottom);
     fillRect(rtPaintInner.right, rtPaintInner.top, rtPaddingOuter.right, rtPaintInner.bottom);
-
-    DeleteObject(hBrush);
 }
@@ -1,5 +1,6 @@
 #include "Splitter.h"
 #include "App.h"
+#include "BrushCache.h"
 #include "Cursor.h"
 #include "Utils.h"
 
@@ -69,7 +70,7 @@ bool sw::Splitter::OnPaint()
     RECT rect;
     GetClientRect(hwnd, &rect);
 
-    HBRUSH hBrush = CreateSolidBrush(static_cast<COLORREF>(GetRealBackColor()));
+    HBRUSH hBrush = BrushCache::GetBrush(static_cast<COLORREF>(GetRealBackColor()));
     FillRect(hdc, &rect, hBrush);
 
     if (_drawSplitterLine) {
@@ -84,7 +85,6 @@ bool sw::Splitter::OnPaint()
         }
     }
 
-    DeleteObject(hBrush);
     EndPaint(hwnd, &ps);
     return true;
 }
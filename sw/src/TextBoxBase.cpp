@@ -1,4 +1,5 @@
 #include "TextBoxBase.h"
+#include <algorithm>
 
 sw::TextBoxBase::TextBoxBase()
     : ReadOnly(
@@ -34,6 +35,32 @@ sw::TextBoxBase::TextBoxBase()
                       self->_acceptTab = value;
                       self->RaisePropertyChanged(&TextBoxBase::AcceptTab);
                   }
+              })),
+
+      MaxLineCount(
+          Property<int>::Init(this)
+              .Getter([](TextBoxBase *self) -> int {
+                  return self->_maxLineCount;
+              })
+              .Setter([](TextBoxBase *self, int value) {
+                  value = (std::max)(value, 0);
+                  if (self->_maxLineCount != value) {
+                      self->_maxLineCount = value;
+                      self->RaisePropertyChanged(&TextBoxBase::MaxLineCount);
+                  }
+              })),
+
+      MaxTextLength(
+          Property<int>::Init(this)
+              .Getter([](TextBoxBase *self) -> int {
+                  return self->_maxTextLength;
+              })
+              .Setter([](TextBoxBase *self, int value) {
+                  value = (std::max)(value, 0);
+                  if (self->_maxTextLength != value) {
+                      self->_maxTextLength = value;
+                      self->RaisePropertyChanged(&TextBoxBase::MaxTextLength);
+                  }
               }))
 {
     this->TabStop = true;
@@ -50,6 +77,8 @@ void sw::TextBoxBase::InitTextBoxBase(DWORD dwStyle, DWORD dwExStyle)
 
 std::wstring &sw::TextBoxBase::GetInternalText()
 {
+    this->FlushAppendText();
+
     if (this->_isTextChanged) {
         this->UpdateInternalText();
         this->_isTextChanged = false;
@@ -57,10 +86,20 @@ std::wstring &sw::TextBoxBase::GetInternalText()
     return this->WndBase::GetInternalText();
 }
 
+void sw::TextBoxBase::SetInternalText(const std::wstring &value)
+{
+    this->_pendingAppendText.clear();
+    this->Control::SetInternalText(value);
+}
+
 void sw::TextBoxBase::OnCommand(int code)
 {
     switch (code) {
         case EN_CHANGE: {
+            // 追加文本时储存的文本由FlushAppendText更新，写入完成后统一调用OnTextChanged
+            if (this->_isAppending) {
+                break;
+            }
             this->_isTextChanged = true;
             this->OnTextChanged();
             break;
@@ -98,6 +137,13 @@ bool sw::TextBoxBase::OnKeyDown(VirtualKey key, const KeyFlags &flags)
     return e.handledMsg;
 }
 
+void sw::TextBoxBase::OnHandleChanged(HWND hwnd)
+{
+    // 重新创建句柄前读取文本时已写入追加的文本，投递到旧句柄的消息不会再被处理
+    this->_isAppendPosted = false;
+    this->Control::OnHandleChanged(hwnd);
+}
+
 void sw::TextBoxBase::Select(int start, int length)
 {
     this->SendMessageW(EM_SETSEL, start, start + length);
@@ -123,6 +169,99 @@ void sw::TextBoxBase::Clear()
     this->Text = std::wstring{};
 }
 
+void sw::TextBoxBase::AppendText(const std::wstring &text)
+{
+    if (text.empty()) {
+        return;
+    }
+
+    this->_pendingAppendText += text;
+
+    if (!this->_isAppendPosted) {
+        this->_isAppendPosted = this->InvokeAsync([this]() {
+            this->_isAppendPosted = false;
+            this->FlushAppendText();
+        });
+        if (!this->_isAppendPosted) {
+            this->FlushAppendText();
+        }
+    }
+}
+
+void sw::TextBoxBase::AppendLines(const std::vector<std::wstring> &lines)
+{
+    size_t length = 0;
+    for (const std::wstring &line : lines) {
+        length += line.size() + 2;
+    }
+
+    std::wstring text;
+    text.reserve(length);
+    for (const std::wstring &line : lines) {
+        text += line;
+        text += L"\r\n";
+    }
+    this->AppendText(text);
+}
+
+void sw::TextBoxBase::FlushAppendText()
+{
+    if (this->_pendingAppendText.empty()) {
+        return;
+    }
+
+    std::wstring text;
+    text.swap(this->_pendingAppendText);
+
+    HWND hwnd  = this->Handle;
+    int length = GetWindowTextLengthW(hwnd);
+
+    DWORD selStart = 0, selEnd = 0;
+    this->SendMessageW(EM_GETSEL, reinterpret_cast<WPARAM>(&selStart), reinterpret_cast<LPARAM>(&selEnd));
+    bool caretAtEnd  = selStart == selEnd && selEnd == static_cast<DWORD>(length);
+    int firstVisible = static_cast<int>(this->SendMessageW(EM_GETFIRSTVISIBLELINE, 0, 0));
+
+    // EM_REPLACESEL受EM_SETLIMITTEXT的限制，与设置Text属性一样不应截断追加的文本
+    size_t newLength = static_cast<size_t>(length) + text.size();
+    if (newLength > static_cast<size_t>(this->SendMessageW(EM_GETLIMITTEXT, 0, 0))) {
+        this->SendMessageW(EM_SETLIMITTEXT, static_cast<WPARAM>(newLength), 0);
+    }
+
+    this->_isAppending = true;
+    this->SendMessageW(EM_SETSEL, length, length);
+    this->SendMessageW(EM_REPLACESEL, FALSE, reinterpret_cast<LPARAM>(text.c_str()));
+
+    int trimmedLines = 0;
+    int trimLength   = this->_GetAppendTrimLength(text.back() == L'\n');
+    if (trimLength > 0) {
+        trimmedLines = static_cast<int>(this->SendMessageW(EM_LINEFROMCHAR, trimLength, 0));
+        this->SendMessageW(EM_SETSEL, 0, trimLength);
+        this->SendMessageW(EM_REPLACESEL, FALSE, reinterpret_cast<LPARAM>(L""));
+    }
+    this->_isAppending = false;
+
+    // 插入符号原本在末尾时跟随新文本滚动，否则恢复原来的选区和滚动位置
+    if (caretAtEnd) {
+        int end = GetWindowTextLengthW(hwnd);
+        this->SendMessageW(EM_SETSEL, end, end);
+        this->SendMessageW(EM_SCROLLCARET, 0, 0);
+    } else {
+        int start = (std::max)(static_cast<int>(selStart) - trimLength, 0);
+        int end   = (std::max)(static_cast<int>(selEnd) - trimLength, 0);
+        this->SendMessageW(EM_SETSEL, start, end);
+        int target = (std::max)(firstVisible - trimmedLines, 0);
+        this->SendMessageW(EM_LINESCROLL, 0, target - static_cast<int>(this->SendMessageW(EM_GETFIRSTVISIBLELINE, 0, 0)));
+    }
+
+    // 储存的文本未失效时直接在其末尾追加，之后读取Text属性不需要重新获取整个文本
+    if (!this->_isTextChanged) {
+        std::wstring &cache = this->WndBase::GetInternalText();
+        cache += text;
+        cache.erase(0, static_cast<size_t>(trimLength));
+    }
+    this->OnTextChanged();
+}
+
 sw::HorizontalAlignment sw::TextBoxBase::_GetHorzContentAlignment()
 {
     LONG_PTR style = this->GetStyle();
@@ -168,3 +307,33 @@ void sw::TextBoxBase::_SetHorzContentAlignment(sw::HorizontalAlignment value)
     this->Redraw();
     this->RaisePropertyChanged(&TextBoxBase::HorizontalContentAlignment);
 }
+
+int sw::TextBoxBase::_GetAppendTrimLength(bool endsWithNewLine)
+{
+    int result = 0;
+
+    if (this->_maxTextLength > 0) {
+        int length = GetWindowTextLengthW(this->Handle);
+        if (length > this->_maxTextLength) {
+            // 删除到超出部分所在行的下一行开头，避免在开头留下不完整的行
+            int excess    = length - this->_maxTextLength;
+            int line      = static_cast<int>(this->SendMessageW(EM_LINEFROMCHAR, excess, 0));
+            int lineStart = static_cast<int>(this->SendMessageW(EM_LINEINDEX, line, 0));
+            int nextStart = lineStart < excess ? static_cast<int>(this->SendMessageW(EM_LINEINDEX, line + 1, 0)) : -1;
+            result        = nextStart > 0 ? nextStart : excess;
+        }
+    }
+
+    if (this->_maxLineCount > 0) {
+        int lineCount = static_cast<int>(this->SendMessageW(EM_GETLINECOUNT, 0, 0));
+        if (endsWithNewLine) {
+            --lineCount;
+        }
+        if (lineCount > this->_maxLineCount) {
+            int start = static_cast<int>(this->SendMessageW(EM_LINEINDEX, lineCount - this->_maxLineCount, 0));
+            result    = (std::max)(result, start);
+        }
+    }
+
+    return result;
+}
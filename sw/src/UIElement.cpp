@@ -1,6 +1,9 @@
 #include "UIElement.h"
+#include "BrushCache.h"
 #include "Dip.h"
+#include "LayoutProfiler.h"
 #include "Menu.h"
+#include "ScratchBuffer.h"
 #include "Utils.h"
 #include "WndMsg.h"
 #include <algorithm>
@@ -33,6 +36,11 @@ namespace
     const sw::FieldId _PropId_LogicalRect         = sw::Reflection::GetFieldId(&sw::UIElement::LogicalRect);
     const sw::FieldId _PropId_IsHitTestVisible    = sw::Reflection::GetFieldId(&sw::UIElement::IsHitTestVisible);
     const sw::FieldId _PropId_IsFocusedViaTab     = sw::Reflection::GetFieldId(&sw::UIElement::IsFocusedViaTab);
+
+    /**
+     * @brief 当前线程的布局更新统计数据
+     */
+    thread_local sw::LayoutUpdateStatistics _layoutUpdateStatistics;
 }
 
 sw::UIElement::UIElement()
@@ -300,35 +308,42 @@ sw::UIElement::~UIElement()
     // 将自己从父窗口的children中移除
     this->SetParent(nullptr);
 
-    // 释放资源
-    if (this->_hCtlColorBrush != NULL) {
-        DeleteObject(this->_hCtlColorBrush);
-    }
+    // 释放WM_CTLCOLORxxx使用的画刷
+    BrushCache::Release(this->_hCtlColorBrush);
 }
 
 void sw::UIElement::RegisterRoutedEvent(RoutedEventType eventType, const RoutedEventHandler &handler)
 {
-    this->_eventMap[eventType] = handler;
+    if (handler) {
+        this->_eventTable.GetOrAdd(eventType) = handler;
+    } else {
+        this->UnregisterRoutedEvent(eventType);
+    }
 }
 
 void sw::UIElement::AddHandler(RoutedEventType eventType, const RoutedEventHandler &handler)
 {
-    if (handler) this->_eventMap[eventType] += handler;
+    if (handler) this->_eventTable.GetOrAdd(eventType) += handler;
 }
 
 bool sw::UIElement::RemoveHandler(RoutedEventType eventType, const RoutedEventHandler &handler)
 {
-    return handler == nullptr ? false : this->_eventMap[eventType].Remove(handler);
+    if (handler == nullptr) return false;
+    auto eventHandler = this->_eventTable.Find(eventType);
+    return eventHandler != nullptr && eventHandler->Remove(handler);
 }
 
 void sw::UIElement::UnregisterRoutedEvent(RoutedEventType eventType)
 {
-    this->_eventMap[eventType] = nullptr;
+    if (auto eventHandler = this->_eventTable.Find(eventType)) {
+        *eventHandler = nullptr;
+    }
 }
 
 bool sw::UIElement::IsRoutedEventRegistered(RoutedEventType eventType)
 {
-    return this->_eventMap[eventType] != nullptr;
+    auto eventHandler = this->_eventTable.Find(eventType);
+    return eventHandler != nullptr && *eventHandler != nullptr;
 }
 
 bool sw::UIElement::AddChild(UIElement *element)
@@ -675,7 +690,45 @@ void sw::UIElement::InvalidateMeasure()
         element = element->_parent;
     } while (element != nullptr);
 
-    root->SendMessageW(WM_UpdateLayout, 0, 0);
+    ++_layoutUpdateStatistics.invalidationCount;
+
+    if (root->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::LayoutPending)) {
+        // 已有挂起的布局更新，合并到该次更新中
+        ++root->_pendingInvalidationCount;
+        ++_layoutUpdateStatistics.mergedInvalidationCount;
+        return;
+    }
+
+    root->_layoutUpdateCondition |= sw::LayoutUpdateCondition::LayoutPending;
+    root->_pendingInvalidationCount = 1;
+
+    // 投递的消息会在WM_PAINT之前被处理，wParam为TRUE表示延迟的布局更新
+    if (!root->PostMessageW(WM_UpdateLayout, TRUE, 0)) {
+        root->SendMessageW(WM_UpdateLayout, FALSE, 0);
+    }
+}
+
+void sw::UIElement::UpdateLayoutNow()
+{
+    UIElement *root = this;
+    while (root->_parent != nullptr) {
+        root = root->_parent;
+    }
+
+    if (root->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::LayoutPending) ||
+        root->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::MeasureInvalidated)) {
+        root->SendMessageW(WM_UpdateLayout, FALSE, 0);
+    }
+}
+
+sw::LayoutUpdateStatistics sw::UIElement::GetLayoutUpdateStatistics()
+{
+    return _layoutUpdateStatistics;
+}
+
+void sw::UIElement::ResetLayoutUpdateStatistics()
+{
+    _layoutUpdateStatistics = sw::LayoutUpdateStatistics{};
 }
 
 bool sw::UIElement::BringIntoView()
@@ -744,9 +797,14 @@ void sw::UIElement::Measure(const Size &availableSize)
 {
     if (!this->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::MeasureInvalidated) &&
         this->_lastMeasureAvailableSize == availableSize) {
+#if !defined(SW_DISABLE_LAYOUT_PROFILER)
+        LayoutProfiler::RecordMeasureSkipped(this);
+#endif
         return; // 若布局未失效且可用尺寸没有变化，则无需重新测量
     }
 
+    LayoutProfiler::Scope profilerScope(this, LayoutPass::Measure);
+
     Size measureSize = availableSize;
 
     Thickness &margin   = this->_margin;
@@ -791,10 +849,13 @@ void sw::UIElement::Measure(const Size &availableSize)
 
 void sw::UIElement::Arrange(const sw::Rect &finalPosition)
 {
+    LayoutProfiler::Scope profilerScope(this, LayoutPass::Arrange);
+
     // 为什么在Arrange阶段清除MeasureInvalidated标记：
     // 一些复杂的布局可能会在测量阶段多次调用Measure函数，
     // 比如Grid会调用两次Measure，若在测量阶段清除该标记，
     // 则在第二次调用时会认为布局没有失效，导致测量被跳过。
+    bool measureInvalidated = this->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::MeasureInvalidated);
     this->_layoutUpdateCondition &= ~sw::LayoutUpdateCondition::MeasureInvalidated;
     this->_layoutUpdateCondition |= sw::LayoutUpdateCondition::Supressed;
 
@@ -858,19 +919,40 @@ void sw::UIElement::Arrange(const sw::Rect &finalPosition)
     bool hasChildren = !this->_children.empty();
     HDWP hdwpCurrent = this->_parent ? this->_parent->_hdwpChildren : NULL;
 
-    if (!hasChildren && hdwpCurrent != NULL) {
+    RECT pxRect{
+        Dip::DipToPxX(rect.left), Dip::DipToPxY(rect.top),
+        Dip::DipToPxX(rect.width), Dip::DipToPxY(rect.height)};
+
+    // 与上次Arrange的结果相同且窗口没有被移动或调整大小时，无需再次调整窗口位置，
+    // 避免产生WM_WINDOWPOSCHANGING/WM_WINDOWPOSCHANGED以及OnMove、OnSize等一系列回调
+    bool rectChanged = !this->_IsArrangedAt(pxRect);
+
+    if (!rectChanged) {
+        ++_layoutUpdateStatistics.skippedWindowPosCount;
+    } else if (!hasChildren && hdwpCurrent != NULL) {
         DeferWindowPos(hdwpCurrent, this->Handle, NULL,
-                       Dip::DipToPxX(rect.left), Dip::DipToPxY(rect.top),
-                       Dip::DipToPxX(rect.width), Dip::DipToPxY(rect.height),
+                       pxRect.left, pxRect.top, pxRect.right, pxRect.bottom,
                        SWP_NOACTIVATE | SWP_NOZORDER);
+#if !defined(SW_DISABLE_LAYOUT_PROFILER)
+        LayoutProfiler::RecordDeferWindowPos(this);
+#endif
     } else {
         SetWindowPos(this->Handle, NULL,
-                     Dip::DipToPxX(rect.left), Dip::DipToPxY(rect.top),
-                     Dip::DipToPxX(rect.width), Dip::DipToPxY(rect.height),
+                     pxRect.left, pxRect.top, pxRect.right, pxRect.bottom,
                      SWP_NOACTIVATE | SWP_NOZORDER);
+#if !defined(SW_DISABLE_LAYOUT_PROFILER)
+        LayoutProfiler::RecordSetWindowPos(this);
+#endif
     }
 
-    if (hasChildren) {
+    this->_lastArrangedRect = pxRect;
+    this->_hasArrangedRect  = true;
+
+    // 位置和尺寸未变且测量未失效时，子元素的排列结果也不会改变：
+    // 子元素及其布局相关属性的变化都会通过InvalidateMeasure使当前元素的测量失效
+    if (hasChildren && !rectChanged && !measureInvalidated) {
+        ++_layoutUpdateStatistics.skippedArrangeOverrideCount;
+    } else if (hasChildren) {
         if (this->_children.size() >= 3) {
             this->_hdwpChildren = BeginDeferWindowPos((int)this->_children.size());
         }
@@ -900,10 +982,12 @@ void sw::UIElement::RaiseRoutedEvent(RoutedEventArgs &eventArgs)
         eventArgs.source = this;
     }
 
+    static const RoutedEventHandler emptyHandler{};
+
     UIElement *element = this;
     do {
-        auto &handler = element->_eventMap[eventArgs.eventType];
-        element->OnRoutedEvent(eventArgs, handler);
+        auto handler = element->_eventTable.Find(eventArgs.eventType);
+        element->OnRoutedEvent(eventArgs, handler ? *handler : emptyHandler);
 
         if (eventArgs.handled) {
             break;
@@ -1013,19 +1097,19 @@ bool sw::UIElement::QueryAllChildren(const Predicate<UIElement *> &queryFunc)
         return true;
     }
 
-    std::vector<UIElement *> stack;
-    stack.push_back(this);
+    ScratchBuffer<UIElement *> stack;
+    stack->push_back(this);
 
-    while (!stack.empty()) {
-        auto current = stack.back();
-        stack.pop_back();
+    while (!stack->empty()) {
+        auto current = stack->back();
+        stack->pop_back();
 
         if (current != this && !queryFunc(current)) {
             return false;
         }
 
         for (UIElement *child : current->_children) {
-            stack.push_back(child);
+            stack->push_back(child);
         }
     }
     return true;
@@ -1054,6 +1138,25 @@ void sw::UIElement::ArrangeOverride(const Size &finalSize)
 {
 }
 
+bool sw::UIElement::AcceptLayoutUpdate(bool deferred)
+{
+    bool pending = this->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::LayoutPending);
+
+    if (deferred && !pending) {
+        return false; // 已被UpdateLayoutNow提前处理
+    }
+
+    uint32_t count = this->_pendingInvalidationCount;
+
+    this->_layoutUpdateCondition &= ~sw::LayoutUpdateCondition::LayoutPending;
+    this->_pendingInvalidationCount = 0;
+
+    ++_layoutUpdateStatistics.layoutPassCount;
+    _layoutUpdateStatistics.lastPassInvalidationCount = count;
+    _layoutUpdateStatistics.maxPassInvalidationCount  = (std::max)(_layoutUpdateStatistics.maxPassInvalidationCount, count);
+    return true;
+}
+
 void sw::UIElement::OnSetBackColor(Color color, bool redraw)
 {
     this->_backColor = color;
@@ -1197,8 +1300,16 @@ void sw::UIElement::ParentChanged(WndBase *newParent)
 {
     auto oldDataContext = this->CurrentDataContext.Get();
 
-    this->_parent = newParent ? newParent->ToUIElement() : nullptr;
+    this->_parent          = newParent ? newParent->ToUIElement() : nullptr;
+    this->_hasArrangedRect = false;
     this->_SetMeasureInvalidated();
+    this->InvalidateCurrentDataContext();
+
+    // 不再是根元素时，挂起的布局更新由新的根元素负责
+    if (this->_parent != nullptr) {
+        this->_layoutUpdateCondition &= ~sw::LayoutUpdateCondition::LayoutPending;
+        this->_pendingInvalidationCount = 0;
+    }
     this->WndBase::ParentChanged(newParent);
 
     if (this->CurrentDataContext != oldDataContext) {
@@ -1426,18 +1537,14 @@ bool sw::UIElement::OnColor(HDC hdc, HBRUSH &hRetBrush)
     ::SetTextColor(hdc, textColor);
     ::SetBkColor(hdc, backColor);
 
-    if (this->_lastTextColor != textColor ||
-        this->_lastBackColor != backColor) {
-        if (this->_hCtlColorBrush != NULL)
-            DeleteObject(this->_hCtlColorBrush);
-        this->_hCtlColorBrush = NULL;
-        this->_lastTextColor  = textColor;
-        this->_lastBackColor  = backColor;
+    // 返回的画刷在控件绘制期间仍会被使用，持有其引用使其不会被缓存销毁
+    if (this->_hCtlColorBrush == NULL || this->_ctlColorBrushColor != backColor) {
+        HBRUSH hBrush = BrushCache::Acquire(backColor);
+        BrushCache::Release(this->_hCtlColorBrush);
+        this->_hCtlColorBrush     = hBrush;
+        this->_ctlColorBrushColor = backColor;
     }
 
-    if (this->_hCtlColorBrush == NULL)
-        this->_hCtlColorBrush = CreateSolidBrush(backColor);
-
     hRetBrush = this->_hCtlColorBrush;
     return true;
 }
@@ -1497,6 +1604,20 @@ void sw::UIElement::_SetMeasureInvalidated()
     this->_layoutUpdateCondition |= sw::LayoutUpdateCondition::MeasureInvalidated;
 }
 
+bool sw::UIElement::_IsArrangedAt(const RECT &pxRect)
+{
+    if (!this->_hasArrangedRect ||
+        this->_lastArrangedRect.left != pxRect.left || this->_lastArrangedRect.top != pxRect.top ||
+        this->_lastArrangedRect.right != pxRect.right || this->_lastArrangedRect.bottom != pxRect.bottom) {
+        return false;
+    }
+
+    // 窗口可能在两次Arrange之间被其他方式移动或调整大小，此时仍需重新设置位置
+    sw::Rect windowRect = this->Rect;
+    return Dip::DipToPxX(windowRect.left) == pxRect.left && Dip::DipToPxY(windowRect.top) == pxRect.top &&
+           Dip::DipToPxX(windowRect.width) == pxRect.right && Dip::DipToPxY(windowRect.height) == pxRect.bottom;
+}
+
 void sw::UIElement::_UpdateLayoutVisibleChildren()
 {
     this->_layoutVisibleChildren.clear();
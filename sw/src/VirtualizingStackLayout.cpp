@@ -0,0 +1,264 @@
+#include "VirtualizingStackLayout.h"
+#include "Utils.h"
+#include <cmath>
+
+namespace
+{
+    /**
+     * @brief 获取尺寸在堆叠方向上的分量
+     */
+    double _GetAlong(const sw::Size &size, bool vertical)
+    {
+        return vertical ? size.height : size.width;
+    }
+
+    /**
+     * @brief 获取尺寸在另一方向上的分量
+     */
+    double _GetCross(const sw::Size &size, bool vertical)
+    {
+        return vertical ? size.width : size.height;
+    }
+
+    /**
+     * @brief 由堆叠方向与另一方向上的分量构造尺寸
+     */
+    sw::Size _MakeSize(double along, double cross, bool vertical)
+    {
+        return vertical ? sw::Size{cross, along} : sw::Size{along, cross};
+    }
+}
+
+sw::Size sw::VirtualizingStackLayout::MeasureOverride(const Size &availableSize)
+{
+    bool vertical = this->orientation == Orientation::Vertical;
+
+    this->_SyncItemCount();
+
+    double start  = Utils::Max(0.0, vertical ? this->_viewport.top : this->_viewport.left);
+    double length = vertical ? this->_viewport.height : this->_viewport.width;
+
+    if (length <= 0) {
+        // 尚未获得可视区域时按可用尺寸实现化，可用尺寸为无穷大时实现化全部子项
+        length = _GetAlong(availableSize, vertical);
+    }
+
+    double crossAvailable = _GetCross(availableSize, vertical);
+    this->_UpdateRealizedItems(start, length, std::isinf(crossAvailable) ? INFINITY : crossAvailable, true);
+
+    return this->GetContentExtent();
+}
+
+void sw::VirtualizingStackLayout::ArrangeOverride(const Size &finalSize)
+{
+    bool vertical = this->orientation == Orientation::Vertical;
+
+    this->_SyncItemCount();
+
+    // 最终尺寸可能大于测量时的可视区域，此时需要补充实现化新露出的子项
+    double start = Utils::Max(0.0, vertical ? this->_viewport.top : this->_viewport.left);
+    this->_UpdateRealizedItems(start, _GetAlong(finalSize, vertical), _GetCross(finalSize, vertical), false);
+
+    double crossSize = _GetCross(finalSize, vertical);
+    double position  = this->_firstRealizedOffset;
+    int realizedCount = static_cast<int>(this->_realizedItems.size());
+
+    for (int i = 0; i < realizedCount; ++i) {
+        double extent = this->_GetItemExtent(this->_firstRealized + i);
+        this->_realizedItems[i]->Arrange(vertical ? Rect{0, position, crossSize, extent} : Rect{position, 0, extent, crossSize});
+        position += extent;
+    }
+}
+
+void sw::VirtualizingStackLayout::UpdateViewport(const Rect &viewport)
+{
+    this->_viewport = viewport;
+}
+
+sw::Size sw::VirtualizingStackLayout::GetContentExtent()
+{
+    int unmeasuredCount = static_cast<int>(this->_itemExtents.size()) - this->_measuredCount;
+    double along        = this->_measuredExtentSum + unmeasuredCount * this->estimatedItemExtent;
+    return _MakeSize(along, this->_maxCrossExtent, this->orientation == Orientation::Vertical);
+}
+
+void sw::VirtualizingStackLayout::ResetItems()
+{
+    this->_RecycleAll();
+    this->_itemExtents.assign(this->_itemExtents.size(), -1);
+    this->_measuredExtentSum   = 0;
+    this->_measuredCount       = 0;
+    this->_maxCrossExtent      = 0;
+    this->_firstRealized       = 0;
+    this->_firstRealizedOffset = 0;
+}
+
+int sw::VirtualizingStackLayout::GetFirstRealizedIndex() const
+{
+    return this->_firstRealized;
+}
+
+int sw::VirtualizingStackLayout::GetRealizedCount() const
+{
+    return static_cast<int>(this->_realizedItems.size());
+}
+
+void sw::VirtualizingStackLayout::_SyncItemCount()
+{
+    int count    = this->generator == nullptr ? 0 : this->generator->GetItemCount();
+    int oldCount = static_cast<int>(this->_itemExtents.size());
+
+    if (count >= oldCount) {
+        this->_itemExtents.resize(count, -1);
+        return;
+    }
+
+    // 回收索引超出范围的子项
+    int realizedCount = static_cast<int>(this->_realizedItems.size());
+    int keepCount     = Utils::Max(0, Utils::Min(realizedCount, count - this->_firstRealized));
+
+    for (int i = keepCount; i < realizedCount && this->generator != nullptr; ++i) {
+        this->generator->RecycleItem(this->_firstRealized + i, *this->_realizedItems[i]);
+    }
+    this->_realizedItems.resize(keepCount);
+
+    for (int i = count; i < oldCount; ++i) {
+        if (this->_itemExtents[i] >= 0) {
+            this->_measuredExtentSum -= this->_itemExtents[i];
+            --this->_measuredCount;
+        }
+    }
+    this->_itemExtents.resize(count);
+
+    if (this->_realizedItems.empty()) {
+        this->_firstRealized       = 0;
+        this->_firstRealizedOffset = 0;
+    }
+}
+
+double sw::VirtualizingStackLayout::_GetItemExtent(int index) const
+{
+    double extent = this->_itemExtents[index];
+    return extent < 0 ? this->estimatedItemExtent : extent;
+}
+
+void sw::VirtualizingStackLayout::_SetItemMeasured(int index, const Size &desireSize)
+{
+    bool vertical  = this->orientation == Orientation::Vertical;
+    double &extent = this->_itemExtents[index];
+
+    if (extent < 0) {
+        ++this->_measuredCount;
+    } else {
+        this->_measuredExtentSum -= extent;
+    }
+
+    extent = _GetAlong(desireSize, vertical);
+    this->_measuredExtentSum += extent;
+    this->_maxCrossExtent = Utils::Max(this->_maxCrossExtent, _GetCross(desireSize, vertical));
+}
+
+int sw::VirtualizingStackLayout::_LocateItem(double position, double &offset)
+{
+    int count = static_cast<int>(this->_itemExtents.size());
+
+    int index = 0;
+    double pos = 0;
+
+    // 第一个已实现化子项的位置只取决于其之前的子项，这些子项在其未实现化期间不会被重新测量，
+    // 只要估计尺寸未改变即可作为查找的起点
+    if (this->_offsetEstimate == this->estimatedItemExtent && this->_firstRealized < count) {
+        index = this->_firstRealized;
+        pos   = this->_firstRealizedOffset;
+    }
+
+    while (index > 0 && pos > position) {
+        pos -= this->_GetItemExtent(--index);
+    }
+    while (index + 1 < count && pos + this->_GetItemExtent(index) <= position) {
+        pos += this->_GetItemExtent(index++);
+    }
+
+    offset = index == 0 ? 0 : pos;
+    return index;
+}
+
+void sw::VirtualizingStackLayout::_UpdateRealizedItems(double start, double length, double crossAvailable, bool measureRealized)
+{
+    int count = static_cast<int>(this->_itemExtents.size());
+
+    if (count == 0) {
+        this->_RecycleAll();
+        return;
+    }
+
+    bool vertical = this->orientation == Orientation::Vertical;
+    double end    = start + length;
+
+    double offset;
+    int first = this->_LocateItem(start, offset);
+
+    std::vector<ILayout *> &oldItems = this->_previousItems;
+    oldItems.swap(this->_realizedItems);
+    this->_realizedItems.clear();
+    int oldFirst = this->_firstRealized;
+    int oldCount = static_cast<int>(oldItems.size());
+
+    // 先回收按当前尺寸确定位于新范围之外的子项，使随后实现化的子项可以复用这些容器
+    double position = offset;
+    for (int i = 0, index = first; i < oldCount; ++i) {
+        int oldIndex = oldFirst + i;
+        if (oldIndex > first) {
+            while (index < oldIndex) {
+                position += this->_GetItemExtent(index++);
+            }
+        }
+        if (oldIndex < first || (oldIndex > first && position >= end)) {
+            this->generator->RecycleItem(oldIndex, *oldItems[i]);
+            oldItems[i] = nullptr;
+        }
+    }
+
+    position = offset;
+
+    for (int index = first; index < count && (index == first || position < end); ++index) {
+        ILayout *item = nullptr;
+        if (index >= oldFirst && index < oldFirst + oldCount) {
+            std::swap(item, oldItems[index - oldFirst]);
+        }
+
+        bool realized = item == nullptr;
+        if (realized) {
+            item = &this->generator->RealizeItem(index);
+        }
+        if (realized || measureRealized) {
+            item->Measure(_MakeSize(INFINITY, crossAvailable, vertical));
+            this->_SetItemMeasured(index, item->GetDesireSize());
+        }
+
+        this->_realizedItems.push_back(item);
+        position += this->_GetItemExtent(index);
+    }
+
+    // 测量后尺寸变小的子项可能使原先的子项移出范围
+    for (int i = 0; i < oldCount; ++i) {
+        if (oldItems[i] != nullptr) {
+            this->generator->RecycleItem(oldFirst + i, *oldItems[i]);
+        }
+    }
+    oldItems.clear();
+
+    this->_firstRealized       = first;
+    this->_firstRealizedOffset = offset;
+    this->_offsetEstimate      = this->estimatedItemExtent;
+}
+
+void sw::VirtualizingStackLayout::_RecycleAll()
+{
+    int realizedCount = static_cast<int>(this->_realizedItems.size());
+
+    for (int i = 0; i < realizedCount && this->generator != nullptr; ++i) {
+        this->generator->RecycleItem(this->_firstRealized + i, *this->_realizedItems[i]);
+    }
+    this->_realizedItems.clear();
+}
@@ -0,0 +1,185 @@
+#include "VirtualizingStackPanel.h"
+#include "Label.h"
+
+namespace
+{
+    /**
+     * @brief 在作用域内抑制元素的InvalidateMeasure，析构时恢复
+     * @note 子元素在面板测量过程中被实现化和回收，面板正在测量，实现化的子元素随后也会被测量，
+     *       此时由子元素的属性变化触发的布局更新请求是多余的，会导致再进行一轮布局
+     */
+    class _InvalidationSuppressor
+    {
+    private:
+        sw::UIElement &_element;
+        bool _wasSupressed;
+
+    public:
+        explicit _InvalidationSuppressor(sw::UIElement &element)
+            : _element(element),
+              _wasSupressed(element.IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::Supressed))
+        {
+            element.LayoutUpdateCondition = element.LayoutUpdateCondition.Get() | sw::LayoutUpdateCondition::Supressed;
+        }
+
+        ~_InvalidationSuppressor()
+        {
+            if (!this->_wasSupressed) {
+                this->_element.LayoutUpdateCondition = this->_element.LayoutUpdateCondition.Get() & ~sw::LayoutUpdateCondition::Supressed;
+            }
+        }
+
+        _InvalidationSuppressor(const _InvalidationSuppressor &)            = delete;
+        _InvalidationSuppressor &operator=(const _InvalidationSuppressor &) = delete;
+    };
+}
+
+sw::VirtualizingStackPanel::VirtualizingStackPanel()
+    : Orientation(
+          Property<sw::Orientation>::Init(this)
+              .Getter([](VirtualizingStackPanel *self) -> sw::Orientation {
+                  return self->_virtualizingLayout.orientation;
+              })
+              .Setter([](VirtualizingStackPanel *self, sw::Orientation value) {
+                  if (self->_virtualizingLayout.orientation != value) {
+                      self->_virtualizingLayout.orientation = value;
+                      self->RaisePropertyChanged(&VirtualizingStackPanel::Orientation);
+                      self->_ResetItems();
+                  }
+              })),
+
+      EstimatedItemExtent(
+          Property<double>::Init(this)
+              .Getter([](VirtualizingStackPanel *self) -> double {
+                  return self->_virtualizingLayout.estimatedItemExtent;
+              })
+              .Setter([](VirtualizingStackPanel *self, double value) {
+                  if (self->_virtualizingLayout.estimatedItemExtent != value) {
+                      self->_virtualizingLayout.estimatedItemExtent = value;
+                      self->RaisePropertyChanged(&VirtualizingStackPanel::EstimatedItemExtent);
+                      self->InvalidateMeasure();
+                  }
+              })),
+
+      ItemsSource(
+          Property<IList *>::Init(this)
+              .Getter([](VirtualizingStackPanel *self) -> IList * {
+                  return self->_itemsSource;
+              })
+              .Setter([](VirtualizingStackPanel *self, IList *value) {
+                  if (self->_itemsSource == value) {
+                      return;
+                  }
+                  if (self->_notifyCollectionChanged != nullptr) {
+                      self->_notifyCollectionChanged->CollectionChanged -=
+                          NotifyCollectionChangedEventHandler(*self, &VirtualizingStackPanel::_CollectionChangedEventHandler);
+                  }
+                  self->_itemsSource             = value;
+                  self->_notifyCollectionChanged = dynamic_cast<INotifyCollectionChanged *>(value);
+                  if (self->_notifyCollectionChanged != nullptr) {
+                      self->_notifyCollectionChanged->CollectionChanged +=
+                          NotifyCollectionChangedEventHandler(*self, &VirtualizingStackPanel::_CollectionChangedEventHandler);
+                  }
+                  self->RaisePropertyChanged(&VirtualizingStackPanel::ItemsSource);
+                  self->_ResetItems();
+              })),
+
+      ItemContainerCount(
+          Property<int>::Init(this)
+              .Getter([](VirtualizingStackPanel *self) -> int {
+                  return static_cast<int>(self->_itemContainers.size());
+              }))
+{
+    this->_virtualizingLayout.generator = this;
+    this->_virtualizingLayout.Associate(this);
+    this->HorizontalAlignment = HorizontalAlignment::Stretch;
+    this->VerticalAlignment   = VerticalAlignment::Stretch;
+}
+
+sw::VirtualizingStackPanel::~VirtualizingStackPanel()
+{
+    if (this->_notifyCollectionChanged != nullptr) {
+        this->_notifyCollectionChanged->CollectionChanged -=
+            NotifyCollectionChangedEventHandler(*this, &VirtualizingStackPanel::_CollectionChangedEventHandler);
+    }
+
+    // 销毁子元素时可能触发布局，此时不应再创建新的子元素
+    this->_virtualizingLayout.generator = nullptr;
+    this->_recycledContainers.clear();
+    this->_itemContainers.clear();
+}
+
+int sw::VirtualizingStackPanel::GetItemCount()
+{
+    return this->_itemsSource == nullptr ? 0 : this->_itemsSource->Count();
+}
+
+sw::ILayout &sw::VirtualizingStackPanel::RealizeItem(int index)
+{
+    UIElement *container;
+    bool created = this->_recycledContainers.empty();
+
+    if (created) {
+        container = this->CreateItemContainer();
+        this->_itemContainers.emplace_back(container);
+    } else {
+        container = this->_recycledContainers.back();
+        this->_recycledContainers.pop_back();
+    }
+
+    {
+        _InvalidationSuppressor suppressPanel(*this);
+        _InvalidationSuppressor suppressContainer(*container);
+
+        if (created) {
+            this->AddChild(container);
+        }
+        this->PrepareItemContainer(*container, index, this->_itemsSource->GetVariantAt(index));
+        container->Visible = true;
+    }
+
+    // 子元素的内容可能已改变，使布局对象接下来对其重新测量
+    container->LayoutUpdateCondition = container->LayoutUpdateCondition.Get() | sw::LayoutUpdateCondition::MeasureInvalidated;
+    return *container;
+}
+
+void sw::VirtualizingStackPanel::RecycleItem(int index, ILayout &container)
+{
+    UIElement &element = static_cast<UIElement &>(container);
+    {
+        _InvalidationSuppressor suppressPanel(*this);
+        _InvalidationSuppressor suppressElement(element);
+        element.Visible = false;
+    }
+    this->_recycledContainers.push_back(&element);
+}
+
+sw::LayoutHost *sw::VirtualizingStackPanel::GetDefaultLayout()
+{
+    return &this->_virtualizingLayout;
+}
+
+sw::UIElement *sw::VirtualizingStackPanel::CreateItemContainer()
+{
+    return new Label;
+}
+
+void sw::VirtualizingStackPanel::PrepareItemContainer(UIElement &container, int index, const Variant &item)
+{
+    if (item.IsType<std::wstring>()) {
+        container.Text = item.UnsafeCast<std::wstring>();
+    }
+}
+
+void sw::VirtualizingStackPanel::_ResetItems()
+{
+    this->_virtualizingLayout.ResetItems();
+    this->InvalidateMeasure();
+}
+
+void sw::VirtualizingStackPanel::_CollectionChangedEventHandler(
+    INotifyCollectionChanged &sender, NotifyCollectionChangedEventArgs &args)
+{
+    // 项的增删会改变其后所有项的索引，这里统一回收后重新实现化可视区域内的项
+    this->_ResetItems();
+}
@@ -1,5 +1,6 @@
 #include "Window.h"
 #include "App.h"
+#include "BrushCache.h"
 #include "Menu.h"
 #include "Screen.h"
 #include "Utils.h"
@@ -315,7 +316,8 @@ LRESULT sw::Window::WndProc(ProcMsg &refMsg)
         }
 
         case WM_UpdateLayout: {
-            if (!_isDestroying && !_IsLayoutDisabled()) {
+            if (AcceptLayoutUpdate(refMsg.wParam != FALSE) &&
+                !_isDestroying && !_IsLayoutDisabled()) {
                 UpdateLayout();
             }
             return 0;
@@ -386,11 +388,10 @@ bool sw::Window::OnPaint()
         ps.rcPaint.top < ps.rcPaint.bottom) //
     {
         auto color    = static_cast<COLORREF>(GetRealBackColor());
-        HBRUSH hBrush = CreateSolidBrush(color);
+        HBRUSH hBrush = BrushCache::GetBrush(color);
 
         if (hBrush != NULL) {
             FillRect(hdc, &ps.rcPaint, hBrush);
-            DeleteObject(hBrush);
         }
     }
 
@@ -607,6 +608,8 @@ bool sw::Window::EnableLayout(bool reset)
         RaisePropertyChanged(&Window::IsLayoutDisabled);
     }
     if (!newValue) {
+        // 立即更新布局，清除挂起的布局更新使已投递的WM_UpdateLayout消息被忽略
+        AcceptLayoutUpdate(false);
         UpdateLayout();
     }
     return true;
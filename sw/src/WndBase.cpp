@@ -2,6 +2,9 @@
 #include "App.h"
 #include "Cursor.h"
 #include "Dip.h"
+#include "Dispatcher.h"
+#include "FontCache.h"
+#include "WndBaseTable.h"
 #include "WndMsg.h"
 #include <atomic>
 
@@ -310,9 +313,7 @@ sw::WndBase::~WndBase()
     if (this->_hwnd != NULL && !this->_isDestroyed) {
         DestroyWindow(this->_hwnd);
     }
-    if (this->_hfont != NULL) {
-        DeleteObject(this->_hfont);
-    }
+    FontCache::Release(this->_hfont);
 
     // 将_check字段置零，标记当前对象无效
     const_cast<uint32_t &>(this->_check) = 0;
@@ -1195,10 +1196,11 @@ void sw::WndBase::Update()
 
 void sw::WndBase::UpdateFont()
 {
-    if (this->_hfont != NULL) {
-        DeleteObject(this->_hfont);
-    }
-    this->_hfont = this->_font.CreateHandle();
+    // 先获取新句柄再释放旧句柄，字体未改变时可直接复用缓存中的同一个句柄
+    HFONT hfont = FontCache::Acquire(this->_font);
+    FontCache::Release(this->_hfont);
+
+    this->_hfont = hfont;
     this->SendMessageW(WM_SETFONT, (WPARAM)this->_hfont, TRUE);
     this->FontChanged(this->_hfont);
 }
@@ -1319,11 +1321,24 @@ void sw::WndBase::Invoke(const Action<> &action)
 }
 
 bool sw::WndBase::InvokeAsync(const Action<> &action)
+{
+    return this->InvokeAsync(action, DispatcherPriority::Render);
+}
+
+bool sw::WndBase::InvokeAsync(const Action<> &action, DispatcherPriority priority, uint64_t key)
 {
     bool result;
 
     if (action == nullptr) {
         result = false;
+    } else if (auto dispatcher = Dispatcher::FromThread(this->GetThreadId())) {
+        // 调度器中的任务不随窗口销毁，执行前检查窗口是否仍然有效
+        HWND hwnd = this->_hwnd;
+        result    = dispatcher->BeginInvoke(
+            [this, hwnd, action]() {
+                if (WndBase::GetWndBase(hwnd) == this) action();
+            },
+            priority, key);
     } else {
         auto *p = new Action<>(action);
 
@@ -1363,7 +1378,13 @@ sw::WndBase *sw::WndBase::GetWndBase(HWND hwnd) noexcept
     } _atom;
     // clang-format on
 
-    auto p = reinterpret_cast<WndBase *>(GetProp(hwnd, MAKEINTATOM(_atom.value)));
+    // 当前线程创建的窗口先查线程内的表，避免每条消息都遍历窗口属性列表
+    WndBase *p = WndBaseTable::_GetCurrent().Find(hwnd);
+    if (p != nullptr && p->_check == _WndBaseMagicNumber && p->_hwnd == hwnd) {
+        return p;
+    }
+
+    p = reinterpret_cast<WndBase *>(GetProp(hwnd, MAKEINTATOM(_atom.value)));
     return (p == nullptr || p->_check != _WndBaseMagicNumber) ? nullptr : p;
 }
 
@@ -1378,7 +1399,12 @@ LRESULT sw::WndBase::_WndProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam
 
     if (pThis != nullptr) {
         ProcMsg msg{hwnd, uMsg, wParam, lParam};
-        return pThis->WndProc(msg);
+        LRESULT result = pThis->WndProc(msg);
+        if (uMsg == WM_NCDESTROY) {
+            // 窗口句柄已失效，之后可能被复用，需要从表中移除
+            WndBaseTable::_GetCurrent().Remove(hwnd);
+        }
+        return result;
     } else {
         return DefWindowProcW(hwnd, uMsg, wParam, lParam);
     }
@@ -1488,4 +1514,9 @@ int sw::WndBase::_NextControlId()
 void sw::WndBase::_SetWndBase(HWND hwnd, WndBase &wnd)
 {
     SetPropW(hwnd, _WndBasePtrProp, reinterpret_cast<HANDLE>(&wnd));
+
+    // 线程内的表只记录当前线程的窗口，其他线程的窗口在销毁时无法从当前线程的表中移除
+    if (GetWindowThreadProcessId(hwnd, NULL) == GetCurrentThreadId()) {
+        WndBaseTable::_GetCurrent().Set(hwnd, &wnd);
+    }
 }
@@ -0,0 +1,104 @@
+#include "WndBaseTable.h"
+#include <cstdint>
+#include <utility>
+
+constexpr size_t sw::WndBaseTable::InitialCapacity;
+
+sw::WndBase *sw::WndBaseTable::Find(HWND hwnd) const noexcept
+{
+    if (hwnd == NULL || this->_count == 0) {
+        return nullptr;
+    }
+    return this->_slots[this->_Probe(hwnd)].wnd;
+}
+
+void sw::WndBaseTable::Set(HWND hwnd, WndBase *wnd)
+{
+    if (hwnd == NULL) {
+        return;
+    }
+
+    // 负载因子不超过1/2，保证探测总能遇到空位且探测序列较短
+    if ((this->_count + 1) * 2 > this->_slots.size()) {
+        this->_Rehash(this->_slots.empty() ? InitialCapacity : this->_slots.size() * 2);
+    }
+
+    _Slot &slot = this->_slots[this->_Probe(hwnd)];
+    if (slot.hwnd == NULL) {
+        slot.hwnd = hwnd;
+        ++this->_count;
+    }
+    slot.wnd = wnd;
+}
+
+void sw::WndBaseTable::Remove(HWND hwnd) noexcept
+{
+    if (hwnd == NULL || this->_count == 0) {
+        return;
+    }
+
+    std::vector<_Slot> &slots = this->_slots;
+
+    size_t mask = slots.size() - 1;
+    size_t hole = this->_Probe(hwnd);
+
+    if (slots[hole].hwnd == NULL) {
+        return;
+    }
+
+    // 向后移动同一探测序列上的后续项填补空位，避免使用删除标记
+    for (size_t i = (hole + 1) & mask; slots[i].hwnd != NULL; i = (i + 1) & mask) {
+        size_t home = _Hash(slots[i].hwnd) & mask;
+
+        // 理想位置位于(hole, i]之间的项无需移动
+        bool stay = hole <= i ? (hole < home && home <= i) : (hole < home || home <= i);
+        if (!stay) {
+            slots[hole] = slots[i];
+            hole        = i;
+        }
+    }
+
+    slots[hole] = _Slot{};
+    --this->_count;
+}
+
+size_t sw::WndBaseTable::GetCount() const noexcept
+{
+    return this->_count;
+}
+
+sw::WndBaseTable &sw::WndBaseTable::_GetCurrent() noexcept
+{
+    static thread_local WndBaseTable table;
+    return table;
+}
+
+size_t sw::WndBaseTable::_Hash(HWND hwnd) noexcept
+{
+    // 句柄值的低位变化较少，乘以黄金分割常数后取高位
+    uint64_t value = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(hwnd));
+    return static_cast<size_t>((value * 0x9e3779b97f4a7c15ull) >> 32);
+}
+
+size_t sw::WndBaseTable::_Probe(HWND hwnd) const noexcept
+{
+    size_t mask = _slots.size() - 1;
+    size_t i    = _Hash(hwnd) & mask;
+
+    while (_slots[i].hwnd != NULL && _slots[i].hwnd != hwnd) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+void sw::WndBaseTable::_Rehash(size_t capacity)
+{
+    std::vector<_Slot> oldSlots(capacity);
+    std::swap(_slots, oldSlots);
+
+    for (const _Slot &slot : oldSlots) {
+        if (slot.hwnd != NULL) {
+            _slots[_Probe(slot.hwnd)] = slot;
+        }
+    }
+}
@@ -1,39 +1,41 @@
 #include "WrapLayout.h"
 #include "Utils.h"
 #include <cmath>
-#include <tuple>
-#include <vector>
 
 namespace
 {
     /**
      * @brief 按行高统一安排一行中的所有子元素，使行内元素占用相同的垂直布局空间
+     * @param begin 该行第一个子元素的索引
+     * @param end 该行最后一个子元素之后的索引
      */
     void _WrapLayoutArrangeRow(
-        double top, double height, const std::vector<std::tuple<sw::ILayout *, sw::Size>> &row)
+        sw::LayoutHost *self, int begin, int end, double top, double height)
     {
         double left = 0;
 
-        for (auto &tuple : row) {
-            sw::ILayout *item = std::get<0>(tuple);
-            sw::Size itemSize = std::get<1>(tuple);
-            item->Arrange(sw::Rect{left, top, itemSize.width, height});
+        for (int i = begin; i < end; ++i) {
+            sw::ILayout &item = self->GetChildLayoutAt(i);
+            sw::Size itemSize = item.GetDesireSize();
+            item.Arrange(sw::Rect{left, top, itemSize.width, height});
             left += itemSize.width;
         }
     }
 
     /**
      * @brief 按列宽统一安排一列中的所有子元素，使列内元素占用相同的水平布局空间
+     * @param begin 该列第一个子元素的索引
+     * @param end 该列最后一个子元素之后的索引
      */
     void _WrapLayoutArrangeCol(
-        double left, double width, const std::vector<std::tuple<sw::ILayout *, sw::Size>> &col)
+        sw::LayoutHost *self, int begin, int end, double left, double width)
     {
         double top = 0;
 
-        for (auto &tuple : col) {
-            sw::ILayout *item = std::get<0>(tuple);
-            sw::Size itemSize = std::get<1>(tuple);
-            item->Arrange(sw::Rect{left, top, width, itemSize.height});
+        for (int i = begin; i < end; ++i) {
+            sw::ILayout &item = self->GetChildLayoutAt(i);
+            sw::Size itemSize = item.GetDesireSize();
+            item.Arrange(sw::Rect{left, top, width, itemSize.height});
             top += itemSize.height;
         }
     }
@@ -90,33 +92,29 @@ namespace
         double rowWidth  = 0;
         double rowHeight = 0;
 
-        int count = self->GetChildLayoutCount();
-
-        std::vector<std::tuple<sw::ILayout *, sw::Size>> row;
-        row.reserve(count);
+        int count    = self->GetChildLayoutCount();
+        int rowBegin = 0; // 当前行第一个子元素的索引
 
+        // 行内的子元素是连续的，只记录行的起始索引，排列时再次获取子元素及其尺寸，无需额外分配内存
         for (int i = 0; i < count; ++i) {
-            sw::ILayout &item       = self->GetChildLayoutAt(i);
-            sw::Size itemDesireSize = item.GetDesireSize();
+            sw::Size itemDesireSize = self->GetChildLayoutAt(i).GetDesireSize();
 
             if (rowWidth + itemDesireSize.width <= finalSize.width) {
-                row.emplace_back(&item, itemDesireSize);
                 rowWidth += itemDesireSize.width;
                 rowHeight = sw::Utils::Max(rowHeight, itemDesireSize.height);
             } else {
-                if (!row.empty()) {
-                    _WrapLayoutArrangeRow(top, rowHeight, row);
+                if (rowBegin < i) {
+                    _WrapLayoutArrangeRow(self, rowBegin, i, top, rowHeight);
                 }
-                row.clear();
-                row.emplace_back(&item, itemDesireSize);
+                rowBegin = i;
                 top += rowHeight;
                 rowWidth  = itemDesireSize.width;
                 rowHeight = itemDesireSize.height;
             }
         }
 
-        if (!row.empty()) {
-            _WrapLayoutArrangeRow(top, rowHeight, row);
+        if (rowBegin < count) {
+            _WrapLayoutArrangeRow(self, rowBegin, count, top, rowHeight);
         }
     }
 
@@ -172,33 +170,29 @@ namespace
         double colHeight = 0;
         double colWidth  = 0;
 
-        int count = self->GetChildLayoutCount();
-
-        std::vector<std::tuple<sw::ILayout *, sw::Size>> col;
-        col.reserve(count);
+        int count    = self->GetChildLayoutCount();
+        int colBegin = 0; // 当前列第一个子元素的索引
 
+        // 列内的子元素是连续的，只记录列的起始索引，排列时再次获取子元素及其尺寸，无需额外分配内存
         for (int i = 0; i < count; ++i) {
-            sw::ILayout &item       = self->GetChildLayoutAt(i);
-            sw::Size itemDesireSize = item.GetDesireSize();
+            sw::Size itemDesireSize = self->GetChildLayoutAt(i).GetDesireSize();
 
             if (colHeight + itemDesireSize.height <= finalSize.height) {
-                col.emplace_back(&item, itemDesireSize);
                 colHeight += itemDesireSize.height;
                 colWidth = sw::Utils::Max(colWidth, itemDesireSize.width);
             } else {
-                if (!col.empty()) {
-                    _WrapLayoutArrangeCol(left, colWidth, col);
+                if (colBegin < i) {
+                    _WrapLayoutArrangeCol(self, colBegin, i, left, colWidth);
                 }
-                col.clear();
-                col.emplace_back(&item, itemDesireSize);
+                colBegin = i;
                 left += colWidth;
                 colHeight = itemDesireSize.height;
                 colWidth  = itemDesireSize.width;
             }
         }
 
-        if (!col.empty()) {
-            _WrapLayoutArrangeCol(left, colWidth, col);
+        if (colBegin < count) {
+            _WrapLayoutArrangeCol(self, colBegin, count, left, colWidth);
         }
     }
 }
@@ -0,0 +1,6 @@
+#include "Bench.h"
+
+int main(int argc, char **argv)
+{
+    return swtest::bench::RunAll(argc, argv);
+}
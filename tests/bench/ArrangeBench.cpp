@@ -0,0 +1,43 @@
+#include "Bench.h"
+
+#include "Label.h"
+#include "StackPanel.h"
+#include "Window.h"
+
+#include <memory>
+#include <vector>
+
+BENCHMARK_CASE("Relayout of 1000 labels after one text change")
+{
+    const int labelCount = 1000;
+
+    sw::Window window;
+    sw::StackPanel panel;
+    window.AddChild(panel);
+
+    std::vector<std::unique_ptr<sw::Label>> labels;
+    for (int i = 0; i < labelCount; ++i) {
+        labels.emplace_back(new sw::Label);
+        labels.back()->Text = L"Label";
+        panel.AddChild(*labels.back());
+    }
+    window.UpdateLayoutNow();
+
+    // 两个文本宽度相同，修改后只有该标签及其祖先元素的测量失效，其余标签的排列结果不变
+    sw::Label &changed = *labels[labelCount / 2];
+    bool toggle        = false;
+
+    sw::UIElement::ResetLayoutUpdateStatistics();
+
+    auto &result = context.Run("Label.Text change + UpdateLayoutNow", 200, [&]() {
+        changed.Text = (toggle = !toggle) ? L"Text1" : L"Text2";
+        window.UpdateLayoutNow();
+    });
+
+    sw::LayoutUpdateStatistics stats = sw::UIElement::GetLayoutUpdateStatistics();
+    if (stats.layoutPassCount != 0) {
+        double passes = static_cast<double>(stats.layoutPassCount);
+        swtest::bench::BenchmarkContext::AddCounter(result, "skippedWindowPosPerPass", stats.skippedWindowPosCount / passes);
+        swtest::bench::BenchmarkContext::AddCounter(result, "skippedArrangeOverridePerPass", stats.skippedArrangeOverrideCount / passes);
+    }
+}
@@ -0,0 +1,104 @@
+#include "Bench.h"
+
+#include "Binding.h"
+#include "ObservableObject.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct BenchViewModel : sw::ObservableObject {
+        int value = 0;
+        int other = 0;
+
+        sw::Property<int> Value{
+            sw::Property<int>::Init(this).Getter<&BenchViewModel::value>().Setter<&BenchViewModel::SetValue>()};
+
+        sw::Property<int> Other{
+            sw::Property<int>::Init(this).Getter<&BenchViewModel::other>().Setter<&BenchViewModel::SetOther>()};
+
+        void SetValue(int newValue)
+        {
+            value = newValue;
+            RaisePropertyChanged(&BenchViewModel::Value);
+        }
+
+        void SetOther(int newValue)
+        {
+            other = newValue;
+            RaisePropertyChanged(&BenchViewModel::Other);
+        }
+
+        void Raise(sw::FieldId propertyId)
+        {
+            RaisePropertyChanged(propertyId);
+        }
+    };
+
+    /**
+     * @brief 模拟Binding的处理函数：订阅全部通知并按属性ID过滤
+     */
+    struct FilteringHandler {
+        sw::FieldId propertyId;
+        int hits = 0;
+
+        void OnPropertyChanged(sw::INotifyPropertyChanged &, sw::PropertyChangedEventArgs &e)
+        {
+            if (e.propertyId == propertyId) {
+                ++hits;
+            }
+        }
+    };
+}
+
+BENCHMARK_CASE("PropertyChanged raise cost versus subscriber count")
+{
+    for (int count : {1, 10, 100, 300, 1000}) {
+        BenchViewModel viewModel;
+        std::vector<FilteringHandler> handlers(count);
+
+        for (int i = 0; i < count; ++i) {
+            handlers[i].propertyId = sw::FieldId(static_cast<uint32_t>(i + 1));
+            viewModel.PropertyChanged += sw::PropertyChangedEventHandler(handlers[i], &FilteringHandler::OnPropertyChanged);
+        }
+        context.Run("filtered PropertyChanged, " + std::to_string(count) + " handlers", 100000, [&]() {
+            viewModel.Raise(sw::FieldId(1));
+        });
+    }
+
+    for (int count : {1, 10, 100, 300, 1000}) {
+        BenchViewModel viewModel;
+        std::vector<FilteringHandler> handlers(count);
+
+        for (int i = 0; i < count; ++i) {
+            handlers[i].propertyId = sw::FieldId(static_cast<uint32_t>(i + 1));
+            viewModel.AddPropertyChangedHandler(
+                handlers[i].propertyId, sw::PropertyChangedEventHandler(handlers[i], &FilteringHandler::OnPropertyChanged));
+        }
+        context.Run("per-property table, " + std::to_string(count) + " handlers", 100000, [&]() {
+            viewModel.Raise(sw::FieldId(1));
+        });
+    }
+}
+
+BENCHMARK_CASE("Binding notification cost versus unrelated binding count")
+{
+    for (int count : {1, 10, 100, 300, 1000}) {
+        BenchViewModel source;
+        std::vector<std::unique_ptr<BenchViewModel>> targets;
+        std::vector<std::unique_ptr<sw::Binding>> bindings;
+
+        for (int i = 0; i < count; ++i) {
+            targets.emplace_back(new BenchViewModel);
+            bindings.emplace_back(sw::Binding::Create(
+                targets.back().get(), &BenchViewModel::Value, &source, &BenchViewModel::Other, sw::BindingMode::OneWay));
+        }
+
+        int next = 0;
+        context.Run("raise unbound property, " + std::to_string(count) + " bindings", 100000, [&]() {
+            source.Value = ++next;
+        });
+    }
+}
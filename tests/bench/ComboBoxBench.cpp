@@ -0,0 +1,38 @@
+#include "Bench.h"
+
+#include "ComboBox.h"
+#include "Window.h"
+
+#include <string>
+
+namespace
+{
+    /**
+     * @brief 测量将组合框绑定到含有100000个零件编号的数据源所需的时间
+     */
+    void RunBind(swtest::bench::BenchmarkContext &context, const std::string &scenario, bool virtualMode)
+    {
+        const int itemCount = 100000;
+
+        sw::ObservableCollection<std::wstring> parts;
+        for (int i = 0; i < itemCount; ++i) {
+            parts.Add(L"PN-" + std::to_wstring(1000000 + i));
+        }
+
+        sw::Window window;
+        sw::ComboBox comboBox;
+        window.AddChild(comboBox);
+        comboBox.VirtualMode = virtualMode;
+
+        context.Run(scenario, 5, [&]() {
+            comboBox.ItemsSource = &parts;
+            comboBox.ItemsSource = nullptr;
+        });
+    }
+}
+
+BENCHMARK_CASE("Bind a ComboBox to 100000 part numbers")
+{
+    RunBind(context, "CBS_HASSTRINGS", false);
+    RunBind(context, "VirtualMode", true);
+}
@@ -0,0 +1,107 @@
+#include "Bench.h"
+
+#include "DataBinding.h"
+#include "FrameworkElementTestHelpers.h"
+#include "ObservableObject.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using swtest::elementtest::TestTreeElement;
+
+    struct ContextViewModel : sw::ObservableObject {
+        int value = 0;
+
+        sw::Property<int> Value{
+            sw::Property<int>::Init(this).Getter<&ContextViewModel::value>().Setter<&ContextViewModel::SetValue>()};
+
+        void SetValue(int newValue)
+        {
+            value = newValue;
+            RaisePropertyChanged(&ContextViewModel::Value);
+        }
+    };
+
+    /**
+     * @brief 创建按完全二叉树排列的子树
+     * @param count 元素数量
+     * @param bind 为true时每个元素都通过DataBinding绑定到数据上下文，
+     *             否则每个元素仅在DataContextChanged中读取CurrentDataContext，与DataBinding的解析路径相同
+     * @param deepest 输出最深一层中的一个元素
+     */
+    std::unique_ptr<TestTreeElement> CreateTree(int count, bool bind, TestTreeElement *&deepest)
+    {
+        std::unique_ptr<TestTreeElement> root(new TestTreeElement);
+        std::vector<TestTreeElement *> elements{root.get()};
+
+        for (int i = 1; i < count; ++i) {
+            TestTreeElement *parent = elements[static_cast<size_t>((i - 1) / 2)];
+            elements.push_back(parent->AddChild(std::unique_ptr<TestTreeElement>(new TestTreeElement)));
+        }
+        for (auto element : elements) {
+            if (bind) {
+                element->AddBinding(sw::DataBinding::Create(&TestTreeElement::Value, &ContextViewModel::Value, sw::BindingMode::OneWay));
+            } else {
+                element->DataContextChanged += [](sw::FrameworkElement &sender, sw::DataContextChangedEventArgs &) {
+                    swtest::bench::DoNotOptimize(sender.CurrentDataContext.Get());
+                };
+            }
+        }
+
+        deepest = elements.back();
+        return root;
+    }
+
+    int TreeDepth(const sw::FrameworkElement *element)
+    {
+        int depth = 0;
+        for (; element != nullptr; element = element->GetParent()) {
+            ++depth;
+        }
+        return depth;
+    }
+}
+
+BENCHMARK_CASE("Attach a data-bound tree under a DataContext")
+{
+    const int count = 5000;
+
+    ContextViewModel viewModel;
+    viewModel.Value = 1;
+
+    for (bool bind : {false, true}) {
+        TestTreeElement host;
+        host.DataContext = sw::Variant::MakeRef(viewModel);
+
+        TestTreeElement *deepest = nullptr;
+        std::unique_ptr<TestTreeElement> subtree = CreateTree(count, bind, deepest);
+        TestTreeElement *subtreeRoot             = subtree.get();
+
+        const std::string kind = bind ? " DataBinding elements" : " context readers";
+
+        auto &attach = context.Run("attach and detach " + std::to_string(count) + kind, bind ? 10 : 500, [&]() {
+            host.AddChild(std::move(subtree));
+            subtree = host.RemoveChild(subtreeRoot);
+        });
+        swtest::bench::BenchmarkContext::AddCounter(attach, "elements", count);
+        swtest::bench::BenchmarkContext::AddCounter(attach, "depth", TreeDepth(deepest));
+
+        if (bind) {
+            continue;
+        }
+
+        host.AddChild(std::move(subtree));
+
+        context.Run("read CurrentDataContext at the deepest element", 1000000, [&]() {
+            swtest::bench::DoNotOptimize(deepest->CurrentDataContext.Get());
+        });
+
+        context.Run("replace DataContext above " + std::to_string(count) + kind, 500, [&]() {
+            host.DataContext = nullptr;
+            host.DataContext = sw::Variant::MakeRef(viewModel);
+        });
+    }
+}
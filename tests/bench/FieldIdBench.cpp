@@ -0,0 +1,122 @@
+#include "Bench.h"
+
+#include "ObservableObject.h"
+#include "Reflection.h"
+
+#include <cstring>
+#include <string>
+
+namespace
+{
+    /**
+     * @brief 替换前的Reflection::GetFieldId：每次调用都对函数指针与成员指针逐字节计算FNV-1a哈希
+     */
+    template <typename T, typename TField>
+    sw::FieldId LegacyFieldId(TField T::*field) noexcept
+    {
+        auto pfunc = &LegacyFieldId<T, TField>;
+
+        uint8_t buffer[sizeof(pfunc) + sizeof(field)];
+        memcpy(buffer, &pfunc, sizeof(pfunc));
+        memcpy(buffer + sizeof(pfunc), &field, sizeof(field));
+
+        uint32_t prime = 16777619u;
+        uint32_t hash  = 2166136261u;
+
+        for (size_t i = 0; i < sizeof(buffer); ++i) {
+            hash ^= static_cast<uint32_t>(buffer[i]);
+            hash *= prime;
+        }
+        return sw::FieldId{hash};
+    }
+
+    struct RaisingViewModel : sw::ObservableObject {
+        int left = 0, top = 0, width = 0, height = 0;
+
+        sw::ReadOnlyProperty<int> Left{sw::Property<int>::Init(this).Getter<&RaisingViewModel::left>()};
+        sw::ReadOnlyProperty<int> Top{sw::Property<int>::Init(this).Getter<&RaisingViewModel::top>()};
+        sw::ReadOnlyProperty<int> Width{sw::Property<int>::Init(this).Getter<&RaisingViewModel::width>()};
+        sw::ReadOnlyProperty<int> Height{sw::Property<int>::Init(this).Getter<&RaisingViewModel::height>()};
+
+        /**
+         * @brief 与WndBase处理WM_WINDOWPOSCHANGED时相同，依次通知四个属性
+         */
+        void RaiseBounds()
+        {
+            RaisePropertyChanged(&RaisingViewModel::Left);
+            RaisePropertyChanged(&RaisingViewModel::Top);
+            RaisePropertyChanged(&RaisingViewModel::Width);
+            RaisePropertyChanged(&RaisingViewModel::Height);
+        }
+
+        void RaiseBoundsLegacy()
+        {
+            RaisePropertyChanged(LegacyFieldId(&RaisingViewModel::Left));
+            RaisePropertyChanged(LegacyFieldId(&RaisingViewModel::Top));
+            RaisePropertyChanged(LegacyFieldId(&RaisingViewModel::Width));
+            RaisePropertyChanged(LegacyFieldId(&RaisingViewModel::Height));
+        }
+    };
+
+    struct BoundsHandler {
+        int hits = 0;
+
+        void OnPropertyChanged(sw::INotifyPropertyChanged &, sw::PropertyChangedEventArgs &)
+        {
+            ++hits;
+        }
+    };
+}
+
+BENCHMARK_CASE("FieldId computation per member pointer")
+{
+    // 通过volatile变量读取成员指针，使两种实现都只能在运行时计算
+    sw::ReadOnlyProperty<int> RaisingViewModel::*volatile field = &RaisingViewModel::Width;
+
+    sw::FieldId id{};
+
+    context.Run("FNV-1a over function and member pointer", 1000000, [&]() {
+        id = LegacyFieldId(field);
+        swtest::bench::DoNotOptimize(id);
+    });
+
+    context.Run("Reflection::GetFieldId", 1000000, [&]() {
+        id = sw::Reflection::GetFieldId(field);
+        swtest::bench::DoNotOptimize(id);
+    });
+}
+
+BENCHMARK_CASE("RaisePropertyChanged(&T::Prop) for four bounds properties")
+{
+    // 通过volatile函数指针调用，避免ID的计算被提到循环之外
+    void (RaisingViewModel::*volatile raiseLegacy)() = &RaisingViewModel::RaiseBoundsLegacy;
+    void (RaisingViewModel::*volatile raiseCurrent)() = &RaisingViewModel::RaiseBounds;
+
+    for (bool subscribed : {false, true}) {
+        RaisingViewModel viewModel;
+        BoundsHandler handler;
+
+        // 只订阅Width，其余三个属性的通知在查表后直接返回
+        if (subscribed) {
+            viewModel.AddPropertyChangedHandler(
+                sw::Reflection::GetFieldId(&RaisingViewModel::Width),
+                sw::PropertyChangedEventHandler(handler, &BoundsHandler::OnPropertyChanged));
+            viewModel.AddPropertyChangedHandler(
+                LegacyFieldId(&RaisingViewModel::Width),
+                sw::PropertyChangedEventHandler(handler, &BoundsHandler::OnPropertyChanged));
+        }
+
+        const std::string suffix = subscribed ? ", Width subscribed" : ", no subscribers";
+
+        auto &legacy = context.Run("hash on every raise" + suffix, 500000, [&]() {
+            (viewModel.*raiseLegacy)();
+        });
+        swtest::bench::BenchmarkContext::AddCounter(legacy, "raises", 4);
+
+        auto &current = context.Run("Reflection::GetFieldId" + suffix, 500000, [&]() {
+            (viewModel.*raiseCurrent)();
+        });
+        swtest::bench::BenchmarkContext::AddCounter(current, "raises", 4);
+        swtest::bench::DoNotOptimize(handler.hits);
+    }
+}
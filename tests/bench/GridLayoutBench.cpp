@@ -0,0 +1,163 @@
+#include "Bench.h"
+
+#include "AllocationCounter.h"
+#include "GridLayout.h"
+
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief 表单中的字段，只记录测量次数，避免RecordingLayout记录调用参数带来的额外开销
+     */
+    struct FormField : sw::ILayout {
+        uint64_t layoutTag = 0;
+        sw::Size desiredSize{};
+        int measureCount = 0;
+
+        virtual uint64_t GetLayoutTag() const override
+        {
+            return this->layoutTag;
+        }
+
+        virtual sw::Size GetDesireSize() const override
+        {
+            return this->desiredSize;
+        }
+
+        virtual int GetChildLayoutCount() const override
+        {
+            return 0;
+        }
+
+        virtual sw::ILayout &GetChildLayoutAt(int) const override
+        {
+            throw std::out_of_range("FormField has no children.");
+        }
+
+        virtual void Measure(const sw::Size &) override
+        {
+            ++this->measureCount;
+        }
+
+        virtual void Arrange(const sw::Rect &) override
+        {
+        }
+    };
+
+    /**
+     * @brief 持有表单字段的容器
+     */
+    struct FormContainer : sw::ILayout {
+        std::vector<std::unique_ptr<FormField>> fields;
+
+        virtual uint64_t GetLayoutTag() const override
+        {
+            return 0;
+        }
+
+        virtual sw::Size GetDesireSize() const override
+        {
+            return sw::Size{};
+        }
+
+        virtual int GetChildLayoutCount() const override
+        {
+            return static_cast<int>(this->fields.size());
+        }
+
+        virtual sw::ILayout &GetChildLayoutAt(int index) const override
+        {
+            return *this->fields[static_cast<size_t>(index)];
+        }
+
+        virtual void Measure(const sw::Size &) override
+        {
+        }
+
+        virtual void Arrange(const sw::Rect &) override
+        {
+        }
+    };
+
+    /**
+     * @brief 创建rows行的数据录入表单，每行依次为“标签 | 输入框”三组，标签列为AutoSize，输入框列为FillRemain
+     */
+    void CreateForm(sw::GridLayout &grid, FormContainer &container, int rows)
+    {
+        for (int i = 0; i < rows; ++i) {
+            grid.rows.Add(sw::AutoSizeGridRow());
+        }
+        for (int j = 0; j < 3; ++j) {
+            grid.columns.Add(sw::AutoSizeGridColumn());
+            grid.columns.Add(sw::FillRemainGridColumn(1));
+        }
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < 6; ++j) {
+                std::unique_ptr<FormField> field(new FormField);
+                field->layoutTag   = static_cast<uint64_t>(sw::GridLayoutTag(i, j));
+                field->desiredSize = j % 2 == 0 ? sw::Size(60, 20) : sw::Size(120, 24);
+                container.fields.emplace_back(std::move(field));
+            }
+        }
+        grid.Associate(&container);
+    }
+
+    /**
+     * @brief 模拟在输入框中输入文字：每次迭代改变一个输入框的期望尺寸后重新测量并排列整个表单
+     * @param changeStructure 为true时每次迭代还会将一个标签的布局标记在两个等价的值之间切换，
+     *                        使网格像缓存行列信息之前一样在每次测量时重新生成内部数据
+     */
+    void RunTyping(swtest::bench::BenchmarkContext &context, const std::string &scenario, bool changeStructure)
+    {
+        const int rows = 40;
+
+        sw::GridLayout grid;
+        FormContainer container;
+        CreateForm(grid, container, rows);
+
+        FormField &editor = *container.fields[1];
+        FormField &label  = *container.fields[0];
+        const uint64_t labelTags[2]{
+            static_cast<uint64_t>(sw::GridLayoutTag(0, 0, 1, 1)),
+            static_cast<uint64_t>(sw::GridLayoutTag(0, 0, 0, 0))};
+
+        int keystroke = 0;
+        auto pass     = [&]() {
+            ++keystroke;
+            editor.desiredSize.width = 120 + keystroke % 16;
+            if (changeStructure) {
+                label.layoutTag = labelTags[keystroke % 2];
+            }
+            swtest::bench::DoNotOptimize(grid.MeasureOverride(sw::Size(800, INFINITY)));
+            grid.ArrangeOverride(sw::Size(800, rows * 24.0));
+        };
+
+        auto &result = context.Run(scenario, 20000, pass);
+
+        int measures = 0;
+        for (auto &field : container.fields) {
+            field->measureCount = 0;
+        }
+        swtest::AllocationScope scope;
+        pass();
+        const size_t allocations = scope.Allocations();
+        for (auto &field : container.fields) {
+            measures += field->measureCount;
+        }
+
+        swtest::bench::BenchmarkContext::AddCounter(result, "children", static_cast<double>(container.fields.size()));
+        swtest::bench::BenchmarkContext::AddCounter(result, "child measures/pass", static_cast<double>(measures));
+        swtest::bench::BenchmarkContext::AddCounter(result, "allocations/pass", static_cast<double>(allocations));
+    }
+}
+
+BENCHMARK_CASE("GridLayout re-measures a 40x6 form on every keystroke")
+{
+    RunTyping(context, "structure changed every pass", true);
+    RunTyping(context, "only desired size changed", false);
+}
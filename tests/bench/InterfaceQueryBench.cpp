@@ -0,0 +1,86 @@
+#include "Bench.h"
+
+#include "ObservableObject.h"
+
+#include <memory>
+#include <string>
+
+namespace
+{
+    /**
+     * @brief 模拟UIElement等类型额外实现的接口（ITag、ILayout、IToString等），使RTTI继承树更宽
+     */
+    template <int N>
+    struct SideInterface {
+        virtual ~SideInterface() = default;
+
+        virtual int GetLevel() const
+        {
+            return N;
+        }
+    };
+
+    /**
+     * @brief 模拟ObservableObject -> FrameworkElement -> WndBase -> UIElement -> Control -> ...的继承链，
+     *        每一层额外实现一个接口
+     */
+    template <int N>
+    struct HierarchyLevel : HierarchyLevel<N - 1>, SideInterface<N> {
+    };
+
+    template <>
+    struct HierarchyLevel<0> : sw::ObservableObject {
+    };
+
+    template <int Depth>
+    void RunQueries(swtest::bench::BenchmarkContext &context)
+    {
+        std::unique_ptr<sw::DynamicObject> object(new HierarchyLevel<Depth>);
+
+        // 通过volatile变量读取对象指针，避免编译器根据已知的动态类型直接计算转换结果
+        sw::DynamicObject *volatile p = object.get();
+
+        const std::string suffix = ", depth " + std::to_string(Depth);
+
+        sw::INotifyPropertyChanged *notifyChanged = nullptr;
+        sw::ObservableObject *observable          = nullptr;
+        sw::INotifyObjectDead *notifyDead         = nullptr;
+
+        context.Run("dynamic_cast<INotifyPropertyChanged *>" + suffix, 1000000, [&]() {
+            notifyChanged = dynamic_cast<sw::INotifyPropertyChanged *>(p);
+            swtest::bench::DoNotOptimize(notifyChanged);
+        });
+
+        context.Run("IsType<INotifyPropertyChanged>" + suffix, 1000000, [&]() {
+            p->IsType(&notifyChanged);
+            swtest::bench::DoNotOptimize(notifyChanged);
+        });
+
+        // 与Binding::RegisterNotifications对目标和源对象的查询相同
+        auto &legacy = context.Run("Binding queries with dynamic_cast" + suffix, 500000, [&]() {
+            for (int i = 0; i < 2; ++i) {
+                observable = dynamic_cast<sw::ObservableObject *>(p);
+                notifyDead = dynamic_cast<sw::INotifyObjectDead *>(p);
+                swtest::bench::DoNotOptimize(observable);
+                swtest::bench::DoNotOptimize(notifyDead);
+            }
+        });
+        swtest::bench::BenchmarkContext::AddCounter(legacy, "queries", 4);
+
+        auto &current = context.Run("Binding queries with IsType" + suffix, 500000, [&]() {
+            for (int i = 0; i < 2; ++i) {
+                p->IsType(&observable);
+                p->IsType(&notifyDead);
+                swtest::bench::DoNotOptimize(observable);
+                swtest::bench::DoNotOptimize(notifyDead);
+            }
+        });
+        swtest::bench::BenchmarkContext::AddCounter(current, "queries", 4);
+    }
+}
+
+BENCHMARK_CASE("Interface queries on a deep UIElement-like hierarchy")
+{
+    RunQueries<1>(context);
+    RunQueries<8>(context);
+}
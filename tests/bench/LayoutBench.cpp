@@ -0,0 +1,391 @@
+#include "Bench.h"
+
+#include "AllocationCounter.h"
+#include "LayoutTestHelpers.h"
+
+#include "CanvasLayout.h"
+#include "DockLayout.h"
+#include "FillLayout.h"
+#include "GridLayout.h"
+#include "StackLayout.h"
+#include "UniformGridLayout.h"
+#include "WrapLayout.h"
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using swtest::bench::BenchmarkContext;
+    using swtest::bench::BenchmarkResult;
+    using swtest::layouttest::ContainerLayout;
+    using swtest::layouttest::RecordingLayout;
+
+    /**
+     * @brief 各场景的子元素数量
+     */
+    const int ChildCounts[] = {1000, 10000, 100000};
+
+    /**
+     * @brief 布局的可用尺寸
+     */
+    const sw::Size AvailableSize(1920, 1080);
+
+    /**
+     * @brief 深树中每条嵌套链的深度
+     */
+    const int ChainDepth = 1000;
+
+    /**
+     * @brief 根据元素数量计算迭代次数，使每个场景处理的元素总数大致相同
+     */
+    uint64_t IterationsFor(int children)
+    {
+        const int totalVisits = 5000000;
+        return static_cast<uint64_t>(children < totalVisits ? totalVisits / children : 1);
+    }
+
+    /**
+     * @brief 由索引生成的伪随机数，保证每次运行的子元素尺寸相同
+     */
+    uint32_t Hash(int index)
+    {
+        uint32_t x = static_cast<uint32_t>(index) * 2654435761u + 0x9e3779b9u;
+        x ^= x >> 15;
+        x *= 0x2c1b3c6du;
+        x ^= x >> 12;
+        return x;
+    }
+
+    /**
+     * @brief 统一的子元素尺寸
+     */
+    sw::Size UniformSize(int)
+    {
+        return sw::Size(40, 20);
+    }
+
+    /**
+     * @brief 宽10~89、高8~39不等的子元素尺寸
+     */
+    sw::Size VaryingSize(int index)
+    {
+        uint32_t h = Hash(index);
+        return sw::Size(10 + h % 80, 8 + (h >> 8) % 32);
+    }
+
+    /**
+     * @brief 不设置布局标记
+     */
+    uint64_t NoTag(int)
+    {
+        return 0;
+    }
+
+    /**
+     * @brief 为一次测量和排列的结果附加计数指标
+     * @param children 参与布局的元素数量
+     * @param allocations 单次调用中的堆分配次数
+     */
+    void AddCounters(BenchmarkResult &result, int children, size_t allocations)
+    {
+        BenchmarkContext::AddCounter(result, "children", static_cast<double>(children));
+        BenchmarkContext::AddCounter(result, "ns/child", result.nsPerIteration / children);
+        BenchmarkContext::AddCounter(result, "allocations/pass", static_cast<double>(allocations));
+    }
+
+    /**
+     * @brief 分别测量host的MeasureOverride和ArrangeOverride，场景名称后附加“measure”或“arrange”
+     * @param children 参与布局的元素数量，用于计算迭代次数和ns/child
+     */
+    void RunPasses(BenchmarkContext &context, const std::string &scenario, sw::LayoutHost &host, int children)
+    {
+        const uint64_t iterations = IterationsFor(children);
+
+        // 首次布局会生成布局对象的内部缓存，不计入统计
+        host.MeasureOverride(AvailableSize);
+        host.ArrangeOverride(AvailableSize);
+
+        sw::Size desiredSize;
+        auto &measure = context.Run(scenario + ", measure", iterations, [&]() {
+            desiredSize = host.MeasureOverride(AvailableSize);
+        });
+        swtest::bench::DoNotOptimize(desiredSize);
+
+        size_t measureAllocations;
+        {
+            swtest::AllocationScope scope;
+            host.MeasureOverride(AvailableSize);
+            measureAllocations = scope.Allocations();
+        }
+        AddCounters(measure, children, measureAllocations);
+
+        auto &arrange = context.Run(scenario + ", arrange", iterations, [&]() {
+            host.ArrangeOverride(AvailableSize);
+        });
+
+        size_t arrangeAllocations;
+        {
+            swtest::AllocationScope scope;
+            host.ArrangeOverride(AvailableSize);
+            arrangeAllocations = scope.Allocations();
+        }
+        AddCounters(arrange, children, arrangeAllocations);
+    }
+
+    /**
+     * @brief 对一层子元素的布局在各元素数量下运行测量和排列
+     * @param setup 创建子元素前对布局对象的设置，参数为布局对象和子元素数量
+     * @param sizeOf 子元素测量结果
+     * @param tagOf 子元素布局标记
+     */
+    template <typename TLayout, typename TSetup, typename TSizeOf, typename TTagOf>
+    void RunFlat(BenchmarkContext &context, const std::string &name, TSetup setup, TSizeOf sizeOf, TTagOf tagOf)
+    {
+        for (int count : ChildCounts) {
+            ContainerLayout container;
+            TLayout host;
+            host.Associate(&container);
+            setup(host, count);
+
+            for (int i = 0; i < count; ++i) {
+                RecordingLayout &child = container.EmplaceChild("child", sizeOf(i), tagOf(i));
+                child.recordHistory    = false;
+            }
+
+            RunPasses(context, name + ", " + std::to_string(count) + " children", host, count);
+        }
+    }
+
+    /**
+     * @brief 设置网格为columns列、按子元素数量确定行数，行列均使用TRow/TColumn创建
+     */
+    template <typename TRow, typename TColumn>
+    void SetupGrid(sw::GridLayout &grid, int count, TRow row, TColumn column)
+    {
+        const int columns = 10;
+        for (int i = 0; i < columns; ++i) {
+            grid.columns.Add(column());
+        }
+        for (int i = 0; i < (count + columns - 1) / columns; ++i) {
+            grid.rows.Add(row());
+        }
+    }
+
+    /**
+     * @brief 十列网格中子元素的布局标记
+     */
+    uint64_t GridTag(int index)
+    {
+        return sw::GridLayoutTag(index / 10, index % 10);
+    }
+
+    /**
+     * @brief 使用StackLayout排列子元素的面板，用于构造嵌套的元素树
+     */
+    struct PanelLayout : sw::ILayout {
+        sw::StackLayout layout;
+        std::vector<std::unique_ptr<sw::ILayout>> children;
+        sw::Size desiredSize{};
+
+        PanelLayout()
+        {
+            this->layout.Associate(this);
+        }
+
+        virtual uint64_t GetLayoutTag() const override
+        {
+            return 0;
+        }
+
+        virtual sw::Size GetDesireSize() const override
+        {
+            return this->desiredSize;
+        }
+
+        virtual int GetChildLayoutCount() const override
+        {
+            return static_cast<int>(this->children.size());
+        }
+
+        virtual sw::ILayout &GetChildLayoutAt(int index) const override
+        {
+            return *this->children[static_cast<size_t>(index)];
+        }
+
+        virtual void Measure(const sw::Size &availableSize) override
+        {
+            this->desiredSize = this->layout.MeasureOverride(availableSize);
+        }
+
+        virtual void Arrange(const sw::Rect &finalPosition) override
+        {
+            this->layout.ArrangeOverride(sw::Size(finalPosition.width, finalPosition.height));
+        }
+
+        /**
+         * @brief 添加一个叶子元素
+         */
+        void AddLeaf(int index)
+        {
+            std::unique_ptr<RecordingLayout> leaf(new RecordingLayout("leaf", VaryingSize(index)));
+            leaf->recordHistory = false;
+            this->children.emplace_back(std::move(leaf));
+        }
+
+        /**
+         * @brief 添加一个子面板
+         */
+        PanelLayout &AddPanel()
+        {
+            PanelLayout *panel = new PanelLayout;
+            this->children.emplace_back(panel);
+            return *panel;
+        }
+    };
+
+    /**
+     * @brief 在panel下构造每层10个子元素、共leafCount个叶子的树
+     * @return 新增的元素数量
+     */
+    int BuildBalanced(PanelLayout &panel, int leafCount)
+    {
+        if (leafCount <= 10) {
+            for (int i = 0; i < leafCount; ++i) panel.AddLeaf(i);
+            return leafCount;
+        }
+        int added = 0;
+        for (int i = 0; i < 10; ++i) {
+            added += 1 + BuildBalanced(panel.AddPanel(), leafCount / 10);
+        }
+        return added;
+    }
+
+    /**
+     * @brief 在panel下构造若干条深度为ChainDepth的嵌套链，每条链的末端为一个叶子元素
+     * @return 新增的元素数量
+     */
+    int BuildDeep(PanelLayout &panel, int count)
+    {
+        int added = 0;
+        for (int chain = 0; chain < count / ChainDepth; ++chain) {
+            PanelLayout *current = &panel.AddPanel();
+            for (int depth = 2; depth < ChainDepth; ++depth) {
+                current = &current->AddPanel();
+            }
+            current->AddLeaf(chain);
+            added += ChainDepth;
+        }
+        return added;
+    }
+}
+
+BENCHMARK_CASE("StackLayout measure and arrange")
+{
+    RunFlat<sw::StackLayout>(
+        context, "vertical",
+        [](sw::StackLayout &host, int) { host.orientation = sw::Orientation::Vertical; }, VaryingSize, NoTag);
+    RunFlat<sw::StackLayout>(
+        context, "horizontal",
+        [](sw::StackLayout &host, int) { host.orientation = sw::Orientation::Horizontal; }, VaryingSize, NoTag);
+}
+
+BENCHMARK_CASE("WrapLayout measure and arrange")
+{
+    RunFlat<sw::WrapLayout>(
+        context, "horizontal, uniform items",
+        [](sw::WrapLayout &host, int) { host.orientation = sw::Orientation::Horizontal; }, UniformSize, NoTag);
+    RunFlat<sw::WrapLayout>(
+        context, "horizontal, varying items",
+        [](sw::WrapLayout &host, int) { host.orientation = sw::Orientation::Horizontal; }, VaryingSize, NoTag);
+    RunFlat<sw::WrapLayout>(
+        context, "vertical, varying items",
+        [](sw::WrapLayout &host, int) { host.orientation = sw::Orientation::Vertical; }, VaryingSize, NoTag);
+}
+
+BENCHMARK_CASE("GridLayout measure and arrange")
+{
+    RunFlat<sw::GridLayout>(
+        context, "auto rows and columns",
+        [](sw::GridLayout &host, int count) {
+            SetupGrid(host, count, []() { return sw::AutoSizeGridRow(); }, []() { return sw::AutoSizeGridColumn(); });
+        },
+        VaryingSize, GridTag);
+    RunFlat<sw::GridLayout>(
+        context, "fixed rows and columns",
+        [](sw::GridLayout &host, int count) {
+            SetupGrid(host, count, []() { return sw::FixSizeGridRow(24); }, []() { return sw::FixSizeGridColumn(100); });
+        },
+        VaryingSize, GridTag);
+    RunFlat<sw::GridLayout>(
+        context, "star rows and columns",
+        [](sw::GridLayout &host, int count) {
+            SetupGrid(host, count, []() { return sw::FillRemainGridRow(1); }, []() { return sw::FillRemainGridColumn(1); });
+        },
+        VaryingSize, GridTag);
+}
+
+BENCHMARK_CASE("DockLayout measure and arrange")
+{
+    RunFlat<sw::DockLayout>(
+        context, "cycling dock sides",
+        [](sw::DockLayout &, int) {}, VaryingSize, [](int i) -> uint64_t { return i % 4; });
+}
+
+BENCHMARK_CASE("UniformGridLayout measure and arrange")
+{
+    RunFlat<sw::UniformGridLayout>(
+        context, "square grid",
+        [](sw::UniformGridLayout &host, int count) {
+            host.columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+            host.rows    = (count + host.columns - 1) / host.columns;
+        },
+        VaryingSize, NoTag);
+}
+
+BENCHMARK_CASE("CanvasLayout measure and arrange")
+{
+    RunFlat<sw::CanvasLayout>(
+        context, "scattered positions",
+        [](sw::CanvasLayout &, int) {}, VaryingSize,
+        [](int i) -> uint64_t {
+            uint32_t h = Hash(i);
+            return sw::CanvasLayoutTag(static_cast<float>(h % 1920), static_cast<float>((h >> 12) % 1080));
+        });
+}
+
+BENCHMARK_CASE("FillLayout measure and arrange")
+{
+    RunFlat<sw::FillLayout>(context, "overlapping children", [](sw::FillLayout &, int) {}, VaryingSize, NoTag);
+}
+
+BENCHMARK_CASE("Nested StackLayout trees measure and arrange")
+{
+    for (int count : ChildCounts) {
+        const std::string leaves = ", " + std::to_string(count) + " leaves";
+
+        // 宽树：所有叶子直接位于根面板下
+        {
+            PanelLayout root;
+            for (int i = 0; i < count; ++i) root.AddLeaf(i);
+            RunPasses(context, "wide" + leaves, root.layout, count);
+        }
+
+        // 平衡树：每个面板有10个子元素
+        {
+            PanelLayout root;
+            int children = BuildBalanced(root, count);
+            RunPasses(context, "balanced, fan-out 10" + leaves, root.layout, children);
+        }
+
+        // 深树：根面板下为若干条深度为ChainDepth的嵌套链，每条链只有一个叶子
+        {
+            PanelLayout root;
+            int children = BuildDeep(root, count);
+            RunPasses(context, "deep, chains of depth " + std::to_string(ChainDepth) + ", " + std::to_string(children) + " elements",
+                      root.layout, children);
+        }
+    }
+}
@@ -0,0 +1,130 @@
+#include "Bench.h"
+
+#include "RoutedEventHandlerTable.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief 模拟UIElement::RaiseRoutedEvent的冒泡过程，只保留处理函数的查找与调用
+     * @tparam TStorage 每个元素记录处理函数的存储类型
+     */
+    template <typename TStorage>
+    struct BubblingElement {
+        BubblingElement *parent = nullptr;
+        TStorage handlers;
+    };
+
+    using MapElement   = BubblingElement<std::unordered_map<sw::RoutedEventType, sw::RoutedEventHandler>>;
+    using TableElement = BubblingElement<sw::RoutedEventHandlerTable>;
+
+    sw::RoutedEventHandler &AddEntry(MapElement &element, sw::RoutedEventType eventType)
+    {
+        return element.handlers[eventType];
+    }
+
+    sw::RoutedEventHandler &AddEntry(TableElement &element, sw::RoutedEventType eventType)
+    {
+        return element.handlers.GetOrAdd(eventType);
+    }
+
+    const sw::RoutedEventHandler &FindHandler(MapElement &element, sw::RoutedEventType eventType)
+    {
+        // 与替换前的实现相同，operator[]会为每个经过的元素插入空项
+        return element.handlers[eventType];
+    }
+
+    const sw::RoutedEventHandler &FindHandler(TableElement &element, sw::RoutedEventType eventType)
+    {
+        static const sw::RoutedEventHandler emptyHandler{};
+        auto handler = element.handlers.Find(eventType);
+        return handler ? *handler : emptyHandler;
+    }
+
+    size_t EntryCount(const MapElement &element)
+    {
+        return element.handlers.size();
+    }
+
+    size_t EntryCount(const TableElement &element)
+    {
+        return static_cast<size_t>(element.handlers.Count());
+    }
+
+    template <typename TElement>
+    int Bubble(TElement *element, sw::UIElement &sender, sw::RoutedEventArgs &args)
+    {
+        int visited = 0;
+        do {
+            auto &handler = FindHandler(*element, args.eventType);
+            if (handler) {
+                handler(sender, args);
+            }
+            ++visited;
+            element = element->parent;
+        } while (element != nullptr && !args.handled);
+        return visited;
+    }
+
+    /**
+     * @brief 创建指定深度的元素链，只有根元素注册了若干常用路由事件，返回最深的元素
+     */
+    template <typename TElement>
+    TElement *CreateChain(std::vector<std::unique_ptr<TElement>> &elements, int depth)
+    {
+        for (int i = 0; i < depth; ++i) {
+            elements.emplace_back(new TElement);
+            if (i > 0) {
+                elements[i]->parent = elements[i - 1].get();
+            }
+        }
+
+        sw::RoutedEventHandler handler([](sw::UIElement &, sw::RoutedEventArgs &args) {
+            swtest::bench::DoNotOptimize(args.eventType);
+        });
+        for (auto eventType : {sw::UIElement_MouseMove, sw::UIElement_KeyDown, sw::ButtonBase_Clicked,
+                               sw::Layer_Scrolling, sw::ListView_ItemClicked, sw::UIElement_SizeChanged}) {
+            AddEntry(*elements.front(), eventType) = handler;
+        }
+        return elements.back().get();
+    }
+
+    template <typename TElement>
+    void RunBubbling(swtest::bench::BenchmarkContext &context, const std::string &scenario, int depth, sw::RoutedEventType eventType)
+    {
+        // 处理函数不访问sender，这里只需提供一个引用
+        alignas(void *) static char senderStorage[sizeof(void *)];
+        auto &sender = *reinterpret_cast<sw::UIElement *>(senderStorage);
+
+        std::vector<std::unique_ptr<TElement>> elements;
+        TElement *leaf = CreateChain(elements, depth);
+
+        auto &result = context.Run(scenario, 200000, [&]() {
+            sw::RoutedEventArgs args(eventType);
+            swtest::bench::DoNotOptimize(Bubble(leaf, sender, args));
+        });
+
+        size_t entries = 0;
+        for (auto &element : elements) {
+            entries += EntryCount(*element);
+        }
+        swtest::bench::BenchmarkContext::AddCounter(result, "entries", static_cast<double>(entries));
+    }
+}
+
+BENCHMARK_CASE("Routed event bubbling through nested panels")
+{
+    for (int depth : {8, 32}) {
+        for (auto eventType : {sw::UIElement_MouseMove, sw::UIElement_MouseLeave}) {
+            const std::string suffix = ", depth " + std::to_string(depth) +
+                                       (eventType == sw::UIElement_MouseMove ? ", handler at root" : ", no handlers");
+
+            RunBubbling<MapElement>(context, "unordered_map operator[]" + suffix, depth, eventType);
+            RunBubbling<TableElement>(context, "RoutedEventHandlerTable" + suffix, depth, eventType);
+        }
+    }
+}
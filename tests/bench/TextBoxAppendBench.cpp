@@ -0,0 +1,51 @@
+#include "Bench.h"
+
+#include "TextBox.h"
+#include "Window.h"
+
+#include <string>
+
+namespace
+{
+    /**
+     * @brief 创建已有lineCount行文本的多行编辑框
+     */
+    void FillLog(sw::TextBox &textBox, int lineCount)
+    {
+        std::wstring text;
+        for (int i = 0; i < lineCount; ++i) {
+            text += L"[info] existing log line " + std::to_wstring(i) + L"\r\n";
+        }
+        textBox.MultiLine = true;
+        textBox.Text      = text;
+    }
+}
+
+BENCHMARK_CASE("Append one line to a 5000-line log TextBox")
+{
+    const int lineCount = 5000;
+
+    sw::Window window;
+
+    {
+        sw::TextBox textBox;
+        window.AddChild(textBox);
+        FillLog(textBox, lineCount);
+
+        context.Run("Text = Text + line", 200, [&]() {
+            textBox.Text = textBox.Text.Get() + L"[info] appended log line\r\n";
+        });
+    }
+
+    {
+        sw::TextBox textBox;
+        window.AddChild(textBox);
+        FillLog(textBox, lineCount);
+        textBox.MaxLineCount = lineCount;
+
+        context.Run("AppendText + FlushAppendText, MaxLineCount = 5000", 200, [&]() {
+            textBox.AppendText(L"[info] appended log line\r\n");
+            textBox.FlushAppendText();
+        });
+    }
+}
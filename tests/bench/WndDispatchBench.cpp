@@ -0,0 +1,95 @@
+#include "Bench.h"
+
+#include "Button.h"
+#include "Window.h"
+#include "WndBaseTable.h"
+
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief 与WndBase中保存对象指针的属性名称相同，WndBase通过该名称对应的原子查找属性
+     */
+    constexpr wchar_t _WndBasePtrProp[] = L"SWPROP_WndBasePtr";
+
+    /**
+     * @brief 未被任何控件处理的通知代码，WM_NOTIFY最终交给DefWindowProc
+     */
+    constexpr UINT _UnhandledNotifyCode = 0x7fff;
+
+    /**
+     * @brief 创建若干仅消息窗口，模拟窗口中的大量控件
+     */
+    std::vector<HWND> CreateMessageWindows(int count)
+    {
+        std::vector<HWND> handles;
+        for (int i = 0; i < count; ++i) {
+            handles.push_back(CreateWindowExW(0, L"STATIC", L"", 0, 0, 0, 0, 0, HWND_MESSAGE, NULL, NULL, NULL));
+        }
+        return handles;
+    }
+}
+
+BENCHMARK_CASE("HWND to WndBase lookup among 256 windows")
+{
+    const int windowCount = 256;
+
+    std::vector<HWND> handles = CreateMessageWindows(windowCount);
+
+    // 与WndBase::GetWndBase的回退路径相同，按原子而非字符串查找属性，避免每次查找都比较字符串
+    ATOM atom = GlobalAddAtomW(_WndBasePtrProp);
+
+    // 只比较查找本身，对象指针不会被解引用
+    sw::WndBaseTable table;
+    std::vector<char> objects(windowCount);
+    for (int i = 0; i < windowCount; ++i) {
+        SetPropW(handles[i], _WndBasePtrProp, reinterpret_cast<HANDLE>(&objects[i]));
+        table.Set(handles[i], reinterpret_cast<sw::WndBase *>(&objects[i]));
+    }
+
+    size_t index = 0;
+
+    context.Run("GetPropW(atom)", 1000000, [&]() {
+        swtest::bench::DoNotOptimize(GetPropW(handles[index], MAKEINTATOM(atom)));
+        index = (index + 1) % handles.size();
+    });
+
+    index = 0;
+
+    auto &result = context.Run("WndBaseTable::Find", 1000000, [&]() {
+        swtest::bench::DoNotOptimize(table.Find(handles[index]));
+        index = (index + 1) % handles.size();
+    });
+    swtest::bench::BenchmarkContext::AddCounter(result, "windows", static_cast<double>(table.GetCount()));
+
+    for (HWND hwnd : handles) {
+        RemovePropW(hwnd, _WndBasePtrProp);
+        DestroyWindow(hwnd);
+    }
+    GlobalDeleteAtom(atom);
+}
+
+BENCHMARK_CASE("Message dispatch through WndBase::_WndProc")
+{
+    sw::Window window;
+    sw::Button button;
+    window.AddChild(button);
+
+    HWND hwnd = window.Handle.Get();
+
+    // 只需在窗口过程中查找一次对象
+    context.Run("WM_NULL to window", 1000000, [&]() {
+        swtest::bench::DoNotOptimize(SendMessageW(hwnd, WM_NULL, 0, 0));
+    });
+
+    // 先查找父窗口，再查找发出通知的子控件
+    NMHDR nmhdr{};
+    nmhdr.hwndFrom = button.Handle.Get();
+    nmhdr.idFrom   = static_cast<UINT_PTR>(GetDlgCtrlID(nmhdr.hwndFrom));
+    nmhdr.code     = _UnhandledNotifyCode;
+
+    context.Run("WM_NOTIFY from child control", 1000000, [&]() {
+        swtest::bench::DoNotOptimize(SendMessageW(hwnd, WM_NOTIFY, nmhdr.idFrom, reinterpret_cast<LPARAM>(&nmhdr)));
+    });
+}
@@ -0,0 +1,76 @@
+#include "AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    thread_local std::size_t _allocationCount = 0;
+
+    void *CountedAlloc(std::size_t size)
+    {
+        ++_allocationCount;
+        void *p = std::malloc(size == 0 ? 1 : size);
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+}
+
+std::size_t swtest::ThreadAllocationCount() noexcept
+{
+    return _allocationCount;
+}
+
+void *operator new(std::size_t size)
+{
+    return CountedAlloc(size);
+}
+
+void *operator new[](std::size_t size)
+{
+    return CountedAlloc(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    ++_allocationCount;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    ++_allocationCount;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, const std::nothrow_t &) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept
+{
+    std::free(p);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief 统计堆分配次数的辅助工具。
+ *
+ * AllocationCounter.cpp替换了全局operator new/delete，每次分配都会累加当前线程的计数，
+ * 测试可以借此断言某段代码不进行堆分配。
+ */
+namespace swtest
+{
+    /**
+     * @brief 获取当前线程累计的堆分配次数。
+     */
+    std::size_t ThreadAllocationCount() noexcept;
+
+    /**
+     * @brief 统计从构造开始当前线程发生的堆分配次数。
+     */
+    class AllocationScope
+    {
+    public:
+        AllocationScope() noexcept
+            : _start(ThreadAllocationCount())
+        {
+        }
+
+        /**
+         * @brief 获取构造以来的堆分配次数。
+         */
+        std::size_t Allocations() const noexcept
+        {
+            return ThreadAllocationCount() - _start;
+        }
+
+    private:
+        std::size_t _start;
+    };
+}
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief sw 性能测试使用的轻量级基准测试框架。
+ *
+ * 与Test.h一样保持为单头文件实现。每个基准用例可以通过BenchmarkContext::Run测量若干场景，
+ * 结果以文本表格输出，指定--json时每个场景输出一行JSON，便于在不同提交之间比较。
+ */
+namespace swtest
+{
+    namespace bench
+    {
+        class BenchmarkContext;
+
+        /**
+         * @brief 单个基准用例的注册信息。
+         */
+        struct BenchmarkCase {
+            const char *name;                 ///< 基准用例名称
+            void (*func)(BenchmarkContext &); ///< 基准用例入口函数
+            const char *file;                 ///< 定义基准用例的源文件
+            int line;                         ///< 定义基准用例的行号
+        };
+
+        /**
+         * @brief 单个测量场景的结果。
+         */
+        struct BenchmarkResult {
+            std::string benchmark;                                ///< 所属基准用例名称
+            std::string scenario;                                 ///< 场景名称
+            std::uint64_t iterations = 0;                         ///< 计时的迭代次数
+            double nsPerIteration    = 0.;                        ///< 每次迭代的平均耗时（纳秒）
+            std::vector<std::pair<std::string, double>> counters; ///< 附加的计数指标
+        };
+
+        /**
+         * @brief 获取全局基准用例注册表。
+         */
+        inline std::vector<BenchmarkCase> &Registry()
+        {
+            static std::vector<BenchmarkCase> benchmarks;
+            return benchmarks;
+        }
+
+        /**
+         * @brief 静态注册基准用例。
+         */
+        struct Registrar {
+            Registrar(const char *name, void (*func)(BenchmarkContext &), const char *file, int line)
+            {
+                Registry().push_back(BenchmarkCase{name, func, file, line});
+            }
+        };
+
+        /**
+         * @brief 阻止编译器将结果优化掉。
+         */
+        template <typename T>
+        inline void DoNotOptimize(const T &value)
+        {
+            static const void *volatile sink;
+            sink = &value;
+            (void)sink;
+        }
+
+        /**
+         * @brief 基准用例的执行上下文，负责计时和记录结果。
+         */
+        class BenchmarkContext
+        {
+        public:
+            /**
+             * @brief 创建指定基准用例的执行上下文。
+             * @param benchmark 基准用例名称
+             * @param scale 迭代次数缩放系数，用于快速冒烟运行
+             */
+            BenchmarkContext(const char *benchmark, double scale)
+                : _benchmark(benchmark), _scale(scale)
+            {
+            }
+
+            /**
+             * @brief 测量一个场景，func会先预热后被连续调用iterations次。
+             * @param scenario 场景名称
+             * @param iterations 计时的迭代次数，会按缩放系数调整且至少为1
+             * @param func 每次迭代执行的函数
+             * @return 本场景的结果，可继续通过AddCounter附加指标
+             */
+            template <typename TFunc>
+            BenchmarkResult &Run(const std::string &scenario, std::uint64_t iterations, TFunc &&func)
+            {
+                iterations = static_cast<std::uint64_t>(static_cast<double>(iterations) * _scale);
+                if (iterations == 0) {
+                    iterations = 1;
+                }
+
+                std::uint64_t warmup = iterations / 10;
+                for (std::uint64_t i = 0; i < warmup; ++i) {
+                    func();
+                }
+
+                const auto started = std::chrono::steady_clock::now();
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    func();
+                }
+                const auto ended = std::chrono::steady_clock::now();
+
+                BenchmarkResult result;
+                result.benchmark      = _benchmark;
+                result.scenario       = scenario;
+                result.iterations     = iterations;
+                result.nsPerIteration = std::chrono::duration<double, std::nano>(ended - started).count() / static_cast<double>(iterations);
+
+                _results.push_back(std::move(result));
+                return _results.back();
+            }
+
+            /**
+             * @brief 为场景结果附加计数指标。
+             */
+            static void AddCounter(BenchmarkResult &result, const std::string &name, double value)
+            {
+                result.counters.emplace_back(name, value);
+            }
+
+            /**
+             * @brief 获取已记录的全部结果。
+             */
+            const std::vector<BenchmarkResult> &Results() const
+            {
+                return _results;
+            }
+
+        private:
+            const char *_benchmark;
+            double _scale;
+            std::vector<BenchmarkResult> _results;
+        };
+
+        namespace Detail
+        {
+            /**
+             * @brief 转义JSON字符串中的特殊字符。
+             */
+            inline std::string EscapeJson(const std::string &value)
+            {
+                std::ostringstream oss;
+                for (char ch : value) {
+                    switch (ch) {
+                        case '\\':
+                            oss << "\\\\";
+                            break;
+                        case '"':
+                            oss << "\\\"";
+                            break;
+                        default:
+                            if (static_cast<unsigned char>(ch) < 0x20) {
+                                oss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(ch) << std::dec;
+                            } else {
+                                oss << ch;
+                            }
+                            break;
+                    }
+                }
+                return oss.str();
+            }
+
+            /**
+             * @brief 以单行JSON输出一个场景结果。
+             */
+            inline void PrintJson(std::ostream &out, const BenchmarkResult &result)
+            {
+                out << "{\"benchmark\":\"" << EscapeJson(result.benchmark)
+                    << "\",\"scenario\":\"" << EscapeJson(result.scenario)
+                    << "\",\"iterations\":" << result.iterations
+                    << ",\"ns_per_iteration\":" << std::fixed << std::setprecision(3) << result.nsPerIteration;
+                for (const auto &counter : result.counters) {
+                    out << ",\"" << EscapeJson(counter.first) << "\":" << counter.second;
+                }
+                out << "}\n";
+                out.unsetf(std::ios::floatfield);
+            }
+
+            /**
+             * @brief 以文本形式输出一个场景结果。
+             */
+            inline void PrintText(std::ostream &out, const BenchmarkResult &result)
+            {
+                out << "  " << std::left << std::setw(48) << result.scenario << std::right
+                    << std::fixed << std::setprecision(1) << std::setw(14) << result.nsPerIteration << " ns/iter";
+                for (const auto &counter : result.counters) {
+                    out << "  " << counter.first << "=" << std::setprecision(3) << counter.second;
+                }
+                out << "\n";
+                out.unsetf(std::ios::floatfield);
+            }
+        }
+
+        /**
+         * @brief 解析命令行参数并运行基准用例。
+         *
+         * 支持 --list、--filter <substring>、--json、--quick 和 --help。
+         *
+         * @return 0表示成功；1表示没有选中任何基准用例；2表示参数错误。
+         */
+        inline int RunAll(int argc, char **argv)
+        {
+            const char *program = argc > 0 && argv[0] != nullptr ? argv[0] : "sw_benchmarks";
+
+            std::string filter;
+            bool listOnly = false;
+            bool json     = false;
+            double scale  = 1.;
+
+            for (int i = 1; i < argc; ++i) {
+                const std::string arg = argv[i] == nullptr ? "" : argv[i];
+                if (arg == "--help" || arg == "-h") {
+                    std::cout << "Usage: " << program << " [--list] [--filter <substring>] [--json] [--quick]\n"
+                              << "  --list                 List registered benchmarks without running them.\n"
+                              << "  --filter <substring>   Run benchmarks whose names contain the substring.\n"
+                              << "  --json                 Print one JSON object per scenario.\n"
+                              << "  --quick                Run 1/100 of the iterations as a smoke test.\n"
+                              << "  --help                 Show this help message.\n";
+                    return 0;
+                } else if (arg == "--list") {
+                    listOnly = true;
+                } else if (arg == "--json") {
+                    json = true;
+                } else if (arg == "--quick") {
+                    scale = 0.01;
+                } else if (arg == "--filter" && i + 1 < argc) {
+                    filter = argv[++i];
+                } else if (arg.compare(0, std::strlen("--filter="), "--filter=") == 0) {
+                    filter = arg.substr(std::strlen("--filter="));
+                } else {
+                    std::cerr << "Unknown option: " << arg << "\n";
+                    return 2;
+                }
+            }
+
+            int selected = 0;
+            for (const auto &benchmark : Registry()) {
+                if (!filter.empty() && std::string(benchmark.name).find(filter) == std::string::npos) {
+                    continue;
+                }
+
+                ++selected;
+                if (listOnly) {
+                    std::cout << benchmark.name << "\n";
+                    continue;
+                }
+
+                BenchmarkContext context(benchmark.name, scale);
+                benchmark.func(context);
+
+                if (!json) {
+                    std::cout << "[ BENCH ] " << benchmark.name << "\n";
+                }
+                for (const auto &result : context.Results()) {
+                    if (json) {
+                        Detail::PrintJson(std::cout, result);
+                    } else {
+                        Detail::PrintText(std::cout, result);
+                    }
+                }
+            }
+
+            if (selected == 0) {
+                std::cerr << "No benchmarks selected.\n";
+                return 1;
+            }
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief 定义并自动注册一个基准用例，函数体中可通过context参数执行测量。
+ */
+#define BENCHMARK_CASE(name)                                                                           \
+    static void SWTEST_BENCH_CONCAT(SwBenchFunc_, __LINE__)(::swtest::bench::BenchmarkContext &);      \
+    static ::swtest::bench::Registrar SWTEST_BENCH_CONCAT(SwBenchRegistrar_, __LINE__)(                \
+        name, &SWTEST_BENCH_CONCAT(SwBenchFunc_, __LINE__), __FILE__, __LINE__);                       \
+    static void SWTEST_BENCH_CONCAT(SwBenchFunc_, __LINE__)(::swtest::bench::BenchmarkContext & context)
+
+#define SWTEST_BENCH_CONCAT_IMPL(a, b) a##b
+#define SWTEST_BENCH_CONCAT(a, b) SWTEST_BENCH_CONCAT_IMPL(a, b)
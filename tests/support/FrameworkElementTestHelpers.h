@@ -0,0 +1,99 @@
+#pragma once
+
+#include "FrameworkElement.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace swtest
+{
+    namespace elementtest
+    {
+        /**
+         * @brief 不依赖窗口句柄的逻辑树元素。
+         *
+         * 该类型用于在单元测试和基准测试中替代真实UIElement。AddChild和RemoveChild
+         * 按UIElement::ParentChanged的顺序更新父元素、使CurrentDataContext缓存失效，
+         * 并在有效数据上下文改变时调用OnCurrentDataContextChanged。
+         */
+        class TestTreeElement : public sw::FrameworkElement
+        {
+        public:
+            /**
+             * @brief 供数据绑定使用的整数值
+             */
+            int value = 0;
+
+            /**
+             * @brief 供数据绑定使用的整数属性
+             */
+            sw::Property<int> Value{
+                sw::Property<int>::Init(this)
+                    .Getter<&TestTreeElement::value>()
+                    .Setter<&TestTreeElement::value>()};
+
+            /**
+             * @brief 添加子元素并获取其所有权。
+             * @return 添加的子元素指针
+             */
+            TestTreeElement *AddChild(std::unique_ptr<TestTreeElement> child)
+            {
+                TestTreeElement *result = child.get();
+                _children.push_back(std::move(child));
+                result->_SetParent(this);
+                return result;
+            }
+
+            /**
+             * @brief 移除子元素并交还其所有权。
+             * @throw std::invalid_argument 如果child不是当前元素的子元素
+             */
+            std::unique_ptr<TestTreeElement> RemoveChild(TestTreeElement *child)
+            {
+                auto it = std::find_if(_children.begin(), _children.end(),
+                                       [child](const std::unique_ptr<TestTreeElement> &p) { return p.get() == child; });
+                if (it == _children.end()) {
+                    throw std::invalid_argument("child");
+                }
+                std::unique_ptr<TestTreeElement> result = std::move(*it);
+                _children.erase(it);
+                result->_SetParent(nullptr);
+                return result;
+            }
+
+            virtual sw::FrameworkElement *GetParent() const override
+            {
+                return _parent;
+            }
+
+            virtual int GetChildCount() const override
+            {
+                return static_cast<int>(_children.size());
+            }
+
+            virtual sw::FrameworkElement &GetChildAt(int index) const override
+            {
+                return *_children.at(static_cast<size_t>(index));
+            }
+
+        private:
+            void _SetParent(TestTreeElement *parent)
+            {
+                auto oldDataContext = CurrentDataContext.Get();
+
+                _parent = parent;
+                InvalidateCurrentDataContext();
+
+                if (CurrentDataContext != oldDataContext) {
+                    OnCurrentDataContextChanged(oldDataContext);
+                }
+            }
+
+            TestTreeElement *_parent = nullptr;
+            std::vector<std::unique_ptr<TestTreeElement>> _children;
+        };
+    }
+}
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "IItemGenerator.h"
 #include "ILayout.h"
 
+#include <map>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -77,6 +79,12 @@ namespace swtest
              */
             std::vector<std::string> *log = nullptr;
 
+            /**
+             * @brief 是否在measureAvailableSizes和arrangeRects中保存每次调用的记录，
+             *        统计布局算法堆分配次数的测试可将其设为false，避免记录本身分配内存
+             */
+            bool recordHistory = true;
+
             /**
              * @brief 创建一个使用默认字段值的记录布局对象
              */
@@ -142,7 +150,9 @@ namespace swtest
             virtual void Measure(const sw::Size &availableSize) override
             {
                 this->lastMeasureAvailableSize = availableSize;
-                this->measureAvailableSizes.push_back(availableSize);
+                if (this->recordHistory) {
+                    this->measureAvailableSizes.push_back(availableSize);
+                }
                 ++this->measureCount;
                 this->desiredSize = this->measureResultSize;
 
@@ -158,7 +168,9 @@ namespace swtest
             virtual void Arrange(const sw::Rect &finalPosition) override
             {
                 this->lastArrangeRect = finalPosition;
-                this->arrangeRects.push_back(finalPosition);
+                if (this->recordHistory) {
+                    this->arrangeRects.push_back(finalPosition);
+                }
                 ++this->arrangeCount;
 
                 if (this->log != nullptr) {
@@ -272,5 +284,125 @@ namespace swtest
             {
             }
         };
+
+        /**
+         * @brief 以RecordingLayout作为子项容器的虚拟化子项生成器。
+         *
+         * 每个数据项只有一个预设测量结果，项数即itemSizes的长度。实现化时优先复用
+         * 已回收的容器，并将容器的name设为“item<索引>”、layoutTag设为索引，
+         * 因此共享调用日志中可以直接看出哪些项被测量或排列。
+         */
+        class RecordingItemGenerator : public sw::IItemGenerator
+        {
+        private:
+            /**
+             * @brief 持有全部已创建的容器，保证其地址稳定
+             */
+            std::vector<std::unique_ptr<RecordingLayout>> _containers{};
+
+            /**
+             * @brief 已回收、可供复用的容器
+             */
+            std::vector<RecordingLayout *> _recycled{};
+
+        public:
+            /**
+             * @brief 各数据项的预设测量结果
+             */
+            std::vector<sw::Size> itemSizes{};
+
+            /**
+             * @brief 传递给新建容器的共享调用日志
+             */
+            std::vector<std::string> *log = nullptr;
+
+            /**
+             * @brief 当前已实现化的项，键为项索引
+             */
+            std::map<int, RecordingLayout *> realized{};
+
+            /**
+             * @brief RealizeItem被调用的次数
+             */
+            int realizeCount = 0;
+
+            /**
+             * @brief RecycleItem被调用的次数
+             */
+            int recycleCount = 0;
+
+            /**
+             * @brief 创建指定数量、测量结果相同的数据项
+             * @param count 数据项数量
+             * @param itemSize 每项的预设测量结果
+             * @param log 可选的共享调用日志
+             */
+            RecordingItemGenerator(int count, sw::Size itemSize, std::vector<std::string> *log = nullptr)
+                : itemSizes(static_cast<size_t>(count), itemSize),
+                  log(log)
+            {
+            }
+
+            /**
+             * @brief 获取已创建的容器数量，包括已回收的容器
+             */
+            int CreatedCount() const
+            {
+                return static_cast<int>(this->_containers.size());
+            }
+
+            /**
+             * @brief 获取数据项数量
+             */
+            virtual int GetItemCount() override
+            {
+                return static_cast<int>(this->itemSizes.size());
+            }
+
+            /**
+             * @brief 实现化指定索引处的项
+             * @throw std::logic_error 如果该项已被实现化
+             */
+            virtual sw::ILayout &RealizeItem(int index) override
+            {
+                if (this->realized.count(index) != 0) {
+                    throw std::logic_error("Item is already realized.");
+                }
+
+                RecordingLayout *container;
+                if (this->_recycled.empty()) {
+                    this->_containers.emplace_back(new RecordingLayout);
+                    container = this->_containers.back().get();
+                } else {
+                    container = this->_recycled.back();
+                    this->_recycled.pop_back();
+                }
+
+                container->name              = "item" + std::to_string(index);
+                container->layoutTag         = static_cast<uint64_t>(index);
+                container->measureResultSize = this->itemSizes.at(static_cast<size_t>(index));
+                container->log               = this->log;
+
+                this->realized[index] = container;
+                ++this->realizeCount;
+                return *container;
+            }
+
+            /**
+             * @brief 回收指定索引处的项
+             * @throw std::logic_error 如果该项未被实现化或容器不匹配
+             */
+            virtual void RecycleItem(int index, sw::ILayout &container) override
+            {
+                auto it = this->realized.find(index);
+                if (it == this->realized.end() || it->second != &container) {
+                    throw std::logic_error("Item is not realized by this container.");
+                }
+
+                this->_recycled.push_back(it->second);
+                this->realized.erase(it);
+                ++this->recycleCount;
+            }
+        };
     }
 }
@@ -0,0 +1,99 @@
+#include "Test.h"
+
+#include "Label.h"
+#include "StackPanel.h"
+#include "Window.h"
+
+namespace
+{
+    /**
+     * @brief 记录ArrangeOverride调用次数的面板
+     */
+    class CountingPanel : public sw::StackPanel
+    {
+    public:
+        int arrangeCount = 0;
+
+    protected:
+        virtual void ArrangeOverride(const sw::Size &finalSize) override
+        {
+            ++arrangeCount;
+            sw::StackPanel::ArrangeOverride(finalSize);
+        }
+    };
+
+    /**
+     * @brief 将元素固定在父元素左上角，使其每次排列的位置和尺寸都相同
+     */
+    void PinToTopLeft(sw::UIElement &element, double width, double height)
+    {
+        element.HorizontalAlignment = sw::HorizontalAlignment::Left;
+        element.VerticalAlignment   = sw::VerticalAlignment::Top;
+        element.Width               = width;
+        element.Height              = height;
+    }
+}
+
+TEST_CASE("Arrange runs ArrangeOverride again for a child whose measure was invalidated at the same rect")
+{
+    sw::Window window;
+    sw::StackPanel outer;
+    CountingPanel inner;
+    sw::Label sibling;
+    sw::Label label;
+
+    sibling.AutoSize = false;
+    label.AutoSize   = false;
+    PinToTopLeft(inner, 120, 40);
+    PinToTopLeft(sibling, 120, 20);
+    PinToTopLeft(label, 100, 20);
+
+    window.AddChild(outer);
+    outer.AddChild(inner);
+    outer.AddChild(sibling);
+    inner.AddChild(label);
+    window.UpdateLayoutNow();
+
+    sw::Rect rect = inner.Rect;
+
+    // 只有兄弟元素的测量失效时，inner的位置和尺寸不变，跳过其ArrangeOverride
+    inner.arrangeCount = 0;
+    sibling.InvalidateMeasure();
+    window.UpdateLayoutNow();
+    CHECK_EQ(0, inner.arrangeCount);
+
+    // inner的测量失效时，即使排列到相同位置也要重新排列其子元素
+    sw::UIElement::ResetLayoutUpdateStatistics();
+    inner.InvalidateMeasure();
+    window.UpdateLayoutNow();
+    CHECK_EQ(1, inner.arrangeCount);
+    CHECK(inner.Rect.Get() == rect);
+    CHECK_GE(sw::UIElement::GetLayoutUpdateStatistics().skippedWindowPosCount, uint64_t(1));
+}
+
+TEST_CASE("Arrange sets the window position again after an element is reparented")
+{
+    sw::Window first;
+    sw::Window second;
+    sw::Label label;
+
+    label.AutoSize = false;
+    PinToTopLeft(label, 100, 20);
+
+    first.AddChild(label);
+    first.UpdateLayoutNow();
+    sw::Rect rect = label.Rect;
+
+    // 新父元素中的位置和尺寸与之前相同，但上次排列的结果属于旧父元素，不能跳过
+    second.AddChild(label);
+    sw::UIElement::ResetLayoutUpdateStatistics();
+    second.UpdateLayoutNow();
+
+    CHECK_EQ(uint64_t(0), sw::UIElement::GetLayoutUpdateStatistics().skippedWindowPosCount);
+    CHECK(label.Rect.Get() == rect);
+
+    // 之后在新父元素中相同位置的排列可以跳过
+    label.InvalidateMeasure();
+    second.UpdateLayoutNow();
+    CHECK_EQ(uint64_t(1), sw::UIElement::GetLayoutUpdateStatistics().skippedWindowPosCount);
+}
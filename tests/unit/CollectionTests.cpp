@@ -1,8 +1,11 @@
 #include "Test.h"
 
+#include "AllocationCounter.h"
 #include "List.h"
 #include "ObservableCollection.h"
 
+#include <iterator>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <typeindex>
@@ -28,6 +31,7 @@ namespace
         const sw::IList *list;
         int index;
         int oldIndex;
+        int count;
     };
 
     template <typename T>
@@ -37,7 +41,7 @@ namespace
     {
         collection.CollectionChanged +=
             [&](sw::INotifyCollectionChanged &, sw::NotifyCollectionChangedEventArgs &args) {
-                records.push_back(CollectionChangeRecord{args.action, args.list, args.index, args.oldIndex});
+                records.push_back(CollectionChangeRecord{args.action, args.list, args.index, args.oldIndex, args.count});
             };
     }
 }
@@ -168,6 +172,47 @@ TEST_CASE("List supports IList variant access")
     CHECK_EQ(7, list.GetAt(0));
 }
 
+TEST_CASE("ObservableCollection GetVariantAt does not allocate for int rows")
+{
+    const int rowCount = 100000;
+
+    sw::ObservableCollection<int> collection;
+    collection.Reserve(rowCount);
+    for (int i = 0; i < rowCount; ++i) {
+        collection.Add(i);
+    }
+
+    sw::IList &list            = collection;
+    const sw::IList &constList = collection;
+
+    long long refSum     = 0;
+    long long valueSum   = 0;
+    std::size_t refAlloc = 0;
+    std::size_t valAlloc = 0;
+    {
+        swtest::AllocationScope scope;
+        for (int i = 0; i < rowCount; ++i) {
+            refSum += list.GetVariantAt(i).DynamicCast<int>();
+        }
+        refAlloc = scope.Allocations();
+    }
+    {
+        swtest::AllocationScope scope;
+        for (int i = 0; i < rowCount; ++i) {
+            sw::Variant value = constList.GetVariantAt(i);
+            sw::Variant copy  = value;
+            valueSum += copy.DynamicCast<int>();
+        }
+        valAlloc = scope.Allocations();
+    }
+
+    const long long expected = static_cast<long long>(rowCount) * (rowCount - 1) / 2;
+    CHECK_EQ(expected, refSum);
+    CHECK_EQ(expected, valueSum);
+    CHECK_EQ(0u, refAlloc);
+    CHECK_EQ(0u, valAlloc);
+}
+
 TEST_CASE("List throws on invalid indexes")
 {
     sw::List<int> list{1, 2};
@@ -356,3 +401,113 @@ TEST_CASE("ObservableCollection does not notify failed or no-op mutations")
     CHECK_EQ(2, collection.GetAt(1));
     CHECK_EQ(3, collection.GetAt(2));
 }
+
+TEST_CASE("ObservableCollection reports range operations as single block notifications")
+{
+    sw::ObservableCollection<int> collection{1, 5};
+    std::vector<CollectionChangeRecord> changes;
+    CaptureCollectionChanges(collection, changes);
+
+    std::vector<int> tail{6, 7, 8};
+    collection.AddRange(tail.begin(), tail.end());
+    collection.InsertRange(1, {2, 3, 4});
+    collection.ReplaceRange(5, {60, 70});
+    collection.RemoveRange(0, 2);
+
+    REQUIRE_EQ(4, static_cast<int>(changes.size()));
+    CHECK(changes[0].action == sw::NotifyCollectionChangedAction::Add);
+    CHECK_EQ(2, changes[0].index);
+    CHECK_EQ(3, changes[0].count);
+    CHECK(changes[1].action == sw::NotifyCollectionChangedAction::Add);
+    CHECK_EQ(1, changes[1].index);
+    CHECK_EQ(3, changes[1].count);
+    CHECK(changes[2].action == sw::NotifyCollectionChangedAction::Replace);
+    CHECK_EQ(5, changes[2].index);
+    CHECK_EQ(2, changes[2].count);
+    CHECK(changes[3].action == sw::NotifyCollectionChangedAction::Remove);
+    CHECK_EQ(0, changes[3].index);
+    CHECK_EQ(2, changes[3].count);
+
+    const std::vector<int> expected{3, 4, 5, 60, 70, 8};
+    CHECK(collection.GetInternalVector() == expected);
+
+    collection.Add(9);
+    REQUIRE_EQ(5, static_cast<int>(changes.size()));
+    CHECK_EQ(1, changes[4].count);
+}
+
+TEST_CASE("ObservableCollection ReplaceRange accepts single-pass input iterators")
+{
+    sw::ObservableCollection<int> collection{1, 2, 3, 4};
+    std::vector<CollectionChangeRecord> changes;
+    CaptureCollectionChanges(collection, changes);
+
+    // istream_iterator只能遍历一次，元素数量与内容都必须来自同一次遍历
+    std::istringstream input("20 30");
+    collection.ReplaceRange(1, std::istream_iterator<int>(input), std::istream_iterator<int>());
+
+    const std::vector<int> expected{1, 20, 30, 4};
+    CHECK(collection.GetInternalVector() == expected);
+    REQUIRE_EQ(1, static_cast<int>(changes.size()));
+    CHECK(changes[0].action == sw::NotifyCollectionChangedAction::Replace);
+    CHECK_EQ(1, changes[0].index);
+    CHECK_EQ(2, changes[0].count);
+
+    std::istringstream tooLong("7 8 9");
+    REQUIRE_THROWS_AS(collection.ReplaceRange(2, std::istream_iterator<int>(tooLong), std::istream_iterator<int>()), std::out_of_range);
+    CHECK(collection.GetInternalVector() == expected);
+}
+
+TEST_CASE("ObservableCollection range operations validate arguments and skip empty ranges")
+{
+    sw::ObservableCollection<int> collection{1, 2, 3};
+    int notifications = 0;
+
+    collection.CollectionChanged += [&](sw::INotifyCollectionChanged &, sw::NotifyCollectionChangedEventArgs &) {
+        ++notifications;
+    };
+
+    REQUIRE_THROWS_AS(collection.InsertRange(4, {0}), std::out_of_range);
+    REQUIRE_THROWS_AS(collection.InsertRange(-1, {0}), std::out_of_range);
+    REQUIRE_THROWS_AS(collection.RemoveRange(2, 2), std::out_of_range);
+    REQUIRE_THROWS_AS(collection.RemoveRange(-1, 1), std::out_of_range);
+    REQUIRE_THROWS_AS(collection.RemoveRange(0, -1), std::out_of_range);
+    REQUIRE_THROWS_AS(collection.ReplaceRange(2, {0, 0}), std::out_of_range);
+    REQUIRE_THROWS_AS(collection.EndUpdate(), std::logic_error);
+
+    collection.AddRange({});
+    collection.RemoveRange(3, 0);
+    collection.ReplaceRange(0, {});
+
+    CHECK_EQ(0, notifications);
+    CHECK_EQ(3, collection.Count());
+}
+
+TEST_CASE("ObservableCollection BeginUpdate defers changes into one reset")
+{
+    sw::ObservableCollection<int> collection;
+    std::vector<CollectionChangeRecord> changes;
+    CaptureCollectionChanges(collection, changes);
+
+    collection.BeginUpdate();
+    collection.BeginUpdate();
+    for (int i = 0; i < 1000; ++i) {
+        collection.Add(i);
+    }
+    collection.RemoveAt(0);
+    collection.EndUpdate();
+
+    CHECK(collection.IsUpdating());
+    CHECK(changes.empty());
+
+    collection.EndUpdate();
+
+    CHECK_FALSE(collection.IsUpdating());
+    REQUIRE_EQ(1, static_cast<int>(changes.size()));
+    CHECK(changes[0].action == sw::NotifyCollectionChangedAction::Reset);
+    CHECK_EQ(999, collection.Count());
+
+    collection.BeginUpdate();
+    collection.EndUpdate();
+    CHECK_EQ(1, static_cast<int>(changes.size()));
+}
@@ -2,13 +2,19 @@
 
 #include "Binding.h"
 #include "Converters.h"
+#include "DataBinding.h"
+#include "FrameworkElementTestHelpers.h"
+#include "IdleScheduler.h"
 #include "ObservableObject.h"
 #include "SelfBinding.h"
 
+#include <chrono>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 namespace
 {
@@ -69,6 +75,48 @@ namespace
         }
     };
 
+    struct CountingTarget : sw::ObservableObject {
+        int value        = 0;
+        int writes       = 0;
+        std::string *log = nullptr;
+        char name        = 0;
+
+        sw::Property<int> Value{
+            sw::Property<int>::Init(this).Getter<&CountingTarget::value>().Setter<&CountingTarget::SetValue>()};
+
+        void SetValue(int newValue)
+        {
+            ++writes;
+            if (log != nullptr) *log += name;
+            if (value != newValue) {
+                value = newValue;
+                RaisePropertyChanged(&CountingTarget::Value);
+            }
+        }
+    };
+
+    struct PropertyChangedCounter {
+        int calls = 0;
+
+        void OnPropertyChanged(sw::INotifyPropertyChanged &, sw::PropertyChangedEventArgs &)
+        {
+            ++calls;
+        }
+    };
+
+    struct SelfRemovingPropertyHandler {
+        BindableObject &object;
+        int calls = 0;
+
+        void OnPropertyChanged(sw::INotifyPropertyChanged &, sw::PropertyChangedEventArgs &e)
+        {
+            ++calls;
+            sw::PropertyChangedEventHandler self(*this, &SelfRemovingPropertyHandler::OnPropertyChanged);
+            object.RemovePropertyChangedHandler(e.propertyId, self);
+            object.AddPropertyChangedHandler(sw::Reflection::GetFieldId(&BindableObject::Text), self);
+        }
+    };
+
     class CountingStringIntConverter : public sw::IValueConverter<std::wstring, int>
     {
     public:
@@ -99,6 +147,26 @@ namespace
         int *_convertBackCalls;
         int *_destructCalls;
     };
+
+    /**
+     * @brief 源字符串为"throw"时抛出异常的转换器
+     */
+    class ThrowingStringIntConverter : public sw::IValueConverter<std::wstring, int>
+    {
+    public:
+        int Convert(const std::wstring &source) override
+        {
+            if (source == L"throw") {
+                throw std::runtime_error("conversion failed");
+            }
+            return static_cast<int>(source.size());
+        }
+
+        std::wstring ConvertBack(int target) override
+        {
+            return std::wstring(static_cast<size_t>(target), L'x');
+        }
+    };
 }
 
 TEST_CASE("Converters handle numeric boolean enum and reverse conversions")
@@ -294,6 +362,280 @@ TEST_CASE("Binding responds to matching property notifications according to mode
     CHECK_EQ(19, source.value);
 }
 
+TEST_CASE("Deferred Binding writes the target once with the latest source value")
+{
+    BindableObject source;
+    CountingTarget target;
+
+    std::unique_ptr<sw::Binding> binding(
+        sw::Binding::Create(&target, &CountingTarget::Value, &source, &BindableObject::Value, sw::BindingMode::OneWay));
+    CHECK_EQ(1, target.writes);
+    CHECK(binding->GetUpdateMode() == sw::BindingUpdateMode::Immediate);
+
+    binding->SetUpdateMode(sw::BindingUpdateMode::Deferred);
+    for (int i = 1; i <= 1000; ++i) {
+        source.Value = i;
+    }
+    CHECK_EQ(1, target.writes);
+    CHECK_EQ(0, target.value);
+    CHECK(sw::Binding::HasDeferredUpdates());
+
+    sw::Binding::FlushDeferredUpdates();
+    CHECK_EQ(2, target.writes);
+    CHECK_EQ(1000, target.value);
+    CHECK_FALSE(sw::Binding::HasDeferredUpdates());
+
+    sw::Binding::FlushDeferredUpdates();
+    CHECK_EQ(2, target.writes);
+
+    // 切换回Immediate时立即应用等待中的更新
+    source.Value = 5;
+    binding->SetUpdateMode(sw::BindingUpdateMode::Immediate);
+    CHECK_EQ(3, target.writes);
+    CHECK_EQ(5, target.value);
+    CHECK_FALSE(sw::Binding::HasDeferredUpdates());
+
+    for (int i = 1; i <= 1000; ++i) {
+        source.Value = -i;
+    }
+    CHECK_EQ(1003, target.writes);
+}
+
+TEST_CASE("Deferred Bindings flush in the order they were first marked")
+{
+    std::string log;
+    BindableObject sources[3];
+    CountingTarget targets[4];
+    std::unique_ptr<sw::Binding> bindings[4];
+
+    for (int i = 0; i < 4; ++i) {
+        targets[i].log  = &log;
+        targets[i].name = static_cast<char>('a' + i);
+    }
+    for (int i = 0; i < 3; ++i) {
+        bindings[i].reset(sw::Binding::Create(
+            &targets[i], &CountingTarget::Value, &sources[i], &BindableObject::Value, sw::BindingMode::OneWay));
+        bindings[i]->SetUpdateMode(sw::BindingUpdateMode::Deferred);
+    }
+    // d绑定到a，a在刷新时更改后d在同一次刷新中更新
+    bindings[3].reset(sw::Binding::Create(
+        &targets[3], &CountingTarget::Value, &targets[0], &CountingTarget::Value, sw::BindingMode::OneWay));
+    bindings[3]->SetUpdateMode(sw::BindingUpdateMode::Deferred);
+    log.clear();
+
+    sources[2].Value = 1;
+    sources[0].Value = 1;
+    sources[2].Value = 2;
+    sources[1].Value = 1;
+    sw::Binding::FlushDeferredUpdates();
+
+    CHECK_EQ(std::string("cabd"), log);
+    CHECK_EQ(1, targets[0].value);
+    CHECK_EQ(1, targets[1].value);
+    CHECK_EQ(2, targets[2].value);
+    CHECK_EQ(1, targets[3].value);
+
+    // 等待中的绑定被销毁或更改对象后不再延迟更新
+    log.clear();
+    sources[0].Value = 3;
+    sources[1].Value = 3;
+    sources[2].Value = 3;
+    bindings[0].reset();
+    bindings[2]->SetSourceObject(&sources[1]);
+    CHECK_EQ(std::string("c"), log);
+
+    sw::Binding::FlushDeferredUpdates();
+    CHECK_EQ(std::string("cb"), log);
+    CHECK_FALSE(sw::Binding::HasDeferredUpdates());
+}
+
+TEST_CASE("Deferred Binding requests a flush when updates are raised while idle")
+{
+    BindableObject source;
+    CountingTarget target;
+
+    std::unique_ptr<sw::Binding> binding(
+        sw::Binding::Create(&target, &CountingTarget::Value, &source, &BindableObject::Value, sw::BindingMode::OneWay));
+    binding->SetUpdateMode(sw::BindingUpdateMode::Deferred);
+
+    // 模拟App::MsgLoop：请求函数代替调度器记录唤醒，消息队列为空时执行空闲任务
+    int requests = 0;
+    sw::Binding::SetDeferredUpdateRequestHandler([&]() { ++requests; });
+
+    sw::IdleScheduler scheduler;
+    int progress = 0;
+    scheduler.Add(L"progress", [&]() {
+        source.Value = ++progress;
+        return progress < 100;
+    });
+
+    CHECK_FALSE(scheduler.Run(std::chrono::seconds(1)));
+    CHECK_EQ(100, progress);
+
+    // 队列由空变为非空时只请求一次，空闲后不会在没有新消息的情况下停留在旧值
+    CHECK_EQ(1, requests);
+    CHECK(sw::Binding::HasDeferredUpdates());
+    CHECK_EQ(0, target.value);
+
+    sw::Binding::FlushDeferredUpdates();
+    CHECK_EQ(100, target.value);
+    CHECK_EQ(2, target.writes);
+
+    source.Value = 1;
+    source.Value = 2;
+    CHECK_EQ(2, requests);
+
+    // 已取消的更新不再计入，队列变空后再次标记时重新请求
+    binding->SetSourceObject(nullptr);
+    CHECK_FALSE(sw::Binding::HasDeferredUpdates());
+    binding->SetSourceObject(&source);
+    source.Value = 3;
+    CHECK_EQ(3, requests);
+    sw::Binding::FlushDeferredUpdates();
+    CHECK_EQ(3, target.value);
+
+    sw::Binding::SetDeferredUpdateRequestHandler(nullptr);
+}
+
+TEST_CASE("Deferred Binding queue stays usable after a converter throws during a flush")
+{
+    BindableObject throwingSource;
+    BindableObject throwingTarget;
+    BindableObject source;
+    CountingTarget target;
+
+    std::unique_ptr<sw::Binding> throwing(sw::Binding::Create(
+        &throwingTarget, &BindableObject::Value, &throwingSource, &BindableObject::Text,
+        sw::BindingMode::OneWay, new ThrowingStringIntConverter));
+    std::unique_ptr<sw::Binding> binding(
+        sw::Binding::Create(&target, &CountingTarget::Value, &source, &BindableObject::Value, sw::BindingMode::OneWay));
+    throwing->SetUpdateMode(sw::BindingUpdateMode::Deferred);
+    binding->SetUpdateMode(sw::BindingUpdateMode::Deferred);
+
+    throwingSource.Text = L"throw";
+    source.Value        = 1;
+    REQUIRE_THROWS_AS(sw::Binding::FlushDeferredUpdates(), std::runtime_error);
+
+    // 抛出异常的绑定已出队，之后的绑定仍在等待，下次刷新时更新
+    CHECK(sw::Binding::HasDeferredUpdates());
+    CHECK_EQ(0, target.value);
+    sw::Binding::FlushDeferredUpdates();
+    CHECK_EQ(1, target.value);
+    CHECK_FALSE(sw::Binding::HasDeferredUpdates());
+
+    throwingSource.Text = L"ok";
+    source.Value        = 2;
+    sw::Binding::FlushDeferredUpdates();
+    CHECK_EQ(2, throwingTarget.value);
+    CHECK_EQ(2, target.value);
+    CHECK_FALSE(sw::Binding::HasDeferredUpdates());
+}
+
+TEST_CASE("Deferred Binding raised on another thread can be destroyed after that thread exits")
+{
+    BindableObject source;
+    CountingTarget target;
+
+    std::unique_ptr<sw::Binding> binding(
+        sw::Binding::Create(&target, &CountingTarget::Value, &source, &BindableObject::Value, sw::BindingMode::OneWay));
+    binding->SetUpdateMode(sw::BindingUpdateMode::Deferred);
+
+    // 绑定加入工作线程的队列，当前线程的队列不受影响
+    bool pendingOnWorker = false;
+    std::thread worker([&]() {
+        source.Value     = 7;
+        pendingOnWorker = sw::Binding::HasDeferredUpdates();
+    });
+    worker.join();
+
+    CHECK(pendingOnWorker);
+    CHECK_FALSE(sw::Binding::HasDeferredUpdates());
+    CHECK_EQ(0, target.value);
+
+    // 工作线程退出时解除关联，此后可以重新加入当前线程的队列并安全销毁
+    source.Value = 8;
+    CHECK(sw::Binding::HasDeferredUpdates());
+    binding.reset();
+    CHECK_FALSE(sw::Binding::HasDeferredUpdates());
+    sw::Binding::FlushDeferredUpdates();
+    CHECK_EQ(0, target.value);
+}
+
+TEST_CASE("ObservableObject dispatches property handlers by property id")
+{
+    BindableObject object;
+    PropertyChangedCounter valueCounter;
+    PropertyChangedCounter otherCounter;
+    PropertyChangedCounter generalCounter;
+
+    const sw::FieldId valueId = sw::Reflection::GetFieldId(&BindableObject::Value);
+    const sw::FieldId otherId = sw::Reflection::GetFieldId(&BindableObject::Other);
+
+    object.PropertyChanged += sw::PropertyChangedEventHandler(generalCounter, &PropertyChangedCounter::OnPropertyChanged);
+    object.AddPropertyChangedHandler(valueId, sw::PropertyChangedEventHandler(valueCounter, &PropertyChangedCounter::OnPropertyChanged));
+    object.AddPropertyChangedHandler(otherId, sw::PropertyChangedEventHandler(otherCounter, &PropertyChangedCounter::OnPropertyChanged));
+
+    object.Value = 1;
+    CHECK_EQ(1, valueCounter.calls);
+    CHECK_EQ(0, otherCounter.calls);
+    CHECK_EQ(1, generalCounter.calls);
+
+    object.Other = 2;
+    object.Other = 3;
+    CHECK_EQ(1, valueCounter.calls);
+    CHECK_EQ(2, otherCounter.calls);
+    CHECK_EQ(3, generalCounter.calls);
+
+    CHECK(object.RemovePropertyChangedHandler(valueId, sw::PropertyChangedEventHandler(valueCounter, &PropertyChangedCounter::OnPropertyChanged)));
+    CHECK_FALSE(object.RemovePropertyChangedHandler(valueId, sw::PropertyChangedEventHandler(valueCounter, &PropertyChangedCounter::OnPropertyChanged)));
+
+    object.Value = 4;
+    CHECK_EQ(1, valueCounter.calls);
+    CHECK_EQ(4, generalCounter.calls);
+}
+
+TEST_CASE("ObservableObject property handlers can unsubscribe during dispatch")
+{
+    BindableObject object;
+    SelfRemovingPropertyHandler handler{object};
+
+    object.AddPropertyChangedHandler(
+        sw::Reflection::GetFieldId(&BindableObject::Value),
+        sw::PropertyChangedEventHandler(handler, &SelfRemovingPropertyHandler::OnPropertyChanged));
+
+    object.Value = 1;
+    object.Value = 2;
+    CHECK_EQ(1, handler.calls);
+
+    object.Text = L"text";
+    CHECK_EQ(2, handler.calls);
+}
+
+TEST_CASE("Binding subscribes to its own property on observable objects")
+{
+    BindableObject target;
+    BindableObject source;
+
+    std::unique_ptr<sw::Binding> valueBinding(
+        sw::Binding::Create(&target, &BindableObject::Value, &source, &BindableObject::Value, sw::BindingMode::OneWay));
+    std::unique_ptr<sw::Binding> otherBinding(
+        sw::Binding::Create(&target, &BindableObject::Other, &source, &BindableObject::Other, sw::BindingMode::TwoWay));
+
+    source.Value = 3;
+    source.Other = 4;
+    CHECK_EQ(3, target.value);
+    CHECK_EQ(4, target.other);
+
+    target.Other = 5;
+    CHECK_EQ(5, source.other);
+
+    otherBinding.reset();
+    source.Other = 6;
+    source.Value = 7;
+    CHECK_EQ(5, target.other);
+    CHECK_EQ(7, target.value);
+}
+
 TEST_CASE("Binding handles null and object death without stale notifications")
 {
     BindableObject target;
@@ -409,3 +751,94 @@ TEST_CASE("SelfBinding synchronizes properties on one object and can retarget")
     first.Value = 20;
     CHECK_EQ(10, first.other);
 }
+
+TEST_CASE("FrameworkElement CurrentDataContext follows DataContext and parent changes")
+{
+    using swtest::elementtest::TestTreeElement;
+
+    BindableObject first;
+    BindableObject second;
+    BindableObject third;
+
+    TestTreeElement root;
+    TestTreeElement otherRoot;
+    auto mid     = root.AddChild(std::unique_ptr<TestTreeElement>(new TestTreeElement));
+    auto leaf    = mid->AddChild(std::unique_ptr<TestTreeElement>(new TestTreeElement));
+    auto owner   = mid->AddChild(std::unique_ptr<TestTreeElement>(new TestTreeElement));
+    auto ownLeaf = owner->AddChild(std::unique_ptr<TestTreeElement>(new TestTreeElement));
+    auto sibling = root.AddChild(std::unique_ptr<TestTreeElement>(new TestTreeElement));
+    owner->DataContext = sw::Variant::MakeRef(third);
+
+    CHECK(leaf->CurrentDataContext.Get() == nullptr);
+    CHECK(ownLeaf->CurrentDataContext.Get() == &third);
+
+    root.DataContext = sw::Variant::MakeRef(first);
+    CHECK(leaf->CurrentDataContext.Get() == &first);
+    CHECK(sibling->CurrentDataContext.Get() == &first);
+    CHECK(ownLeaf->CurrentDataContext.Get() == &third);
+
+    mid->DataContext = sw::Variant::MakeRef(second);
+    CHECK(leaf->CurrentDataContext.Get() == &second);
+    CHECK(sibling->CurrentDataContext.Get() == &first);
+
+    mid->DataContext = nullptr;
+    CHECK(leaf->CurrentDataContext.Get() == &first);
+
+    auto detached = root.RemoveChild(mid);
+    CHECK(leaf->CurrentDataContext.Get() == nullptr);
+    CHECK(ownLeaf->CurrentDataContext.Get() == &third);
+
+    otherRoot.DataContext = sw::Variant::MakeRef(second);
+    otherRoot.AddChild(std::move(detached));
+    CHECK(mid->CurrentDataContext.Get() == &second);
+    CHECK(leaf->CurrentDataContext.Get() == &second);
+    CHECK(ownLeaf->CurrentDataContext.Get() == &third);
+
+    owner->DataContext = nullptr;
+    CHECK(ownLeaf->CurrentDataContext.Get() == &second);
+}
+
+TEST_CASE("FrameworkElement raises DataContextChanged for each small by-value DataContext")
+{
+    using swtest::elementtest::TestTreeElement;
+
+    TestTreeElement element;
+    std::vector<int> seen;
+    element.DataContextChanged += [&](sw::FrameworkElement &sender, sw::DataContextChangedEventArgs &) {
+        seen.push_back(sender.DataContext.Get().DynamicCast<int>());
+    };
+
+    // 两个值都存放在Variant内部的缓冲区中，新旧对象的地址相同
+    element.DataContext = 1;
+    element.DataContext = 2;
+    CHECK(seen == std::vector<int>({1, 2}));
+    CHECK_EQ(2, element.CurrentDataContext.Get()->DynamicCast<int>());
+}
+
+TEST_CASE("DataBinding picks up the data context when a bound subtree is attached")
+{
+    using swtest::elementtest::TestTreeElement;
+
+    BindableObject viewModel;
+    viewModel.Value = 42;
+
+    std::unique_ptr<TestTreeElement> subtree(new TestTreeElement);
+    auto leaf = subtree->AddChild(std::unique_ptr<TestTreeElement>(new TestTreeElement));
+    REQUIRE(leaf->AddBinding(sw::DataBinding::Create(&TestTreeElement::Value, &BindableObject::Value, sw::BindingMode::OneWay)));
+
+    int contextChanges = 0;
+    leaf->DataContextChanged += [&](sw::FrameworkElement &, sw::DataContextChangedEventArgs &) {
+        ++contextChanges;
+    };
+
+    TestTreeElement root;
+    root.DataContext = sw::Variant::MakeRef(viewModel);
+    CHECK_EQ(0, leaf->value);
+
+    root.AddChild(std::move(subtree));
+    CHECK_EQ(1, contextChanges);
+    CHECK_EQ(42, leaf->value);
+
+    viewModel.Value = 7;
+    CHECK_EQ(7, leaf->value);
+}
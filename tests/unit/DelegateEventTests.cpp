@@ -1,5 +1,6 @@
 #include "Test.h"
 
+#include "AllocationCounter.h"
 #include "Delegate.h"
 #include "Event.h"
 
@@ -89,6 +90,30 @@ namespace
 
     using IntHandler = sw::Delegate<void(int)>;
 
+    /**
+     * @brief 在被调用时修改所属委托的处理函数
+     */
+    struct DispatchMutator {
+        IntHandler *target;
+        std::vector<int> *log;
+        int id;
+        DispatchMutator *removeOnCall = nullptr;
+        DispatchMutator *addOnCall    = nullptr;
+
+        void OnInvoke(int)
+        {
+            log->push_back(id);
+            if (removeOnCall != nullptr) {
+                target->Remove(*removeOnCall, &DispatchMutator::OnInvoke);
+                removeOnCall = nullptr;
+            }
+            if (addOnCall != nullptr) {
+                target->Add(*addOnCall, &DispatchMutator::OnInvoke);
+                addOnCall = nullptr;
+            }
+        }
+    };
+
     struct EventOwner {
         IntHandler handler;
 
@@ -341,3 +366,138 @@ TEST_CASE("Event forwards static handlers to backing delegate")
     changed -= handler;
     CHECK(StaticEventHandler() == nullptr);
 }
+
+TEST_CASE("Delegate multicast invocation does not allocate")
+{
+    int seen = 0;
+    Receiver receiver;
+    receiver.calls.reserve(4096);
+
+    IntHandler action;
+    action += VoidRecorder{&seen};
+    action += [&seen](int value) { seen += value * 2; };
+    action += [&seen](int value) { seen -= value; };
+
+    sw::Delegate<int(int)> func;
+    func.Add(receiver, &Receiver::Multiply);
+    func += PlainFunctor{1};
+    func += FreeAddTwo;
+
+    swtest::AllocationScope scope;
+    for (int i = 0; i < 1000; ++i) {
+        action(1);
+        CHECK_EQ(3, func(1));
+    }
+
+    CHECK_EQ(0, static_cast<int>(scope.Allocations()));
+    CHECK_EQ(2000, seen);
+    CHECK_EQ(1000, static_cast<int>(receiver.calls.size()));
+}
+
+TEST_CASE("Delegate dispatch uses the handlers present when invocation starts")
+{
+    std::vector<int> log;
+    IntHandler action;
+
+    DispatchMutator first{&action, &log, 1};
+    DispatchMutator second{&action, &log, 2};
+    DispatchMutator third{&action, &log, 3};
+    DispatchMutator added{&action, &log, 4};
+
+    action.Add(first, &DispatchMutator::OnInvoke);
+    action.Add(second, &DispatchMutator::OnInvoke);
+    action.Add(third, &DispatchMutator::OnInvoke);
+
+    first.removeOnCall = &second;
+    first.addOnCall    = &added;
+    third.removeOnCall = &third;
+
+    action(0);
+    CHECK(log == std::vector<int>({1, 2, 3}));
+
+    log.clear();
+    action(0);
+    CHECK(log == std::vector<int>({1, 4}));
+
+    log.clear();
+    swtest::AllocationScope scope;
+    action(0);
+    CHECK_EQ(0, static_cast<int>(scope.Allocations()));
+    CHECK(log == std::vector<int>({1, 4}));
+}
+
+TEST_CASE("Delegate stores a single small handler without allocating")
+{
+    int seen = 0;
+    Receiver receiver;
+    receiver.calls.reserve(16);
+    EventOwner owner;
+
+    swtest::AllocationScope scope;
+    {
+        sw::Delegate<int(int)> member(receiver, &Receiver::Multiply);
+        sw::Delegate<int(int)> constMember(receiver, &Receiver::AddFactor);
+        sw::Delegate<int(int)> function(FreeAddOne);
+        sw::Delegate<int(int)> lambda([](int value) { return value * 3; });
+        IntHandler capturing([&seen](int value) { seen += value; });
+
+        sw::Delegate<int(int)> copied(member);
+        sw::Delegate<int(int)> moved(std::move(constMember));
+        function = lambda;
+        lambda   = copied;
+
+        CHECK_EQ(2, copied(2));
+        CHECK_EQ(3, moved(2));
+        CHECK_EQ(6, function(2));
+        CHECK_EQ(5, lambda(5));
+        CHECK(lambda == member);
+        capturing(7);
+
+        owner.Changed += VoidRecorder{&seen};
+        owner.handler(1);
+        owner.Changed -= VoidRecorder{&seen};
+    }
+    CHECK_EQ(0, static_cast<int>(scope.Allocations()));
+    CHECK_EQ(8, seen);
+    CHECK(receiver.calls == std::vector<int>({2, 5}));
+    CHECK(owner.handler == nullptr);
+}
+
+TEST_CASE("Delegate keeps the state of a single mutable handler between calls")
+{
+    int count = 0;
+    sw::Delegate<int()> counter([count]() mutable { return ++count; });
+
+    CHECK_EQ(1, counter());
+    CHECK_EQ(2, counter());
+    CHECK(counter.InvokeAll() == std::vector<int>({3}));
+    CHECK_EQ(0, count);
+}
+
+TEST_CASE("Delegate keeps an inline handler valid when it subscribes another handler")
+{
+    std::vector<int> log;
+    int total = 0;
+    IntHandler action;
+
+    action += [&log, &action, &total](int value) {
+        action += VoidRecorder{&total};
+        log.push_back(value);
+    };
+
+    action(1);
+    CHECK(log == std::vector<int>({1}));
+    CHECK_EQ(0, total);
+
+    action(2);
+    CHECK(log == std::vector<int>({1, 2}));
+    CHECK_EQ(2, total);
+
+    CHECK(action.Remove(VoidRecorder{&total}));
+    CHECK(action.Remove(VoidRecorder{&total}));
+    CHECK_FALSE(action.Remove(VoidRecorder{&total}));
+
+    action(3);
+    CHECK(log == std::vector<int>({1, 2, 3}));
+    CHECK_EQ(2, total);
+}
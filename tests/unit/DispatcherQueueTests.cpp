@@ -0,0 +1,250 @@
+#include "Test.h"
+
+#include "DispatcherQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief 返回向log追加name的任务
+     */
+    sw::Action<> Append(std::string &log, const char *name)
+    {
+        return [&log, name]() {
+            if (!log.empty()) log += ',';
+            log += name;
+        };
+    }
+}
+
+TEST_CASE("DispatcherQueue runs priorities from high to low and keeps FIFO order within a priority")
+{
+    sw::DispatcherQueue queue;
+    std::string log;
+
+    queue.Enqueue(Append(log, "b1"), sw::DispatcherPriority::Background);
+    queue.Enqueue(Append(log, "r1"), sw::DispatcherPriority::Render);
+    queue.Enqueue(Append(log, "i1"), sw::DispatcherPriority::Input);
+    queue.Enqueue(Append(log, "b2"), sw::DispatcherPriority::Background);
+    queue.Enqueue(Append(log, "r2"), sw::DispatcherPriority::Render);
+    queue.Enqueue(Append(log, "i2"), sw::DispatcherPriority::Input);
+
+    CHECK_FALSE(queue.Drain());
+    CHECK_EQ(std::string("i1,i2,r1,r2,b1,b2"), log);
+
+    // 执行期间入队的较低优先级任务在同一次Drain中执行，同一优先级的任务留到下次
+    log.clear();
+    auto enqueueMore = [&]() {
+        Append(log, "r1")();
+        queue.Enqueue(Append(log, "r2"), sw::DispatcherPriority::Render);
+        queue.Enqueue(Append(log, "b1"), sw::DispatcherPriority::Background);
+    };
+    queue.Enqueue(enqueueMore, sw::DispatcherPriority::Render);
+
+    CHECK(queue.Drain());
+    CHECK_EQ(std::string("r1,b1"), log);
+    CHECK_FALSE(queue.Drain());
+    CHECK_EQ(std::string("r1,b1,r2"), log);
+}
+
+TEST_CASE("DispatcherQueue asks for one wake-up until the consumer drains it")
+{
+    sw::DispatcherQueue queue;
+    int runs = 0;
+
+    CHECK(queue.Enqueue([&]() { ++runs; }, sw::DispatcherPriority::Render));
+    CHECK_FALSE(queue.Enqueue([&]() { ++runs; }, sw::DispatcherPriority::Input));
+    CHECK_FALSE(queue.Enqueue([&]() { ++runs; }, sw::DispatcherPriority::Background));
+
+    CHECK_FALSE(queue.Drain());
+    CHECK_EQ(3, runs);
+
+    // Drain开始后入队的任务需要新的唤醒
+    auto enqueueMore = [&]() {
+        ++runs;
+        CHECK(queue.Enqueue([&]() { ++runs; }, sw::DispatcherPriority::Input));
+    };
+    CHECK(queue.Enqueue(enqueueMore, sw::DispatcherPriority::Input));
+    CHECK(queue.Drain());
+    CHECK_FALSE(queue.Drain());
+    CHECK_EQ(5, runs);
+
+    // 唤醒失败时撤销请求，下次入队重新请求唤醒
+    CHECK(queue.Enqueue([&]() { ++runs; }, sw::DispatcherPriority::Render));
+    queue.CancelWakeRequest();
+    CHECK(queue.Enqueue([&]() { ++runs; }, sw::DispatcherPriority::Render));
+    CHECK_FALSE(queue.Drain());
+    CHECK_EQ(7, runs);
+}
+
+TEST_CASE("DispatcherQueue keeps only the latest task for each key")
+{
+    sw::DispatcherQueue queue;
+    std::vector<int> values;
+
+    for (int i = 1; i <= 1000; ++i) {
+        queue.Enqueue([&values, i]() { values.push_back(i); }, sw::DispatcherPriority::Render, 1);
+    }
+    queue.Enqueue([&values]() { values.push_back(-1); }, sw::DispatcherPriority::Render, 2);
+    queue.Enqueue([&values]() { values.push_back(0); }, sw::DispatcherPriority::Render);
+    queue.Enqueue([&values]() { values.push_back(0); }, sw::DispatcherPriority::Render);
+
+    queue.Drain();
+    CHECK_EQ((std::vector<int>{1000, -1, 0, 0}), values);
+
+    sw::DispatcherQueueMetrics metrics = queue.GetMetrics();
+    CHECK_EQ(uint64_t(1003), metrics.enqueuedCount);
+    CHECK_EQ(uint64_t(4), metrics.executedCount);
+    CHECK_EQ(uint64_t(999), metrics.coalescedCount);
+    CHECK_EQ(size_t(0), metrics.depth);
+
+    // 未执行的任务被同一优先级中相同键值的新任务取代
+    values.clear();
+    queue.Enqueue([&values]() { values.push_back(1); }, sw::DispatcherPriority::Background, 3);
+    CHECK(queue.Drain([]() { return true; }));
+    CHECK(values.empty());
+
+    queue.Enqueue([&values]() { values.push_back(2); }, sw::DispatcherPriority::Background, 3);
+    CHECK_FALSE(queue.Drain());
+    CHECK_EQ((std::vector<int>{2}), values);
+    CHECK_EQ(uint64_t(1000), queue.GetMetrics().coalescedCount);
+
+    // 不同优先级的键值互不影响
+    values.clear();
+    queue.Enqueue([&values]() { values.push_back(3); }, sw::DispatcherPriority::Background, 4);
+    queue.Enqueue([&values]() { values.push_back(4); }, sw::DispatcherPriority::Input, 4);
+    CHECK_FALSE(queue.Drain());
+    CHECK_EQ((std::vector<int>{4, 3}), values);
+    CHECK_EQ(uint64_t(1000), queue.GetMetrics().coalescedCount);
+}
+
+TEST_CASE("DispatcherQueue yields lower priorities but always runs input tasks")
+{
+    sw::DispatcherQueue queue;
+    std::string log;
+    int budget = 2;
+
+    queue.Enqueue(Append(log, "b1"), sw::DispatcherPriority::Background);
+    queue.Enqueue(Append(log, "b2"), sw::DispatcherPriority::Background);
+    queue.Enqueue(Append(log, "r1"), sw::DispatcherPriority::Render);
+    queue.Enqueue(Append(log, "i1"), sw::DispatcherPriority::Input);
+    queue.Enqueue(Append(log, "i2"), sw::DispatcherPriority::Input);
+    queue.Enqueue(Append(log, "i3"), sw::DispatcherPriority::Input);
+
+    auto shouldYield = [&]() { return budget-- <= 0; };
+
+    CHECK(queue.Drain(shouldYield));
+    CHECK_EQ(std::string("i1,i2,i3,r1,b1"), log);
+    CHECK_EQ(size_t(1), queue.GetMetrics().depth);
+
+    budget = 0;
+    CHECK(queue.Drain(shouldYield));
+    CHECK_EQ(std::string("i1,i2,i3,r1,b1"), log);
+
+    CHECK_FALSE(queue.Drain());
+    CHECK_EQ(std::string("i1,i2,i3,r1,b1,b2"), log);
+}
+
+TEST_CASE("DispatcherQueue reports depth and latency")
+{
+    sw::DispatcherQueue queue;
+
+    for (int i = 0; i < 10; ++i) {
+        queue.Enqueue([]() {}, sw::DispatcherPriority::Background);
+    }
+    CHECK_EQ(size_t(10), queue.GetMetrics().depth);
+    CHECK_EQ(size_t(10), queue.GetMetrics().maxDepth);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    queue.Drain();
+
+    sw::DispatcherQueueMetrics metrics = queue.GetMetrics();
+    CHECK_EQ(size_t(0), metrics.depth);
+    CHECK_EQ(uint64_t(10), metrics.executedCount);
+    CHECK_EQ(uint64_t(1), metrics.batchCount);
+    CHECK_GE(metrics.maxLatency, uint64_t(2000000));
+    CHECK_GE(metrics.totalLatency, uint64_t(10 * 2000000));
+
+    queue.ResetMetrics();
+    metrics = queue.GetMetrics();
+    CHECK_EQ(size_t(0), metrics.maxDepth);
+    CHECK_EQ(uint64_t(0), metrics.executedCount);
+    CHECK_EQ(uint64_t(0), metrics.maxLatency);
+}
+
+TEST_CASE("DispatcherQueue releases tasks that were never run")
+{
+    auto token = std::make_shared<int>(0);
+    {
+        sw::DispatcherQueue queue;
+        for (int i = 0; i < 100; ++i) {
+            queue.Enqueue([token]() {}, sw::DispatcherPriority::Background, i % 10);
+        }
+        CHECK_EQ(101L, token.use_count());
+    }
+    CHECK_EQ(1L, token.use_count());
+}
+
+TEST_CASE("DispatcherQueue delivers every task exactly once from concurrent producers")
+{
+    const int producerCount = 4;
+    const int taskCount     = 20000;
+
+    sw::DispatcherQueue queue;
+
+    // 仅由消费者线程（当前线程）读写
+    std::vector<int> lastSeen(producerCount, -1);
+    int received    = 0;
+    int keyedRuns   = 0;
+    bool outOfOrder = false;
+
+    std::atomic<int> wakeups{0};
+    std::atomic<int> finished{0};
+    std::vector<std::thread> producers;
+
+    for (int p = 0; p < producerCount; ++p) {
+        producers.emplace_back([&, p]() {
+            for (int i = 0; i < taskCount; ++i) {
+                // 不同优先级之间的执行顺序不确定，只检查同一优先级内的顺序
+                auto task = [&, p, i]() {
+                    if (i % 3 == 0) {
+                        if (i <= lastSeen[p]) outOfOrder = true;
+                        lastSeen[p] = i;
+                    }
+                    ++received;
+                };
+                if (queue.Enqueue(task, static_cast<sw::DispatcherPriority>(i % 3))) {
+                    ++wakeups;
+                }
+            }
+            // 每个生产者最后提交一个相同键值的任务，执行前入队的同键值任务会被合并
+            queue.Enqueue([&]() { ++keyedRuns; }, sw::DispatcherPriority::Background, 42);
+            ++finished;
+        });
+    }
+
+    while (finished.load() < producerCount) {
+        queue.Drain();
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    CHECK_FALSE(queue.Drain());
+
+    CHECK_EQ(producerCount * taskCount, received);
+    CHECK_FALSE(outOfOrder);
+    CHECK_GE(wakeups.load(), 1);
+
+    sw::DispatcherQueueMetrics metrics = queue.GetMetrics();
+    CHECK_EQ(size_t(0), metrics.depth);
+    CHECK_GE(keyedRuns, 1);
+    CHECK_EQ(uint64_t(producerCount), keyedRuns + metrics.coalescedCount);
+    CHECK_EQ(uint64_t(producerCount * (taskCount + 1)), metrics.enqueuedCount);
+    CHECK_EQ(metrics.enqueuedCount, metrics.executedCount + metrics.coalescedCount);
+}
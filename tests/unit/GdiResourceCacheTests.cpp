@@ -0,0 +1,183 @@
+#include "Test.h"
+
+#include "BrushCache.h"
+#include "Font.h"
+#include "FontCache.h"
+
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief 测试使用的字体，名称不与其他测试或系统默认字体重复，避免共享缓存项
+     */
+    sw::Font CreateTestFont(double size = 13)
+    {
+        return sw::Font(L"sw-font-cache-test", size, sw::FontWeight::Normal);
+    }
+}
+
+TEST_CASE("FontCache shares one handle among controls using the same font")
+{
+    const int controlCount = 64;
+
+    sw::FontCacheStatistics before = sw::FontCache::GetStatistics();
+
+    // 与WndBase::UpdateFont相同，每个控件各自获取一次字体句柄
+    std::vector<HFONT> handles;
+    for (int i = 0; i < controlCount; ++i) {
+        handles.push_back(sw::FontCache::Acquire(CreateTestFont()));
+    }
+
+    REQUIRE(handles.front() != NULL);
+    for (HFONT hfont : handles) {
+        CHECK(hfont == handles.front());
+    }
+
+    sw::FontCacheStatistics acquired = sw::FontCache::GetStatistics();
+    CHECK_EQ(before.handleCount + 1, acquired.handleCount);
+    CHECK_EQ(before.referenceCount + controlCount, acquired.referenceCount);
+    CHECK_EQ(before.missCount + 1, acquired.missCount);
+    CHECK_EQ(before.hitCount + controlCount - 1, acquired.hitCount);
+
+    for (int i = 1; i < controlCount; ++i) {
+        sw::FontCache::Release(handles[i]);
+    }
+    CHECK_EQ(before.handleCount + 1, sw::FontCache::GetStatistics().handleCount);
+
+    sw::FontCache::Release(handles.front());
+
+    sw::FontCacheStatistics released = sw::FontCache::GetStatistics();
+    CHECK_EQ(before.handleCount, released.handleCount);
+    CHECK_EQ(before.referenceCount, released.referenceCount);
+}
+
+TEST_CASE("FontCache keys handles on the whole LOGFONTW")
+{
+    sw::FontCacheStatistics before = sw::FontCache::GetStatistics();
+
+    HFONT normal = sw::FontCache::Acquire(CreateTestFont(13));
+    HFONT larger = sw::FontCache::Acquire(CreateTestFont(20));
+
+    sw::Font italicFont = CreateTestFont(13);
+    italicFont.italic   = true;
+    HFONT italic        = sw::FontCache::Acquire(italicFont);
+
+    CHECK(normal != larger);
+    CHECK(normal != italic);
+    CHECK_EQ(before.handleCount + 3, sw::FontCache::GetStatistics().handleCount);
+
+    // 字体名称结束符之后的内容不影响查找
+    LOGFONTW logFont = CreateTestFont(13);
+    logFont.lfFaceName[LF_FACESIZE - 1] = L'x';
+    HFONT same = sw::FontCache::Acquire(logFont);
+    CHECK(same == normal);
+
+    for (HFONT hfont : {normal, larger, italic, same}) {
+        sw::FontCache::Release(hfont);
+    }
+    CHECK_EQ(before.handleCount, sw::FontCache::GetStatistics().handleCount);
+
+    // 释放NULL或不是由缓存创建的句柄时不做任何操作
+    CHECK_NOTHROW(sw::FontCache::Release(NULL));
+    CHECK_EQ(before.referenceCount, sw::FontCache::GetStatistics().referenceCount);
+}
+
+TEST_CASE("BrushCache reuses one brush per color on the current thread")
+{
+    sw::BrushCache::Clear();
+    sw::BrushCacheStatistics before = sw::BrushCache::GetStatistics();
+
+    HBRUSH red = sw::BrushCache::GetBrush(RGB(255, 0, 0));
+    REQUIRE(red != NULL);
+
+    // 模拟连续多次重绘
+    for (int i = 0; i < 100; ++i) {
+        CHECK(sw::BrushCache::GetBrush(RGB(255, 0, 0)) == red);
+    }
+    HBRUSH blue = sw::BrushCache::GetBrush(RGB(0, 0, 255));
+    CHECK(blue != red);
+
+    sw::BrushCacheStatistics after = sw::BrushCache::GetStatistics();
+    CHECK_EQ(before.createdCount + 2, after.createdCount);
+    CHECK_EQ(before.reusedCount + 100, after.reusedCount);
+    CHECK_EQ(2, after.brushCount);
+
+    sw::BrushCache::Clear();
+    CHECK_EQ(0, sw::BrushCache::GetStatistics().brushCount);
+    CHECK_EQ(after.evictedCount + 2, sw::BrushCache::GetStatistics().evictedCount);
+}
+
+TEST_CASE("BrushCache evicts the least recently used brush beyond its capacity")
+{
+    const int capacity = sw::BrushCache::GetCapacity();
+
+    sw::BrushCache::Clear();
+    sw::BrushCache::SetCapacity(2);
+
+    sw::BrushCache::GetBrush(RGB(1, 0, 0));
+    sw::BrushCache::GetBrush(RGB(2, 0, 0));
+    sw::BrushCache::GetBrush(RGB(1, 0, 0)); // RGB(2, 0, 0)成为最久未使用的画刷
+
+    sw::BrushCacheStatistics before = sw::BrushCache::GetStatistics();
+    sw::BrushCache::GetBrush(RGB(3, 0, 0));
+
+    sw::BrushCacheStatistics evicted = sw::BrushCache::GetStatistics();
+    CHECK_EQ(2, evicted.brushCount);
+    CHECK_EQ(before.evictedCount + 1, evicted.evictedCount);
+
+    sw::BrushCache::GetBrush(RGB(1, 0, 0));
+    CHECK_EQ(evicted.reusedCount + 1, sw::BrushCache::GetStatistics().reusedCount);
+    sw::BrushCache::GetBrush(RGB(2, 0, 0));
+    CHECK_EQ(evicted.createdCount + 1, sw::BrushCache::GetStatistics().createdCount);
+
+    sw::BrushCache::SetCapacity(0);
+    CHECK_EQ(1, sw::BrushCache::GetCapacity());
+    CHECK_EQ(1, sw::BrushCache::GetStatistics().brushCount);
+
+    sw::BrushCache::SetCapacity(capacity);
+    sw::BrushCache::Clear();
+}
+
+TEST_CASE("BrushCache keeps acquired brushes alive across eviction and Clear")
+{
+    const int capacity = sw::BrushCache::GetCapacity();
+
+    sw::BrushCache::Clear();
+    sw::BrushCache::SetCapacity(1);
+
+    // 模拟控件在WM_CTLCOLORxxx中返回的画刷
+    HBRUSH pinned = sw::BrushCache::Acquire(RGB(10, 0, 0));
+    REQUIRE(pinned != NULL);
+    CHECK(sw::BrushCache::Acquire(RGB(10, 0, 0)) == pinned);
+    CHECK_EQ(1, sw::BrushCache::GetStatistics().acquiredCount);
+
+    // 被引用的画刷不计入容量，获取其他颜色不会将其销毁
+    sw::BrushCache::GetBrush(RGB(11, 0, 0));
+    sw::BrushCache::GetBrush(RGB(12, 0, 0));
+    CHECK_EQ(2, sw::BrushCache::GetStatistics().brushCount);
+    CHECK(sw::BrushCache::GetBrush(RGB(10, 0, 0)) == pinned);
+
+    sw::BrushCacheStatistics before = sw::BrushCache::GetStatistics();
+    sw::BrushCache::Clear();
+    CHECK_EQ(1, sw::BrushCache::GetStatistics().brushCount);
+    CHECK_EQ(before.evictedCount + 1, sw::BrushCache::GetStatistics().evictedCount);
+    CHECK(sw::BrushCache::GetBrush(RGB(10, 0, 0)) == pinned);
+
+    // 引用计数归零后按容量规则淘汰
+    sw::BrushCache::Release(pinned);
+    CHECK_EQ(1, sw::BrushCache::GetStatistics().acquiredCount);
+    sw::BrushCache::Release(pinned);
+    CHECK_EQ(0, sw::BrushCache::GetStatistics().acquiredCount);
+    CHECK_EQ(1, sw::BrushCache::GetStatistics().brushCount);
+
+    sw::BrushCache::Clear();
+    CHECK_EQ(0, sw::BrushCache::GetStatistics().brushCount);
+
+    // 多余的Release与NULL不做任何操作
+    CHECK_NOTHROW(sw::BrushCache::Release(pinned));
+    CHECK_NOTHROW(sw::BrushCache::Release(NULL));
+    CHECK_EQ(0, sw::BrushCache::GetStatistics().acquiredCount);
+
+    sw::BrushCache::SetCapacity(capacity);
+}
@@ -0,0 +1,174 @@
+#include "Test.h"
+
+#include "IdleScheduler.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief 返回完成remaining次工作后报告没有工作的任务，每次调用向log追加name
+     */
+    sw::Func<bool> CountDown(std::string &log, const char *name, int remaining)
+    {
+        return [&log, name, remaining]() mutable {
+            log += name;
+            return --remaining > 0;
+        };
+    }
+
+    /**
+     * @brief 忙等待指定时间
+     */
+    void Spin(std::chrono::microseconds duration)
+    {
+        auto end = std::chrono::steady_clock::now() + duration;
+        while (std::chrono::steady_clock::now() < end) {
+        }
+    }
+}
+
+TEST_CASE("IdleScheduler calls tasks round-robin until none has work")
+{
+    sw::IdleScheduler scheduler;
+    std::string log;
+
+    CHECK(scheduler.IsEmpty());
+    CHECK_FALSE(scheduler.Run(std::chrono::seconds(1)));
+
+    scheduler.Add(L"a", CountDown(log, "a", 3));
+    scheduler.Add(L"b", CountDown(log, "b", 1));
+    scheduler.Add(L"c", CountDown(log, "c", 2));
+
+    CHECK_FALSE(scheduler.IsEmpty());
+    CHECK_FALSE(scheduler.Run(std::chrono::seconds(1)));
+    CHECK_EQ(std::string("abcaca"), log);
+
+    // 没有工作的任务在Reset之前不再调用
+    log.clear();
+    CHECK_FALSE(scheduler.Run(std::chrono::seconds(1)));
+    CHECK(log.empty());
+
+    // 从上次最后执行的任务的下一个开始
+    scheduler.Reset();
+    CHECK_FALSE(scheduler.Run(std::chrono::seconds(1)));
+    CHECK_EQ(std::string("bca"), log);
+}
+
+TEST_CASE("IdleScheduler runs at least one task and resumes after the last one it ran")
+{
+    sw::IdleScheduler scheduler;
+    std::string log;
+
+    scheduler.Add(L"a", CountDown(log, "a", 100));
+    scheduler.Add(L"b", CountDown(log, "b", 100));
+    scheduler.Add(L"c", CountDown(log, "c", 100));
+
+    // 预算为0时每次只执行一个任务，依次轮到每个任务
+    for (int i = 0; i < 4; ++i) {
+        CHECK(scheduler.Run(std::chrono::nanoseconds(0)));
+    }
+    CHECK_EQ(std::string("abca"), log);
+
+    // shouldYield在每个任务执行后检查
+    log.clear();
+    int budget = 2;
+    CHECK(scheduler.Run(std::chrono::seconds(1), [&]() { return budget-- <= 0; }));
+    CHECK_EQ(std::string("bca"), log);
+}
+
+TEST_CASE("IdleScheduler stops when the time budget is used up")
+{
+    sw::IdleScheduler scheduler;
+    int calls = 0;
+
+    scheduler.Add(L"slow", [&]() {
+        ++calls;
+        Spin(std::chrono::microseconds(2000));
+        return true;
+    });
+
+    CHECK(scheduler.Run(std::chrono::microseconds(5000)));
+    CHECK_GE(calls, 3);
+    CHECK(calls <= 4);
+
+    std::vector<sw::IdleTaskStatistics> statistics = scheduler.GetStatistics();
+    REQUIRE_EQ(size_t(1), statistics.size());
+    CHECK(statistics[0].name == L"slow");
+    CHECK_EQ(uint64_t(calls), statistics[0].callCount);
+    CHECK_GE(statistics[0].maxTime, uint64_t(2000000));
+    CHECK_GE(statistics[0].totalTime, uint64_t(calls) * 2000000);
+
+    scheduler.ResetStatistics();
+    statistics = scheduler.GetStatistics();
+    CHECK_EQ(uint64_t(0), statistics[0].callCount);
+    CHECK_EQ(uint64_t(0), statistics[0].totalTime);
+    CHECK_EQ(uint64_t(0), statistics[0].maxTime);
+}
+
+TEST_CASE("IdleScheduler reports the cost of each task separately")
+{
+    sw::IdleScheduler scheduler;
+
+    int cheap = scheduler.Add(L"cheap", []() { return false; });
+    int heavy = scheduler.Add(L"heavy", []() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return false;
+    });
+
+    CHECK_FALSE(scheduler.Run(std::chrono::seconds(1)));
+
+    std::vector<sw::IdleTaskStatistics> statistics = scheduler.GetStatistics();
+    REQUIRE_EQ(size_t(2), statistics.size());
+    CHECK_EQ(cheap, statistics[0].id);
+    CHECK_EQ(heavy, statistics[1].id);
+    CHECK_EQ(uint64_t(1), statistics[0].callCount);
+    CHECK_EQ(uint64_t(1), statistics[1].callCount);
+    CHECK_GE(statistics[1].totalTime, uint64_t(1000000));
+    CHECK(statistics[0].totalTime < statistics[1].totalTime);
+}
+
+TEST_CASE("IdleScheduler allows tasks to add and remove tasks while running")
+{
+    sw::IdleScheduler scheduler;
+    std::string log;
+
+    int b = 0;
+    scheduler.Add(L"a", [&]() {
+        log += 'a';
+        scheduler.Remove(b);
+        scheduler.Add(L"c", CountDown(log, "c", 1));
+        return false;
+    });
+    b = scheduler.Add(L"b", CountDown(log, "b", 1));
+
+    CHECK_FALSE(scheduler.Run(std::chrono::seconds(1)));
+    CHECK_EQ(std::string("ac"), log);
+    CHECK_EQ(size_t(2), scheduler.GetStatistics().size());
+    CHECK_FALSE(scheduler.Remove(b));
+
+    // 任务移除自身
+    log.clear();
+    int self = 0;
+    self     = scheduler.Add(L"self", [&]() {
+        log += 's';
+        scheduler.Remove(self);
+        return true;
+    });
+    CHECK_FALSE(scheduler.Run(std::chrono::seconds(1)));
+    CHECK_EQ(std::string("s"), log);
+    CHECK_EQ(size_t(2), scheduler.GetStatistics().size());
+
+    // 任务中嵌套调用Run不执行任何任务
+    log.clear();
+    scheduler.Add(L"nested", [&]() {
+        log += 'n';
+        CHECK_FALSE(scheduler.Run(std::chrono::seconds(1)));
+        return false;
+    });
+    CHECK_FALSE(scheduler.Run(std::chrono::seconds(1)));
+    CHECK_EQ(std::string("n"), log);
+}
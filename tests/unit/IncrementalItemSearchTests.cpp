@@ -0,0 +1,137 @@
+#include "Test.h"
+
+#include "IItemSearchIndex.h"
+#include "IncrementalItemSearch.h"
+
+#include <cwctype>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief 逐项比较前缀的索引，记录每次查找的参数
+     */
+    class ListSearchIndex : public sw::IItemSearchIndex
+    {
+    public:
+        std::vector<std::wstring> items;
+        std::vector<std::wstring> prefixes;
+        std::vector<int> startIndices;
+
+        explicit ListSearchIndex(std::vector<std::wstring> items)
+            : items(std::move(items))
+        {
+        }
+
+        int FindPrefix(const std::wstring &prefix, int startIndex) override
+        {
+            prefixes.push_back(prefix);
+            startIndices.push_back(startIndex);
+
+            return sw::IncrementalItemSearch::FindNext(
+                static_cast<int>(items.size()), startIndex, [&](int index) -> bool {
+                    const std::wstring &text = items[index];
+                    if (text.size() < prefix.size()) return false;
+                    for (size_t i = 0; i < prefix.size(); ++i) {
+                        if (std::towupper(text[i]) != std::towupper(prefix[i])) return false;
+                    }
+                    return true;
+                });
+        }
+    };
+
+    /**
+     * @brief 通过索引处理输入，返回应选中的子项
+     */
+    int Type(sw::IncrementalItemSearch &search, ListSearchIndex &index, wchar_t ch, uint32_t time, int current)
+    {
+        return search.Input(ch, time, current, [&index](const std::wstring &prefix, int startIndex) -> int {
+            return index.FindPrefix(prefix, startIndex);
+        });
+    }
+}
+
+TEST_CASE("IncrementalItemSearch FindNext wraps around from the item after startIndex")
+{
+    std::vector<int> visited;
+    auto never = [&](int index) -> bool {
+        visited.push_back(index);
+        return false;
+    };
+
+    CHECK_EQ(-1, sw::IncrementalItemSearch::FindNext(4, 1, never));
+    CHECK_EQ((std::vector<int>{2, 3, 0, 1}), visited);
+
+    visited.clear();
+    CHECK_EQ(-1, sw::IncrementalItemSearch::FindNext(3, -1, never));
+    CHECK_EQ((std::vector<int>{0, 1, 2}), visited);
+
+    visited.clear();
+    CHECK_EQ(-1, sw::IncrementalItemSearch::FindNext(3, 7, never));
+    CHECK_EQ((std::vector<int>{0, 1, 2}), visited);
+
+    CHECK_EQ(-1, sw::IncrementalItemSearch::FindNext(0, -1, never));
+
+    auto isEven = [](int index) { return index % 2 == 0; };
+    CHECK_EQ(0, sw::IncrementalItemSearch::FindNext(5, 4, isEven));
+    CHECK_EQ(4, sw::IncrementalItemSearch::FindNext(5, 2, isEven));
+}
+
+TEST_CASE("IncrementalItemSearch cycles through items when the same character is repeated")
+{
+    ListSearchIndex index({L"apple", L"Banana", L"avocado", L"blueberry", L"apricot"});
+    sw::IncrementalItemSearch search;
+
+    int current = -1;
+    current     = Type(search, index, L'a', 100, current);
+    CHECK_EQ(0, current);
+    current = Type(search, index, L'a', 200, current);
+    CHECK_EQ(2, current);
+    current = Type(search, index, L'a', 300, current);
+    CHECK_EQ(4, current);
+    current = Type(search, index, L'a', 400, current);
+    CHECK_EQ(0, current);
+
+    CHECK(search.GetText() == L"aaaa");
+    CHECK((std::vector<std::wstring>{L"a", L"a", L"a", L"a"}) == index.prefixes);
+    CHECK_EQ((std::vector<int>{-1, 0, 2, 4}), index.startIndices);
+
+    // 不区分大小写
+    search.Reset();
+    CHECK_EQ(1, Type(search, index, L'B', 500, current));
+}
+
+TEST_CASE("IncrementalItemSearch keeps the current item while it still matches and restarts after the timeout")
+{
+    ListSearchIndex index({L"apple", L"apricot", L"avocado", L"banana"});
+    sw::IncrementalItemSearch search(1000);
+
+    int current = Type(search, index, L'a', 0, -1);
+    CHECK_EQ(0, current);
+
+    // "ap"仍匹配当前项，从当前项开始查找
+    current = Type(search, index, L'p', 500, current);
+    CHECK_EQ(0, current);
+    CHECK_EQ(-1, index.startIndices.back());
+
+    current = Type(search, index, L'r', 900, current);
+    CHECK_EQ(1, current);
+    CHECK(search.GetText() == L"apr");
+
+    // 未找到时返回-1，已输入的文本保留
+    CHECK_EQ(-1, Type(search, index, L'x', 1000, current));
+    CHECK(search.GetText() == L"aprx");
+
+    // 超过间隔后重新开始
+    current = Type(search, index, L'b', 2001, current);
+    CHECK_EQ(3, current);
+    CHECK(search.GetText() == L"b");
+
+    // 计时器回绕时按无符号差值计算间隔
+    sw::IncrementalItemSearch wrapped(1000);
+    CHECK_EQ(0, Type(wrapped, index, L'a', 0xFFFFFF00u, -1));
+    CHECK_EQ(0, Type(wrapped, index, L'p', 0x00000010u, 0));
+    CHECK_EQ(1, Type(wrapped, index, L'r', 0x00000020u, 0));
+    CHECK(wrapped.GetText() == L"apr");
+}
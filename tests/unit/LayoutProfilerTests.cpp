@@ -0,0 +1,182 @@
+#include "Test.h"
+
+#include "LayoutProfiler.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief 模拟UIElement的测量与排列过程：元素通过布局对象测量和排列子元素，叶子元素调用SetWindowPos
+     */
+    struct ProfiledElement {
+        std::vector<ProfiledElement *> children;
+        bool measureValid = false;
+
+        virtual ~ProfiledElement() = default;
+
+        void Measure()
+        {
+            if (measureValid) {
+                sw::LayoutProfiler::RecordMeasureSkipped(this);
+                return;
+            }
+            sw::LayoutProfiler::Scope scope(this, sw::LayoutPass::Measure);
+            MeasureOverride();
+            measureValid = true;
+        }
+
+        void Arrange()
+        {
+            sw::LayoutProfiler::Scope scope(this, sw::LayoutPass::Arrange);
+            if (children.empty()) {
+                Spin();
+                sw::LayoutProfiler::RecordSetWindowPos(this);
+            } else {
+                ArrangeOverride();
+            }
+        }
+
+        virtual void MeasureOverride()
+        {
+            Spin();
+        }
+
+        virtual void ArrangeOverride()
+        {
+        }
+
+        /**
+         * @brief 占用少量时间，保证计时结果不为0
+         */
+        static void Spin()
+        {
+            auto start = std::chrono::steady_clock::now();
+            while (std::chrono::steady_clock::now() - start < std::chrono::microseconds(50)) {
+            }
+        }
+    };
+
+    /**
+     * @brief 模拟Layer：测量和排列时交给布局对象处理子元素
+     */
+    struct ProfiledPanel : ProfiledElement {
+        struct Layout {
+            virtual ~Layout() = default;
+        } layout;
+
+        virtual void MeasureOverride() override
+        {
+            sw::LayoutProfiler::Scope scope(&layout, sw::LayoutPass::Measure);
+            for (ProfiledElement *child : children) child->Measure();
+        }
+
+        virtual void ArrangeOverride() override
+        {
+            sw::LayoutProfiler::Scope scope(&layout, sw::LayoutPass::Arrange);
+            for (ProfiledElement *child : children) child->Arrange();
+        }
+    };
+
+    const sw::LayoutProfileRecord *FindRecord(const std::vector<sw::LayoutProfileRecord> &records, const void *obj)
+    {
+        for (const auto &record : records) {
+            if (record.object == obj) return &record;
+        }
+        return nullptr;
+    }
+}
+
+TEST_CASE("LayoutProfiler records per-element passes, times and window position calls")
+{
+    ProfiledPanel panel;
+    ProfiledElement first, second;
+    panel.children = {&first, &second};
+
+    sw::LayoutProfiler::Reset();
+    sw::LayoutProfiler::SetEnabled(true, true);
+
+    panel.Measure();
+    panel.Arrange();
+
+    // 第二次布局时子元素的测量未失效，只统计为跳过
+    panel.measureValid = false;
+    panel.Measure();
+    panel.Arrange();
+
+    sw::LayoutProfiler::SetEnabled(false);
+
+    auto records = sw::LayoutProfiler::GetRecords();
+    REQUIRE_EQ(size_t(4), records.size());
+
+    const sw::LayoutProfileRecord *panelRecord  = FindRecord(records, &panel);
+    const sw::LayoutProfileRecord *layoutRecord = FindRecord(records, &panel.layout);
+    const sw::LayoutProfileRecord *firstRecord  = FindRecord(records, &first);
+    const sw::LayoutProfileRecord *secondRecord = FindRecord(records, &second);
+    REQUIRE(panelRecord != nullptr);
+    REQUIRE(layoutRecord != nullptr);
+    REQUIRE(firstRecord != nullptr);
+    REQUIRE(secondRecord != nullptr);
+
+    // 调用关系：panel -> layout -> first/second
+    CHECK(panelRecord->parent == nullptr);
+    CHECK(layoutRecord->parent == &panel);
+    CHECK(firstRecord->parent == &panel.layout);
+    CHECK(secondRecord->parent == &panel.layout);
+
+    CHECK_EQ(uint64_t(2), panelRecord->measureCount);
+    CHECK_EQ(uint64_t(2), panelRecord->arrangeCount);
+    CHECK_EQ(uint64_t(1), firstRecord->measureCount);
+    CHECK_EQ(uint64_t(1), firstRecord->measureSkipCount);
+    CHECK_EQ(uint64_t(2), firstRecord->arrangeCount);
+    CHECK_EQ(uint64_t(2), firstRecord->setWindowPosCount);
+    CHECK_EQ(uint64_t(0), panelRecord->setWindowPosCount);
+    CHECK_EQ(uint64_t(0), panelRecord->deferWindowPosCount);
+
+    // 独占时间不含嵌套对象的时间
+    CHECK_GT(firstRecord->arrangeExclusiveTime, uint64_t(0));
+    CHECK_EQ(firstRecord->arrangeInclusiveTime, firstRecord->arrangeExclusiveTime);
+    CHECK_GE(layoutRecord->arrangeInclusiveTime, firstRecord->arrangeInclusiveTime + secondRecord->arrangeInclusiveTime);
+    CHECK_EQ(layoutRecord->arrangeInclusiveTime - firstRecord->arrangeInclusiveTime - secondRecord->arrangeInclusiveTime,
+             layoutRecord->arrangeExclusiveTime);
+    CHECK_GE(panelRecord->measureInclusiveTime, layoutRecord->measureInclusiveTime);
+    CHECK_LE(panelRecord->measureExclusiveTime, panelRecord->measureInclusiveTime - layoutRecord->measureInclusiveTime);
+
+    // 树形JSON中子元素嵌套在布局对象中
+    std::string json = sw::LayoutProfiler::ToJson();
+    CHECK(json.compare(0, 13, "{\"elements\":[") == 0);
+    CHECK(json.find("\"children\":[{\"type\"") != std::string::npos);
+    CHECK(json.find("\"skipped\":1") != std::string::npos);
+    CHECK(json.find("\"setWindowPos\":2") != std::string::npos);
+
+    // 每次实际执行的测量和排列各对应一个事件：测量2+2+1+1，排列2+2+2+2
+    std::string trace = sw::LayoutProfiler::ToChromeTrace();
+    size_t eventCount = 0;
+    for (size_t pos = trace.find("\"ph\":\"X\""); pos != std::string::npos; pos = trace.find("\"ph\":\"X\"", pos + 1)) {
+        ++eventCount;
+    }
+    CHECK_EQ(size_t(14), eventCount);
+
+    sw::LayoutProfiler::Reset();
+    CHECK(sw::LayoutProfiler::GetRecords().empty());
+}
+
+TEST_CASE("LayoutProfiler records nothing while disabled")
+{
+    ProfiledPanel panel;
+    ProfiledElement child;
+    panel.children = {&child};
+
+    sw::LayoutProfiler::Reset();
+    CHECK_FALSE(sw::LayoutProfiler::IsEnabled());
+
+    panel.Measure();
+    panel.Arrange();
+    panel.Measure();
+
+    CHECK(sw::LayoutProfiler::GetRecords().empty());
+    CHECK_EQ(std::string("{\"elements\":[]}"), sw::LayoutProfiler::ToJson());
+    CHECK(sw::LayoutProfiler::ToChromeTrace().find("\"ph\"") == std::string::npos);
+}
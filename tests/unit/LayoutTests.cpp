@@ -1,5 +1,6 @@
 #include "Test.h"
 
+#include "AllocationCounter.h"
 #include "LayoutTestHelpers.h"
 
 #include "CanvasLayout.h"
@@ -8,6 +9,7 @@
 #include "GridLayout.h"
 #include "StackLayout.h"
 #include "UniformGridLayout.h"
+#include "VirtualizingStackLayout.h"
 #include "WrapLayout.h"
 
 #include <limits>
@@ -31,6 +33,44 @@ namespace
             this->host.Associate(&this->container);
         }
     };
+
+    /**
+     * @brief 创建包含1000个子元素的布局，预热一次后统计重复Measure/Arrange期间的堆分配次数
+     * @param setup 添加子元素前对布局对象的设置
+     * @param tagOf 根据子元素索引返回布局标记
+     */
+    template <typename TLayout, typename TSetup, typename TTagOf>
+    size_t CountSteadyStateAllocations(TSetup setup, TTagOf tagOf)
+    {
+        const int childCount = 1000;
+        const sw::Size available(800, 600);
+
+        swtest::layouttest::ContainerLayout container;
+        TLayout host;
+        host.Associate(&container);
+        setup(host);
+
+        for (int i = 0; i < childCount; ++i) {
+            auto &child = container.EmplaceChild(
+                "child", sw::Size(10 + i % 7 * 5, 8 + i % 5 * 3), tagOf(i));
+            child.recordHistory = false;
+        }
+
+        host.MeasureOverride(available);
+        host.ArrangeOverride(available);
+
+        swtest::AllocationScope scope;
+        for (int pass = 0; pass < 10; ++pass) {
+            host.MeasureOverride(available);
+            host.ArrangeOverride(available);
+        }
+        return scope.Allocations();
+    }
+
+    uint64_t NoTag(int)
+    {
+        return 0;
+    }
 }
 
 TEST_CASE("RecordingLayout records measure arrange calls and returns configured state")
@@ -202,6 +242,117 @@ TEST_CASE("StackLayout dispatches through the generic host orientation")
     CHECK_EQ(sw::Rect(30, 0, 20, 20), second.lastArrangeRect);
 }
 
+TEST_CASE("VirtualizingStackLayout measures only items intersecting the viewport")
+{
+    LayoutFixture<sw::VirtualizingStackLayout> fx;
+    swtest::layouttest::RecordingItemGenerator generator(5000, sw::Size(80, 20), &fx.calls);
+    fx.host.generator = &generator;
+
+    fx.host.UpdateViewport(sw::Rect(0, 0, 100, 100));
+    CHECK_EQ(sw::Size(80, 100000), fx.host.MeasureOverride(sw::Size(100, 100)));
+
+    std::vector<std::string> expectedCalls{
+        "item0.Measure",
+        "item1.Measure",
+        "item2.Measure",
+        "item3.Measure",
+        "item4.Measure"};
+    CHECK_EQ(expectedCalls, fx.calls);
+    CHECK_EQ(sw::Size(100, kInf), generator.realized.at(0)->lastMeasureAvailableSize);
+    CHECK_EQ(5, generator.CreatedCount());
+
+    fx.host.ArrangeOverride(sw::Size(100, 100));
+    CHECK_EQ(sw::Rect(0, 40, 100, 20), generator.realized.at(2)->lastArrangeRect);
+    CHECK_EQ(sw::Rect(0, 80, 100, 20), generator.realized.at(4)->lastArrangeRect);
+
+    // 滚动后只实现化与新可视区域相交的项，并复用离开可视区域的容器
+    fx.calls.clear();
+    fx.host.UpdateViewport(sw::Rect(0, 1010, 100, 100));
+    fx.host.MeasureOverride(sw::Size(100, 100));
+
+    expectedCalls = {
+        "item50.Measure",
+        "item51.Measure",
+        "item52.Measure",
+        "item53.Measure",
+        "item54.Measure",
+        "item55.Measure"};
+    CHECK_EQ(expectedCalls, fx.calls);
+    CHECK_EQ(50, fx.host.GetFirstRealizedIndex());
+    CHECK_EQ(6, fx.host.GetRealizedCount());
+    CHECK_EQ(6, static_cast<int>(generator.realized.size()));
+    CHECK_EQ(5, generator.recycleCount);
+    CHECK_EQ(6, generator.CreatedCount());
+
+    fx.host.ArrangeOverride(sw::Size(100, 100));
+    CHECK_EQ(sw::Rect(0, 1000, 100, 20), generator.realized.at(50)->lastArrangeRect);
+    CHECK_EQ(sw::Rect(0, 1100, 100, 20), generator.realized.at(55)->lastArrangeRect);
+
+    fx.calls.clear();
+    fx.host.UpdateViewport(sw::Rect(0, 30, 100, 100));
+    fx.host.MeasureOverride(sw::Size(100, 100));
+
+    CHECK_EQ(6, static_cast<int>(fx.calls.size()));
+    CHECK_EQ("item1.Measure", fx.calls.front());
+    CHECK_EQ("item6.Measure", fx.calls.back());
+    CHECK_EQ(1, fx.host.GetFirstRealizedIndex());
+    CHECK_EQ(6, generator.CreatedCount());
+}
+
+TEST_CASE("VirtualizingStackLayout estimates unrealized items and realizes newly exposed items on arrange")
+{
+    LayoutFixture<sw::VirtualizingStackLayout> fx;
+    swtest::layouttest::RecordingItemGenerator generator(100, sw::Size(30, 15), &fx.calls);
+    fx.host.generator           = &generator;
+    fx.host.orientation         = sw::Orientation::Horizontal;
+    fx.host.estimatedItemExtent = 10;
+
+    fx.host.UpdateViewport(sw::Rect(0, 0, 50, 40));
+    CHECK_EQ(sw::Size(2 * 30 + 98 * 10, 15), fx.host.MeasureOverride(sw::Size(50, 40)));
+    CHECK_EQ(sw::Size(kInf, 40), generator.realized.at(0)->lastMeasureAvailableSize);
+
+    fx.calls.clear();
+    fx.host.ArrangeOverride(sw::Size(100, 40));
+
+    std::vector<std::string> expectedCalls{
+        "item2.Measure",
+        "item3.Measure",
+        "item0.Arrange",
+        "item1.Arrange",
+        "item2.Arrange",
+        "item3.Arrange"};
+    CHECK_EQ(expectedCalls, fx.calls);
+    CHECK_EQ(sw::Rect(90, 0, 30, 40), generator.realized.at(3)->lastArrangeRect);
+    CHECK_EQ(sw::Size(4 * 30 + 96 * 10, 15), fx.host.GetContentExtent());
+
+    // 项数减少时回收超出范围的项
+    generator.itemSizes.resize(3);
+    CHECK_EQ(sw::Size(90, 15), fx.host.MeasureOverride(sw::Size(100, 40)));
+    CHECK_EQ(2, fx.host.GetRealizedCount());
+    CHECK_EQ(2, static_cast<int>(generator.realized.size()));
+    CHECK_EQ(2, generator.recycleCount);
+}
+
+TEST_CASE("VirtualizingStackLayout ResetItems recycles realized items and forgets measured extents")
+{
+    LayoutFixture<sw::VirtualizingStackLayout> fx;
+    swtest::layouttest::RecordingItemGenerator generator(10, sw::Size(40, 25));
+    fx.host.generator = &generator;
+
+    fx.host.UpdateViewport(sw::Rect(0, 0, 40, 60));
+    CHECK_EQ(sw::Size(40, 3 * 25 + 7 * 20), fx.host.MeasureOverride(sw::Size(40, 60)));
+    CHECK_EQ(3, static_cast<int>(generator.realized.size()));
+
+    fx.host.ResetItems();
+    CHECK_EQ(0, fx.host.GetRealizedCount());
+    CHECK_EQ(3, generator.recycleCount);
+    CHECK(generator.realized.empty());
+    CHECK_EQ(sw::Size(0, 10 * 20), fx.host.GetContentExtent());
+
+    fx.host.generator = nullptr;
+    CHECK_EQ(sw::Size(0, 0), fx.host.MeasureOverride(sw::Size(40, 60)));
+}
+
 TEST_CASE("FillLayout measures all children with the same constraint and fills the final rect")
 {
     LayoutFixture<sw::FillLayout> fx;
@@ -629,3 +780,159 @@ TEST_CASE("GridLayout uses fill remain rows and columns in finite space")
     CHECK_EQ(sw::Rect(0, 0, 30, 10), first.lastArrangeRect);
     CHECK_EQ(sw::Rect(30, 10, 90, 90), second.lastArrangeRect);
 }
+
+TEST_CASE("GridLayout recomputes auto tracks when only child sizes change")
+{
+    LayoutFixture<sw::GridLayout> fx;
+    fx.host.rows.Add(sw::AutoSizeGridRow());
+    fx.host.rows.Add(sw::FillRemainGridRow(1));
+    fx.host.columns.Add(sw::AutoSizeGridColumn());
+    fx.host.columns.Add(sw::FillRemainGridColumn(1));
+
+    auto &first = fx.container.EmplaceChild(
+        "first",
+        sw::Size(30, 10),
+        static_cast<uint64_t>(sw::GridLayoutTag(0, 0)));
+    auto &second = fx.container.EmplaceChild(
+        "second",
+        sw::Size(20, 40),
+        static_cast<uint64_t>(sw::GridLayoutTag(1, 1)));
+
+    CHECK_EQ(sw::Size(120, 100), fx.host.MeasureOverride(sw::Size(120, 100)));
+
+    first.measureResultSize = sw::Size(50, 25);
+    CHECK_EQ(sw::Size(120, 100), fx.host.MeasureOverride(sw::Size(120, 100)));
+    CHECK_EQ(sw::Size(70, 75), second.lastMeasureAvailableSize);
+
+    fx.host.ArrangeOverride(sw::Size(120, 100));
+    CHECK_EQ(sw::Rect(0, 0, 50, 25), first.lastArrangeRect);
+    CHECK_EQ(sw::Rect(50, 25, 70, 75), second.lastArrangeRect);
+
+    // 子元素变小时，AutoSize行列应随之缩小而不是保留上次的尺寸
+    first.measureResultSize = sw::Size(30, 10);
+    CHECK_EQ(sw::Size(120, 100), fx.host.MeasureOverride(sw::Size(120, 100)));
+    CHECK_EQ(sw::Size(90, 90), second.lastMeasureAvailableSize);
+
+    fx.host.ArrangeOverride(sw::Size(120, 100));
+    CHECK_EQ(sw::Rect(0, 0, 30, 10), first.lastArrangeRect);
+    CHECK_EQ(sw::Rect(30, 10, 90, 90), second.lastArrangeRect);
+}
+
+TEST_CASE("GridLayout keeps fixed tracks and unchanged auto tracks when another auto track changes")
+{
+    LayoutFixture<sw::GridLayout> fx;
+    fx.host.rows.Add(sw::FixSizeGridRow(20));
+    fx.host.rows.Add(sw::AutoSizeGridRow());
+    fx.host.columns.Add(sw::FixSizeGridColumn(40));
+    fx.host.columns.Add(sw::AutoSizeGridColumn());
+    fx.host.columns.Add(sw::AutoSizeGridColumn());
+
+    auto &fixed = fx.container.EmplaceChild(
+        "fixed",
+        sw::Size(5, 5),
+        static_cast<uint64_t>(sw::GridLayoutTag(0, 0)));
+    auto &changing = fx.container.EmplaceChild(
+        "changing",
+        sw::Size(30, 10),
+        static_cast<uint64_t>(sw::GridLayoutTag(1, 1)));
+    auto &steady = fx.container.EmplaceChild(
+        "steady",
+        sw::Size(25, 8),
+        static_cast<uint64_t>(sw::GridLayoutTag(1, 2)));
+
+    CHECK_EQ(sw::Size(95, 30), fx.host.MeasureOverride(sw::Size(kInf, kInf)));
+
+    changing.measureResultSize = sw::Size(50, 12);
+    CHECK_EQ(sw::Size(115, 32), fx.host.MeasureOverride(sw::Size(kInf, kInf)));
+
+    // 固定尺寸的行列不参与重新计算，其中的子元素只以单元格尺寸测量，不会以无限尺寸测量
+    REQUIRE_EQ(2, static_cast<int>(fixed.measureAvailableSizes.size()));
+    CHECK_EQ(sw::Size(40, 20), fixed.measureAvailableSizes[0]);
+    CHECK_EQ(sw::Size(40, 20), fixed.measureAvailableSizes[1]);
+
+    // 另一AutoSize列改变时，子元素未改变的列宽度不变，其子元素收到的可用尺寸与上次相同
+    REQUIRE_EQ(4, static_cast<int>(steady.measureAvailableSizes.size()));
+    CHECK_EQ(steady.measureAvailableSizes[0], steady.measureAvailableSizes[2]);
+    CHECK_EQ(sw::Size(25, kInf), steady.measureAvailableSizes[1]);
+    CHECK_EQ(sw::Size(25, kInf), steady.measureAvailableSizes[3]);
+
+    fx.host.ArrangeOverride(sw::Size(115, 32));
+    CHECK_EQ(sw::Rect(0, 0, 40, 20), fixed.lastArrangeRect);
+    CHECK_EQ(sw::Rect(40, 20, 50, 12), changing.lastArrangeRect);
+    CHECK_EQ(sw::Rect(90, 20, 25, 12), steady.lastArrangeRect);
+}
+
+TEST_CASE("GridLayout rebuilds its cached structure when tags, definitions or children change")
+{
+    LayoutFixture<sw::GridLayout> fx;
+    fx.host.rows.Add(sw::FixSizeGridRow(10));
+    fx.host.rows.Add(sw::FixSizeGridRow(20));
+    fx.host.columns.Add(sw::FixSizeGridColumn(30));
+    fx.host.columns.Add(sw::FixSizeGridColumn(40));
+
+    auto &moving = fx.container.EmplaceChild(
+        "moving",
+        sw::Size(1, 1),
+        static_cast<uint64_t>(sw::GridLayoutTag(0, 0)));
+
+    CHECK_EQ(sw::Size(70, 30), fx.host.MeasureOverride(sw::Size(100, 50)));
+    fx.host.ArrangeOverride(sw::Size(100, 50));
+    CHECK_EQ(sw::Rect(0, 0, 30, 10), moving.lastArrangeRect);
+
+    moving.layoutTag = static_cast<uint64_t>(sw::GridLayoutTag(1, 1));
+    CHECK_EQ(sw::Size(70, 30), fx.host.MeasureOverride(sw::Size(100, 50)));
+    CHECK_EQ(sw::Size(40, 20), moving.lastMeasureAvailableSize);
+    fx.host.ArrangeOverride(sw::Size(100, 50));
+    CHECK_EQ(sw::Rect(30, 10, 40, 20), moving.lastArrangeRect);
+
+    fx.host.rows.SetAt(1, sw::FixSizeGridRow(50));
+    fx.host.columns.Add(sw::FixSizeGridColumn(5));
+    CHECK_EQ(sw::Size(75, 60), fx.host.MeasureOverride(sw::Size(100, 80)));
+    CHECK_EQ(sw::Size(40, 50), moving.lastMeasureAvailableSize);
+
+    auto &added = fx.container.EmplaceChild(
+        "added",
+        sw::Size(1, 1),
+        static_cast<uint64_t>(sw::GridLayoutTag(0, 2)));
+    CHECK_EQ(sw::Size(75, 60), fx.host.MeasureOverride(sw::Size(100, 80)));
+    CHECK_EQ(1, added.measureCount);
+    CHECK_EQ(sw::Size(5, 10), added.lastMeasureAvailableSize);
+
+    fx.host.ArrangeOverride(sw::Size(100, 80));
+    CHECK_EQ(sw::Rect(30, 10, 40, 50), moving.lastArrangeRect);
+    CHECK_EQ(sw::Rect(70, 0, 5, 10), added.lastArrangeRect);
+}
+
+TEST_CASE("Layouts do not allocate during steady-state relayout of 1000 children")
+{
+    CHECK_EQ(size_t(0), CountSteadyStateAllocations<sw::StackLayout>([](sw::StackLayout &) {}, NoTag));
+    CHECK_EQ(size_t(0), CountSteadyStateAllocations<sw::FillLayout>([](sw::FillLayout &) {}, NoTag));
+
+    CHECK_EQ(size_t(0), CountSteadyStateAllocations<sw::WrapLayout>(
+                            [](sw::WrapLayout &host) { host.orientation = sw::Orientation::Horizontal; }, NoTag));
+    CHECK_EQ(size_t(0), CountSteadyStateAllocations<sw::WrapLayout>(
+                            [](sw::WrapLayout &host) { host.orientation = sw::Orientation::Vertical; }, NoTag));
+
+    CHECK_EQ(size_t(0), CountSteadyStateAllocations<sw::UniformGridLayout>(
+                            [](sw::UniformGridLayout &host) { host.rows = 25, host.columns = 40; }, NoTag));
+
+    CHECK_EQ(size_t(0), CountSteadyStateAllocations<sw::DockLayout>(
+                            [](sw::DockLayout &) {}, [](int i) -> uint64_t { return i % 4; }));
+
+    CHECK_EQ(size_t(0), CountSteadyStateAllocations<sw::CanvasLayout>(
+                            [](sw::CanvasLayout &) {},
+                            [](int i) -> uint64_t { return sw::CanvasLayoutTag(float(i % 40 * 20), float(i / 40 * 20)); }));
+
+    // 自动、固定与按比例分配的行列混合，且部分子元素跨多行多列
+    CHECK_EQ(size_t(0), CountSteadyStateAllocations<sw::GridLayout>(
+                            [](sw::GridLayout &host) {
+                                for (int i = 0; i < 10; ++i) {
+                                    switch (i % 3) {
+                                        case 0: host.rows.Add(sw::AutoSizeGridRow()), host.columns.Add(sw::AutoSizeGridColumn()); break;
+                                        case 1: host.rows.Add(sw::FixSizeGridRow(20)), host.columns.Add(sw::FixSizeGridColumn(30)); break;
+                                        default: host.rows.Add(sw::FillRemainGridRow(1)), host.columns.Add(sw::FillRemainGridColumn(1)); break;
+                                    }
+                                }
+                            },
+                            [](int i) -> uint64_t { return sw::GridLayoutTag(i / 10 % 10, i % 10, 1 + i % 3 / 2, 1 + i % 5 / 4); }));
+}
@@ -0,0 +1,122 @@
+#include "Test.h"
+
+#include "Menu.h"
+#include "MenuItem.h"
+
+TEST_CASE("MenuBase finds items by id and tag after the tree changes")
+{
+    sw::Menu menu{
+        sw::MenuItemDesc(1, L"File", {
+            sw::MenuItemDesc(11, L"Open"),
+            sw::MenuItemDesc(12, L"Save"),
+        }),
+        sw::MenuItemDesc(2, L"Edit"),
+    };
+
+    sw::MenuItem *open = menu.FindMenuItemByTag(11);
+    REQUIRE(open != nullptr);
+    CHECK(open->Text.Get() == L"Open");
+    CHECK(menu.FindMenuItemById(open->Id) == open);
+
+    sw::MenuItem *edit = menu.FindMenuItemByTag(2);
+    REQUIRE(edit != nullptr);
+
+    // 添加和插入的菜单项（包括其子菜单项）立即可以查找
+    sw::MenuItem *copy = edit->AddChild(sw::MenuItemDesc(21, L"Copy"));
+    sw::MenuItem *help = menu.Root->InsertChild(0, sw::MenuItemDesc(3, L"Help", {sw::MenuItemDesc(31, L"About")}));
+    CHECK(menu.FindMenuItemByTag(21) == copy);
+    CHECK(menu.FindMenuItemById(help->Id) == help);
+    REQUIRE(menu.FindMenuItemByTag(31) != nullptr);
+    CHECK(menu.FindMenuItemByTag(31)->GetParent() == help);
+
+    // 移除的菜单项及其子菜单项不再能被找到
+    int openId  = open->Id;
+    int aboutId = menu.FindMenuItemByTag(31)->Id;
+    CHECK(menu.Root->RemoveChild(help));
+    CHECK(menu.FindMenuItemByTag(3) == nullptr);
+    CHECK(menu.FindMenuItemById(aboutId) == nullptr);
+
+    // 修改tag后按新tag查找
+    copy->Tag = 22;
+    CHECK(menu.FindMenuItemByTag(21) == nullptr);
+    CHECK(menu.FindMenuItemByTag(22) == copy);
+
+    // 重置子菜单项
+    menu.Root->ResetChildren({sw::MenuItemDesc(4, L"View")});
+    CHECK(menu.FindMenuItemById(openId) == nullptr);
+    CHECK(menu.FindMenuItemByTag(22) == nullptr);
+    REQUIRE(menu.FindMenuItemByTag(4) != nullptr);
+    CHECK(menu.FindMenuItemByTag(4)->Text.Get() == L"View");
+
+    menu.Root->ClearChildren();
+    CHECK(menu.FindMenuItemByTag(4) == nullptr);
+}
+
+TEST_CASE("MenuItem lookups stay within the item's own subtree")
+{
+    sw::Menu menu{
+        sw::MenuItemDesc(1, L"File", {sw::MenuItemDesc(11, L"Open")}),
+        sw::MenuItemDesc(2, L"Edit", {sw::MenuItemDesc(21, L"Copy")}),
+        sw::MenuItemDesc(5, L"Duplicate tag"),
+    };
+
+    sw::MenuItem *file = menu.FindMenuItemByTag(1);
+    sw::MenuItem *copy = menu.FindMenuItemByTag(21);
+    REQUIRE(file != nullptr);
+    REQUIRE(copy != nullptr);
+
+    CHECK(file->FindChildByTag(1) == file);
+    CHECK(file->FindChildByTag(11) != nullptr);
+    CHECK(file->FindChildByTag(21) == nullptr);
+    CHECK(file->FindChildById(copy->Id) == nullptr);
+
+    // 同一tag存在多个菜单项时只返回位于当前子树中的菜单项，有多个时返回先序遍历中的第一个
+    sw::MenuItem *duplicate = menu.FindMenuItemByTag(5);
+    sw::MenuItem *inner     = file->AddChild(sw::MenuItemDesc(5, L"Inner"));
+    REQUIRE(duplicate != nullptr);
+    CHECK(duplicate->Text.Get() == L"Duplicate tag");
+    CHECK(file->FindChildByTag(5) == inner);
+    CHECK(menu.FindMenuItemByTag(5) == inner);
+
+    sw::MenuItem *nested = inner->AddChild(sw::MenuItemDesc(5, L"Nested"));
+    CHECK(menu.FindMenuItemByTag(5) == inner);
+    CHECK(inner->FindChildByTag(5) == inner);
+    inner->Tag = 6;
+    CHECK(menu.FindMenuItemByTag(5) == nested);
+    CHECK(file->FindChildByTag(5) == nested);
+
+    // tag为0的菜单项不加入索引，仍可通过遍历找到
+    sw::MenuItem *untagged = file->AddChild(L"Untagged");
+    CHECK(untagged->Tag.Get() == 0);
+    CHECK(file->FindChildByTag(0) == untagged);
+
+    // 未挂到菜单下的菜单项没有索引，查找结果与挂到菜单下时一致
+    std::unique_ptr<sw::MenuItem> detached(sw::MenuItem::Create(sw::MenuItemDesc(7, L"Detached", {sw::MenuItemDesc(71, L"Child")})));
+    CHECK(detached->FindChildByTag(71) != nullptr);
+    sw::MenuItem *first = detached->AddChild(sw::MenuItemDesc(8, L"First"));
+    detached->AddChild(sw::MenuItemDesc(8, L"Second"));
+    CHECK(detached->FindChildByTag(8) == first);
+    CHECK(detached->FindChildById(copy->Id) == nullptr);
+}
+
+TEST_CASE("MenuBase raises ItemClicked for indexed items only")
+{
+    sw::Menu menu{sw::MenuItemDesc(1, L"File", {sw::MenuItemDesc(11, L"Open")})};
+
+    sw::MenuItem *clicked = nullptr;
+    menu.ItemClicked += [&clicked](sw::MenuItem &item, sw::MenuItemClickedEventArgs &) {
+        clicked = &item;
+    };
+
+    sw::MenuItem *open = menu.FindMenuItemByTag(11);
+    REQUIRE(open != nullptr);
+
+    int openId = open->Id;
+    CHECK(menu.RaiseClickedEvent(openId));
+    CHECK(clicked == open);
+
+    menu.FindMenuItemByTag(1)->ClearChildren();
+    clicked = nullptr;
+    CHECK_FALSE(menu.RaiseClickedEvent(openId));
+    CHECK(clicked == nullptr);
+}
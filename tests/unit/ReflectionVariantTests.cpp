@@ -1,11 +1,15 @@
 #include "Test.h"
 
+#include "AllocationCounter.h"
+#include "ObservableCollection.h"
+#include "ObservableObject.h"
 #include "Reflection.h"
 #include "Variant.h"
 
 #include <stdexcept>
 #include <string>
 #include <typeindex>
+#include <vector>
 
 namespace
 {
@@ -155,6 +159,70 @@ TEST_CASE("Variant supports copy move and reference equality")
     CHECK(ref.ReferenceEquals(sw::Variant::MakeRef(obj)));
 }
 
+TEST_CASE("Variant stores small values inline without allocating")
+{
+    ReflectiveObject obj;
+    obj.number = 5;
+
+    std::size_t allocations = 0;
+    {
+        swtest::AllocationScope scope;
+
+        sw::Variant number = 42;
+        sw::Variant real   = 2.5;
+        sw::Variant flag   = true;
+        sw::Variant ref    = sw::Variant::MakeRef(obj);
+
+        sw::Variant copied = number;
+        sw::Variant moved  = std::move(copied);
+        real               = flag;
+        flag               = std::move(moved);
+        ref                = sw::Variant::MakeRef(obj);
+
+        allocations = scope.Allocations();
+
+        CHECK_EQ(42, number.DynamicCast<int>());
+        CHECK_EQ(42, flag.DynamicCast<int>());
+        CHECK_EQ(true, real.DynamicCast<bool>());
+        CHECK(copied.IsNull());
+        CHECK(moved.IsNull());
+        CHECK(ref.Object() == &obj);
+    }
+    CHECK_EQ(0u, allocations);
+}
+
+TEST_CASE("Variant inline and heap storage keep value semantics")
+{
+    sw::Variant small = 1;
+    sw::Variant large = std::wstring(L"a string long enough to live outside of the small string buffer");
+
+    sw::Variant smallCopy = small;
+    sw::Variant largeCopy = large;
+    smallCopy.DynamicCast<int>() = 2;
+    largeCopy.DynamicCast<std::wstring>() += L"!";
+
+    CHECK_EQ(1, small.DynamicCast<int>());
+    CHECK_EQ(2, smallCopy.DynamicCast<int>());
+    CHECK(large.DynamicCast<std::wstring>() != largeCopy.DynamicCast<std::wstring>());
+
+    small.Reset(small.DynamicCast<int>() + 10);
+    CHECK_EQ(11, small.DynamicCast<int>());
+
+    small.Reset(small.DynamicCast<int>());
+    CHECK_EQ(11, small.DynamicCast<int>());
+
+    small = large;
+    large = smallCopy;
+    CHECK(small.IsType<std::wstring>());
+    CHECK_EQ(2, large.DynamicCast<int>());
+
+    sw::Variant derived = DerivedReflectiveObject{};
+    derived.DynamicCast<DerivedReflectiveObject>().extra = 4;
+    sw::Variant derivedCopy = derived;
+    CHECK(derivedCopy.IsType<DerivedReflectiveObject>());
+    CHECK_EQ(4, derivedCopy.DynamicCast<DerivedReflectiveObject>().extra);
+}
+
 TEST_CASE("Variant keeps DynamicObject references transparent across copy and const access")
 {
     ReflectiveObject obj;
@@ -234,6 +302,36 @@ TEST_CASE("Variant MakeRef forwards existing variant storage")
     CHECK_EQ(9, obj.number);
 }
 
+TEST_CASE("Variant MakeRef keeps referring to inline values after the source is moved")
+{
+    sw::Variant value    = 42;
+    sw::Variant valueRef = sw::Variant::MakeRef(value);
+
+    // 触发多次扩容，使value中的对象随vector中的Variant一起被移动
+    std::vector<sw::Variant> values;
+    values.push_back(std::move(value));
+    for (int i = 0; i < 16; ++i) {
+        values.emplace_back(i);
+    }
+
+    CHECK(valueRef.ReferenceEquals(values.front()));
+    CHECK_EQ(42, valueRef.DynamicCast<int>());
+
+    valueRef.DynamicCast<int>() = 43;
+    CHECK_EQ(43, values.front().DynamicCast<int>());
+
+    sw::Variant copied = values.front();
+    copied.DynamicCast<int>() = 44;
+    CHECK_EQ(43, values.front().DynamicCast<int>());
+    CHECK_EQ(44, copied.DynamicCast<int>());
+
+    sw::Variant moveOnly    = sw::Variant::MakeVal<MoveOnly>(7);
+    sw::Variant moveOnlyRef = sw::Variant::MakeRef(moveOnly);
+    sw::Variant movedTo     = std::move(moveOnly);
+    CHECK(moveOnlyRef.ReferenceEquals(movedTo));
+    CHECK_EQ(7, moveOnlyRef.DynamicCast<MoveOnly>().value);
+}
+
 TEST_CASE("Variant casts throw for null and mismatched types")
 {
     sw::Variant empty;
@@ -263,6 +361,33 @@ TEST_CASE("Reflection field ids are stable and distinguish fields")
     CHECK_EQ(std::to_wstring(numberA.value), numberA.ToString());
 }
 
+TEST_CASE("Reflection field ids distinguish fields at the same offset")
+{
+    struct First {
+        int value;
+        int other;
+    };
+    struct Second {
+        int value;
+    };
+    struct Third {
+        float value;
+    };
+
+    auto first  = sw::Reflection::GetFieldId(&First::value);
+    auto second = sw::Reflection::GetFieldId(&Second::value);
+    auto third  = sw::Reflection::GetFieldId(&Third::value);
+
+    // 偏移相同，分别只有所属类或字段类型不同
+    CHECK(first != second);
+    CHECK(second != third);
+    CHECK(first != sw::Reflection::GetFieldId(&First::other));
+
+    // 通过非常量成员指针计算的结果与常量成员指针相同
+    int First::*volatile field = &First::value;
+    CHECK(sw::Reflection::GetFieldId(static_cast<int First::*>(field)) == first);
+}
+
 TEST_CASE("Reflection method and field accessors work for plain and dynamic objects")
 {
     PlainObject plain;
@@ -299,3 +424,51 @@ TEST_CASE("Reflection property getters and setters work")
     sw::Reflection::SetProperty(setter, obj, 44);
     CHECK_EQ(44, obj.number);
 }
+
+TEST_CASE("DynamicObject resolves registered interfaces and falls back to dynamic_cast")
+{
+    // 额外实现了INotifyCollectionChanged但未重写QueryInterface，需回退到dynamic_cast
+    struct UnregisteredCollection : sw::ObservableObject, sw::INotifyCollectionChanged {
+        sw::NotifyCollectionChangedEventHandler handler;
+
+        sw::NotifyCollectionChangedEventHandler &GetCollectionChangedEventDelegate() override
+        {
+            return handler;
+        }
+    };
+
+    sw::ObservableCollection<int> collection;
+    sw::DynamicObject &collectionObject = collection;
+
+    sw::INotifyCollectionChanged *notifyCollection = nullptr;
+    sw::IList *list                                = nullptr;
+    sw::ObservableObject *observable               = nullptr;
+
+    REQUIRE(collectionObject.IsType(&notifyCollection));
+    REQUIRE(collectionObject.IsType(&list));
+    REQUIRE(collectionObject.IsType(&observable));
+    CHECK(notifyCollection == static_cast<sw::INotifyCollectionChanged *>(&collection));
+    CHECK(list == static_cast<sw::IList *>(&collection));
+    CHECK(observable == static_cast<sw::ObservableObject *>(&collection));
+
+    const sw::DynamicObject &constObject = collection;
+    CHECK(&constObject.DynamicCast<sw::INotifyPropertyChanged>() == static_cast<const sw::INotifyPropertyChanged *>(&collection));
+    CHECK(&constObject.DynamicCast<sw::INotifyObjectDead>() == static_cast<const sw::INotifyObjectDead *>(&collection));
+
+    UnregisteredCollection unregistered;
+    sw::DynamicObject &unregisteredObject = unregistered;
+
+    CHECK(unregisteredObject.IsType(&notifyCollection));
+    CHECK(notifyCollection == static_cast<sw::INotifyCollectionChanged *>(&unregistered));
+    CHECK(unregisteredObject.IsType<sw::INotifyPropertyChanged>());
+    CHECK_FALSE(unregisteredObject.IsType(&list));
+    CHECK(list == nullptr);
+    REQUIRE_THROWS_AS(unregisteredObject.DynamicCast<sw::IList>(), std::bad_cast);
+
+    // 未派生自ObservableObject的对象不受影响
+    ReflectiveObject plain;
+    sw::DynamicObject &plainObject = plain;
+    CHECK_FALSE(plainObject.IsType<sw::INotifyPropertyChanged>());
+    CHECK_FALSE(plainObject.IsType<sw::ObservableObject>());
+    REQUIRE_THROWS_AS(plainObject.DynamicCast<sw::ObservableObject>(), std::bad_cast);
+}
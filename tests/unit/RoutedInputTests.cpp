@@ -3,6 +3,7 @@
 #include "Keys.h"
 #include "RoutedEvent.h"
 #include "RoutedEventArgs.h"
+#include "RoutedEventHandlerTable.h"
 
 #include <type_traits>
 #include <windows.h>
@@ -152,3 +153,43 @@ TEST_CASE("List and control routed event args preserve indices text time and key
     CHECK(hotkey.key == sw::VirtualKey::K);
     CHECK(hotkey.modifier == sw::HotKeyModifier::Ctrl);
 }
+
+TEST_CASE("RoutedEventHandlerTable lookups do not insert entries")
+{
+    sw::RoutedEventHandlerTable table;
+    const sw::RoutedEventType userType = static_cast<sw::RoutedEventType>(sw::RoutedEventType_User + 5);
+
+    CHECK(table.Find(sw::UIElement_MouseMove) == nullptr);
+    CHECK(table.Find(userType) == nullptr);
+    CHECK_EQ(0, table.Count());
+
+    table.GetOrAdd(sw::TreeView_CheckStateChanged) += [](sw::UIElement &, sw::RoutedEventArgs &) {};
+    table.GetOrAdd(userType) += [](sw::UIElement &, sw::RoutedEventArgs &) {};
+    table.GetOrAdd(sw::UIElement_SizeChanged);
+
+    CHECK_EQ(3, table.Count());
+    CHECK(table.Find(sw::UIElement_MouseMove) == nullptr);
+    CHECK(table.Find(static_cast<sw::RoutedEventType>(sw::RoutedEventType_User + 6)) == nullptr);
+    CHECK_EQ(3, table.Count());
+
+    REQUIRE(table.Find(sw::UIElement_SizeChanged) != nullptr);
+    CHECK(*table.Find(sw::UIElement_SizeChanged) == nullptr);
+    REQUIRE(table.Find(sw::TreeView_CheckStateChanged) != nullptr);
+    CHECK(*table.Find(sw::TreeView_CheckStateChanged) != nullptr);
+    REQUIRE(table.Find(userType) != nullptr);
+    CHECK(*table.Find(userType) != nullptr);
+}
+
+TEST_CASE("RoutedEventHandlerTable keeps handler references stable while inserting")
+{
+    sw::RoutedEventHandlerTable table;
+
+    sw::RoutedEventHandler &first = table.GetOrAdd(sw::UIElement_MouseMove);
+    for (uint32_t i = 1; i <= 64; ++i) {
+        table.GetOrAdd(static_cast<sw::RoutedEventType>(sw::RoutedEventType_User + i));
+    }
+
+    CHECK(&first == table.Find(sw::UIElement_MouseMove));
+    CHECK(&first == &table.GetOrAdd(sw::UIElement_MouseMove));
+    CHECK_EQ(65, table.Count());
+}
@@ -0,0 +1,173 @@
+#include "Test.h"
+
+#include "TextBox.h"
+
+#include <string>
+#include <utility>
+#include <windows.h>
+
+namespace
+{
+    /**
+     * @brief 处理当前线程消息队列中的所有消息，使InvokeAsync投递的追加操作得以执行
+     */
+    void PumpMessages()
+    {
+        MSG msg;
+        while (PeekMessageW(&msg, NULL, 0, 0, PM_REMOVE)) {
+            TranslateMessage(&msg);
+            DispatchMessageW(&msg);
+        }
+    }
+
+    /**
+     * @brief 获取文本框当前的选区
+     */
+    std::pair<int, int> GetSelection(sw::TextBox &textBox)
+    {
+        DWORD start = 0, end = 0;
+        textBox.SendMessageW(EM_GETSEL, reinterpret_cast<WPARAM>(&start), reinterpret_cast<LPARAM>(&end));
+        return {static_cast<int>(start), static_cast<int>(end)};
+    }
+
+    /**
+     * @brief 记录Text属性更改通知次数的文本框
+     */
+    class CountingTextBox : public sw::TextBox
+    {
+    public:
+        int textChangedCount = 0;
+
+        CountingTextBox()
+        {
+            this->MultiLine = true;
+            this->AddPropertyChangedHandler(
+                sw::Reflection::GetFieldId(&sw::WndBase::Text),
+                sw::PropertyChangedEventHandler(*this, &CountingTextBox::OnTextPropertyChanged));
+        }
+
+    private:
+        void OnTextPropertyChanged(sw::INotifyPropertyChanged &, sw::PropertyChangedEventArgs &)
+        {
+            ++textChangedCount;
+        }
+    };
+}
+
+TEST_CASE("TextBox coalesces several appends into one update")
+{
+    CountingTextBox textBox;
+    textBox.Text             = L"start";
+    textBox.textChangedCount = 0;
+
+    textBox.AppendText(L"\r\none");
+    textBox.AppendText(L"\r\ntwo");
+    textBox.AppendLines({L"", L"three"});
+    CHECK_EQ(0, textBox.textChangedCount);
+
+    PumpMessages();
+    CHECK_EQ(1, textBox.textChangedCount);
+    CHECK(textBox.Text.Get() == L"start\r\none\r\ntwo\r\nthree\r\n");
+    CHECK_EQ(1, textBox.textChangedCount);
+}
+
+TEST_CASE("TextBox Text includes appended text before and after the posted flush")
+{
+    CountingTextBox textBox;
+    textBox.Text             = L"a";
+    textBox.textChangedCount = 0;
+
+    // 投递的写入执行之前读取Text会立即写入
+    textBox.AppendText(L"b");
+    CHECK(textBox.Text.Get() == L"ab");
+    CHECK_EQ(1, textBox.textChangedCount);
+
+    // 之后执行投递的写入时没有剩余的文本
+    PumpMessages();
+    CHECK(textBox.Text.Get() == L"ab");
+    CHECK_EQ(1, textBox.textChangedCount);
+
+    textBox.AppendText(L"c");
+    PumpMessages();
+    CHECK(textBox.Text.Get() == L"abc");
+    CHECK_EQ(2, textBox.textChangedCount);
+
+    textBox.AppendText(L"d");
+    textBox.FlushAppendText();
+    CHECK_EQ(3, textBox.textChangedCount);
+    CHECK(textBox.Text.Get() == L"abcd");
+}
+
+TEST_CASE("TextBox MaxLineCount removes whole lines from the start")
+{
+    CountingTextBox textBox;
+    textBox.MaxLineCount = 3;
+
+    // 以换行结尾时末尾的空行不计入行数
+    textBox.AppendLines({L"1", L"2", L"3", L"4"});
+    textBox.FlushAppendText();
+    CHECK(textBox.Text.Get() == L"2\r\n3\r\n4\r\n");
+
+    textBox.AppendText(L"5");
+    textBox.FlushAppendText();
+    CHECK(textBox.Text.Get() == L"3\r\n4\r\n5");
+
+    textBox.AppendText(L"\r\n6\r\n7");
+    textBox.FlushAppendText();
+    CHECK(textBox.Text.Get() == L"5\r\n6\r\n7");
+}
+
+TEST_CASE("TextBox MaxTextLength removes text from the start by lines")
+{
+    CountingTextBox textBox;
+    textBox.MaxTextLength = 10;
+
+    // 超出的部分恰好为整行时只删除这些行
+    textBox.AppendText(L"aaaa\r\nbbbb\r\ncccc");
+    textBox.FlushAppendText();
+    CHECK(textBox.Text.Get() == L"bbbb\r\ncccc");
+
+    // 超出的部分在行中间结束时删除到下一行开头，不留下不完整的行
+    textBox.AppendText(L"dd");
+    textBox.FlushAppendText();
+    CHECK(textBox.Text.Get() == L"ccccdd");
+
+    textBox.Text = std::wstring{};
+    textBox.AppendText(L"aaaa\r\nbbbb\r\ncc");
+    textBox.FlushAppendText();
+    CHECK(textBox.Text.Get() == L"bbbb\r\ncc");
+}
+
+TEST_CASE("TextBox restores the caret and selection after appending")
+{
+    CountingTextBox textBox;
+    textBox.Text = L"hello\r\nworld";
+
+    // 选区不在末尾时保持选中相同的文本
+    textBox.Select(8, 3);
+    textBox.AppendText(L"\r\nmore");
+    textBox.FlushAppendText();
+    CHECK(GetSelection(textBox) == std::make_pair(8, 11));
+
+    // 开头的文本被删除时选区随之前移
+    textBox.Select(15, 2);
+    textBox.MaxLineCount = 2;
+    textBox.AppendText(L"\r\nlast");
+    textBox.FlushAppendText();
+    CHECK(textBox.Text.Get() == L"more\r\nlast");
+    CHECK(GetSelection(textBox) == std::make_pair(1, 3));
+
+    // 选中的文本被删除时选区移到开头
+    textBox.Select(1, 2);
+    textBox.AppendText(L"\r\nnext");
+    textBox.FlushAppendText();
+    CHECK(textBox.Text.Get() == L"last\r\nnext");
+    CHECK(GetSelection(textBox) == std::make_pair(0, 0));
+
+    // 插入符号在末尾时跟随追加的文本移动到新的末尾
+    textBox.MaxLineCount = 0;
+    textBox.Select(10, 0);
+    textBox.AppendText(L"!");
+    textBox.FlushAppendText();
+    CHECK(GetSelection(textBox) == std::make_pair(11, 11));
+}
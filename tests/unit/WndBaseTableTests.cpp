@@ -0,0 +1,79 @@
+#include "Test.h"
+
+#include "WndBaseTable.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief 构造测试用的句柄值，表只比较句柄值，不会调用任何窗口函数
+     */
+    HWND FakeHwnd(uintptr_t value)
+    {
+        return reinterpret_cast<HWND>(value);
+    }
+
+    /**
+     * @brief 构造测试用的对象指针，表不会解引用保存的指针
+     */
+    sw::WndBase *FakeWndBase(uintptr_t value)
+    {
+        return reinterpret_cast<sw::WndBase *>(value * 16);
+    }
+}
+
+TEST_CASE("WndBaseTable finds, replaces and removes handles")
+{
+    sw::WndBaseTable table;
+    const uintptr_t count = 1000;
+
+    CHECK_EQ(size_t(0), table.GetCount());
+    CHECK(table.Find(FakeHwnd(0x10)) == nullptr);
+
+    // 等差的句柄值经乘法哈希后几乎不会冲突，这里使用伪随机的句柄值，使部分句柄落在相同的探测序列上
+    std::vector<HWND> handles;
+    uint32_t seed = 12345;
+    for (uintptr_t i = 1; i <= count; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        handles.push_back(FakeHwnd((static_cast<uintptr_t>(seed) << 4) | 1));
+        table.Set(handles.back(), FakeWndBase(i));
+    }
+    CHECK_EQ(size_t(count), table.GetCount());
+
+    for (uintptr_t i = 1; i <= count; ++i) {
+        CHECK(table.Find(handles[i - 1]) == FakeWndBase(i));
+    }
+    CHECK(table.Find(FakeHwnd(0x10)) == nullptr);
+    CHECK(table.Find(NULL) == nullptr);
+
+    // 已存在的句柄替换对象而不增加表项
+    table.Set(handles[0], FakeWndBase(count + 1));
+    CHECK(table.Find(handles[0]) == FakeWndBase(count + 1));
+    CHECK_EQ(size_t(count), table.GetCount());
+
+    // 移除一半句柄后其余句柄仍可找到
+    for (uintptr_t i = 0; i < count; i += 2) {
+        table.Remove(handles[i]);
+    }
+    CHECK_EQ(size_t(count / 2), table.GetCount());
+
+    for (uintptr_t i = 0; i < count; ++i) {
+        if (i % 2 == 0) {
+            CHECK(table.Find(handles[i]) == nullptr);
+        } else {
+            CHECK(table.Find(handles[i]) == FakeWndBase(i + 1));
+        }
+    }
+
+    // 移除不存在的句柄不做任何操作
+    table.Remove(handles[0]);
+    table.Remove(NULL);
+    CHECK_EQ(size_t(count / 2), table.GetCount());
+
+    for (uintptr_t i = 1; i < count; i += 2) {
+        table.Remove(handles[i]);
+    }
+    CHECK_EQ(size_t(0), table.GetCount());
+}